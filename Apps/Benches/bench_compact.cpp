@@ -15,6 +15,8 @@
 #include "Utils/chrono.h"
 #include "Algo/Filtering/average.h"
 
+#include <cstdlib>
+
 using namespace CGoGN ;
 
 struct PFP: public PFP_STANDARD
@@ -30,11 +32,16 @@ typedef PFP::VEC3 VEC3;
 int main(int argc, char **argv)
 {
 
-	if(argc != 2)
+	if(argc < 2 || argc > 3)
 		return 1;
 
 	MAP myMap;
 
+	// optional attribute block size (default _BLOCKSIZE_)
+	if (argc == 3 && !myMap.setBlockSize(atoi(argv[2])))
+		return 1;
+	std::cout << "block size "<< myMap.getAttributeContainer<DART>().getBlockSize() << std::endl;
+
 	std::vector<std::string> attrNames ;
 	if(!Algo::Surface::Import::importMesh<PFP>(myMap, argv[1], attrNames))
 	{
@@ -0,0 +1,84 @@
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap3.h"
+
+#include "Algo/Import/import.h"
+#include "Algo/Topo/basic.h"
+
+#include "Utils/chrono.h"
+
+#include <cstdlib>
+#include <fstream>
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	// definition of the map
+	typedef EmbeddedMap3 MAP ;
+};
+
+typedef PFP::MAP MAP ;
+
+// write a grid of n*n*n cubes each cut in 6 tetrahedra (n=120 -> 10.4M tets)
+static void writeTetGrid(const std::string& filename, unsigned int n)
+{
+	std::ofstream out(filename.c_str());
+	unsigned int nv = n + 1;
+	out << nv*nv*nv << " vertices" << std::endl;
+	out << 6*n*n*n << " tets" << std::endl;
+	for (unsigned int k = 0; k < nv; ++k)
+		for (unsigned int j = 0; j < nv; ++j)
+			for (unsigned int i = 0; i < nv; ++i)
+				out << i << " " << j << " " << k << "\n";
+
+	const unsigned int tets[6][4] = { {0,1,2,6}, {0,2,3,6}, {0,3,7,6}, {0,7,4,6}, {0,4,5,6}, {0,5,1,6} };
+	for (unsigned int k = 0; k < n; ++k)
+		for (unsigned int j = 0; j < n; ++j)
+			for (unsigned int i = 0; i < n; ++i)
+			{
+				unsigned int o = i + nv*(j + nv*k);
+				unsigned int c[8] = { o, o+1, o+1+nv, o+nv, o+nv*nv, o+1+nv*nv, o+1+nv+nv*nv, o+nv+nv*nv };
+				for (unsigned int t = 0; t < 6; ++t)
+					out << "4 " << c[tets[t][0]] << " " << c[tets[t][1]] << " " << c[tets[t][2]] << " " << c[tets[t][3]] << "\n";
+			}
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 2)
+	{
+		std::cout << "usage: " << argv[0] << " <volume mesh file | grid size>" << std::endl;
+		return 1;
+	}
+
+	std::string filename(argv[1]);
+	unsigned int n = atoi(argv[1]);
+	if (n > 0)
+	{
+		filename = "bench_import3_grid.tet";
+		Utils::Chrono chrono;
+		chrono.start();
+		writeTetGrid(filename, n);
+		std::cout << "grid " << n << "^3 written in " << chrono.elapsed() << " ms" << std::endl;
+	}
+
+	std::cout << "threads " << Parallel::NumberOfThreads << std::endl;
+
+	MAP myMap;
+	std::vector<std::string> attrNames ;
+
+	Utils::Chrono chrono;
+	chrono.start();
+	if(!Algo::Volume::Import::importMesh<PFP>(myMap, filename, attrNames))
+	{
+		CGoGNerr << "could not import " << filename << CGoGNendl ;
+		return 2;
+	}
+	CGoGNout << "BenchTime import "<< chrono.elapsed() << " ms"<< CGoGNendl;
+
+	std::cout << "  NB Volumes "<< Algo::Topo::getNbOrbits<VOLUME>(myMap) << std::endl;
+	std::cout << "  NB Faces "<< Algo::Topo::getNbOrbits<FACE>(myMap) << std::endl;
+	std::cout << "  NB Vertices "<< Algo::Topo::getNbOrbits<VERTEX>(myMap) << std::endl;
+
+	return 0;
+}
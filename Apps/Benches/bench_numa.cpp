@@ -0,0 +1,229 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/mapBuilder.h"
+#include "Algo/Geometry/normal.h"
+#include "Container/blockAllocator.h"
+#include "Utils/chrono.h"
+
+#include <atomic>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+/**
+ * triangulated grid of nb x nb squares built in bulk: the blocks of the attributes
+ * (and their pages) are initialized by the threads of the builder
+ */
+void buildGrid(MAP& map, VertexAttribute<VEC3, MAP>& position, unsigned int nb)
+{
+	const unsigned int nbv = nb + 1;
+	MapBuilder<MAP> mb(map);
+	mb.reserveDarts(6 * nb * nb);
+	mb.reserveCells<VERTEX>(nbv * nbv);
+	mb.newDarts(6 * nb * nb);
+	mb.newCells<VERTEX>(nbv * nbv);
+
+	// square (i,j) : triangle (v00,v10,v11) darts 0..2, triangle (v00,v11,v01) darts 3..5
+	mb.setPhi1([] (unsigned int d) -> unsigned int { return (d % 3 == 2) ? d - 2 : d + 1; });
+	mb.setPhi2([nb] (unsigned int d) -> unsigned int
+	{
+		unsigned int q = d / 6;
+		unsigned int i = q % nb;
+		unsigned int j = q / nb;
+		switch (d % 6)
+		{
+			case 0 : return (j > 0) ? 6 * (q - nb) + 4 : EMBNULL;
+			case 1 : return (i < nb - 1) ? 6 * (q + 1) + 5 : EMBNULL;
+			case 2 : return 6 * q + 3;
+			case 3 : return 6 * q + 2;
+			case 4 : return (j < nb - 1) ? 6 * (q + nb) : EMBNULL;
+			default : return (i > 0) ? 6 * (q - 1) + 1 : EMBNULL;
+		}
+	});
+	mb.setEmbeddings<VERTEX>([nb, nbv] (unsigned int d) -> unsigned int
+	{
+		unsigned int q = d / 6;
+		unsigned int v00 = (q / nb) * nbv + q % nb;
+		const unsigned int corner[6] = { v00, v00 + 1, v00 + nbv + 1, v00, v00 + nbv + 1, v00 + nbv };
+		return corner[d % 6];
+	});
+
+	Parallel::foreach_index(0, nbv * nbv, [&] (unsigned int v, unsigned int)
+	{
+		position[mb.cell<VERTEX>(v)] = VEC3(float(v % nbv) / float(nb), float(v / nbv) / float(nb), 0.0f);
+	});
+
+	mb.closeMap();
+}
+
+/**
+ * count the pages of the blocks of an attribute on each NUMA node (move_pages query)
+ * @return false if the location of the pages can not be asked to the system
+ */
+bool pagesOnNodes(AttributeMultiVectorGen* amv, std::vector<unsigned int>& nbPages)
+{
+	nbPages.assign(NumaBlockAllocator::getNbNodes(), 0);
+#if defined(__linux__) && defined(SYS_move_pages)
+	std::vector<void*> blocks;
+	unsigned int byteBlockSize;
+	amv->getBlocksPointers(blocks, byteBlockSize);
+
+	const std::size_t pageSize = std::size_t(sysconf(_SC_PAGESIZE));
+	std::vector<void*> pages;
+	for (unsigned int b = 0; b < blocks.size(); ++b)
+	{
+		std::size_t first = reinterpret_cast<std::size_t>(blocks[b]) / pageSize;
+		std::size_t last = (reinterpret_cast<std::size_t>(blocks[b]) + byteBlockSize - 1) / pageSize;
+		for (std::size_t p = first; p <= last; ++p)
+			pages.push_back(reinterpret_cast<void*>(p * pageSize));
+	}
+	std::sort(pages.begin(), pages.end());
+	pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+
+	// without target nodes, move_pages only gives the node of each page
+	std::vector<int> status(pages.size(), -1);
+	if (!pages.empty() && syscall(SYS_move_pages, 0, pages.size(), &pages[0], NULL, &status[0], 0) != 0)
+		return false;
+	for (unsigned int i = 0; i < status.size(); ++i)
+	{
+		if (status[i] >= 0 && (unsigned int)(status[i]) < nbPages.size())
+			++nbPages[status[i]];
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void printPages(const std::string& name, AttributeMultiVectorGen* amv)
+{
+	std::vector<unsigned int> nbPages;
+	std::cout << "  pages of " << name << " by node :";
+	if (!pagesOnNodes(amv, nbPages))
+	{
+		std::cout << " unknown" << std::endl;
+		return;
+	}
+	for (unsigned int i = 0; i < nbPages.size(); ++i)
+		std::cout << " " << nbPages[i];
+	std::cout << std::endl;
+}
+
+/**
+ * Traverse a large mesh with the parallel normal computation:
+ *  - heap blocks, threads not pinned
+ *  - NUMA first touch blocks, threads pinned on the nodes (the blocks are
+ *    initialized by the pinned threads of the builder, then read by pinned threads)
+ *  - NUMA interleaved blocks, threads not pinned
+ * With pinned threads, each thread checks that it runs on a cpu of its node.
+ * The number of pages of the attributes on each node is given for each case:
+ * first touch and interleave must spread them on all the nodes.
+ */
+void bench(const std::string& name, BlockAllocator* alloc, bool pin, unsigned int nb, int nbPasses)
+{
+	Parallel::PinThreads = pin;
+
+	MAP myMap;
+	if (alloc != NULL)
+		myMap.setBlockAllocator(alloc);
+
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	VertexAttribute<VEC3, MAP> normal = myMap.addAttribute<VEC3, VERTEX, MAP>("normal");
+	buildGrid(myMap, position, nb);
+
+	// each traversal thread checks its cpu on the first cell it gets
+	std::vector<unsigned char> threadChecked(std::max(Parallel::NumberOfThreads, 2), 0);
+	std::atomic<unsigned int> nbMisplaced(0);
+	std::atomic<unsigned int> nbChecked(0);
+	Parallel::foreach_cell<VERTEX>(myMap, [&] (Vertex v, unsigned int thr)
+	{
+		normal[v] = VEC3(0);
+#ifdef __linux__
+		if (pin && !threadChecked[thr])
+		{
+			threadChecked[thr] = 1;
+			std::vector<unsigned int> cpus = NumaBlockAllocator::getNodeCpus(Parallel::numaNodeOfThread(thr));
+			int cpu = sched_getcpu();
+			if (cpu >= 0 && std::find(cpus.begin(), cpus.end(), (unsigned int)cpu) == cpus.end())
+				++nbMisplaced;
+			++nbChecked;
+		}
+#endif
+	});
+
+	Utils::Chrono ch;
+	ch.start();
+	for (int i = 0; i < nbPasses; ++i)
+		Algo::Surface::Geometry::Parallel::computeNormalVertices<PFP>(myMap, position, normal);
+	int elapsed = ch.elapsed();
+
+	std::cout << name << " : " << nbPasses << " normal passes in " << elapsed << " ms";
+	if (pin)
+		std::cout << " (" << nbMisplaced << " threads out of their node on " << nbChecked << " checks)";
+	std::cout << std::endl;
+	printPages("position", position.getDataVector());
+	printPages("normal", normal.getDataVector());
+
+	Parallel::PinThreads = false;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int nb = 1000;
+	if (argc > 1)
+		nb = atoi(argv[1]);
+	if (argc > 2)
+		Parallel::NumberOfThreads = atoi(argv[2]);
+
+	std::cout << NumaBlockAllocator::getNbNodes() << " NUMA nodes, " << Parallel::NumberOfThreads << " threads" << std::endl;
+	for (unsigned int i = 1; i < (unsigned int)(Parallel::NumberOfThreads); ++i)
+		std::cout << "thread " << i << " -> node " << Parallel::numaNodeOfThread(i) << std::endl;
+
+	bench("heap", NULL, false, nb, 10);
+
+	NumaBlockAllocator firstTouch(NumaBlockAllocator::FIRST_TOUCH);
+	bench("numa first touch, pinned", &firstTouch, true, nb, 10);
+
+	NumaBlockAllocator interleave(NumaBlockAllocator::INTERLEAVE);
+	bench("numa interleave", &interleave, false, nb, 10);
+
+	return 0;
+}
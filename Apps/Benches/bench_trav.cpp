@@ -30,6 +30,8 @@
 #include "Algo/Geometry/volume.h"
 #include "Utils/chrono.h"
 
+#include <cstdlib>
+
 
 using namespace CGoGN ;
 
@@ -49,11 +51,16 @@ typedef PFP::MAP MAP;
 typedef PFP::MAP::IMPL MAP_IMPL;
 typedef PFP::VEC3 VEC3;
 
-int main()
+int main(int argc, char **argv)
 {
 	// declare a map to handle the mesh
 	MAP myMap;
 
+	// optional attribute block size (default _BLOCKSIZE_)
+	if (argc > 1 && !myMap.setBlockSize(atoi(argv[1])))
+		return 1;
+	std::cout << "block size "<< myMap.getAttributeContainer<DART>().getBlockSize() << std::endl;
+
 	Utils::Chrono ch;
 	ch.start();
 	// add position attribute on vertices and get handler on it
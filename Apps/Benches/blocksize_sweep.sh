@@ -0,0 +1,43 @@
+#!/bin/bash
+
+# Run bench_trav & bench_compact for each attribute block size.
+# Usage: blocksize_sweep.sh mesh_file [build_type] [list of block sizes]
+#
+# The block size is a runtime setting of the maps, so the benches of an
+# existing build ($ROOT/bin/build_type) are run once per size, without
+# rebuilding anything.
+
+if test $# -lt 1; then
+	echo $0 mesh_file [Release/Debug] [block sizes]
+	exit 2
+fi
+
+MESH=$(readlink -f $1)
+ROOT=$(cd $(dirname $0)/../.. && pwd)
+TYPE=${2:-Release}
+shift
+if test $# -gt 0; then
+	shift
+fi
+SIZES=${@:-256 1024 4096 16384 65536}
+BIN=$ROOT/bin/$TYPE
+
+if test ! -f $MESH; then
+	echo File $MESH does not exist
+	exit 3
+fi
+
+for B in bench_trav bench_compact
+do
+	if test ! -x $BIN/$B; then
+		echo $BIN/$B not found: build the benches with CGoGN_COMPILE_BENCHES=ON
+		exit 4
+	fi
+done
+
+for BS in $SIZES
+do
+	echo "==== block size $BS ===="
+	$BIN/bench_trav $BS || exit 5
+	$BIN/bench_compact $MESH $BS || exit 5
+done
@@ -9,6 +9,7 @@ extern int test_geometryPredictor();
 extern int test_edgeSelector();
 extern int test_halfEdgeSelector();
 extern int test_decimation();
+extern int test_qemInit();
 
 int main()
 {
@@ -21,6 +22,7 @@ int main()
 	test_edgeSelector();
 	test_halfEdgeSelector();
 	test_decimation();
+	test_qemInit();
 
 	return 0;
 }
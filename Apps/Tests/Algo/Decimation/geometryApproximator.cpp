@@ -3,6 +3,7 @@
 #include "Topology/gmap/embeddedGMap2.h"
 
 #include "Algo/Decimation/geometryApproximator.h"
+#include "Utils/compactSphericalHarmonics.h"
 
 using namespace CGoGN;
 
@@ -29,6 +30,8 @@ template class Algo::Surface::Decimation::Approximator_QEMhalfEdge<PFP1>;
 template class Algo::Surface::Decimation::Approximator_InterpolateAlongEdge<PFP1,float>;
 template class Algo::Surface::Decimation::Approximator_HalfCollapse<PFP1,float>;
 template class Algo::Surface::Decimation::Approximator_CornerCutting<PFP1>;
+template class Algo::Surface::Decimation::Approximator_InterpolateAlongEdge<PFP1, Utils::CompactSphericalHarmonics<float, Geom::Vec3f, Utils::Half> >;
+template class Algo::Surface::Decimation::Approximator_HalfCollapse<PFP1, Utils::CompactSphericalHarmonics<float, Geom::Vec3f, Utils::Half> >;
 template class Algo::Surface::Decimation::Approximator_NormalArea<PFP1>;
 
 
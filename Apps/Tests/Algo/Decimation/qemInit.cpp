@@ -0,0 +1,48 @@
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/gmap/embeddedGMap2.h"
+
+#include "Algo/Decimation/qemInit.h"
+
+using namespace CGoGN;
+
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedGMap2 MAP;
+};
+
+
+template void Algo::Surface::Decimation::computeVertexQuadrics<PFP1>(
+	PFP1::MAP& map,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	VertexAttribute<Utils::Quadric<PFP1::REAL>, PFP1::MAP>& quadric);
+
+template void Algo::Surface::Decimation::evaluateEdgeCollapses<PFP1>(
+	PFP1::MAP& map,
+	const VertexAttribute<Utils::Quadric<PFP1::REAL>, PFP1::MAP>& quadric,
+	Algo::Surface::Decimation::Approximator<PFP1, PFP1::VEC3, EDGE>& approx,
+	std::vector<std::pair<PFP1::REAL, Dart> >& collapses);
+
+template void Algo::Surface::Decimation::computeVertexQuadrics<PFP2>(
+	PFP2::MAP& map,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	VertexAttribute<Utils::Quadric<PFP2::REAL>, PFP2::MAP>& quadric);
+
+template void Algo::Surface::Decimation::evaluateEdgeCollapses<PFP2>(
+	PFP2::MAP& map,
+	const VertexAttribute<Utils::Quadric<PFP2::REAL>, PFP2::MAP>& quadric,
+	Algo::Surface::Decimation::Approximator<PFP2, PFP2::VEC3, EDGE>& approx,
+	std::vector<std::pair<PFP2::REAL, Dart> >& collapses);
+
+
+int test_qemInit()
+{
+
+	return 0;
+}
@@ -3,6 +3,7 @@
 extern int test_average();
 extern int test_average_normals();
 extern int test_bilateral();
+extern int test_iterate();
 extern int test_taubin();
 extern int test_tools();
 
@@ -11,6 +12,7 @@ int main()
 	test_average();
 	test_average_normals();
 	test_bilateral();
+	test_iterate();
 	test_taubin();
 	test_tools();
 
@@ -87,6 +87,11 @@ template void Algo::Surface::Filtering::filterVNBA<PFP3>(PFP3::MAP& map, float s
 	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal);
 
 
+template class Algo::Surface::Filtering::FaceNormalsBuffers<PFP1>;
+template class Algo::Surface::Filtering::FaceNormalsBuffers<PFP2>;
+template class Algo::Surface::Filtering::FaceNormalsBuffers<PFP3>;
+
+
 int test_average_normals()
 {
 
@@ -0,0 +1,47 @@
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/gmap/embeddedGMap2.h"
+
+
+#include "Algo/Filtering/iterate.h"
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP3 : public PFP_DOUBLE
+{
+	typedef EmbeddedGMap2 MAP;
+};
+
+typedef void (*FILTER1)(const VertexAttribute<PFP1::VEC3, PFP1::MAP>&, VertexAttribute<PFP1::VEC3, PFP1::MAP>&);
+typedef void (*FILTER2)(const VertexAttribute<PFP2::VEC3, PFP2::MAP>&, VertexAttribute<PFP2::VEC3, PFP2::MAP>&);
+typedef void (*FILTER3)(const VertexAttribute<PFP3::VEC3, PFP3::MAP>&, VertexAttribute<PFP3::VEC3, PFP3::MAP>&);
+
+
+template void Algo::Surface::Filtering::iterateFilter<PFP1, FILTER1>(PFP1::MAP& map,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2,
+	unsigned int nbIterations, FILTER1 filter);
+
+template void Algo::Surface::Filtering::iterateFilter<PFP2, FILTER2>(PFP2::MAP& map,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2,
+	unsigned int nbIterations, FILTER2 filter);
+
+template void Algo::Surface::Filtering::iterateFilter<PFP3, FILTER3>(PFP3::MAP& map,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2,
+	unsigned int nbIterations, FILTER3 filter);
+
+
+int test_iterate()
+{
+
+	return 0;
+}
@@ -7,6 +7,10 @@ extern int test_basic();
 extern int test_convexity();
 extern int test_curvature();
 extern int test_distances();
+extern int test_closestFace();
+extern int test_geodesicPropagation();
+extern int test_heatGeodesics();
+extern int test_incrementalAttributes();
 
 
 int main()
@@ -18,6 +22,10 @@ int main()
 	test_convexity();
 	test_curvature();
 	test_distances();
+	test_closestFace();
+	test_geodesicPropagation();
+	test_heatGeodesics();
+	test_incrementalAttributes();
 
 	return 0;
 }
@@ -0,0 +1,39 @@
+#include <iostream>
+#include "Topology/generic/parameters.h"
+#include "Topology/gmap/embeddedGMap2.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/Geometry/closestFace.h"
+
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP3 : public PFP_STANDARD
+{
+	typedef EmbeddedGMap2 MAP;
+};
+
+
+/*****************************************
+*		 INSTANTIATION
+*****************************************/
+
+template class Algo::Geometry::ClosestFaceSearch<PFP1>;
+template class Algo::Geometry::ClosestFaceSearch<PFP2>;
+template class Algo::Geometry::ClosestFaceSearch<PFP3>;
+
+
+int test_closestFace()
+{
+	return 0;
+}
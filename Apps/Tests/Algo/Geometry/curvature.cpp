@@ -61,17 +61,44 @@ template void Algo::Surface::Geometry::vertexQuadraticFitting<PFP1>(
 	PFP1::REAL& a, PFP1::REAL& b, PFP1::REAL& c, PFP1::REAL& d, PFP1::REAL& e
 	);
 
+template void Algo::Surface::Geometry::computeCurvatureVertices_QuadraticFitting<PFP1>(
+	PFP1::MAP& map,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP1>& neigh,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmax,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmax,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmin
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertex_QuadraticFitting<PFP1>(
+	PFP1::MAP& map,
+	Vertex v,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP1>& neigh,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmax,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmax,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmin
+	);
+
 template void Algo::Surface::Geometry::quadraticFittingAddVertexPos<PFP1>(
-	PFP1::VEC3& v,
-	PFP1::VEC3& p,
-	PFP1::MATRIX33& localFrame
+	const PFP1::VEC3& v,
+	const PFP1::VEC3& p,
+	const PFP1::MATRIX33& localFrame,
+	Eigen::Matrix<double,5,5>& AtA,
+	Eigen::Matrix<double,5,1>& Atb
 	);
 
 template void Algo::Surface::Geometry::quadraticFittingAddVertexNormal<PFP1>(
-	PFP1::VEC3& v,
-	PFP1::VEC3& n,
-	PFP1::VEC3& p,
-	PFP1::MATRIX33& localFrame
+	const PFP1::VEC3& v,
+	const PFP1::VEC3& n,
+	const PFP1::VEC3& p,
+	const PFP1::MATRIX33& localFrame,
+	Eigen::Matrix<double,5,5>& AtA,
+	Eigen::Matrix<double,5,1>& Atb
 	);
 
 
@@ -133,7 +160,104 @@ template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles_Proje
 	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Knormal
 	);
 
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles<PFP1>(
+	PFP1::MAP& map,
+	Vertex v,
+	Algo::Surface::Selection::Collector_WithinSphere<PFP1>& neigh,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgeangle,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgearea,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmax,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmax,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles_Projected<PFP1>(
+	PFP1::MAP& map,
+	Vertex v,
+	Algo::Surface::Selection::Collector_WithinSphere<PFP1>& neigh,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgeangle,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgearea,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmax,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmax,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Knormal
+	);
+
+
+
+template void Algo::Surface::Geometry::computeCurvatureVertices_NormalCycles<PFP1>(
+	PFP1::MAP& map,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP1>& neigh,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgeangle,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgearea,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmax,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmax,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Knormal
+	);
 
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles<PFP1>(
+	PFP1::MAP& map,
+	Vertex v,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP1>& neigh,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgeangle,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgearea,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmax,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmax,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertices_NormalCycles_Projected<PFP1>(
+	PFP1::MAP& map,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP1>& neigh,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgeangle,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgearea,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmax,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmax,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles_Projected<PFP1>(
+	PFP1::MAP& map,
+	Vertex v,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP1>& neigh,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgeangle,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgearea,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmax,
+	VertexAttribute<PFP1::REAL, PFP1::MAP>& kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmax,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Kmin,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::normalCycles_computeTensor<PFP1>(
+	const Algo::Surface::Selection::NeighborhoodCache<PFP1>& neigh,
+	Vertex v,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgeangle,
+	const EdgeAttribute<PFP1::REAL, PFP1::MAP>& edgearea,
+	Geom::Matrix<3, 3, PFP1::REAL>& tensor
+	);
 
 template void Algo::Surface::Geometry::normalCycles_computeTensor<PFP1>(
 	Algo::Surface::Selection::Collector<PFP1>& col,
@@ -207,17 +331,44 @@ template void Algo::Surface::Geometry::vertexQuadraticFitting<PFP2>(
 	PFP2::REAL& a, PFP2::REAL& b, PFP2::REAL& c, PFP2::REAL& d, PFP2::REAL& e
 	);
 
+template void Algo::Surface::Geometry::computeCurvatureVertices_QuadraticFitting<PFP2>(
+	PFP2::MAP& map,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP2>& neigh,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmax,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmax,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmin
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertex_QuadraticFitting<PFP2>(
+	PFP2::MAP& map,
+	Vertex v,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP2>& neigh,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmax,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmax,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmin
+	);
+
 template void Algo::Surface::Geometry::quadraticFittingAddVertexPos<PFP2>(
-	PFP2::VEC3& v,
-	PFP2::VEC3& p,
-	PFP2::MATRIX33& localFrame
+	const PFP2::VEC3& v,
+	const PFP2::VEC3& p,
+	const PFP2::MATRIX33& localFrame,
+	Eigen::Matrix<double,5,5>& AtA,
+	Eigen::Matrix<double,5,1>& Atb
 	);
 
 template void Algo::Surface::Geometry::quadraticFittingAddVertexNormal<PFP2>(
-	PFP2::VEC3& v,
-	PFP2::VEC3& n,
-	PFP2::VEC3& p,
-	PFP2::MATRIX33& localFrame
+	const PFP2::VEC3& v,
+	const PFP2::VEC3& n,
+	const PFP2::VEC3& p,
+	const PFP2::MATRIX33& localFrame,
+	Eigen::Matrix<double,5,5>& AtA,
+	Eigen::Matrix<double,5,1>& Atb
 	);
 
 
@@ -279,8 +430,105 @@ template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles_Proje
 	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Knormal
 	);
 
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles<PFP2>(
+	PFP2::MAP& map,
+	Vertex v,
+	Algo::Surface::Selection::Collector_WithinSphere<PFP2>& neigh,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgeangle,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgearea,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmax,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmax,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles_Projected<PFP2>(
+	PFP2::MAP& map,
+	Vertex v,
+	Algo::Surface::Selection::Collector_WithinSphere<PFP2>& neigh,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgeangle,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgearea,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmax,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmax,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Knormal
+	);
+
 
 
+template void Algo::Surface::Geometry::computeCurvatureVertices_NormalCycles<PFP2>(
+	PFP2::MAP& map,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP2>& neigh,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgeangle,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgearea,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmax,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmax,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles<PFP2>(
+	PFP2::MAP& map,
+	Vertex v,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP2>& neigh,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgeangle,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgearea,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmax,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmax,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertices_NormalCycles_Projected<PFP2>(
+	PFP2::MAP& map,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP2>& neigh,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgeangle,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgearea,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmax,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmax,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles_Projected<PFP2>(
+	PFP2::MAP& map,
+	Vertex v,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP2>& neigh,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgeangle,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgearea,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmax,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmax,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::normalCycles_computeTensor<PFP2>(
+	const Algo::Surface::Selection::NeighborhoodCache<PFP2>& neigh,
+	Vertex v,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgeangle,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgearea,
+	Geom::Matrix<3, 3, PFP2::REAL>& tensor
+	);
+
 template void Algo::Surface::Geometry::normalCycles_computeTensor<PFP2>(
 	Algo::Surface::Selection::Collector<PFP2>& col,
 	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
@@ -353,17 +601,44 @@ template void Algo::Surface::Geometry::vertexQuadraticFitting<PFP3>(
 	PFP3::REAL& a, PFP3::REAL& b, PFP3::REAL& c, PFP3::REAL& d, PFP3::REAL& e
 	);
 
+template void Algo::Surface::Geometry::computeCurvatureVertices_QuadraticFitting<PFP3>(
+	PFP3::MAP& map,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP3>& neigh,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmax,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmax,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmin
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertex_QuadraticFitting<PFP3>(
+	PFP3::MAP& map,
+	Vertex v,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP3>& neigh,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmax,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmax,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmin
+	);
+
 template void Algo::Surface::Geometry::quadraticFittingAddVertexPos<PFP3>(
-	PFP3::VEC3& v,
-	PFP3::VEC3& p,
-	PFP3::MATRIX33& localFrame
+	const PFP3::VEC3& v,
+	const PFP3::VEC3& p,
+	const PFP3::MATRIX33& localFrame,
+	Eigen::Matrix<double,5,5>& AtA,
+	Eigen::Matrix<double,5,1>& Atb
 	);
 
 template void Algo::Surface::Geometry::quadraticFittingAddVertexNormal<PFP3>(
-	PFP3::VEC3& v,
-	PFP3::VEC3& n,
-	PFP3::VEC3& p,
-	PFP3::MATRIX33& localFrame
+	const PFP3::VEC3& v,
+	const PFP3::VEC3& n,
+	const PFP3::VEC3& p,
+	const PFP3::MATRIX33& localFrame,
+	Eigen::Matrix<double,5,5>& AtA,
+	Eigen::Matrix<double,5,1>& Atb
 	);
 
 
@@ -425,8 +700,105 @@ template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles_Proje
 	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Knormal
 	);
 
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles<PFP3>(
+	PFP3::MAP& map,
+	Vertex v,
+	Algo::Surface::Selection::Collector_WithinSphere<PFP3>& neigh,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgeangle,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgearea,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmax,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmax,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles_Projected<PFP3>(
+	PFP3::MAP& map,
+	Vertex v,
+	Algo::Surface::Selection::Collector_WithinSphere<PFP3>& neigh,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgeangle,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgearea,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmax,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmax,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Knormal
+	);
+
 
 
+template void Algo::Surface::Geometry::computeCurvatureVertices_NormalCycles<PFP3>(
+	PFP3::MAP& map,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP3>& neigh,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgeangle,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgearea,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmax,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmax,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles<PFP3>(
+	PFP3::MAP& map,
+	Vertex v,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP3>& neigh,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgeangle,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgearea,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmax,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmax,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertices_NormalCycles_Projected<PFP3>(
+	PFP3::MAP& map,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP3>& neigh,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgeangle,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgearea,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmax,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmax,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles_Projected<PFP3>(
+	PFP3::MAP& map,
+	Vertex v,
+	const Algo::Surface::Selection::NeighborhoodCache<PFP3>& neigh,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgeangle,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgearea,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmax,
+	VertexAttribute<PFP3::REAL, PFP3::MAP>& kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmax,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Kmin,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& Knormal
+	);
+
+template void Algo::Surface::Geometry::normalCycles_computeTensor<PFP3>(
+	const Algo::Surface::Selection::NeighborhoodCache<PFP3>& neigh,
+	Vertex v,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgeangle,
+	const EdgeAttribute<PFP3::REAL, PFP3::MAP>& edgearea,
+	Geom::Matrix<3, 3, PFP3::REAL>& tensor
+	);
+
 template void Algo::Surface::Geometry::normalCycles_computeTensor<PFP3>(
 	Algo::Surface::Selection::Collector<PFP3>& col,
 	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
@@ -0,0 +1,37 @@
+#include <iostream>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/gmap/embeddedGMap2.h"
+
+#include "Algo/Geometry/geodesicPropagation.h"
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+template class Algo::Surface::Geometry::GeodesicPropagation<PFP1>;
+
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+template class Algo::Surface::Geometry::GeodesicPropagation<PFP2>;
+
+
+struct PFP3 : public PFP_STANDARD
+{
+	typedef EmbeddedGMap2 MAP;
+};
+
+template class Algo::Surface::Geometry::GeodesicPropagation<PFP3>;
+
+
+int test_geodesicPropagation()
+{
+	return 0;
+}
@@ -0,0 +1,28 @@
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/Geometry/heatGeodesics.h"
+
+using namespace CGoGN;
+
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+template class Algo::Surface::Geometry::HeatGeodesics<PFP1>;
+
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+template class Algo::Surface::Geometry::HeatGeodesics<PFP2>;
+
+
+int test_heatGeodesics()
+{
+	return 0;
+}
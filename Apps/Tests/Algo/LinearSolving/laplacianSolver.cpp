@@ -0,0 +1,39 @@
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/map/embeddedMap3.h"
+
+
+#include "Algo/LinearSolving/laplacianSolver.h"
+
+using namespace CGoGN;
+
+
+struct PFP1 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+template class Algo::LinearSolving::LaplacianSolver<PFP1>;
+
+
+struct PFP2 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+template class Algo::LinearSolving::LaplacianSolver<PFP2>;
+
+
+struct PFP3 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap3 MAP;
+};
+
+template class Algo::LinearSolving::LaplacianSolver<PFP3>;
+
+
+int test_laplacianSolver()
+{
+
+	return 0;
+}
@@ -33,6 +33,10 @@ template void Algo::Surface::Modelisation::DooSabin<PFP1, VPOS1>(PFP1::MAP& map,
 template void Algo::Surface::Modelisation::computeDual<PFP1>(PFP1::MAP& map, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position);
 template void Algo::Surface::Modelisation::computeBoundaryConstraintDual<PFP1>(PFP1::MAP& map, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position);
 template void Algo::Surface::Modelisation::computeBoundaryConstraintKeepingOldVerticesDual<PFP1>(PFP1::MAP& map, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position);
+template void Algo::Surface::Modelisation::Parallel::CatmullClarkSubdivision<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& attributs, unsigned int nbth);
+template void Algo::Surface::Modelisation::Parallel::LoopSubdivision<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& attributs, unsigned int nbth);
+template void Algo::Surface::Modelisation::Parallel::TwoNPlusOneSubdivision<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& attributs, float size, unsigned int nbth);
+template void Algo::Surface::Modelisation::Parallel::DooSabin<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& position, unsigned int nbth);
 
 
 
@@ -61,6 +65,10 @@ template void Algo::Surface::Modelisation::DooSabin<PFP2, VPOS2>(PFP2::MAP& map,
 template void Algo::Surface::Modelisation::computeDual<PFP2>(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position);
 template void Algo::Surface::Modelisation::computeBoundaryConstraintDual<PFP2>(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position);
 template void Algo::Surface::Modelisation::computeBoundaryConstraintKeepingOldVerticesDual<PFP2>(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position);
+template void Algo::Surface::Modelisation::Parallel::CatmullClarkSubdivision<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& attributs, unsigned int nbth);
+template void Algo::Surface::Modelisation::Parallel::LoopSubdivision<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& attributs, unsigned int nbth);
+template void Algo::Surface::Modelisation::Parallel::TwoNPlusOneSubdivision<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& attributs, float size, unsigned int nbth);
+template void Algo::Surface::Modelisation::Parallel::DooSabin<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& position, unsigned int nbth);
 
 
 
@@ -27,6 +27,9 @@ template void Algo::Volume::Modelisation::Tetrahedralization::swapGen2To3<PFP1>(
 template Dart Algo::Volume::Modelisation::Tetrahedralization::flip1To4<PFP1>(PFP1::MAP& map, Dart d);
 template Dart Algo::Volume::Modelisation::Tetrahedralization::flip1To3<PFP1>(PFP1::MAP& map, Dart d);
 template Dart Algo::Volume::Modelisation::Tetrahedralization::edgeBisection<PFP1>(PFP1::MAP& map, Dart d);
+template PFP1::REAL Algo::Volume::Modelisation::Tetrahedralization::tetQuality<PFP1>(const PFP1::VEC3& a, const PFP1::VEC3& b, const PFP1::VEC3& c, const PFP1::VEC3& d, Algo::Volume::Modelisation::Tetrahedralization::TetQualityMeasure measure);
+template PFP1::REAL Algo::Volume::Modelisation::Tetrahedralization::tetQuality<PFP1>(PFP1::MAP& map, Vol v, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, Algo::Volume::Modelisation::Tetrahedralization::TetQualityMeasure measure);
+template unsigned int Algo::Volume::Modelisation::Tetrahedralization::optimizeQuality<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, Algo::Volume::Modelisation::Tetrahedralization::TetQualityMeasure measure, unsigned int nbPasses, PFP1::REAL minGain, unsigned int nbth);
 
 
 
@@ -2,11 +2,13 @@
 
 extern int test_pmesh();
 extern int test_vsplit();
+extern int test_vdpmesh();
 
 int main()
 {
 	test_pmesh();
 	test_vsplit();
+	test_vdpmesh();
 
 	return 0;
 }
@@ -22,9 +22,8 @@ struct PFP3 : public PFP_DOUBLE
 	typedef EmbeddedGMap2 MAP;
 };
 
-// TODO modif ProgressiveMesh
-//template class Algo::Surface::PMesh::ProgressiveMesh<PFP1>;
-//template class Algo::Surface::PMesh::ProgressiveMesh<PFP2>;
+template class Algo::Surface::PMesh::ProgressiveMesh<PFP1>;
+template class Algo::Surface::PMesh::ProgressiveMesh<PFP2>;
 //template class Algo::Surface::PMesh::ProgressiveMesh<PFP3>;
 
 
@@ -0,0 +1,29 @@
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+
+#include "Algo/ProgressiveMesh/vdpmesh.h"
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+template class Algo::Surface::PMesh::ViewFrustum<float>;
+template class Algo::Surface::PMesh::ViewFrustum<double>;
+template class Algo::Surface::PMesh::ViewDependentPMesh<PFP1>;
+template class Algo::Surface::PMesh::ViewDependentPMesh<PFP2>;
+
+
+int test_vdpmesh()
+{
+
+	return 0;
+}
@@ -2,12 +2,14 @@
 
 extern int test_shapeMatchingLinear();
 extern int test_shapeMatchingQuadratic();
+extern int test_shapeMatchingClustered();
 
 
 int main()
 {
 	test_shapeMatchingLinear();
 	test_shapeMatchingQuadratic();
+	test_shapeMatchingClustered();
 
 
 	return 0;
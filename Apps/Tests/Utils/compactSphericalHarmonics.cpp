@@ -0,0 +1,16 @@
+#include "Utils/compactSphericalHarmonics.h"
+
+
+template class CGoGN::Utils::CompactSphericalHarmonics<float, float>;
+template class CGoGN::Utils::CompactSphericalHarmonics<double, double>;
+template class CGoGN::Utils::CompactSphericalHarmonics<float, CGoGN::Geom::Vec3f>;
+template class CGoGN::Utils::CompactSphericalHarmonics<float, CGoGN::Geom::Vec3f, CGoGN::Utils::Half>;
+template class CGoGN::Utils::CompactSphericalHarmonics<double, CGoGN::Geom::Vec3d, float>;
+template class CGoGN::Utils::CompactSphericalHarmonics<double, CGoGN::Geom::Vec3d, CGoGN::Utils::Half>;
+
+
+int test_compactSphericalHarmonics()
+{
+
+	return 0;
+}
@@ -0,0 +1,15 @@
+#include "Utils/indexedHeap.h"
+
+using namespace CGoGN;
+
+
+template class Utils::IndexedHeap<float>;
+template class Utils::IndexedHeap<double>;
+template class Utils::IndexedHeap<double, std::greater<double> >;
+
+
+int test_indexedHeap()
+{
+
+	return 0;
+}
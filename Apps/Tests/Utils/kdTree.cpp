@@ -0,0 +1,17 @@
+#include "Utils/kdTree.h"
+#include "Geometry/vector_gen.h"
+
+using namespace CGoGN;
+
+
+template class Utils::KdTree<Geom::Vec2f>;
+template class Utils::KdTree<Geom::Vec3f>;
+template class Utils::KdTree<Geom::Vec3d>;
+template class Utils::KdTree<Geom::Vec4d>;
+
+
+int test_kdTree()
+{
+
+	return 0;
+}
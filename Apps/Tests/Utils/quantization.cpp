@@ -3,15 +3,15 @@
 
 using namespace CGoGN;
 
-//template struct Utils::CodeVector<Geom::Vec3f>;
-//template struct Utils::CodeVector<Geom::Vec3d>;
-//template struct Utils::CodeVector<Geom::Vec4d>;
+template struct Utils::CodeVector<Geom::Vec3f>;
+template struct Utils::CodeVector<Geom::Vec3d>;
+template struct Utils::CodeVector<Geom::Vec4d>;
 
 
 
-//template class Utils::Quantization<Geom::Vec3f>;
-//template class Utils::Quantization<Geom::Vec3d>;
-//template class Utils::Quantization<Geom::Vec4d>;
+template class Utils::Quantization<Geom::Vec3f>;
+template class Utils::Quantization<Geom::Vec3d>;
+template class Utils::Quantization<Geom::Vec4d>;
 
 
 int test_quantization()
@@ -0,0 +1,127 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Topology/generic/parameters.h"
+#include "Algo/ImplicitHierarchicalMesh/ihm3.h"
+#include "Algo/ImplicitHierarchicalMesh/subdivision3.h"
+#include "Algo/Tiling/Volume/cubic.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef Algo::Volume::IHM::ImplicitHierarchicalMap3 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+// mark (at their level) the volumes of level l that subdivideVolumes will subdivide
+void markToSubdivide(MAP& map, const std::vector<Dart>& volumes, unsigned int l, DartMarker<MAP>& marker)
+{
+	std::vector<Dart> toSubdivide;
+	Algo::Volume::IHM::balanceVolumes<PFP>(map, volumes, toSubdivide, Algo::Volume::IHM::B_FACE);
+
+	unsigned int cur = map.getCurrentLevel();
+	map.setCurrentLevel(l);
+	for (std::vector<Dart>::iterator it = toSubdivide.begin(); it != toSubdivide.end(); ++it)
+	{
+		if (map.volumeLevel(*it) == l)
+			marker.markOrbit<VOLUME>(*it);
+	}
+	map.setCurrentLevel(cur);
+}
+
+// volumeIsSubdivided must answer the same for all the darts of a volume,
+// even for the darts of faces or edges cut by a subdivided neighbour
+int checkVolumeIsSubdivided(MAP& map, unsigned int l, DartMarker<MAP>& subdivided, const std::string& step)
+{
+	unsigned int cur = map.getCurrentLevel();
+	map.setCurrentLevel(l);
+
+	int nbErrors = 0;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		if (!map.isBoundaryMarked(3, d) && map.volumeLevel(d) == l && map.volumeIsSubdivided(d) != subdivided.isMarked(d))
+			++nbErrors;
+	}
+	map.setCurrentLevel(cur);
+
+	if (nbErrors > 0)
+		std::cerr << step << " : level " << l << " : " << nbErrors << " darts with a wrong volumeIsSubdivided" << std::endl;
+	return nbErrors;
+}
+
+int main()
+{
+	MAP myMap;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Volume::Tilings::Cubic::Grid<PFP> cubic(myMap, 3, 3, 1);
+	cubic.embedIntoGrid(position, 1.0f, 1.0f, 1.0f);
+
+	myMap.initImplicitProperties();
+
+	int nbErrors = 0;
+	DartMarker<MAP> subdivided0(myMap);
+	DartMarker<MAP> subdivided1(myMap);
+
+	// one volume out of four: each one has unsubdivided neighbours
+	std::vector<Dart> volumes;
+	unsigned int i = 0;
+	foreach_cell<VOLUME>(myMap, [&] (Vol v)
+	{
+		if (i++ % 4 == 0)
+			volumes.push_back(v.dart);
+	});
+	markToSubdivide(myMap, volumes, 0, subdivided0);
+	Algo::Volume::IHM::subdivideVolumes<PFP>(myMap, volumes, position);
+	nbErrors += checkVolumeIsSubdivided(myMap, 0, subdivided0, "first batch");
+
+	// subdivide some volumes of level 1: their coarser neighbours are subdivided first
+	myMap.setCurrentLevel(1);
+	volumes.clear();
+	i = 0;
+	foreach_cell<VOLUME>(myMap, [&] (Vol v)
+	{
+		if (myMap.volumeLevel(v.dart) == 1 && i++ % 5 == 0)
+			volumes.push_back(v.dart);
+	});
+	markToSubdivide(myMap, volumes, 0, subdivided0);
+	markToSubdivide(myMap, volumes, 1, subdivided1);
+	myMap.setCurrentLevel(myMap.getMaxLevel());
+	Algo::Volume::IHM::subdivideVolumes<PFP>(myMap, volumes, position);
+	nbErrors += checkVolumeIsSubdivided(myMap, 0, subdivided0, "second batch");
+	nbErrors += checkVolumeIsSubdivided(myMap, 1, subdivided1, "second batch");
+
+	if (myMap.getMaxLevel() != 2)
+	{
+		std::cerr << "second batch : max level " << myMap.getMaxLevel() << " instead of 2" << std::endl;
+		++nbErrors;
+	}
+
+	if (nbErrors == 0)
+		std::cout << "batch subdivision OK" << std::endl;
+
+	return nbErrors;
+}
@@ -0,0 +1,175 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/ihmap/ihm3.h"
+#include "Algo/Tiling/Volume/cubic.h"
+#include "Algo/Multiresolution/IHM3/ihm3_PrimalAdapt.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef ImplicitHierarchicalMap3 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+// subdivision without geometry: only the topology is checked
+class NoEmbedding : public FunctorType
+{
+public:
+	bool operator()(Dart) { return false; }
+};
+
+struct Phis
+{
+	std::vector<Dart> phi1, phi_1, phi2, phi3;
+};
+
+// phi of the darts of the current level, as read by the map in its current state
+Phis readPhis(MAP& map)
+{
+	Phis p;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		p.phi1.push_back(map.phi1(d));
+		p.phi_1.push_back(map.phi_1(d));
+		p.phi2.push_back(map.phi2(d));
+		p.phi3.push_back(map.phi3(d));
+	}
+	return p;
+}
+
+// compare the phi read in the current state (level tables or not) with the
+// phi computed by walking through the darts (level tables disabled)
+int checkAgainstUncached(MAP& map, const std::string& step)
+{
+	bool enabled = map.isLevelCacheEnabled();
+	Phis cached = readPhis(map);
+
+	map.enableLevelCache(false);
+	map.setCurrentLevel(map.getCurrentLevel());
+	Phis ref = readPhis(map);
+
+	if (enabled)
+		map.enableLevelCache();
+
+	if (cached.phi1 != ref.phi1 || cached.phi_1 != ref.phi_1 || cached.phi2 != ref.phi2 || cached.phi3 != ref.phi3)
+	{
+		std::cerr << step << " : level " << map.getCurrentLevel() << " phi differ from uncached ones" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	MAP myMap;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Volume::Tilings::Cubic::Grid<PFP> cubic(myMap, 2, 2, 2);
+	cubic.embedIntoGrid(position, 1.0f, 1.0f, 1.0f);
+
+	myMap.initImplicitProperties();
+
+	NoEmbedding noEmb;
+	Algo::Volume::MR::Primal::Adaptive::IHM3<PFP> ihm(myMap);
+	ihm.setVertexVertexFunctor(&noEmb);
+	ihm.setEdgeVertexFunctor(&noEmb);
+	ihm.setFaceVertexFunctor(&noEmb);
+	ihm.setVolumeVertexFunctor(&noEmb);
+
+	// subdivide an edge twice and another one once: the phi of the coarse
+	// levels walk through the darts of the finer ones
+	myMap.setCurrentLevel(0);
+	Dart e0 = myMap.begin();
+	Dart e1 = myMap.phi1(myMap.phi1(e0));
+	ihm.subdivideEdge(e0);
+	ihm.subdivideEdge(e1);
+	myMap.setCurrentLevel(1);
+	ihm.subdivideEdge(e0);
+	myMap.setCurrentLevel(myMap.getMaxLevel());
+
+	int nbErrors = 0;
+
+	// tables of each level
+	myMap.enableLevelCache();
+	for (unsigned int l = 0; l <= myMap.getMaxLevel(); ++l)
+	{
+		myMap.setCurrentLevel(l);
+		nbErrors += checkAgainstUncached(myMap, "snapshot");
+	}
+
+	// unsew / sew faces and volumes while the level tables are built
+	myMap.setCurrentLevel(myMap.getMaxLevel());
+	Dart d = NIL;
+	for (Dart e = myMap.begin(); e != myMap.end() && d == NIL; myMap.next(e))
+		if (!myMap.isBoundaryMarked(3, e) && !myMap.isBoundaryMarked(3, myMap.phi3(e)))
+			d = e;
+	Dart dd = myMap.phi3(d);
+
+	Dart f = myMap.phi2(d);
+	myMap.unsewFaces(d, false);
+	nbErrors += checkAgainstUncached(myMap, "unsewFaces");
+	myMap.sewFaces(d, f, false);
+	nbErrors += checkAgainstUncached(myMap, "sewFaces");
+
+	myMap.unsewVolumes(d, false);
+	nbErrors += checkAgainstUncached(myMap, "unsewVolumes");
+	myMap.sewVolumes(d, dd, false);
+	nbErrors += checkAgainstUncached(myMap, "sewVolumes");
+
+	// the out of date tables must not be used again when the level changes
+	myMap.unsewVolumes(d, false);
+	for (unsigned int l = 0; l <= myMap.getMaxLevel(); ++l)
+	{
+		myMap.setCurrentLevel(l);
+		nbErrors += checkAgainstUncached(myMap, "level change after unsewVolumes");
+	}
+	myMap.setCurrentLevel(myMap.getMaxLevel());
+	myMap.sewVolumes(d, dd, false);
+
+	// edge & face ids are used by the phi of the coarse levels
+	myMap.enableLevelCache();
+	myMap.setEdgeId(d, myMap.getEdgeId(d));
+	if (myMap.isLevelCacheEnabled())
+	{
+		std::cerr << "setEdgeId does not drop the level tables" << std::endl;
+		++nbErrors;
+	}
+	myMap.enableLevelCache();
+	myMap.setFaceId(d, myMap.getFaceId(d), DART);
+	if (myMap.isLevelCacheEnabled())
+	{
+		std::cerr << "setFaceId does not drop the level tables" << std::endl;
+		++nbErrors;
+	}
+
+	if (nbErrors == 0)
+		std::cout << "level tables OK" << std::endl;
+
+	return nbErrors;
+}
@@ -0,0 +1,117 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap3.h"
+
+#include "Algo/Import/import.h"
+#include "Algo/Topo/basic.h"
+
+#include <fstream>
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap3 MAP;
+};
+
+typedef PFP::MAP MAP;
+
+// two unit cubes side by side: a hexahedron and a cube cut in 6 tetrahedra.
+// The common square is a quad for the hexahedron and two triangles for the
+// tetrahedra: a connector glues them.
+// (hexahedra of .tet files are given with the vertices of a face in zigzag order)
+static void writeSample(const std::string& filename)
+{
+	std::ofstream out(filename.c_str());
+	out << "12 vertices" << std::endl;
+	out << "8 volumes" << std::endl;
+	out << "0 0 0\n1 0 0\n1 1 0\n0 1 0\n0 0 1\n1 0 1\n1 1 1\n0 1 1\n";
+	out << "2 0 0\n2 1 0\n2 1 1\n2 0 1\n";
+	out << "8 0 1 3 2 4 5 7 6\n";
+	out << "4 1 8 9 10\n4 1 8 11 10\n4 1 2 9 10\n4 1 2 6 10\n4 1 5 11 10\n4 1 5 6 10\n";
+	out << "# C 1 2 6 5\n";
+}
+
+int check(const std::string& what, unsigned int nb, unsigned int expected)
+{
+	if (nb == expected)
+		return 0;
+	std::cerr << what << " : " << nb << " instead of " << expected << std::endl;
+	return 1;
+}
+
+int main()
+{
+	std::string filename("importConnectors.tet");
+	writeSample(filename);
+
+	MAP myMap;
+	std::vector<std::string> attrNames;
+	if (!Algo::Volume::Import::importMesh<PFP>(myMap, filename, attrNames))
+	{
+		std::cerr << "could not import " << filename << std::endl;
+		return 1;
+	}
+
+	int nbErrors = 0;
+
+	// 1 hexahedron + 6 tetrahedra + 1 connector, the connector adds no edge
+	// (its diagonal is the one of the tetrahedra) and shares all its faces
+	nbErrors += check("volumes", Algo::Topo::getNbOrbits<VOLUME>(myMap), 8);
+	nbErrors += check("faces", Algo::Topo::getNbOrbits<FACE>(myMap), 24);
+	nbErrors += check("edges", Algo::Topo::getNbOrbits<EDGE>(myMap), 27);
+	nbErrors += check("vertices", Algo::Topo::getNbOrbits<VERTEX>(myMap), 12);
+
+	// closed map: every dart is sewn and the boundary is the one of the
+	// 2x1x1 box (5 quads of the hexahedron, 10 triangles of the tetrahedra)
+	unsigned int nbFree = 0;
+	unsigned int nbBoundaryFaces = 0;
+	DartMarker<MAP> mf(myMap);
+	for (Dart d = myMap.begin(); d != myMap.end(); myMap.next(d))
+	{
+		if (myMap.phi3(d) == d)
+			++nbFree;
+		if (myMap.isBoundaryMarked(3, d) && !mf.isMarked(d))
+		{
+			mf.markOrbit<FACE2>(d);
+			++nbBoundaryFaces;
+		}
+	}
+	nbErrors += check("darts without phi3", nbFree, 0);
+	nbErrors += check("boundary faces", nbBoundaryFaces, 15);
+
+	if (!myMap.check())
+	{
+		std::cerr << "inconsistent map" << std::endl;
+		++nbErrors;
+	}
+
+	if (nbErrors == 0)
+		std::cout << "connector import OK" << std::endl;
+
+	return nbErrors;
+}
@@ -0,0 +1,286 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Geometry/incrementalAttributes.h"
+
+#include <cstdlib>
+#include <sstream>
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+
+typedef Algo::Surface::Geometry::IncrementalAttributes<PFP> Incremental;
+
+REAL random(REAL amplitude)
+{
+	return amplitude * (REAL(rand()) / REAL(RAND_MAX) - REAL(0.5)) ;
+}
+
+VEC3 randomMove()
+{
+	return VEC3(random(0.05), random(0.05), random(0.05)) ;
+}
+
+Dart randomDart(MAP& map)
+{
+	std::vector<Dart> darts ;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+		darts.push_back(d) ;
+	return darts[rand() % darts.size()] ;
+}
+
+bool isTriangle(MAP& map, Dart d)
+{
+	return map.phi1(map.phi1(map.phi1(d))) == d ;
+}
+
+bool equal(REAL a, REAL b)
+{
+	return a == b || std::abs(a - b) <= REAL(1e-9) * (REAL(1) + std::abs(a)) ;
+}
+
+bool equal(const VEC3& a, const VEC3& b)
+{
+	return equal(a[0], b[0]) && equal(a[1], b[1]) && equal(a[2], b[2]) ;
+}
+
+// collapse the degenerated faces (1 or 2 edges) around the vertex of d
+void collapseDegeneratedFaces(MAP& map, Dart d)
+{
+	bool found = true ;
+	while (found)
+	{
+		found = false ;
+		Dart it = d ;
+		do
+		{
+			if (map.phi1(map.phi1(it)) == it)
+			{
+				d = map.phi1(map.phi2(it)) ;
+				map.collapseDegeneratedFace(it) ;
+				found = true ;
+				break ;
+			}
+			it = map.phi2(map.phi_1(it)) ;
+		} while (it != d) ;
+	}
+}
+
+// apply a random topological operator (and position writes) on the map
+void randomOperator(MAP& map, VertexAttribute<VEC3, MAP>& position, Incremental& ia)
+{
+	Dart d = randomDart(map) ;
+	Dart e = map.phi2(d) ;
+	if (map.sameFace(d, e))
+		return ;
+
+	switch (rand() % 9)
+	{
+		case 0 : // cut an edge and triangulate its faces
+		{
+			VEC3 p = (position[d] + position[e]) * REAL(0.5) + randomMove() ;
+			Dart nd = map.cutEdge(d) ;
+			ia.setPosition(nd, p) ;
+			Dart ne = map.phi2(nd) ;
+			map.splitFace(nd, map.phi_1(d)) ;
+			map.splitFace(map.phi1(ne), map.phi_1(ne)) ;
+			break ;
+		}
+		case 1 :
+			if (isTriangle(map, d) && isTriangle(map, e))
+				map.flipEdge(d) ;
+			break ;
+		case 2 : // flip an edge by moving its ends from vertex to vertex
+			if (isTriangle(map, d) && isTriangle(map, e))
+			{
+				Dart dNext = map.phi1(d) ;
+				Dart ePrev = map.phi_1(e) ;
+				map.removeEdgeFromVertex(d) ;
+				map.removeEdgeFromVertex(e) ;
+				map.insertEdgeInVertex(map.phi1(dNext), e) ;
+				map.insertEdgeInVertex(ePrev, d) ;
+			}
+			break ;
+		case 3 :
+			if (map.edgeCanCollapse(d))
+			{
+				VEC3 p = (position[d] + position[e]) * REAL(0.5) ;
+				Dart v = map.collapseEdge(d) ;
+				ia.setPosition(v, p) ;
+			}
+			break ;
+		case 4 : // collapse an edge, then its degenerated faces
+			if (map.edgeCanCollapse(d))
+			{
+				VEC3 p = (position[d] + position[e]) * REAL(0.5) ;
+				Dart v = map.collapseEdge(d, false) ;
+				collapseDegeneratedFaces(map, v) ;
+				ia.setPosition(v, p) ;
+			}
+			break ;
+		case 5 : // merge two faces and split them along the other diagonal
+			if (isTriangle(map, d) && isTriangle(map, e))
+			{
+				Dart dNext = map.phi1(d) ;
+				map.mergeFaces(d) ;
+				map.splitFace(dNext, map.phi1(map.phi1(dNext))) ;
+			}
+			break ;
+		case 6 : // split a vertex
+		{
+			Dart f = map.phi2(map.phi_1(map.phi2(map.phi_1(d)))) ;
+			if (f != d && map.phi2(map.phi_1(f)) != d)
+			{
+				VEC3 p = position[d] + randomMove() ;
+				map.splitVertex(d, f) ;
+				ia.setPosition(f, p) ;
+			}
+			break ;
+		}
+		case 7 : // open an edge, fill the hole with a 2-sided face, swap its edges and close it back
+		{
+			map.unsewFaces(d, false) ;
+			map.closeHole(d, false) ;
+			Dart g = map.phi2(d) ;
+			map.swapEdges(d, e) ;
+			map.swapEdges(d, g) ;
+			map.collapseDegeneratedFace(g) ;
+			break ;
+		}
+		case 8 :
+			ia.setPosition(d, position[d] + randomMove()) ;
+			break ;
+	}
+}
+
+// compare the incremental attributes with a full recompute
+int checkAgainstFullRecompute(MAP& map, VertexAttribute<VEC3, MAP>& position, Incremental& ia,
+	const VertexAttribute<VEC3, MAP>& normal, const FaceAttribute<REAL, MAP>& area,
+	const FaceAttribute<VEC3, MAP>& centroid, const EdgeAttribute<REAL, MAP>& cotan, const std::string& step)
+{
+	ia.update() ;
+
+	VertexAttribute<VEC3, MAP> normalRef = map.addAttribute<VEC3, VERTEX, MAP>("normalRef") ;
+	FaceAttribute<REAL, MAP> areaRef = map.addAttribute<REAL, FACE, MAP>("areaRef") ;
+	FaceAttribute<VEC3, MAP> centroidRef = map.addAttribute<VEC3, FACE, MAP>("centroidRef") ;
+	EdgeAttribute<REAL, MAP> cotanRef = map.addAttribute<REAL, EDGE, MAP>("cotanRef") ;
+	Algo::Surface::Geometry::computeNormalVertices<PFP>(map, position, normalRef) ;
+	Algo::Surface::Geometry::computeAreaFaces<PFP>(map, position, areaRef) ;
+	Algo::Surface::Geometry::computeCentroidFaces<PFP>(map, position, centroidRef) ;
+	Algo::Surface::Geometry::computeCotanWeightEdges<PFP>(map, position, cotanRef) ;
+
+	int nbErrors = 0 ;
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		if (!equal(normal[v], normalRef[v]))
+			++nbErrors ;
+	});
+	foreach_cell<FACE>(map, [&] (Face f)
+	{
+		if (!equal(area[f], areaRef[f]) || !equal(centroid[f], centroidRef[f]))
+			++nbErrors ;
+	});
+	foreach_cell<EDGE>(map, [&] (Edge e)
+	{
+		if (!equal(cotan[e], cotanRef[e]))
+			++nbErrors ;
+	});
+
+	map.removeAttribute(normalRef) ;
+	map.removeAttribute(areaRef) ;
+	map.removeAttribute(centroidRef) ;
+	map.removeAttribute(cotanRef) ;
+
+	if (!map.check())
+	{
+		std::cerr << step << " : map is not valid" << std::endl;
+		++nbErrors ;
+	}
+	if (nbErrors > 0)
+		std::cerr << step << " : " << nbErrors << " cells differ from a full recompute" << std::endl;
+	return nbErrors ;
+}
+
+int main()
+{
+	srand(0) ;
+
+	MAP myMap ;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position") ;
+
+	// two tori, glued later by mergeVolumes
+	Algo::Surface::Tilings::Triangular::Tore<PFP> tore1(myMap, 20, 20) ;
+	tore1.embedIntoTore(position, 1.0f, 0.4f) ;
+	Algo::Surface::Tilings::Triangular::Tore<PFP> tore2(myMap, 12, 12) ;
+	tore2.embedIntoTore(position, 0.6f, 0.2f) ;
+	std::vector<Dart>& vd2 = tore2.getVertexDarts() ;
+	for (std::vector<Dart>::iterator it = vd2.begin(); it != vd2.end(); ++it)
+		position[*it] += VEC3(2.5, 0, 0) ;
+
+	VertexAttribute<VEC3, MAP> normal = myMap.addAttribute<VEC3, VERTEX, MAP>("normal") ;
+	FaceAttribute<REAL, MAP> area = myMap.addAttribute<REAL, FACE, MAP>("area") ;
+	FaceAttribute<VEC3, MAP> centroid = myMap.addAttribute<VEC3, FACE, MAP>("centroid") ;
+	EdgeAttribute<REAL, MAP> cotan = myMap.addAttribute<REAL, EDGE, MAP>("cotan") ;
+
+	Incremental ia(myMap, position) ;
+	ia.setVertexNormal(normal) ;
+	ia.setFaceArea(area) ;
+	ia.setFaceCentroid(centroid) ;
+	ia.setEdgeCotanWeight(cotan) ;
+
+	int nbErrors = 0 ;
+
+	Dart f1 = tore1.getVertexDarts()[0] ;
+	Dart f2 = vd2[0] ;
+	myMap.mergeVolumes(f1, f2) ;
+	nbErrors += checkAgainstFullRecompute(myMap, position, ia, normal, area, centroid, cotan, "mergeVolumes") ;
+
+	for (unsigned int batch = 0; batch < 50; ++batch)
+	{
+		unsigned int nb = 1 + rand() % 10 ;
+		for (unsigned int i = 0; i < nb; ++i)
+			randomOperator(myMap, position, ia) ;
+
+		std::stringstream ss ;
+		ss << "batch " << batch ;
+		nbErrors += checkAgainstFullRecompute(myMap, position, ia, normal, area, centroid, cotan, ss.str()) ;
+	}
+
+	if (nbErrors == 0)
+		std::cout << "incremental attributes OK" << std::endl;
+
+	return nbErrors ;
+}
@@ -0,0 +1,174 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/ProgressiveMesh/pmesh.h"
+
+#include <algorithm>
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef Algo::Surface::PMesh::ProgressiveMesh<PFP> PMesh;
+
+bool lessVec(const VEC3& a, const VEC3& b)
+{
+	return std::lexicographical_compare(&a[0], &a[0] + 3, &b[0], &b[0] + 3) ;
+}
+
+bool lessFace(const std::vector<VEC3>& a, const std::vector<VEC3>& b)
+{
+	return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), lessVec) ;
+}
+
+// active faces of the mesh, given by the positions of their vertices (starting
+// from the smallest one to keep the orientation), in a sorted list
+std::vector< std::vector<VEC3> > activeFaces(MAP& map, const VertexAttribute<VEC3, MAP>& position, const DartMarker<MAP>& inactive)
+{
+	std::vector< std::vector<VEC3> > faces ;
+	foreach_cell<FACE>(map, [&] (Face f)
+	{
+		if (inactive.isMarked(f.dart))
+			return ;
+		std::vector<VEC3> face ;
+		Dart d = f.dart ;
+		do
+		{
+			face.push_back(position[d]) ;
+			d = map.phi1(d) ;
+		} while (d != f.dart) ;
+		std::rotate(face.begin(), std::min_element(face.begin(), face.end(), lessVec), face.end()) ;
+		faces.push_back(face) ;
+	});
+	std::sort(faces.begin(), faces.end(), lessFace) ;
+	return faces ;
+}
+
+unsigned int nbActiveVertices(MAP& map, const DartMarker<MAP>& inactive)
+{
+	std::vector<unsigned char> used(map.getAttributeContainer<VERTEX>().end(), 0) ;
+	unsigned int nb = 0 ;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		unsigned int v = map.getEmbedding<VERTEX>(d) ;
+		if (!inactive.isMarked(d) && !used[v])
+		{
+			used[v] = 1 ;
+			++nb ;
+		}
+	}
+	return nb ;
+}
+
+int main()
+{
+	// sender : PM of a 10k vertices torus, with quantized details
+	MAP map ;
+	VertexAttribute<VEC3, MAP> position = map.addAttribute<VEC3, VERTEX, MAP>("position") ;
+	Algo::Surface::Tilings::Triangular::Tore<PFP> tore(map, 100, 100) ;
+	tore.embedIntoTore(position, 5.0f, 2.0f) ;
+
+	std::vector<VEC3> original(map.getAttributeContainer<VERTEX>().end()) ;
+	for (unsigned int v = map.getAttributeContainer<VERTEX>().begin(); v != map.getAttributeContainer<VERTEX>().end(); map.getAttributeContainer<VERTEX>().next(v))
+		original[v] = position[v] ;
+
+	DartMarker<MAP> inactive(map) ;
+	PMesh pm(map, inactive, Algo::Surface::Decimation::S_QEM, Algo::Surface::Decimation::A_QEM, position) ;
+	pm.createPM(5) ;
+	pm.quantizeDetailVectors(1024u) ;
+
+	int nbErrors = 0 ;
+
+	// the finest level is rebuilt from the quantized details
+	pm.gotoLevel(0) ;
+	float maxError = 0.0f ;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+		maxError = std::max(maxError, (position[d] - original[map.getEmbedding<VERTEX>(d)]).norm()) ;
+	std::cout << "max position error : " << maxError << std::endl ;
+	if (maxError > 0.1f)	// the edges of the torus are about 0.3 long
+	{
+		std::cerr << "quantized positions too far from the original ones" << std::endl ;
+		++nbErrors ;
+	}
+
+	if (!pm.saveSplits("pmeshStream.pm"))
+		return 1 ;
+
+	const unsigned int nbSplits = pm.nbSplits() ;
+	const unsigned int levels[6] = { nbSplits, nbSplits / 2, 0, nbSplits / 2, nbSplits, 0 } ;
+	std::vector< std::vector<VEC3> > sent[6] ;
+	for (unsigned int i = 0; i < 6; ++i)
+	{
+		pm.gotoLevel(levels[i]) ;
+		sent[i] = activeFaces(map, position, inactive) ;
+	}
+
+	// receiver : base mesh then splits, rebuilt from the stream only
+	MAP rmap ;
+	VertexAttribute<VEC3, MAP> rposition = rmap.addAttribute<VEC3, VERTEX, MAP>("position") ;
+	DartMarker<MAP> rinactive(rmap) ;
+	PMesh rpm(rmap, rinactive, rposition) ;
+	if (!rpm.loadSplits("pmeshStream.pm"))
+		return 1 ;
+
+	if (rpm.nbSplits() != nbSplits || rpm.currentLevel() != nbSplits)
+	{
+		std::cerr << "wrong number of splits" << std::endl ;
+		return 1 ;
+	}
+	std::cout << "base mesh : " << nbActiveVertices(rmap, rinactive) << " vertices, " << nbSplits << " splits" << std::endl ;
+
+	for (unsigned int i = 0; i < 6; ++i)
+	{
+		rpm.gotoLevel(levels[i]) ;
+		if (activeFaces(rmap, rposition, rinactive) != sent[i])
+		{
+			std::cerr << "level " << levels[i] << " : received mesh differs from the sent one" << std::endl ;
+			++nbErrors ;
+		}
+	}
+
+	if (nbActiveVertices(rmap, rinactive) != 10000)
+	{
+		std::cerr << "finest level : " << nbActiveVertices(rmap, rinactive) << " vertices" << std::endl ;
+		++nbErrors ;
+	}
+	if (!rmap.check())
+		++nbErrors ;
+
+	if (nbErrors == 0)
+		std::cout << "progressive mesh stream OK" << std::endl ;
+
+	return nbErrors ;
+}
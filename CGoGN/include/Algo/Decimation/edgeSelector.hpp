@@ -312,29 +312,34 @@ bool EdgeSelector_QEM<PFP>::init()
 		return false ;
 	}
 
-	for (Vertex v : allVerticesOf(m))
-	{
-		Utils::Quadric<REAL> q ;	// create one quadric
-		quadric[v] = q ;				// per vertex
-	}
-
-	for (Face f : allFacesOf(m))
-	{
-		Dart d = f.dart;
-		Dart d1 = m.phi1(d) ;	// for each triangle,
-		Dart d_1 = m.phi_1(d) ;	// initialize the quadric of the triangle
-		Utils::Quadric<REAL> q(m_position[d], m_position[d1], m_position[d_1]) ;
-		quadric[d] += q ;		// and add the contribution of
-		quadric[d1] += q ;		// this quadric to the ones
-		quadric[d_1] += q ;		// of the 3 incident vertices
-	}
+	// each vertex quadric is the sum of the quadrics of its incident triangles
+	computeVertexQuadrics<PFP>(m, m_position, quadric) ;
 
 	edges.clear() ;
 
-	for (Edge e : allEdgesOf(m))
+	if(m_positionApproximator.getType() == A_QEM)
 	{
-		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
+		// the collapses are evaluated by blocks (in parallel) and come sorted by error :
+		// each one is inserted at the end of the multimap in constant time
+		for(unsigned int i = edgeInfo.begin(); i != edgeInfo.end(); edgeInfo.next(i))
+			edgeInfo[i].valid = false ;
+
+		std::vector<std::pair<REAL, Dart> > collapses ;
+		evaluateEdgeCollapses<PFP>(m, quadric, m_positionApproximator, collapses) ;
+		for(typename std::vector<std::pair<REAL, Dart> >::const_iterator it = collapses.begin(); it != collapses.end(); ++it)
+		{
+			EdgeInfo& einfo = edgeInfo[it->second] ;
+			einfo.it = edges.insert(edges.end(), *it) ;
+			einfo.valid = true ;
+		}
+	}
+	else
+	{
+		for (Edge e : allEdgesOf(m))
+		{
+			initEdgeInfo(e.dart) ;	// init the edges with their optimal position
+		}							// and insert them in the multimap according to their error
+	}
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -510,29 +515,34 @@ bool EdgeSelector_QEMml<PFP>::init()
 		return false ;
 	}
 
-	for (Vertex v : allVerticesOf(m))
-	{
-		Utils::Quadric<REAL> q ;	// create one quadric
-		quadric[v] = q ;				// per vertex
-	}
-
-	for (Face f : allFacesOf(m))
-	{
-		Dart d = f.dart;
-		Dart d1 = m.phi1(d) ;	// for each triangle,
-		Dart d_1 = m.phi_1(d) ;	// initialize the quadric of the triangle
-		Utils::Quadric<REAL> q(m_position[d], m_position[d1], m_position[d_1]) ;
-		quadric[d] += q ;		// and add the contribution of
-		quadric[d1] += q ;		// this quadric to the ones
-		quadric[d_1] += q ;		// of the 3 incident vertices
-	}
+	// each vertex quadric is the sum of the quadrics of its incident triangles
+	computeVertexQuadrics<PFP>(m, m_position, quadric) ;
 
 	edges.clear() ;
 
-	for (Edge e : allEdgesOf(m))
+	if(m_positionApproximator.getType() == A_QEM)
 	{
-		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
+		// the collapses are evaluated by blocks (in parallel) and come sorted by error :
+		// each one is inserted at the end of the multimap in constant time
+		for(unsigned int i = edgeInfo.begin(); i != edgeInfo.end(); edgeInfo.next(i))
+			edgeInfo[i].valid = false ;
+
+		std::vector<std::pair<REAL, Dart> > collapses ;
+		evaluateEdgeCollapses<PFP>(m, quadric, m_positionApproximator, collapses) ;
+		for(typename std::vector<std::pair<REAL, Dart> >::const_iterator it = collapses.begin(); it != collapses.end(); ++it)
+		{
+			EdgeInfo& einfo = edgeInfo[it->second] ;
+			einfo.it = edges.insert(edges.end(), *it) ;
+			einfo.valid = true ;
+		}
+	}
+	else
+	{
+		for (Edge e : allEdgesOf(m))
+		{
+			initEdgeInfo(e.dart) ;	// init the edges with their optimal position
+		}							// and insert them in the multimap according to their error
+	}
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -1559,22 +1569,8 @@ bool EdgeSelector_ColorNaive<PFP>::init()
 		return false;
 	}
 
-	for (Vertex v : allVerticesOf(m))
-	{
-		Utils::Quadric<REAL> q ;	// create one quadric
-		m_quadric[v] = q ;				// per vertex
-	}
-
-	for (Face f : allFacesOf(m))
-	{
-		Dart d = f.dart;
-		Dart d1 = m.phi1(d) ;	// for each triangle,
-		Dart d_1 = m.phi_1(d) ;	// initialize the quadric of the triangle
-		Utils::Quadric<REAL> q(m_position[d], m_position[d1], m_position[d_1]) ;
-		m_quadric[d] += q ;		// and add the contribution of
-		m_quadric[d1] += q ;		// this quadric to the ones
-		m_quadric[d_1] += q ;		// of the 3 incident vertices
-	}
+	// each vertex quadric is the sum of the quadrics of its incident triangles
+	computeVertexQuadrics<PFP>(m, m_position, m_quadric) ;
 
 	edges.clear() ;
 
@@ -1784,22 +1780,8 @@ bool EdgeSelector_GeomColOptGradient<PFP>::init()
 		return false;
 	}
 
-	for (Vertex v : allVerticesOf(m))
-	{
-		Utils::Quadric<REAL> q ;	// create one quadric
-		m_quadric[v] = q ;				// per vertex
-	}
-
-	for (Face f : allFacesOf(m))
-	{
-		Dart d = f.dart;
-		Dart d1 = m.phi1(d) ;	// for each triangle,
-		Dart d_1 = m.phi_1(d) ;	// initialize the quadric of the triangle
-		Utils::Quadric<REAL> q(m_position[d], m_position[d1], m_position[d_1]) ;
-		m_quadric[d] += q ;		// and add the contribution of
-		m_quadric[d1] += q ;		// this quadric to the ones
-		m_quadric[d_1] += q ;		// of the 3 incident vertices
-	}
+	// each vertex quadric is the sum of the quadrics of its incident triangles
+	computeVertexQuadrics<PFP>(m, m_position, m_quadric) ;
 
 	edges.clear() ;
 
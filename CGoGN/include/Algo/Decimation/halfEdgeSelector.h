@@ -27,6 +27,7 @@
 
 #include "Algo/Decimation/selector.h"
 #include "Algo/Decimation/approximator.h"
+#include "Algo/Decimation/qemInit.h"
 #include "Utils/qem.h"
 #include "Topology/generic/dart.h"
 
@@ -50,22 +50,8 @@ bool HalfEdgeSelector_QEMml<PFP>::init()
 		return false ;
 	}
 
-	for (Vertex v : allVerticesOf(m))
-	{
-		Utils::Quadric<REAL> q ;	// create one quadric
-		m_quadric[v] = q ;				// per vertex
-	}
-
-	for (Face f : allFacesOf(m))
-	{
-		Dart d = f.dart;
-		Dart d1 = m.phi1(d) ;	// for each triangle,
-		Dart d_1 = m.phi_1(d) ;	// initialize the quadric of the triangle
-		Utils::Quadric<REAL> q(m_position[d], m_position[d1], m_position[d_1]) ;
-		m_quadric[d] += q ;		// and add the contribution of
-		m_quadric[d1] += q ;		// this quadric to the ones
-		m_quadric[d_1] += q ;		// of the 3 incident vertices
-	}
+	// each vertex quadric is the sum of the quadrics of its incident triangles
+	computeVertexQuadrics<PFP>(m, m_position, m_quadric) ;
 
 	// Init multimap for each Half-edge
 	halfEdges.clear() ;
@@ -838,22 +824,8 @@ bool HalfEdgeSelector_ColorGradient<PFP>::init()
 		return false;
 	}
 
-	for (Vertex v : allVerticesOf(m))
-	{
-		Utils::Quadric<REAL> q ;	// create one quadric
-		m_quadric[v] = q ;				// per vertex
-	}
-
-	for (Face f : allFacesOf(m))
-	{
-		Dart d = f.dart;
-		Dart d1 = m.phi1(d) ;	// for each triangle,
-		Dart d_1 = m.phi_1(d) ;	// initialize the quadric of the triangle
-		Utils::Quadric<REAL> q(m_position[d], m_position[d1], m_position[d_1]) ;
-		m_quadric[d] += q ;		// and add the contribution of
-		m_quadric[d1] += q ;		// this quadric to the ones
-		m_quadric[d_1] += q ;		// of the 3 incident vertices
-	}
+	// each vertex quadric is the sum of the quadrics of its incident triangles
+	computeVertexQuadrics<PFP>(m, m_position, m_quadric) ;
 
 	// Init multimap for each Half-edge
 	halfEdges.clear() ;
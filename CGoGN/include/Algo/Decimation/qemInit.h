@@ -0,0 +1,115 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2013, IGG Team, ICube, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __QEMINIT_H__
+#define __QEMINIT_H__
+
+#include "Algo/Decimation/approximator.h"
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/traversor/traversor2.h"
+#include "Topology/generic/parallelLoop.h"
+#include "Utils/qem.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Decimation
+{
+
+/**
+ * compute the error quadric of each vertex as the sum of the quadrics
+ * of the planes of its incident faces
+ * @param map the map on which we work
+ * @param position the position of vertices attribute handler
+ * @param quadric the quadric handler in which the result will be stored
+ */
+template <typename PFP>
+void computeVertexQuadrics(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<Utils::Quadric<typename PFP::REAL>, typename PFP::MAP>& quadric) ;
+
+/**
+ * evaluate the collapse of all the collapsible edges of the map with a QEM approximator
+ * (the approximator stores its result for each edge)
+ * @param map the map on which we work
+ * @param quadric the vertex quadrics (see computeVertexQuadrics)
+ * @param approx the position approximator (must be of type A_QEM)
+ * @param collapses the (error, edge) pairs of the collapsible edges, sorted by increasing error
+ */
+template <typename PFP>
+void evaluateEdgeCollapses(
+	typename PFP::MAP& map,
+	const VertexAttribute<Utils::Quadric<typename PFP::REAL>, typename PFP::MAP>& quadric,
+	Approximator<PFP, typename PFP::VEC3, EDGE>& approx,
+	std::vector<std::pair<typename PFP::REAL, Dart> >& collapses) ;
+
+
+namespace Parallel
+{
+
+/**
+ * each vertex gathers the quadrics of its own incident faces,
+ * so that vertices are processed concurrently without any shared write
+ */
+template <typename PFP>
+void computeVertexQuadrics(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<Utils::Quadric<typename PFP::REAL>, typename PFP::MAP>& quadric,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+/**
+ * edges are evaluated by blocks in the threads; the result does not depend
+ * on the number of threads (ties are sorted by dart index)
+ */
+template <typename PFP>
+void evaluateEdgeCollapses(
+	typename PFP::MAP& map,
+	const VertexAttribute<Utils::Quadric<typename PFP::REAL>, typename PFP::MAP>& quadric,
+	Approximator<PFP, typename PFP::VEC3, EDGE>& approx,
+	std::vector<std::pair<typename PFP::REAL, Dart> >& collapses,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+} // namespace Parallel
+
+} // namespace Decimation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Decimation/qemInit.hpp"
+
+#endif
@@ -0,0 +1,182 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2013, IGG Team, ICube, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Decimation
+{
+
+template <typename REAL>
+inline bool collapseLess(const std::pair<REAL, Dart>& a, const std::pair<REAL, Dart>& b)
+{
+	if (a.first != b.first)
+		return a.first < b.first ;
+	return a.second.index < b.second.index ;
+}
+
+template <typename PFP>
+inline Utils::Quadric<typename PFP::REAL> vertexQuadric(
+	typename PFP::MAP& map,
+	Vertex v,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+{
+	Utils::Quadric<typename PFP::REAL> q ;
+	foreach_incident2<FACE>(map, v, [&] (Face f)
+	{
+		q += Utils::Quadric<typename PFP::REAL>(position[f.dart], position[map.phi1(f.dart)], position[map.phi_1(f.dart)]) ;
+	});
+	return q ;
+}
+
+template <typename PFP>
+void computeVertexQuadrics(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<Utils::Quadric<typename PFP::REAL>, typename PFP::MAP>& quadric)
+{
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::computeVertexQuadrics<PFP>(map, position, quadric) ;
+		return ;
+	}
+
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		quadric[v] = vertexQuadric<PFP>(map, v, position) ;
+	}, FORCE_CELL_MARKING);
+}
+
+template <typename PFP>
+void evaluateEdgeCollapses(
+	typename PFP::MAP& map,
+	const VertexAttribute<Utils::Quadric<typename PFP::REAL>, typename PFP::MAP>& quadric,
+	Approximator<PFP, typename PFP::VEC3, EDGE>& approx,
+	std::vector<std::pair<typename PFP::REAL, Dart> >& collapses)
+{
+	typedef typename PFP::REAL REAL ;
+
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::evaluateEdgeCollapses<PFP>(map, quadric, approx, collapses) ;
+		return ;
+	}
+
+	collapses.clear() ;
+	foreach_cell<EDGE>(map, [&] (Edge e)
+	{
+		if (map.edgeCanCollapse(e.dart))
+		{
+			Utils::Quadric<REAL> quad(quadric[e.dart]) ;
+			quad += quadric[map.phi2(e.dart)] ;
+			approx.approximate(e.dart) ;
+			collapses.push_back(std::make_pair(quad(approx.getApprox(e.dart)), e.dart)) ;
+		}
+	});
+	std::sort(collapses.begin(), collapses.end(), collapseLess<REAL>) ;
+}
+
+
+namespace Parallel
+{
+
+template <typename PFP>
+void computeVertexQuadrics(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<Utils::Quadric<typename PFP::REAL>, typename PFP::MAP>& quadric,
+	unsigned int nbth)
+{
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
+	{
+		quadric[v] = vertexQuadric<PFP>(map, v, position) ;
+	}, FORCE_CELL_MARKING, nbth);
+}
+
+template <typename PFP>
+void evaluateEdgeCollapses(
+	typename PFP::MAP& map,
+	const VertexAttribute<Utils::Quadric<typename PFP::REAL>, typename PFP::MAP>& quadric,
+	Approximator<PFP, typename PFP::VEC3, EDGE>& approx,
+	std::vector<std::pair<typename PFP::REAL, Dart> >& collapses,
+	unsigned int nbth)
+{
+	typedef typename PFP::REAL REAL ;
+
+	assert(approx.getType() == A_QEM || !"evaluateEdgeCollapses: only the QEM approximator is thread-safe") ;
+
+	// foreach_cell uses at least one worker thread (thread ids start at 1)
+	if (nbth < 2)
+		nbth = 2 ;
+
+	// one buffer per thread, sorted in its thread then merged
+	std::vector< std::vector< std::pair<REAL, Dart> > > found(nbth) ;
+
+	CGoGN::Parallel::foreach_cell<EDGE>(map, [&] (Edge e, unsigned int thr)
+	{
+		if (map.edgeCanCollapse(e.dart))
+		{
+			Utils::Quadric<REAL> quad(quadric[e.dart]) ;
+			quad += quadric[map.phi2(e.dart)] ;
+			approx.approximate(e.dart) ;
+			found[thr].push_back(std::make_pair(quad(approx.getApprox(e.dart)), e.dart)) ;
+		}
+	}, AUTO, nbth);
+
+	CGoGN::Parallel::foreach_index(0, nbth, [&] (unsigned int i, unsigned int /*thr*/)
+	{
+		std::sort(found[i].begin(), found[i].end(), collapseLess<REAL>) ;
+	}, nbth, 1);
+
+	std::size_t total = 0 ;
+	for (unsigned int i = 0; i < nbth; ++i)
+		total += found[i].size() ;
+	collapses.clear() ;
+	collapses.reserve(total) ;
+	for (unsigned int i = 0; i < nbth; ++i)
+	{
+		std::size_t mid = collapses.size() ;
+		collapses.insert(collapses.end(), found[i].begin(), found[i].end()) ;
+		std::vector< std::pair<REAL, Dart> >().swap(found[i]) ;
+		std::inplace_merge(collapses.begin(), collapses.begin() + mid, collapses.end(), collapseLess<REAL>) ;
+	}
+}
+
+} // namespace Parallel
+
+} // namespace Decimation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -26,6 +26,9 @@
 #include "Algo/Filtering/functors.h"
 #include "Algo/Selection/collector.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace CGoGN
 {
 
@@ -40,6 +43,60 @@ namespace Filtering
 
 enum neighborhood { INSIDE = 1, BORDER = 2 };
 
+namespace Parallel
+{
+
+template <typename PFP, typename T>
+void filterAverageAttribute_OneRing(
+	typename PFP::MAP& map,
+	const VertexAttribute<T, typename PFP::MAP>& attIn,
+	VertexAttribute<T, typename PFP::MAP>& attOut,
+	int neigh) ;
+
+} // namespace Parallel
+
+/**
+ * average of attIn on the neighborhood of v collected by col
+ * (attIn[v] for boundary vertices)
+ */
+template <typename PFP, typename T>
+T averageAttribute_OneRing(
+	typename PFP::MAP& map,
+	Vertex v,
+	const VertexAttribute<T, typename PFP::MAP>& attIn,
+	int neigh,
+	Algo::Surface::Selection::Collector_OneRing<PFP>& col,
+	FunctorAverage<VertexAttribute<T, typename PFP::MAP> >& fa)
+{
+	if(map.isBoundaryVertex(v))
+		return attIn[v] ;
+
+	if (neigh & INSIDE)
+		col.collectAll(v) ;
+	else
+		col.collectBorder(v) ;
+
+	fa.reset() ;
+	if (neigh & INSIDE)
+	{
+		switch (attIn.getOrbit())
+		{
+		case VERTEX :
+			col.applyOnInsideVertices(fa) ;
+			break;
+		case EDGE :
+			col.applyOnInsideEdges(fa) ;
+			break;
+		case FACE :
+			col.applyOnInsideFaces(fa) ;
+			break;
+		}
+	}
+	if (neigh & BORDER)
+		col.applyOnBorder(fa) ;
+	return fa.getAverage() ;
+}
+
 template <typename PFP, typename T>
 void filterAverageAttribute_OneRing(
 	typename PFP::MAP& map,
@@ -47,42 +104,18 @@ void filterAverageAttribute_OneRing(
 	VertexAttribute<T, typename PFP::MAP>& attOut,
 	int neigh)
 {
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::filterAverageAttribute_OneRing<PFP, T>(map, attIn, attOut, neigh) ;
+		return ;
+	}
+
 	FunctorAverage<VertexAttribute<T, typename PFP::MAP> > fa(attIn) ;
 	Algo::Surface::Selection::Collector_OneRing<PFP> col(map) ;
 
 	TraversorV<typename PFP::MAP> t(map) ;
 	for(Dart d = t.begin(); d != t.end(); d = t.next())
-	{
-		if(!map.isBoundaryVertex(d))
-		{
-			if (neigh & INSIDE)
-				col.collectAll(d) ;
-			else
-				col.collectBorder(d) ;
-
-			fa.reset() ;
-			if (neigh & INSIDE)
-			{
-				switch (attIn.getOrbit())
-				{
-				case VERTEX :
-					col.applyOnInsideVertices(fa) ;
-					break;
-				case EDGE :
-					col.applyOnInsideEdges(fa) ;
-					break;
-				case FACE :
-					col.applyOnInsideFaces(fa) ;
-					break;
-				}
-			}
-			if (neigh & BORDER)
-				col.applyOnBorder(fa) ;
-			attOut[d] = fa.getAverage() ;
-		}
-		else
-			attOut[d] = attIn[d] ;
-	}
+		attOut[d] = averageAttribute_OneRing<PFP, T>(map, d, attIn, neigh, col, fa) ;
 }
 
 template <typename PFP, typename T>
@@ -180,6 +213,32 @@ void filterAverageFaceAttribute_WithinSphere(
 	}
 }
 
+namespace Parallel
+{
+
+/**
+ * each thread uses its own collector and functor
+ */
+template <typename PFP, typename T>
+void filterAverageAttribute_OneRing(
+	typename PFP::MAP& map,
+	const VertexAttribute<T, typename PFP::MAP>& attIn,
+	VertexAttribute<T, typename PFP::MAP>& attOut,
+	int neigh)
+{
+	unsigned int nbth = std::max(CGoGN::Parallel::NumberOfThreads, 2) ;
+
+	std::vector<Algo::Surface::Selection::Collector_OneRing<PFP> > collectors(nbth, Algo::Surface::Selection::Collector_OneRing<PFP>(map)) ;
+	std::vector<FunctorAverage<VertexAttribute<T, typename PFP::MAP> > > functors(nbth, FunctorAverage<VertexAttribute<T, typename PFP::MAP> >(attIn)) ;
+
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int thr)
+	{
+		attOut[v] = averageAttribute_OneRing<PFP, T>(map, v, attIn, neigh, collectors[thr], functors[thr]) ;
+	}, AUTO, nbth) ;
+}
+
+} // namespace Parallel
+
 } // namespace Filtering
 
 } // namespace Surface
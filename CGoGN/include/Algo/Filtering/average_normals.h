@@ -27,6 +27,7 @@
 #include "Topology/generic/autoAttributeHandler.h"
 #include "Algo/Geometry/area.h"
 #include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/centroid.h"
 
 
 namespace CGoGN
@@ -42,9 +43,56 @@ namespace Filtering
 {
 
 /**
- * compute new position of vertices from normals (normalAverage & MMSE filters)
- * @param map the map
+ * attributes used by the filters based on face normals (normalAverage, MMSE, TNBA, VNBA)
+ * Keep one instance between successive iterations to avoid reallocating them
+ * (the vertex attributes are only allocated by VNBA).
  */
+template <typename PFP>
+class FaceNormalsBuffers
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	MAP& m_map ;
+
+public:
+	FaceAutoAttribute<REAL, MAP> faceArea ;
+	FaceAutoAttribute<VEC3, MAP> faceNormal ;
+	FaceAutoAttribute<VEC3, MAP> faceCentroid ;
+	FaceAutoAttribute<VEC3, MAP> faceNewNormal ;
+
+	VertexAttribute<REAL, MAP> vertexArea ;
+	VertexAttribute<VEC3, MAP> vertexNewNormal ;
+
+	FaceNormalsBuffers(MAP& map) :
+		m_map(map),
+		faceArea(map),
+		faceNormal(map),
+		faceCentroid(map),
+		faceNewNormal(map)
+	{}
+
+	~FaceNormalsBuffers()
+	{
+		if (vertexArea.isValid())
+			m_map.removeAttribute(vertexArea) ;
+		if (vertexNewNormal.isValid())
+			m_map.removeAttribute(vertexNewNormal) ;
+	}
+
+	void addVertexBuffers()
+	{
+		if (!vertexArea.isValid())
+			vertexArea = m_map.template addAttribute<REAL, VERTEX, MAP>("") ;
+		if (!vertexNewNormal.isValid())
+			vertexNewNormal = m_map.template addAttribute<VEC3, VERTEX, MAP>("") ;
+	}
+} ;
+
+namespace Parallel
+{
+
 template <typename PFP>
 void computeNewPositionsFromFaceNormals(
 	typename PFP::MAP& map,
@@ -53,419 +101,516 @@ void computeNewPositionsFromFaceNormals(
 	const FaceAttribute<typename PFP::REAL, typename PFP::MAP>& faceArea,
 	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceCentroid,
 	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceNormal,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceNewNormal) ;
+
+template <typename PFP>
+void filterAverageNormals(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, FaceNormalsBuffers<PFP>& buffers) ;
+
+template <typename PFP>
+void filterMMSE(typename PFP::MAP& map, float sigmaN2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, FaceNormalsBuffers<PFP>& buffers) ;
+
+template <typename PFP>
+void filterTNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, FaceNormalsBuffers<PFP>& buffers) ;
+
+template <typename PFP>
+void filterVNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal, FaceNormalsBuffers<PFP>& buffers) ;
+
+} // namespace Parallel
+
+/**
+ * new position of vertex v from the normals of its incident faces
+ */
+template <typename PFP>
+typename PFP::VEC3 newPositionFromFaceNormals(
+	typename PFP::MAP& map,
+	Vertex v,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const FaceAttribute<typename PFP::REAL, typename PFP::MAP>& faceArea,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceCentroid,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceNormal,
 	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceNewNormal)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL ;
 
-	TraversorV<typename PFP::MAP> t(map) ;
-	for(Dart d = t.begin(); d != t.end(); d = t.next())
-	{
-		const VEC3& pos_d = position[d] ;
+	const VEC3& pos_d = position[v] ;
 
-		VEC3 displ(0) ;
-		REAL sumAreas = 0 ;
+	VEC3 displ(0) ;
+	REAL sumAreas = 0 ;
 
-		Traversor2VF<typename PFP::MAP> tvf(map, d) ;
-		for(Dart it = tvf.begin(); it != tvf.end(); it = tvf.next())
-		{
-			sumAreas += faceArea[it] ;
-			VEC3 vT = faceCentroid[it] - pos_d ;
-			vT = (vT * faceNewNormal[it]) * faceNormal[it] ;
-			displ += faceArea[it] * vT ;
-		}
+	Traversor2VF<typename PFP::MAP> tvf(map, v) ;
+	for(Dart it = tvf.begin(); it != tvf.end(); it = tvf.next())
+	{
+		sumAreas += faceArea[it] ;
+		VEC3 vT = faceCentroid[it] - pos_d ;
+		vT = (vT * faceNewNormal[it]) * faceNormal[it] ;
+		displ += faceArea[it] * vT ;
+	}
+
+	displ /= sumAreas ;
+	return pos_d + displ ;
+}
 
-		displ /= sumAreas ;
-		position2[d] = pos_d + displ ;
+/**
+ * compute new position of vertices from normals (normalAverage & MMSE filters)
+ * @param map the map
+ */
+template <typename PFP>
+void computeNewPositionsFromFaceNormals(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2,
+	const FaceAttribute<typename PFP::REAL, typename PFP::MAP>& faceArea,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceCentroid,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceNormal,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceNewNormal)
+{
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::computeNewPositionsFromFaceNormals<PFP>(map, position, position2, faceArea, faceCentroid, faceNormal, faceNewNormal) ;
+		return ;
 	}
+
+	TraversorV<typename PFP::MAP> t(map) ;
+	for(Dart d = t.begin(); d != t.end(); d = t.next())
+		position2[d] = newPositionFromFaceNormals<PFP>(map, d, position, faceArea, faceCentroid, faceNormal, faceNewNormal) ;
 }
 
+/**
+ * area weighted average of the normals of the faces adjacent to f (by edges and vertices)
+ */
 template <typename PFP>
-void filterAverageNormals(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+typename PFP::VEC3 averageFaceNormal(
+	typename PFP::MAP& map,
+	Face f,
+	const FaceAttribute<typename PFP::REAL, typename PFP::MAP>& faceArea,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceNormal)
 {
-	typedef typename PFP::MAP MAP ;
 	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL ;
 
-	FaceAutoAttribute<REAL, MAP> faceArea(map, "faceArea") ;
-	FaceAutoAttribute<VEC3, MAP> faceNormal(map, "faceNormal") ;
-	FaceAutoAttribute<VEC3, MAP> faceCentroid(map, "faceCentroid") ;
+	REAL sumArea = 0 ;
+	VEC3 meanFilter(0) ;
 
-	Algo::Surface::Geometry::computeAreaFaces<PFP>(map, position, faceArea) ;
-	Algo::Surface::Geometry::computeNormalFaces<PFP>(map, position, faceNormal) ;
-	Algo::Surface::Geometry::computeCentroidFaces<PFP>(map, position, faceCentroid) ;
-
-	FaceAutoAttribute<VEC3, MAP> faceNewNormal(map, "faceNewNormal") ;
-
-	// Compute new normals
-	TraversorF<MAP> tf(map) ;
-	for(Dart d = tf.begin(); d != tf.end(); d = tf.next())
+	// traversal of adjacent faces (by edges and vertices)
+	Traversor2FFaV<typename PFP::MAP> taf(map, f) ;
+	for(Dart it = taf.begin(); it != taf.end(); it = taf.next())
 	{
-		REAL sumArea = 0 ;
-		VEC3 meanFilter(0) ;
-
-		// traversal of adjacent faces (by edges and vertices)
-		Traversor2FFaV<MAP> taf(map, d) ;
-		for(Dart it = taf.begin(); it != taf.end(); it = taf.next())
-		{
-			sumArea += faceArea[it] ;
-			meanFilter += faceArea[it] * faceNormal[it] ;
-		}
-
-		// finalize the computation of meanFilter normal
-		meanFilter /= sumArea ;
-		meanFilter.normalize() ;
-		// and store it
-		faceNewNormal[d] = meanFilter ;
+		sumArea += faceArea[it] ;
+		meanFilter += faceArea[it] * faceNormal[it] ;
 	}
 
-	// Compute new vertices position
-	computeNewPositionsFromFaceNormals<PFP>(
-		map, position, position2, faceArea, faceCentroid, faceNormal, faceNewNormal) ;
+	// finalize the computation of meanFilter normal
+	meanFilter /= sumArea ;
+	meanFilter.normalize() ;
+	return meanFilter ;
 }
 
+/**
+ * MMSE estimation of the normal of f from the normals of the faces adjacent
+ * to f (by edges and vertices) whose angle with the normal of f is below
+ * SUSANthreshold (all the faces if SUSANthreshold < 0)
+ */
 template <typename PFP>
-void filterMMSE(typename PFP::MAP& map, float sigmaN2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+typename PFP::VEC3 mmseFaceNormal(
+	typename PFP::MAP& map,
+	Face f,
+	float sigmaN2,
+	float SUSANthreshold,
+	const FaceAttribute<typename PFP::REAL, typename PFP::MAP>& faceArea,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceNormal)
 {
-	typedef typename PFP::MAP MAP ;
 	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL ;
 
-	FaceAutoAttribute<REAL, MAP> faceArea(map, "faceArea") ;
-	FaceAutoAttribute<VEC3, MAP> faceNormal(map, "faceNormal") ;
-	FaceAutoAttribute<VEC3, MAP> faceCentroid(map, "faceCentroid") ;
+	const VEC3& normF = faceNormal[f] ;
 
-	Algo::Surface::Geometry::computeAreaFaces<PFP>(map, position, faceArea) ;
-	Algo::Surface::Geometry::computeNormalFaces<PFP>(map, position, faceNormal) ;
-	Algo::Surface::Geometry::computeCentroidFaces<PFP>(map, position, faceCentroid) ;
+	// traversal of neighbour vertices
+	REAL sumArea = 0 ;
+	REAL sigmaX2 = 0 ;
+	REAL sigmaY2 = 0 ;
+	REAL sigmaZ2 = 0 ;
 
-	FaceAutoAttribute<VEC3, MAP> faceNewNormal(map, "faceNewNormal") ;
+	VEC3 meanFilter(0) ;
 
-	// Compute new normals
-	TraversorF<typename PFP::MAP> tf(map) ;
-	for(Dart d = tf.begin(); d != tf.end(); d = tf.next())
+	// traversal of adjacent faces (by edges and vertices)
+	Traversor2FFaV<typename PFP::MAP> taf(map, f) ;
+	for(Dart it = taf.begin(); it != taf.end(); it = taf.next())
 	{
-		// traversal of neighbour vertices
-		REAL sumArea = 0 ;
-		REAL sigmaX2 = 0 ;
-		REAL sigmaY2 = 0 ;
-		REAL sigmaZ2 = 0 ;
-
-		VEC3 meanFilter(0) ;
-
-		// traversal of adjacent faces (by edges and vertices)
-		Traversor2FFaV<typename PFP::MAP> taf(map, d) ;
-		for(Dart it = taf.begin(); it != taf.end(); it = taf.next())
+		// get info from face embedding and sum
+		const VEC3& normal = faceNormal[it] ;
+		if(SUSANthreshold < 0.0f || Geom::angle(normF, normal) <= SUSANthreshold)
 		{
-			// get info from face embedding and sum
 			REAL area = faceArea[it] ;
 			sumArea += area ;
-			VEC3 normal = faceNormal[it] ;
 			meanFilter += area * normal ;
 			sigmaX2 += area * normal[0] * normal[0] ;
 			sigmaY2 += area * normal[1] * normal[1] ;
 			sigmaZ2 += area * normal[2] * normal[2] ;
 		}
+	}
 
-		meanFilter /= sumArea ;
-		sigmaX2 /= sumArea ;
-		sigmaX2 -= meanFilter[0] * meanFilter[0] ;
-		sigmaY2 /= sumArea ;
-		sigmaY2 -= meanFilter[1] * meanFilter[1] ;
-		sigmaZ2 /= sumArea ;
-		sigmaZ2 -= meanFilter[2] * meanFilter[2] ;
+	if(sumArea <= 0.0f)
+		return normF ;
 
-		VEC3& oldNormal = faceNormal[d] ;
-		VEC3 newNormal ;
+	meanFilter /= sumArea ;
+	sigmaX2 /= sumArea ;
+	sigmaX2 -= meanFilter[0] * meanFilter[0] ;
+	sigmaY2 /= sumArea ;
+	sigmaY2 -= meanFilter[1] * meanFilter[1] ;
+	sigmaZ2 /= sumArea ;
+	sigmaZ2 -= meanFilter[2] * meanFilter[2] ;
 
-		if(sigmaX2 < sigmaN2)
-			newNormal[0] = meanFilter[0] ;
-		else
-		{
-			newNormal[0] = (1 - (sigmaN2 / sigmaX2)) * oldNormal[0] ;
-			newNormal[0] += (sigmaN2 / sigmaX2) * meanFilter[0] ;
-		}
-		if(sigmaY2 < sigmaN2)
-			newNormal[1] = meanFilter[1] ;
-		else
-		{
-			newNormal[1] = (1 - (sigmaN2 / sigmaY2)) * oldNormal[1] ;
-			newNormal[1] += (sigmaN2 / sigmaY2) * meanFilter[1] ;
-		}
-		if(sigmaZ2 < sigmaN2)
-			newNormal[2] = meanFilter[2] ;
-		else
-		{
-			newNormal[2] = (1 - (sigmaN2 / sigmaZ2)) * oldNormal[2] ;
-			newNormal[2] += (sigmaN2 / sigmaZ2) * meanFilter[2] ;
-		}
+	VEC3 newNormal ;
 
-		newNormal.normalize() ;
-		faceNewNormal[d] = newNormal ;
+	if(sigmaX2 < sigmaN2)
+		newNormal[0] = meanFilter[0] ;
+	else
+	{
+		newNormal[0] = (1 - (sigmaN2 / sigmaX2)) * normF[0] ;
+		newNormal[0] += (sigmaN2 / sigmaX2) * meanFilter[0] ;
+	}
+	if(sigmaY2 < sigmaN2)
+		newNormal[1] = meanFilter[1] ;
+	else
+	{
+		newNormal[1] = (1 - (sigmaN2 / sigmaY2)) * normF[1] ;
+		newNormal[1] += (sigmaN2 / sigmaY2) * meanFilter[1] ;
+	}
+	if(sigmaZ2 < sigmaN2)
+		newNormal[2] = meanFilter[2] ;
+	else
+	{
+		newNormal[2] = (1 - (sigmaN2 / sigmaZ2)) * normF[2] ;
+		newNormal[2] += (sigmaN2 / sigmaZ2) * meanFilter[2] ;
 	}
 
-	// Compute new vertices position
-	computeNewPositionsFromFaceNormals<PFP>(
-		map, position, position2, faceArea, faceCentroid, faceNormal, faceNewNormal) ;
+	newNormal.normalize() ;
+	return newNormal ;
 }
 
+/**
+ * MMSE estimation of the normal of v from the normals of its neighbors
+ * whose angle with the normal of v is below SUSANthreshold
+ */
 template <typename PFP>
-void filterTNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+typename PFP::VEC3 vnbaVertexNormal(
+	typename PFP::MAP& map,
+	Vertex v,
+	float sigmaN2,
+	float SUSANthreshold,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertexArea)
 {
-	typedef typename PFP::MAP MAP ;
 	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL ;
 
-	FaceAutoAttribute<REAL, MAP> faceArea(map, "faceArea") ;
-	FaceAutoAttribute<VEC3, MAP> faceNormal(map, "faceNormal") ;
-	FaceAutoAttribute<VEC3, MAP> faceCentroid(map, "faceCentroid") ;
+	const VEC3& normV = normal[v] ;
 
-	Algo::Surface::Geometry::computeAreaFaces<PFP>(map, position, faceArea) ;
-	Algo::Surface::Geometry::computeNormalFaces<PFP>(map, position, faceNormal) ;
-	Algo::Surface::Geometry::computeCentroidFaces<PFP>(map, position, faceCentroid) ;
+	REAL sumArea = 0 ;
+	REAL sigmaX2 = 0 ;
+	REAL sigmaY2 = 0 ;
+	REAL sigmaZ2 = 0 ;
 
-	FaceAutoAttribute<VEC3, MAP> faceNewNormal(map, "faceNewNormal") ;
+	VEC3 meanFilter(0) ;
 
-	// Compute new normals
-	long nbTot = 0 ;
-	long nbAdapt = 0 ;
-	long nbSusan = 0 ;
-
-	TraversorF<typename PFP::MAP> tf(map) ;
-	for(Dart d = tf.begin(); d != tf.end(); d = tf.next())
+	// traversal of neighbour vertices
+	Traversor2VVaE<typename PFP::MAP> tav(map, v) ;
+	for(Dart it = tav.begin(); it != tav.end(); it = tav.next())
 	{
-		const VEC3& normF = faceNormal[d] ;
+		const VEC3& neighborNormal = normal[it] ;
+		REAL angle = Geom::angle(normV, neighborNormal) ;
+		if( angle <= SUSANthreshold )
+		{
+			REAL umbArea = vertexArea[it] ;
+			sumArea += umbArea ;
+			sigmaX2 += umbArea * neighborNormal[0] * neighborNormal[0] ;
+			sigmaY2 += umbArea * neighborNormal[1] * neighborNormal[1] ;
+			sigmaZ2 += umbArea * neighborNormal[2] * neighborNormal[2] ;
+			meanFilter += neighborNormal * umbArea ;
+		}
+	}
 
-		// traversal of neighbour vertices
-		REAL sumArea = 0 ;
-		REAL sigmaX2 = 0 ;
-		REAL sigmaY2 = 0 ;
-		REAL sigmaZ2 = 0 ;
+	if(sumArea <= 0.0f)
+		return normV ;
+
+	meanFilter /= sumArea ;
+	sigmaX2 /= sumArea ;
+	sigmaX2 -= meanFilter[0] * meanFilter[0] ;
+	sigmaY2 /= sumArea ;
+	sigmaY2 -= meanFilter[1] * meanFilter[1] ;
+	sigmaZ2 /= sumArea ;
+	sigmaZ2 -= meanFilter[2] * meanFilter[2] ;
+
+	VEC3 newNormal ;
+	if(sigmaX2 < sigmaN2)
+		newNormal[0] = meanFilter[0] ;
+	else
+	{
+		newNormal[0] = (1 - (sigmaN2 / sigmaX2)) * normV[0] ;
+		newNormal[0] += (sigmaN2 / sigmaX2) * meanFilter[0] ;
+	}
+	if(sigmaY2 < sigmaN2)
+		newNormal[1] = meanFilter[1] ;
+	else
+	{
+		newNormal[1] = (1 - (sigmaN2 / sigmaY2)) * normV[1] ;
+		newNormal[1] += (sigmaN2 / sigmaY2) * meanFilter[1] ;
+	}
+	if(sigmaZ2 < sigmaN2)
+		newNormal[2] = meanFilter[2] ;
+	else
+	{
+		newNormal[2] = (1 - (sigmaN2 / sigmaZ2)) * normV[2] ;
+		newNormal[2] += (sigmaN2 / sigmaZ2) * meanFilter[2] ;
+	}
 
-		VEC3 meanFilter(0) ;
-		bool SUSANregion = false ;
+	newNormal.normalize() ;
+	return newNormal ;
+}
 
-		// traversal of adjacent faces (by edges and vertices)
-		Traversor2FFaV<typename PFP::MAP> taf(map, d) ;
-		for(Dart it = taf.begin(); it != taf.end(); it = taf.next())
-		{
-			// get info from face embedding and sum
-			const VEC3& normal = faceNormal[it] ;
-
-			REAL angle = Geom::angle(normF, normal) ;
-			if(angle <= SUSANthreshold)
-			{
-				REAL area = faceArea[it] ;
-				sumArea += area ;
-				meanFilter += area * normal ;
-				sigmaX2 += area * normal[0] * normal[0] ;
-				sigmaY2 += area * normal[1] * normal[1] ;
-				sigmaZ2 += area * normal[2] * normal[2] ;
-			}
-			else SUSANregion = true ;
-		}
+/**
+ * area weighted average of the new normals of the vertices of f
+ */
+template <typename PFP>
+typename PFP::VEC3 faceNormalFromVertexNormals(
+	typename PFP::MAP& map,
+	Face f,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& vertexNewNormal,
+	const VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertexArea)
+{
+	typedef typename PFP::VEC3 VEC3 ;
 
-		if(SUSANregion)
-			++nbSusan ;
+	VEC3 newNormal(0) ;
+	Traversor2FV<typename PFP::MAP> tav(map, f) ;
+	for(Dart it = tav.begin(); it != tav.end(); it = tav.next())
+	{
+		VEC3 vNorm = vertexNewNormal[it] ;
+		vNorm *= vertexArea[it] ;
+		newNormal += vNorm ;
+	}
+	newNormal.normalize() ;
+	return newNormal ;
+}
 
-		++nbTot ;
+template <typename PFP>
+void computeFaceNormalsBuffers(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, FaceNormalsBuffers<PFP>& buffers)
+{
+	Algo::Surface::Geometry::computeAreaFaces<PFP>(map, position, buffers.faceArea) ;
+	Algo::Surface::Geometry::computeNormalFaces<PFP>(map, position, buffers.faceNormal) ;
+	Algo::Surface::Geometry::computeCentroidFaces<PFP>(map, position, buffers.faceCentroid) ;
+}
 
-		if(sumArea > 0.0f)
-		{
-			meanFilter /= sumArea ;
-			sigmaX2 /= sumArea ;
-			sigmaX2 -= meanFilter[0] * meanFilter[0] ;
-			sigmaY2 /= sumArea ;
-			sigmaY2 -= meanFilter[1] * meanFilter[1] ;
-			sigmaZ2 /= sumArea ;
-			sigmaZ2 -= meanFilter[2] * meanFilter[2] ;
-
-			VEC3& oldNormal = faceNormal[d] ;
-			VEC3 newNormal ;
-
-			bool adapt = false ;
-			if(sigmaX2 < sigmaN2)
-				newNormal[0] = meanFilter[0] ;
-			else
-			{
-				adapt = true ;
-				newNormal[0] = (1 - (sigmaN2 / sigmaX2)) * oldNormal[0] ;
-				newNormal[0] += (sigmaN2 / sigmaX2) * meanFilter[0] ;
-			}
-			if(sigmaY2 < sigmaN2)
-				newNormal[1] = meanFilter[1] ;
-			else
-			{
-				adapt = true ;
-				newNormal[1] = (1 - (sigmaN2 / sigmaY2)) * oldNormal[1] ;
-				newNormal[1] += (sigmaN2 / sigmaY2) * meanFilter[1] ;
-			}
-			if(sigmaZ2 < sigmaN2)
-				newNormal[2] = meanFilter[2] ;
-			else
-			{
-				adapt = true ;
-				newNormal[2] = (1 - (sigmaN2 / sigmaZ2)) * oldNormal[2] ;
-				newNormal[2] += (sigmaN2 / sigmaZ2) * meanFilter[2] ;
-			}
-			if(adapt)
-				++nbAdapt ;
-
-			newNormal.normalize() ;
-			faceNewNormal[d] = newNormal;
-		}
-		else
-		{
-			faceNewNormal[d] = normF ;
-		}
+template <typename PFP>
+void filterAverageNormals(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, FaceNormalsBuffers<PFP>& buffers)
+{
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::filterAverageNormals<PFP>(map, position, position2, buffers) ;
+		return ;
 	}
 
+	computeFaceNormalsBuffers<PFP>(map, position, buffers) ;
+
+	// Compute new normals
+	TraversorF<typename PFP::MAP> tf(map) ;
+	for(Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		buffers.faceNewNormal[d] = averageFaceNormal<PFP>(map, d, buffers.faceArea, buffers.faceNormal) ;
+
 	// Compute new vertices position
 	computeNewPositionsFromFaceNormals<PFP>(
-		map, position, position2, faceArea, faceCentroid, faceNormal, faceNewNormal) ;
+		map, position, position2, buffers.faceArea, buffers.faceCentroid, buffers.faceNormal, buffers.faceNewNormal) ;
+}
 
-//	CGoGNout <<" susan rate = "<< float(nbSusan)/float(nbTot)<<CGoGNendl;
-//	CGoGNout <<" adaptive rate = "<< float(nbAdapt)/float(nbTot)<<CGoGNendl;
+template <typename PFP>
+void filterAverageNormals(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+{
+	FaceNormalsBuffers<PFP> buffers(map) ;
+	filterAverageNormals<PFP>(map, position, position2, buffers) ;
 }
 
 template <typename PFP>
-void filterVNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal)
+void filterMMSE(typename PFP::MAP& map, float sigmaN2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, FaceNormalsBuffers<PFP>& buffers)
 {
-	typedef typename PFP::MAP MAP ;
-	typedef typename PFP::VEC3 VEC3 ;
-	typedef typename PFP::REAL REAL ;
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::filterMMSE<PFP>(map, sigmaN2, position, position2, buffers) ;
+		return ;
+	}
 
-	FaceAutoAttribute<REAL, MAP> faceArea(map, "faceArea") ;
-	FaceAutoAttribute<VEC3, MAP> faceNormal(map, "faceNormal") ;
-	FaceAutoAttribute<VEC3, MAP> faceCentroid(map, "faceCentroid") ;
+	computeFaceNormalsBuffers<PFP>(map, position, buffers) ;
 
-	Algo::Surface::Geometry::computeAreaFaces<PFP>(map, position, faceArea) ;
-	Algo::Surface::Geometry::computeNormalFaces<PFP>(map, position, faceNormal) ;
-	Algo::Surface::Geometry::computeCentroidFaces<PFP>(map, position, faceCentroid) ;
+	// Compute new normals
+	TraversorF<typename PFP::MAP> tf(map) ;
+	for(Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		buffers.faceNewNormal[d] = mmseFaceNormal<PFP>(map, d, sigmaN2, -1.0f, buffers.faceArea, buffers.faceNormal) ;
 
-	VertexAutoAttribute<REAL, MAP> vertexArea(map, "vertexArea") ;
-	FaceAutoAttribute<VEC3, MAP> faceNewNormal(map, "faceNewNormal") ;
-	VertexAutoAttribute<VEC3, MAP> vertexNewNormal(map, "vertexNewNormal") ;
+	// Compute new vertices position
+	computeNewPositionsFromFaceNormals<PFP>(
+		map, position, position2, buffers.faceArea, buffers.faceCentroid, buffers.faceNormal, buffers.faceNewNormal) ;
+}
 
-	long nbTot = 0 ;
-	long nbAdapt = 0 ;
-	long nbSusan = 0 ;
+template <typename PFP>
+void filterMMSE(typename PFP::MAP& map, float sigmaN2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+{
+	FaceNormalsBuffers<PFP> buffers(map) ;
+	filterMMSE<PFP>(map, sigmaN2, position, position2, buffers) ;
+}
 
-	TraversorV<typename PFP::MAP> tv(map) ;
-	for(Dart d = tv.begin(); d != tv.end(); d = tv.next())
+template <typename PFP>
+void filterTNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, FaceNormalsBuffers<PFP>& buffers)
+{
+	if (CGoGN::Parallel::NumberOfThreads > 1)
 	{
-		const VEC3& normV = normal[d] ;
+		Parallel::filterTNBA<PFP>(map, sigmaN2, SUSANthreshold, position, position2, buffers) ;
+		return ;
+	}
 
-		REAL sumArea = 0 ;
-		REAL sigmaX2 = 0 ;
-		REAL sigmaY2 = 0 ;
-		REAL sigmaZ2 = 0 ;
+	computeFaceNormalsBuffers<PFP>(map, position, buffers) ;
 
-		VEC3 meanFilter(0) ;
+	// Compute new normals
+	TraversorF<typename PFP::MAP> tf(map) ;
+	for(Dart d = tf.begin(); d != tf.end(); d = tf.next())
+		buffers.faceNewNormal[d] = mmseFaceNormal<PFP>(map, d, sigmaN2, SUSANthreshold, buffers.faceArea, buffers.faceNormal) ;
 
-		bool SUSANregion = false ;
+	// Compute new vertices position
+	computeNewPositionsFromFaceNormals<PFP>(
+		map, position, position2, buffers.faceArea, buffers.faceCentroid, buffers.faceNormal, buffers.faceNewNormal) ;
+}
 
-		// traversal of neighbour vertices
-		Traversor2VVaE<typename PFP::MAP> tav(map, d) ;
-		for(Dart it = tav.begin(); it != tav.end(); it = tav.next())
-		{
-			const VEC3& neighborNormal = normal[it] ;
-			REAL angle = Geom::angle(normV, neighborNormal) ;
-			if( angle <= SUSANthreshold )
-			{
-				REAL umbArea = Algo::Surface::Geometry::vertexOneRingArea<PFP>(map, it, position) ;
-				vertexArea[it] = umbArea ;
-
-				sumArea += umbArea ;
-				sigmaX2 += umbArea * neighborNormal[0] * neighborNormal[0] ;
-				sigmaY2 += umbArea * neighborNormal[1] * neighborNormal[1] ;
-				sigmaZ2 += umbArea * neighborNormal[2] * neighborNormal[2] ;
-				meanFilter += neighborNormal * umbArea ;
-			}
-			else SUSANregion = true ;
-		}
+template <typename PFP>
+void filterTNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+{
+	FaceNormalsBuffers<PFP> buffers(map) ;
+	filterTNBA<PFP>(map, sigmaN2, SUSANthreshold, position, position2, buffers) ;
+}
 
-		if(SUSANregion)
-			++nbSusan ;
+template <typename PFP>
+void filterVNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal, FaceNormalsBuffers<PFP>& buffers)
+{
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::filterVNBA<PFP>(map, sigmaN2, SUSANthreshold, position, position2, normal, buffers) ;
+		return ;
+	}
 
-		++nbTot ;
+	computeFaceNormalsBuffers<PFP>(map, position, buffers) ;
+	buffers.addVertexBuffers() ;
+	Algo::Surface::Geometry::computeOneRingAreaVertices<PFP>(map, position, buffers.vertexArea) ;
 
-		if(sumArea > 0.0f)
-		{
-			meanFilter /= sumArea ;
-			sigmaX2 /= sumArea ;
-			sigmaX2 -= meanFilter[0] * meanFilter[0] ;
-			sigmaY2 /= sumArea ;
-			sigmaY2 -= meanFilter[1] * meanFilter[1] ;
-			sigmaZ2 /= sumArea ;
-			sigmaZ2 -= meanFilter[2] * meanFilter[2] ;
-
-			VEC3 newNormal ;
-			bool adapt = false ;
-			if(sigmaX2 < sigmaN2)
-				newNormal[0] = meanFilter[0] ;
-			else
-			{
-				adapt = true ;
-				newNormal[0] = (1 - (sigmaN2 / sigmaX2)) * normV[0] ;
-				newNormal[0] += (sigmaN2 / sigmaX2) * meanFilter[0] ;
-			}
-			if(sigmaY2 < sigmaN2)
-				newNormal[1] = meanFilter[1] ;
-			else
-			{
-				adapt = true ;
-				newNormal[1] = (1 - (sigmaN2 / sigmaY2)) * normV[1] ;
-				newNormal[1] += (sigmaN2 / sigmaY2) * meanFilter[1] ;
-			}
-			if(sigmaZ2 < sigmaN2)
-				newNormal[2] = meanFilter[2] ;
-			else
-			{
-				adapt = true ;
-				newNormal[2] = (1 - (sigmaN2 / sigmaZ2)) * normV[2] ;
-				newNormal[2] += (sigmaN2 / sigmaZ2) * meanFilter[2] ;
-			}
-
-			if(adapt)
-				++nbAdapt ;
-
-			newNormal.normalize() ;
-			vertexNewNormal[d] = newNormal ;
-		}
-		else
-		{
-			vertexNewNormal[d] = normV ;
-		}
-	}
+	TraversorV<typename PFP::MAP> tv(map) ;
+	for(Dart d = tv.begin(); d != tv.end(); d = tv.next())
+		buffers.vertexNewNormal[d] = vnbaVertexNormal<PFP>(map, d, sigmaN2, SUSANthreshold, normal, buffers.vertexArea) ;
 
 	// Compute face normals from vertex normals
 	TraversorF<typename PFP::MAP> tf(map) ;
 	for(Dart d = tf.begin(); d != tf.end(); d = tf.next())
-	{
-		VEC3 newNormal(0) ;
-		REAL totArea = 0 ;
-		Traversor2FV<typename PFP::MAP> tav(map, d) ;
-		for(Dart it = tav.begin(); it != tav.end(); it = tav.next())
-		{
-			VEC3 vNorm = vertexNewNormal[it] ;
-			REAL area = vertexArea[it] ;
-			totArea += area ;
-			vNorm *= area ;
-			newNormal += vNorm ;
-		}
-		newNormal.normalize() ;
-		faceNewNormal[d] = newNormal ;
-	}
+		buffers.faceNewNormal[d] = faceNormalFromVertexNormals<PFP>(map, d, buffers.vertexNewNormal, buffers.vertexArea) ;
 
 	// Compute new vertices position
 	computeNewPositionsFromFaceNormals<PFP>(
-		map, position, position2, faceArea, faceCentroid, faceNormal, faceNewNormal	) ;
+		map, position, position2, buffers.faceArea, buffers.faceCentroid, buffers.faceNormal, buffers.faceNewNormal) ;
+}
 
-//	CGoGNout <<" susan rate = "<< float(nbSusan)/float(nbTot)<<CGoGNendl;
-//	CGoGNout <<" adaptive rate = "<< float(nbAdapt)/float(nbTot)<<CGoGNendl;
+template <typename PFP>
+void filterVNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal)
+{
+	FaceNormalsBuffers<PFP> buffers(map) ;
+	filterVNBA<PFP>(map, sigmaN2, SUSANthreshold, position, position2, normal, buffers) ;
 }
 
+namespace Parallel
+{
+
+template <typename PFP>
+void computeNewPositionsFromFaceNormals(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2,
+	const FaceAttribute<typename PFP::REAL, typename PFP::MAP>& faceArea,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceCentroid,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceNormal,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceNewNormal)
+{
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
+	{
+		position2[v] = newPositionFromFaceNormals<PFP>(map, v, position, faceArea, faceCentroid, faceNormal, faceNewNormal) ;
+	}) ;
+}
+
+template <typename PFP>
+void computeFaceNormalsBuffers(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, FaceNormalsBuffers<PFP>& buffers)
+{
+	Algo::Surface::Geometry::Parallel::computeAreaFaces<PFP>(map, position, buffers.faceArea) ;
+	Algo::Surface::Geometry::Parallel::computeNormalFaces<PFP>(map, position, buffers.faceNormal) ;
+	Algo::Surface::Geometry::Parallel::computeCentroidFaces<PFP>(map, position, buffers.faceCentroid) ;
+}
+
+template <typename PFP>
+void filterAverageNormals(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, FaceNormalsBuffers<PFP>& buffers)
+{
+	Parallel::computeFaceNormalsBuffers<PFP>(map, position, buffers) ;
+
+	CGoGN::Parallel::foreach_cell<FACE>(map, [&] (Face f, unsigned int /*thr*/)
+	{
+		buffers.faceNewNormal[f] = averageFaceNormal<PFP>(map, f, buffers.faceArea, buffers.faceNormal) ;
+	}) ;
+
+	computeNewPositionsFromFaceNormals<PFP>(
+		map, position, position2, buffers.faceArea, buffers.faceCentroid, buffers.faceNormal, buffers.faceNewNormal) ;
+}
+
+template <typename PFP>
+void filterMMSE(typename PFP::MAP& map, float sigmaN2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, FaceNormalsBuffers<PFP>& buffers)
+{
+	Parallel::computeFaceNormalsBuffers<PFP>(map, position, buffers) ;
+
+	CGoGN::Parallel::foreach_cell<FACE>(map, [&] (Face f, unsigned int /*thr*/)
+	{
+		buffers.faceNewNormal[f] = mmseFaceNormal<PFP>(map, f, sigmaN2, -1.0f, buffers.faceArea, buffers.faceNormal) ;
+	}) ;
+
+	computeNewPositionsFromFaceNormals<PFP>(
+		map, position, position2, buffers.faceArea, buffers.faceCentroid, buffers.faceNormal, buffers.faceNewNormal) ;
+}
+
+template <typename PFP>
+void filterTNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, FaceNormalsBuffers<PFP>& buffers)
+{
+	Parallel::computeFaceNormalsBuffers<PFP>(map, position, buffers) ;
+
+	CGoGN::Parallel::foreach_cell<FACE>(map, [&] (Face f, unsigned int /*thr*/)
+	{
+		buffers.faceNewNormal[f] = mmseFaceNormal<PFP>(map, f, sigmaN2, SUSANthreshold, buffers.faceArea, buffers.faceNormal) ;
+	}) ;
+
+	computeNewPositionsFromFaceNormals<PFP>(
+		map, position, position2, buffers.faceArea, buffers.faceCentroid, buffers.faceNormal, buffers.faceNewNormal) ;
+}
+
+template <typename PFP>
+void filterVNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal, FaceNormalsBuffers<PFP>& buffers)
+{
+	Parallel::computeFaceNormalsBuffers<PFP>(map, position, buffers) ;
+	buffers.addVertexBuffers() ;
+	Algo::Surface::Geometry::Parallel::computeOneRingAreaVertices<PFP>(map, position, buffers.vertexArea) ;
+
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
+	{
+		buffers.vertexNewNormal[v] = vnbaVertexNormal<PFP>(map, v, sigmaN2, SUSANthreshold, normal, buffers.vertexArea) ;
+	}) ;
+
+	CGoGN::Parallel::foreach_cell<FACE>(map, [&] (Face f, unsigned int /*thr*/)
+	{
+		buffers.faceNewNormal[f] = faceNormalFromVertexNormals<PFP>(map, f, buffers.vertexNewNormal, buffers.vertexArea) ;
+	}) ;
+
+	computeNewPositionsFromFaceNormals<PFP>(
+		map, position, position2, buffers.faceArea, buffers.faceCentroid, buffers.faceNormal, buffers.faceNewNormal) ;
+}
+
+} // namespace Parallel
+
 } // namespace Filtering
 
 } // namespace Surface
@@ -23,6 +23,8 @@
 *******************************************************************************/
 
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include "Topology/generic/traversor/traversorCell.h"
 #include "Topology/generic/traversor/traversor2.h"
 #include "Algo/Geometry/basic.h"
@@ -39,12 +41,32 @@ namespace Surface
 namespace Filtering
 {
 
+namespace Parallel
+{
+
+template <typename PFP>
+void sigmaBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal, typename PFP::REAL& sigmaC, typename PFP::REAL& sigmaS) ;
+
+template <typename PFP>
+void filterBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positionIn, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positionOut, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal) ;
+
+template <typename PFP>
+void filterSUSAN(typename PFP::MAP& map, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal) ;
+
+} // namespace Parallel
+
 template <typename PFP>
 void sigmaBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal, typename PFP::REAL& sigmaC, typename PFP::REAL& sigmaS)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL ;
 
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::sigmaBilateral<PFP>(map, position, normal, sigmaC, sigmaS) ;
+		return ;
+	}
+
 	REAL sumLengths = 0.0f;
 	REAL sumAngles = 0.0f;
 	long nbEdges = 0 ;
@@ -62,6 +84,49 @@ void sigmaBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::
 	sigmaS = 2.5f * (sumAngles / REAL(nbEdges));
 }
 
+/**
+ * bilateral filtered position of vertex v
+ * (SUSANthreshold: neighbors whose normal deviates more are ignored, no threshold if < 0)
+ */
+template <typename PFP>
+typename PFP::VEC3 bilateralVertex(
+	typename PFP::MAP& map,
+	Vertex v,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	typename PFP::REAL sigmaC,
+	typename PFP::REAL sigmaS,
+	float SUSANthreshold = -1.0f)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL;
+
+	if(map.isBoundaryVertex(v))
+		return position[v] ;
+
+	// get normal of vertex
+	const VEC3& normal_d = normal[v] ;
+
+	// traversal of incident edges
+	REAL sum = 0.0f, normalizer = 0.0f;
+	Traversor2VE<typename PFP::MAP> te(map, v) ;
+	for(Dart it = te.begin(); it != te.end(); it = te.next())
+	{
+		if (SUSANthreshold >= 0.0f && Geom::angle(normal_d, normal[map.phi1(it)]) > SUSANthreshold)
+			continue ;
+		VEC3 vec = Algo::Geometry::vectorOutOfDart<PFP>(map, it, position) ;
+		REAL h = normal_d * vec;
+		REAL t = vec.norm();
+		REAL wcs = std::exp((-1.0f * (t * t) / (2.0f * sigmaC * sigmaC)) + (-1.0f * (h * h) / (2.0f * sigmaS * sigmaS)));
+		sum += wcs * h ;
+		normalizer += wcs ;
+	}
+
+	if (normalizer != 0.0f)
+		return position[v] + ((sum / normalizer) * normal_d) ;
+	return position[v] ;
+}
+
 /**
  * \brief Function applying a bilateral filter smoothing on the mesh.
  * \param map the map of the mesh
@@ -76,98 +141,100 @@ void filterBilateral(
         VertexAttribute<typename PFP::VEC3,typename PFP::MAP>& positionOut,
         const VertexAttribute<typename PFP::VEC3,typename PFP::MAP>& normal)
 {
-	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL;
 
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::filterBilateral<PFP>(map, positionIn, positionOut, normal) ;
+		return ;
+	}
+
 	REAL sigmaC, sigmaS;
-    sigmaBilateral<PFP>(map, positionIn, normal, sigmaC, sigmaS) ;
+	sigmaBilateral<PFP>(map, positionIn, normal, sigmaC, sigmaS) ;
 
 	TraversorV<typename PFP::MAP> t(map) ;
 	for(Dart d = t.begin(); d != t.end(); d = t.next())
-	{
-		if(!map.isBoundaryVertex(d))
-		{
-			// get normal of vertex
-			const VEC3& normal_d = normal[d] ;
-
-			// traversal of incident edges
-			REAL sum = 0.0f, normalizer = 0.0f;
-			Traversor2VE<typename PFP::MAP> te(map, d) ;
-			for(Dart it = te.begin(); it != te.end(); it = te.next())
-			{
-                VEC3 vec = Algo::Geometry::vectorOutOfDart<PFP>(map, it, positionIn) ;
-				REAL h = normal_d * vec;
-				REAL t = vec.norm();
-				REAL wcs = std::exp((-1.0f * (t * t) / (2.0f * sigmaC * sigmaC)) + (-1.0f * (h * h) / (2.0f * sigmaS * sigmaS)));
-				sum += wcs * h ;
-				normalizer += wcs ;
-			}
-
-            positionOut[d] = positionIn[d] + ((sum / normalizer) * normal_d) ;
-		}
-		else
-            positionOut[d] = positionIn[d] ;
-	}
+		positionOut[d] = bilateralVertex<PFP>(map, d, positionIn, normal, sigmaC, sigmaS) ;
 }
 
 template <typename PFP>
 void filterSUSAN(typename PFP::MAP& map, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal)
 {
-	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL;
 
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::filterSUSAN<PFP>(map, SUSANthreshold, position, position2, normal) ;
+		return ;
+	}
+
 	REAL sigmaC, sigmaS;
 	sigmaBilateral<PFP>(map, position, normal, sigmaC, sigmaS) ;
 
-	long nbTot = 0 ;
-	long nbSusan = 0 ;
-
 	TraversorV<typename PFP::MAP> t(map) ;
 	for(Dart d = t.begin(); d != t.end(); d = t.next())
+		position2[d] = bilateralVertex<PFP>(map, d, position, normal, sigmaC, sigmaS, SUSANthreshold) ;
+}
+
+namespace Parallel
+{
+
+template <typename PFP>
+void sigmaBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal, typename PFP::REAL& sigmaC, typename PFP::REAL& sigmaS)
+{
+	typedef typename PFP::REAL REAL ;
+
+	unsigned int nbth = std::max(CGoGN::Parallel::NumberOfThreads, 2) ;
+
+	// per thread sums
+	std::vector<REAL> sumLengths(nbth, REAL(0)) ;
+	std::vector<REAL> sumAngles(nbth, REAL(0)) ;
+	std::vector<long> nbEdges(nbth, 0) ;
+
+	CGoGN::Parallel::foreach_cell<EDGE>(map, [&] (Edge e, unsigned int thr)
+	{
+		sumLengths[thr] += Algo::Geometry::edgeLength<PFP>(map, e, position) ;
+		sumAngles[thr] += Geom::angle(normal[e.dart], normal[map.phi1(e)]) ;
+		++nbEdges[thr] ;
+	}, AUTO, nbth) ;
+
+	for (unsigned int i = 1; i < nbth; ++i)
 	{
-		if(!map.isBoundaryVertex(d))
-		{
-			// get position & normal of vertex
-			const VEC3& pos_d = position[d] ;
-			const VEC3& normal_d = normal[d] ;
-
-			// traversal of incident edges
-			REAL sum = 0.0f, normalizer = 0.0f;
-			bool SUSANregion = false ;
-			Traversor2VE<typename PFP::MAP> te(map, d) ;
-			for(Dart it = te.begin(); it != te.end(); it = te.next())
-			{
-				const VEC3& neighborNormal = normal[map.phi1(it)] ;
-				REAL angle = Geom::angle(normal_d, neighborNormal);
-				if( angle <= SUSANthreshold )
-				{
-					VEC3 vec = Algo::Geometry::vectorOutOfDart<PFP>(map, it, position) ;
-					REAL h = normal_d * vec;
-					REAL t = vec.norm();
-					REAL wcs = std::exp((-1.0f * (t * t) / (2.0f * sigmaC * sigmaC)) + (-1.0f * (h * h) / (2.0f * sigmaS * sigmaS)));
-					sum += wcs * h ;
-					normalizer += wcs ;
-				}
-				else
-					SUSANregion = true ;
-			}
-
-			if(SUSANregion)
-				nbSusan++ ;
-			nbTot++ ;
-
-			if (normalizer != 0.0f)
-				position2[d] = pos_d + ((sum / normalizer) * normal_d) ;
-			else
-				position2[d] = pos_d ;
-		}
-		else
-			position2[d] = position[d] ;
+		sumLengths[0] += sumLengths[i] ;
+		sumAngles[0] += sumAngles[i] ;
+		nbEdges[0] += nbEdges[i] ;
 	}
 
-//	CGoGNout <<" susan rate = "<< float(nbSusan)/float(nbTot)<<CGoGNendl;
+	sigmaC = 1.0f * (sumLengths[0] / REAL(nbEdges[0]));
+	sigmaS = 2.5f * (sumAngles[0] / REAL(nbEdges[0]));
+}
+
+template <typename PFP>
+void filterBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positionIn, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positionOut, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal)
+{
+	typename PFP::REAL sigmaC, sigmaS;
+	sigmaBilateral<PFP>(map, positionIn, normal, sigmaC, sigmaS) ;
+
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
+	{
+		positionOut[v] = bilateralVertex<PFP>(map, v, positionIn, normal, sigmaC, sigmaS) ;
+	}) ;
+}
+
+template <typename PFP>
+void filterSUSAN(typename PFP::MAP& map, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal)
+{
+	typename PFP::REAL sigmaC, sigmaS;
+	sigmaBilateral<PFP>(map, position, normal, sigmaC, sigmaS) ;
+
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
+	{
+		position2[v] = bilateralVertex<PFP>(map, v, position, normal, sigmaC, sigmaS, SUSANthreshold) ;
+	}) ;
 }
 
+} // namespace Parallel
+
 } //namespace Filtering
 
 }
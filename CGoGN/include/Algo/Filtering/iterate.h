@@ -0,0 +1,75 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __FILTERING_ITERATE_H__
+#define __FILTERING_ITERATE_H__
+
+#include "Topology/generic/attributeHandler.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Filtering
+{
+
+/**
+ * apply nbIterations times a filter that computes new positions in a second buffer
+ * (filterBilateral, filterSUSAN, filterMMSE, filterTNBA, filterVNBA, ...)
+ * @param position the positions to filter (contain the result after the call)
+ * @param position2 the second buffer
+ * @param filter called as filter(position, position2) at each iteration
+ * After each iteration the contents of the two buffers are swapped
+ * (only the pointers are exchanged): nothing is allocated or copied between
+ * the iterations. The filter may keep its own buffers (e.g. FaceNormalsBuffers).
+ */
+template <typename PFP, typename FILTER>
+void iterateFilter(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2,
+	unsigned int nbIterations,
+	FILTER filter)
+{
+	for (unsigned int i = 0; i < nbIterations; ++i)
+	{
+		filter(position, position2) ;
+		map.swapAttributes(position, position2) ;
+	}
+}
+
+} // namespace Filtering
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#endif
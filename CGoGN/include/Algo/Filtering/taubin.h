@@ -25,6 +25,9 @@
 #include "Algo/Filtering/functors.h"
 #include "Algo/Selection/collector.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace CGoGN
 {
 
@@ -37,6 +40,41 @@ namespace Surface
 namespace Filtering
 {
 
+namespace Parallel
+{
+
+template <typename PFP>
+void filterTaubin(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2) ;
+
+} // namespace Parallel
+
+/**
+ * one step of Taubin filter on vertex v:
+ * displacement towards the average of the neighbors scaled by factor
+ */
+template <typename PFP>
+typename PFP::VEC3 taubinVertex(
+	typename PFP::MAP& map,
+	Vertex v,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	typename PFP::REAL factor,
+	Algo::Surface::Selection::Collector_OneRing<PFP>& c,
+	FunctorAverage<VertexAttribute<typename PFP::VEC3, typename PFP::MAP> >& fa)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+
+	if(map.isBoundaryVertex(v))
+		return position[v] ;
+
+	c.collectBorder(v) ;
+	fa.reset() ;
+	c.applyOnBorder(fa) ;
+	VEC3 p = position[v] ;
+	VEC3 displ = fa.getAverage() - p ;
+	displ *= factor ;
+	return p + displ ;
+}
+
 template <typename PFP>
 void filterTaubin(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
 {
@@ -44,57 +82,26 @@ void filterTaubin(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, ty
 	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL;
 
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::filterTaubin<PFP>(map, position, position2) ;
+		return ;
+	}
+
 	Algo::Surface::Selection::Collector_OneRing<PFP> c(map) ;
 
 	const REAL lambda = 0.6307f;
 	const REAL mu = -0.6732f;
 
-	CellMarkerNoUnmark<MAP, VERTEX> mv(map) ;
-
 	FunctorAverage<VertexAttribute<VEC3, MAP> > fa1(position) ;
-	for(Dart d = map.begin(); d != map.end(); map.next(d))
-	{
-		if( !mv.isMarked(d))
-		{
-			mv.mark(d);
-
-			if(!map.isBoundaryVertex(d))
-			{
-				c.collectBorder(d) ;
-				fa1.reset() ;
-				c.applyOnBorder(fa1) ;
-				VEC3 p = position[d] ;
-				VEC3 displ = fa1.getAverage() - p ;
-				displ *= lambda ;
-				position2[d] = p + displ ;
-			}
-			else
-				position2[d] = position[d] ;
-		}
-	}
+	TraversorV<MAP> t(map) ;
+	for(Dart d = t.begin(); d != t.end(); d = t.next())
+		position2[d] = taubinVertex<PFP>(map, d, position, lambda, c, fa1) ;
 
 	// unshrinking step
 	FunctorAverage<VertexAttribute<VEC3, MAP> > fa2(position2) ;
-	for(Dart d = map.begin(); d != map.end(); map.next(d))
-	{
-		if( mv.isMarked(d))
-		{
-			mv.unmark(d);
-
-			if(!map.isBoundaryVertex(d))
-			{
-				c.collectBorder(d) ;
-				fa2.reset() ;
-				c.applyOnBorder(fa2) ;
-				VEC3 p = position2[d] ;
-				VEC3 displ = fa2.getAverage() - p ;
-				displ *= mu ;
-				position[d] = p + displ ;
-			}
-			else
-				position[d] = position2[d] ;
-		}
-	}
+	for(Dart d = t.begin(); d != t.end(); d = t.next())
+		position[d] = taubinVertex<PFP>(map, d, position2, mu, c, fa2) ;
 }
 
 /**
@@ -160,6 +167,42 @@ void filterTaubin_modified(typename PFP::MAP& map, VertexAttribute<typename PFP:
 	}
 }
 
+namespace Parallel
+{
+
+/**
+ * each thread uses its own collector and functors
+ */
+template <typename PFP>
+void filterTaubin(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL;
+
+	const REAL lambda = 0.6307f;
+	const REAL mu = -0.6732f;
+
+	unsigned int nbth = std::max(CGoGN::Parallel::NumberOfThreads, 2) ;
+
+	std::vector<Algo::Surface::Selection::Collector_OneRing<PFP> > collectors(nbth, Algo::Surface::Selection::Collector_OneRing<PFP>(map)) ;
+	std::vector<FunctorAverage<VertexAttribute<VEC3, MAP> > > functors1(nbth, FunctorAverage<VertexAttribute<VEC3, MAP> >(position)) ;
+	std::vector<FunctorAverage<VertexAttribute<VEC3, MAP> > > functors2(nbth, FunctorAverage<VertexAttribute<VEC3, MAP> >(position2)) ;
+
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int thr)
+	{
+		position2[v] = taubinVertex<PFP>(map, v, position, lambda, collectors[thr], functors1[thr]) ;
+	}, AUTO, nbth) ;
+
+	// unshrinking step
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int thr)
+	{
+		position[v] = taubinVertex<PFP>(map, v, position2, mu, collectors[thr], functors2[thr]) ;
+	}, AUTO, nbth) ;
+}
+
+} // namespace Parallel
+
 } // namespace Filtering
 
 } // namespace Surface
@@ -0,0 +1,107 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __ALGO_GEOMETRY_CLOSESTFACE_H__
+#define __ALGO_GEOMETRY_CLOSESTFACE_H__
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/traversor/traversorCell.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+/**
+* Bounding volume hierarchy on the faces of a map, for closest face queries.
+* The hierarchy is built once from the current positions (call build again if they change);
+* the queries are read-only and can be done concurrently from several threads.
+*/
+template <typename PFP>
+class ClosestFaceSearch
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+private:
+	struct Node
+	{
+		VEC3 bbMin ;
+		VEC3 bbMax ;
+		unsigned int first ;	// leaf : first face in m_faces, inner node : index of the second child (the first one follows the node)
+		unsigned int count ;	// number of faces of a leaf, 0 for an inner node
+	} ;
+
+	MAP& m_map ;
+	const VertexAttribute<VEC3, MAP>& m_position ;
+	unsigned int m_leafSize ;
+
+	std::vector<Dart> m_faces ;
+	std::vector<Node> m_nodes ;
+
+	unsigned int buildNode(std::vector<VEC3>& centers, std::vector<VEC3>& bbs, unsigned int begin, unsigned int end) ;
+
+	static REAL squaredDistancePoint2Box(const VEC3& P, const VEC3& bbMin, const VEC3& bbMax) ;
+
+public:
+	/**
+	* @param map the map
+	* @param position the vertex attribute storing positions
+	* @param leafSize max number of faces in a leaf of the hierarchy
+	*/
+	ClosestFaceSearch(MAP& map, const VertexAttribute<VEC3, MAP>& position, unsigned int leafSize = 4) ;
+
+	/**
+	* (re)build the hierarchy from the current positions
+	*/
+	void build() ;
+
+	/**
+	* find the face that is closest to a point
+	* @param P the point
+	* @param dist2 the squared distance from P to the returned face
+	* @return the closest face (NIL dart if the map has no face)
+	*/
+	Face closestFace(const VEC3& P, REAL& dist2) const ;
+
+	unsigned int nbFaces() const { return uint32(m_faces.size()) ; }
+} ;
+
+} // namespace Geometry
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Geometry/closestFace.hpp"
+
+#endif
@@ -0,0 +1,223 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Algo/Geometry/distances.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+template <typename PFP>
+ClosestFaceSearch<PFP>::ClosestFaceSearch(MAP& map, const VertexAttribute<VEC3, MAP>& position, unsigned int leafSize) :
+	m_map(map),
+	m_position(position),
+	m_leafSize(leafSize > 0 ? leafSize : 1)
+{
+	build() ;
+}
+
+template <typename PFP>
+void ClosestFaceSearch<PFP>::build()
+{
+	m_faces.clear() ;
+	m_nodes.clear() ;
+
+	std::vector<VEC3> centers ;
+	std::vector<VEC3> bbs ;		// min and max of each face
+
+	foreach_cell<FACE>(m_map, [&] (Face f)
+	{
+		VEC3 bbMin = m_position[f.dart] ;
+		VEC3 bbMax = bbMin ;
+		for (Dart d = m_map.phi1(f.dart); d != f.dart; d = m_map.phi1(d))
+		{
+			const VEC3& p = m_position[d] ;
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				bbMin[i] = std::min(bbMin[i], p[i]) ;
+				bbMax[i] = std::max(bbMax[i], p[i]) ;
+			}
+		}
+		m_faces.push_back(f.dart) ;
+		centers.push_back((bbMin + bbMax) / REAL(2)) ;
+		bbs.push_back(bbMin) ;
+		bbs.push_back(bbMax) ;
+	});
+
+	if (m_faces.empty())
+		return ;
+
+	m_nodes.reserve(2 * (m_faces.size() / m_leafSize) + 1) ;
+	buildNode(centers, bbs, 0, uint32(m_faces.size())) ;
+}
+
+template <typename PFP>
+unsigned int ClosestFaceSearch<PFP>::buildNode(std::vector<VEC3>& centers, std::vector<VEC3>& bbs, unsigned int begin, unsigned int end)
+{
+	unsigned int n = uint32(m_nodes.size()) ;
+	m_nodes.push_back(Node()) ;
+
+	VEC3 bbMin = bbs[2*begin] ;
+	VEC3 bbMax = bbs[2*begin+1] ;
+	VEC3 cMin = centers[begin] ;
+	VEC3 cMax = cMin ;
+	for (unsigned int f = begin + 1; f < end; ++f)
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			bbMin[i] = std::min(bbMin[i], bbs[2*f][i]) ;
+			bbMax[i] = std::max(bbMax[i], bbs[2*f+1][i]) ;
+			cMin[i] = std::min(cMin[i], centers[f][i]) ;
+			cMax[i] = std::max(cMax[i], centers[f][i]) ;
+		}
+	}
+	m_nodes[n].bbMin = bbMin ;
+	m_nodes[n].bbMax = bbMax ;
+
+	if (end - begin <= m_leafSize)
+	{
+		m_nodes[n].first = begin ;
+		m_nodes[n].count = end - begin ;
+		return n ;
+	}
+
+	// median split along the largest extent of the face centers
+	VEC3 ext = cMax - cMin ;
+	unsigned int axis = 0 ;
+	if (ext[1] > ext[axis]) axis = 1 ;
+	if (ext[2] > ext[axis]) axis = 2 ;
+
+	unsigned int mid = (begin + end) / 2 ;
+	std::vector<unsigned int> order(end - begin) ;
+	for (unsigned int f = begin; f < end; ++f)
+		order[f - begin] = f ;
+	std::nth_element(order.begin(), order.begin() + (mid - begin), order.end(),
+		[&] (unsigned int a, unsigned int b) { return centers[a][axis] < centers[b][axis] ; }) ;
+
+	std::vector<Dart> faces(end - begin) ;
+	std::vector<VEC3> c(end - begin) ;
+	std::vector<VEC3> bb(2 * (end - begin)) ;
+	for (unsigned int i = 0; i < end - begin; ++i)
+	{
+		faces[i] = m_faces[order[i]] ;
+		c[i] = centers[order[i]] ;
+		bb[2*i] = bbs[2*order[i]] ;
+		bb[2*i+1] = bbs[2*order[i]+1] ;
+	}
+	std::copy(faces.begin(), faces.end(), m_faces.begin() + begin) ;
+	std::copy(c.begin(), c.end(), centers.begin() + begin) ;
+	std::copy(bb.begin(), bb.end(), bbs.begin() + 2*begin) ;
+
+	buildNode(centers, bbs, begin, mid) ;
+	unsigned int right = buildNode(centers, bbs, mid, end) ;
+	m_nodes[n].first = right ;
+	m_nodes[n].count = 0 ;
+	return n ;
+}
+
+template <typename PFP>
+inline typename PFP::REAL ClosestFaceSearch<PFP>::squaredDistancePoint2Box(const VEC3& P, const VEC3& bbMin, const VEC3& bbMax)
+{
+	REAL d2 = REAL(0) ;
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		REAL d = REAL(0) ;
+		if (P[i] < bbMin[i])
+			d = bbMin[i] - P[i] ;
+		else if (P[i] > bbMax[i])
+			d = P[i] - bbMax[i] ;
+		d2 += d * d ;
+	}
+	return d2 ;
+}
+
+template <typename PFP>
+Face ClosestFaceSearch<PFP>::closestFace(const VEC3& P, REAL& dist2) const
+{
+	Face closest(NIL) ;
+	dist2 = std::numeric_limits<REAL>::max() ;
+	if (m_nodes.empty())
+		return closest ;
+
+	// depth first traversal, nearest child first, pruned by the current best distance
+	unsigned int stack[64] ;
+	REAL stackDist[64] ;
+	unsigned int top = 0 ;
+	stack[top] = 0 ;
+	stackDist[top++] = squaredDistancePoint2Box(P, m_nodes[0].bbMin, m_nodes[0].bbMax) ;
+
+	while (top > 0)
+	{
+		--top ;
+		if (stackDist[top] >= dist2)
+			continue ;
+
+		const Node& node = m_nodes[stack[top]] ;
+		if (node.count > 0)
+		{
+			for (unsigned int f = node.first; f < node.first + node.count; ++f)
+			{
+				REAL d2 = squaredDistancePoint2Face<PFP>(m_map, m_faces[f], m_position, P) ;
+				if (d2 < dist2)
+				{
+					dist2 = d2 ;
+					closest = m_faces[f] ;
+				}
+			}
+		}
+		else
+		{
+			unsigned int left = stack[top] + 1 ;
+			unsigned int right = node.first ;
+			REAL dl = squaredDistancePoint2Box(P, m_nodes[left].bbMin, m_nodes[left].bbMax) ;
+			REAL dr = squaredDistancePoint2Box(P, m_nodes[right].bbMin, m_nodes[right].bbMax) ;
+			if (dl < dr)
+			{
+				std::swap(left, right) ;
+				std::swap(dl, dr) ;
+			}
+			// the nearest child is pushed last to be visited first
+			stack[top] = left ;
+			stackDist[top++] = dl ;
+			stack[top] = right ;
+			stackDist[top++] = dr ;
+		}
+	}
+
+	return closest ;
+}
+
+} // namespace Geometry
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -28,11 +28,10 @@
 #include "Geometry/basic.h"
 
 #include "Algo/Selection/collector.h"
+#include "Algo/Selection/neighborhoodCache.h"
 
 #include "Utils/convertType.h"
 
-#include "NL/nl.h"
-
 #include <Eigen/Core>
 #include <Eigen/Eigenvalues>
 
@@ -83,19 +82,79 @@ void vertexQuadraticFitting(
 	typename PFP::REAL& a, typename PFP::REAL& b, typename PFP::REAL& c, typename PFP::REAL& d, typename PFP::REAL& e
 );
 
+/* quadratic fitting with a neighborhood cache as a parameter : the cache can be shared by several computations */
+
+template <typename PFP>
+void computeCurvatureVertices_QuadraticFitting(
+	typename PFP::MAP& map,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin
+);
+
+template <typename PFP>
+void computeCurvatureVertex_QuadraticFitting(
+	typename PFP::MAP& map,
+	Vertex v,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin
+);
+
+template <typename PFP>
+void vertexQuadraticFitting(
+	Vertex v,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const typename PFP::MATRIX33& localFrame,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	typename PFP::REAL& a, typename PFP::REAL& b, typename PFP::REAL& c, typename PFP::REAL& d, typename PFP::REAL& e
+);
+
+/* least squares rows of the fitting accumulated in the normal equations AtA x = Atb (thread safe) */
+
 template <typename PFP>
 void quadraticFittingAddVertexPos(
-	typename PFP::VEC3& v,
-	typename PFP::VEC3& p,
-	typename PFP::MATRIX33& localFrame
+	const typename PFP::VEC3& v,
+	const typename PFP::VEC3& p,
+	const typename PFP::MATRIX33& localFrame,
+	Eigen::Matrix<double,5,5>& AtA,
+	Eigen::Matrix<double,5,1>& Atb
 );
 
 template <typename PFP>
 void quadraticFittingAddVertexNormal(
-	typename PFP::VEC3& v,
-	typename PFP::VEC3& n,
-	typename PFP::VEC3& p,
-	typename PFP::MATRIX33& localFrame
+	const typename PFP::VEC3& v,
+	const typename PFP::VEC3& n,
+	const typename PFP::VEC3& p,
+	const typename PFP::MATRIX33& localFrame,
+	Eigen::Matrix<double,5,5>& AtA,
+	Eigen::Matrix<double,5,1>& Atb
+);
+
+template <typename PFP>
+void quadraticFitting_Solve(
+	const Eigen::Matrix<double,5,5>& AtA,
+	const Eigen::Matrix<double,5,1>& Atb,
+	typename PFP::REAL& a, typename PFP::REAL& b, typename PFP::REAL& c, typename PFP::REAL& d, typename PFP::REAL& e
+);
+
+template <typename PFP>
+void quadraticFitting_SetCurvatures(
+	typename PFP::REAL a, typename PFP::REAL b, typename PFP::REAL c,
+	const typename PFP::MATRIX33& localFrame,
+	typename PFP::REAL& kmax,
+	typename PFP::REAL& kmin,
+	typename PFP::VEC3& Kmax,
+	typename PFP::VEC3& Kmin
 );
 
 /*
@@ -173,6 +232,41 @@ void computeCurvatureVertex_NormalCycles_Projected(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal
 );
 
+/* normal cycles of one vertex with a collector as a parameter :
+ * the collector (of the wanted radius) is reused from vertex to vertex */
+
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles(
+	typename PFP::MAP& map,
+	Vertex v,
+	Selection::Collector_WithinSphere<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal
+);
+
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles_Projected(
+	typename PFP::MAP& map,
+	Vertex v,
+	Selection::Collector_WithinSphere<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal
+);
+
 
 
 template <typename PFP>
@@ -220,77 +314,105 @@ void normalCycles_ProjectTensor(
 	const typename PFP::VEC3& normal_vector
 );
 
-/* normal cycles with collector as a parameter : not usable in parallel */
-
-//template <typename PFP>
-//void computeCurvatureVertices_NormalCycles(
-//	typename PFP::MAP& map,
-//	Algo::Surface::Selection::Collector<PFP> & neigh,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal) ;
-
-//template <typename PFP>
-//void computeCurvatureVertex_NormalCycles(
-//	Vertex v,
-//	Algo::Surface::Selection::Collector<PFP> & neigh,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal) ;
-
-//template <typename PFP>
-//void computeCurvatureVertices_NormalCycles_Projected(
-//	typename PFP::MAP& map,
-//	Algo::Surface::Selection::Collector<PFP> & neigh,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal) ;
-
-//template <typename PFP>
-//void computeCurvatureVertex_NormalCycles_Projected(
-//	Vertex v,
-//	Algo::Surface::Selection::Collector<PFP> & neigh,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal) ;
+/* normal cycles with a neighborhood cache as a parameter : usable in parallel,
+ * the cache (collected once for a given radius) can be shared by several computations */
+
+template <typename PFP>
+void computeCurvatureVertices_NormalCycles(
+	typename PFP::MAP& map,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal
+);
+
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles(
+	typename PFP::MAP& map,
+	Vertex v,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal
+);
+
+template <typename PFP>
+void computeCurvatureVertices_NormalCycles_Projected(
+	typename PFP::MAP& map,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal
+);
+
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles_Projected(
+	typename PFP::MAP& map,
+	Vertex v,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal
+);
+
+template <typename PFP>
+void normalCycles_computeTensor(
+	const Algo::Surface::Selection::NeighborhoodCache<PFP>& neigh,
+	Vertex v,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	Geom::Matrix<3,3,typename PFP::REAL>& tensor
+);
 
 
 namespace Parallel
 {
 
-//template <typename PFP>
-//void computeCurvatureVertices_QuadraticFitting(
-//	typename PFP::MAP& map,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin);
+template <typename PFP>
+void computeCurvatureVertices_QuadraticFitting(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin) ;
+
+template <typename PFP>
+void computeCurvatureVertices_QuadraticFitting(
+	typename PFP::MAP& map,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin) ;
 
 template <typename PFP>
 void computeCurvatureVertices_NormalCycles(
@@ -306,6 +428,20 @@ void computeCurvatureVertices_NormalCycles(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal) ;
 
+template <typename PFP>
+void computeCurvatureVertices_NormalCycles(
+	typename PFP::MAP& map,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal) ;
+
 template <typename PFP>
 void computeCurvatureVertices_NormalCycles_Projected(
 	typename PFP::MAP& map,
@@ -320,6 +456,20 @@ void computeCurvatureVertices_NormalCycles_Projected(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal) ;
 
+template <typename PFP>
+void computeCurvatureVertices_NormalCycles_Projected(
+	typename PFP::MAP& map,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal) ;
+
 } // namespace Parallel
 
 
@@ -50,13 +50,11 @@ void computeCurvatureVertices_QuadraticFitting(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin)
 {
-	// TODO: nl not thread safe
-
-//	if (CGoGN::Parallel::NumberOfThreads > 1)
-//	{
-//		Parallel::computeCurvatureVertices_QuadraticFitting<PFP>(map, position, normal, kmax, kmin, Kmax, Kmin);
-//		return;
-//	}
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::computeCurvatureVertices_QuadraticFitting<PFP>(map, position, normal, kmax, kmin, Kmax, Kmin);
+		return;
+	}
 
 	foreach_cell<VERTEX>(map, [&] (Vertex v)
 	{
@@ -83,13 +81,108 @@ void computeCurvatureVertex_QuadraticFitting(
 	VEC3 n = normal[v] ;
 
 	MATRIX33 localFrame = Algo::Geometry::vertexLocalFrame<PFP>(map, v, position, n) ;
-	MATRIX33 invLocalFrame ;
-	localFrame.invert(invLocalFrame) ;
 
 	REAL a, b, c, d, e;
 	//vertexCubicFitting(map,dart,localFrame,a,b,c,d,e,f,g,h,i) ;
 	vertexQuadraticFitting<PFP>(map, v, localFrame, position, normal, a, b, c, d, e) ;
 
+	quadraticFitting_SetCurvatures<PFP>(a, b, c, localFrame, kmax[v], kmin[v], Kmax[v], Kmin[v]) ;
+}
+
+template <typename PFP>
+void vertexQuadraticFitting(
+	typename PFP::MAP& map,
+	Vertex v,
+	typename PFP::MATRIX33& localFrame,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	typename PFP::REAL& a, typename PFP::REAL& b, typename PFP::REAL& c, typename PFP::REAL& d, typename PFP::REAL& e)
+{
+	const typename PFP::VEC3& p = position[v] ;
+
+	Eigen::Matrix<double,5,5> AtA = Eigen::Matrix<double,5,5>::Zero() ;
+	Eigen::Matrix<double,5,1> Atb = Eigen::Matrix<double,5,1>::Zero() ;
+	foreach_adjacent2<EDGE>(map, v, [&] (Vertex it)
+	{
+		quadraticFittingAddVertexPos<PFP>(p, position[it], localFrame, AtA, Atb) ;
+		quadraticFittingAddVertexNormal<PFP>(position[it], normal[it], p, localFrame, AtA, Atb) ;
+	});
+
+	quadraticFitting_Solve<PFP>(AtA, Atb, a, b, c, d, e) ;
+}
+
+template <typename PFP>
+void quadraticFittingAddVertexPos(
+	const typename PFP::VEC3& v,
+	const typename PFP::VEC3& p,
+	const typename PFP::MATRIX33& localFrame,
+	Eigen::Matrix<double,5,5>& AtA,
+	Eigen::Matrix<double,5,1>& Atb)
+{
+	typename PFP::VEC3 vec = v - p ;
+	vec = localFrame * vec ;
+
+	Eigen::Matrix<double,5,1> row ;
+	row << vec[0]*vec[0], vec[0]*vec[1], vec[1]*vec[1], vec[0], vec[1] ;
+	AtA.noalias() += row * row.transpose() ;
+	Atb += row * double(vec[2]) ;
+}
+
+template <typename PFP>
+void quadraticFittingAddVertexNormal(
+	const typename PFP::VEC3& v,
+	const typename PFP::VEC3& n,
+	const typename PFP::VEC3& p,
+	const typename PFP::MATRIX33& localFrame,
+	Eigen::Matrix<double,5,5>& AtA,
+	Eigen::Matrix<double,5,1>& Atb)
+{
+	typename PFP::VEC3 vec = v - p ;
+	vec = localFrame * vec ;
+	typename PFP::VEC3 norm = localFrame * n ;
+
+	Eigen::Matrix<double,5,1> row ;
+	row << 2.0 * vec[0] * norm[2], vec[1] * norm[2], 0.0, norm[2], 0.0 ;
+	AtA.noalias() += row * row.transpose() ;
+	Atb += row * (-1.0 * norm[0]) ;
+
+	row << 0.0, vec[0] * norm[2], 2.0 * vec[1] * norm[2], 0.0, norm[2] ;
+	AtA.noalias() += row * row.transpose() ;
+	Atb += row * (-1.0 * norm[1]) ;
+}
+
+template <typename PFP>
+void quadraticFitting_Solve(
+	const Eigen::Matrix<double,5,5>& AtA,
+	const Eigen::Matrix<double,5,1>& Atb,
+	typename PFP::REAL& a, typename PFP::REAL& b, typename PFP::REAL& c, typename PFP::REAL& d, typename PFP::REAL& e)
+{
+	// least squares solution of the normal equations (LDLT zeroes null pivots of degenerate neighborhoods)
+	Eigen::Matrix<double,5,1> x = AtA.ldlt().solve(Atb) ;
+
+	a = typename PFP::REAL(x[0]) ;
+	b = typename PFP::REAL(x[1]) ;
+	c = typename PFP::REAL(x[2]) ;
+	d = typename PFP::REAL(x[3]) ;
+	e = typename PFP::REAL(x[4]) ;
+}
+
+template <typename PFP>
+void quadraticFitting_SetCurvatures(
+	typename PFP::REAL a, typename PFP::REAL b, typename PFP::REAL c,
+	const typename PFP::MATRIX33& localFrame,
+	typename PFP::REAL& kmax,
+	typename PFP::REAL& kmin,
+	typename PFP::VEC3& Kmax,
+	typename PFP::VEC3& Kmin)
+{
+	typedef typename PFP::REAL REAL ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::MATRIX33 MATRIX33 ;
+
+	MATRIX33 invLocalFrame ;
+	localFrame.invert(invLocalFrame) ;
+
 //	REAL kmax_v, kmin_v, Kmax_x, Kmax_y ;
 //	/*int res = */slaev2_(&a, &b, &c, &kmax_v, &kmin_v, &Kmax_x, &Kmax_y) ;
 
@@ -112,96 +205,90 @@ void computeCurvatureVertex_QuadraticFitting(
 
 	if (kmax_v < kmin_v)
 	{
-		kmax[v] = -kmax_v ;
-		kmin[v] = -kmin_v ;
-		Kmax[v] = Kmax_v ;
-		Kmin[v] = Kmin_v ;
+		kmax = -kmax_v ;
+		kmin = -kmin_v ;
+		Kmax = Kmax_v ;
+		Kmin = Kmin_v ;
 	}
 	else
 	{
-		kmax[v] = -kmin_v ;
-		kmin[v] = -kmax_v ;
-		Kmax[v] = Kmin_v ;
-		Kmin[v] = Kmax_v ;
+		kmax = -kmin_v ;
+		kmin = -kmax_v ;
+		Kmax = Kmin_v ;
+		Kmin = Kmax_v ;
 	}
 }
 
 template <typename PFP>
-void vertexQuadraticFitting(
+void computeCurvatureVertices_QuadraticFitting(
 	typename PFP::MAP& map,
-	Vertex v,
-	typename PFP::MATRIX33& localFrame,
+	const Selection::NeighborhoodCache<PFP>& neigh,
 	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
 	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
-    typename PFP::REAL& a, typename PFP::REAL& b, typename PFP::REAL& c, typename PFP::REAL& d, typename PFP::REAL& e)
-{
-	typename PFP::VEC3 p = position[v] ;
-
-	NLContext nlContext = nlNewContext() ;
-	nlMakeCurrent(nlContext) ;
-	nlSolverParameteri(NL_NB_VARIABLES, 5) ;
-	nlSolverParameteri(NL_LEAST_SQUARES, NL_TRUE) ;
-	nlBegin(NL_SYSTEM) ;
-	nlBegin(NL_MATRIX) ;
-	foreach_adjacent2<EDGE>(map, v, [&] (Vertex it) {
-		typename PFP::VEC3 itp = position[it] ;
-        quadraticFittingAddVertexPos<PFP>(p, itp, localFrame) ;
-		typename PFP::VEC3 itn = normal[it] ;
-		quadraticFittingAddVertexNormal<PFP>(itp, itn, p, localFrame) ;
-	});
-	nlEnd(NL_MATRIX) ;
-	nlEnd(NL_SYSTEM) ;
-	nlSolve() ;
-
-	a = typename PFP::REAL(nlGetVariable(0));
-	b = typename PFP::REAL(nlGetVariable(1));
-	c = typename PFP::REAL(nlGetVariable(2));
-	d = typename PFP::REAL(nlGetVariable(3));
-	e = typename PFP::REAL(nlGetVariable(4));
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin)
+{
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::computeCurvatureVertices_QuadraticFitting<PFP>(map, neigh, position, normal, kmax, kmin, Kmax, Kmin);
+		return;
+	}
 
-	nlDeleteContext(nlContext) ;
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		computeCurvatureVertex_QuadraticFitting<PFP>(map, v, neigh, position, normal, kmax, kmin, Kmax, Kmin) ;
+	}
+	, FORCE_CELL_MARKING);
 }
 
 template <typename PFP>
-void quadraticFittingAddVertexPos(typename PFP::VEC3& v, typename PFP::VEC3& p, typename PFP::MATRIX33& localFrame)
+void computeCurvatureVertex_QuadraticFitting(
+	typename PFP::MAP& map,
+	Vertex v,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin)
 {
-	typename PFP::VEC3 vec = v - p ;
-	vec = localFrame * vec ;
+	typedef typename PFP::REAL REAL ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::MATRIX33 MATRIX33 ;
+
+	VEC3 n = normal[v] ;
+
+	MATRIX33 localFrame = Algo::Geometry::vertexLocalFrame<PFP>(map, v, position, n) ;
+
+	REAL a, b, c, d, e;
+	vertexQuadraticFitting<PFP>(v, neigh, localFrame, position, normal, a, b, c, d, e) ;
 
-	nlRowParameterd(NL_RIGHT_HAND_SIDE, vec[2]) ;
-	nlBegin(NL_ROW) ;
-	nlCoefficient(0, vec[0]*vec[0]) ;
-	nlCoefficient(1, vec[0]*vec[1]) ;
-	nlCoefficient(2, vec[1]*vec[1]) ;
-	nlCoefficient(3, vec[0]) ;
-	nlCoefficient(4, vec[1]) ;
-	nlEnd(NL_ROW) ;
+	quadraticFitting_SetCurvatures<PFP>(a, b, c, localFrame, kmax[v], kmin[v], Kmax[v], Kmin[v]) ;
 }
 
 template <typename PFP>
-void quadraticFittingAddVertexNormal(typename PFP::VEC3& v, typename PFP::VEC3& n, typename PFP::VEC3& p, typename PFP::MATRIX33& localFrame)
+void vertexQuadraticFitting(
+	Vertex v,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const typename PFP::MATRIX33& localFrame,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	typename PFP::REAL& a, typename PFP::REAL& b, typename PFP::REAL& c, typename PFP::REAL& d, typename PFP::REAL& e)
 {
-	typename PFP::VEC3 vec = v - p ;
-	vec = localFrame * vec ;
-	typename PFP::VEC3 norm = localFrame * n ;
+	const typename PFP::VEC3& p = position[v] ;
+
+	Eigen::Matrix<double,5,5> AtA = Eigen::Matrix<double,5,5>::Zero() ;
+	Eigen::Matrix<double,5,1> Atb = Eigen::Matrix<double,5,1>::Zero() ;
+	for (Dart it : neigh.getRing(v))
+	{
+		quadraticFittingAddVertexPos<PFP>(p, position[it], localFrame, AtA, Atb) ;
+		quadraticFittingAddVertexNormal<PFP>(position[it], normal[it], p, localFrame, AtA, Atb) ;
+	}
 
-	nlRowParameterd(NL_RIGHT_HAND_SIDE, -1.0f * norm[0]) ;
-	nlBegin(NL_ROW);
-	nlCoefficient(0, 2.0f * vec[0] * norm[2]) ;
-	nlCoefficient(1, vec[1] * norm[2]) ;
-	nlCoefficient(2, 0) ;
-	nlCoefficient(3, 1.0f * norm[2]) ;
-	nlCoefficient(4, 0) ;
-	nlEnd(NL_ROW) ;
-
-	nlRowParameterd(NL_RIGHT_HAND_SIDE, -1.0f * norm[1]) ;
-	nlBegin(NL_ROW);
-	nlCoefficient(0, 0) ;
-	nlCoefficient(1, vec[0] * norm[2]) ;
-	nlCoefficient(2, 2.0f * vec[1] * norm[2]) ;
-	nlCoefficient(3, 0) ;
-	nlCoefficient(4, 1.0f * norm[2]) ;
-	nlEnd(NL_ROW) ;
+	quadraticFitting_Solve<PFP>(AtA, Atb, a, b, c, d, e) ;
 }
 /*
 template <typename PFP>
@@ -317,9 +404,11 @@ void computeCurvatureVertices_NormalCycles(
 		return;
 	}
 
+	// a single collector, reused from vertex to vertex
+	Selection::Collector_WithinSphere<PFP> neigh(map, position, radius) ;
 	foreach_cell<VERTEX>(map, [&] (Vertex v)
 	{
-		computeCurvatureVertex_NormalCycles<PFP>(map, v, radius, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+		computeCurvatureVertex_NormalCycles<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
 	}
 	,FORCE_CELL_MARKING);
 }
@@ -338,6 +427,25 @@ void computeCurvatureVertex_NormalCycles(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
+{
+	Selection::Collector_WithinSphere<PFP> neigh(map, position, radius) ;
+	computeCurvatureVertex_NormalCycles<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+}
+
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles(
+	typename PFP::MAP& /*map*/,
+	Vertex v,
+	Selection::Collector_WithinSphere<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
 {
 	typedef typename PFP::REAL REAL ;
 	typedef typename PFP::VEC3 VEC3 ;
@@ -346,7 +454,6 @@ void computeCurvatureVertex_NormalCycles(
 	typedef Eigen::Matrix<REAL,3,3,Eigen::RowMajor> E_MATRIX;
 
 	// collect the normal cycle tensor
-	Selection::Collector_WithinSphere<PFP> neigh(map, position, radius) ;
 	neigh.collectAll(v) ;
 
 	MATRIX tensor(0) ;
@@ -380,9 +487,11 @@ void computeCurvatureVertices_NormalCycles_Projected(
 		return;
 	}
 
+	// a single collector, reused from vertex to vertex
+	Selection::Collector_WithinSphere<PFP> neigh(map, position, radius) ;
 	foreach_cell<VERTEX>(map, [&] (Vertex v)
 	{
-		computeCurvatureVertex_NormalCycles_Projected<PFP>(map, v, radius, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+		computeCurvatureVertex_NormalCycles_Projected<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
 	}
 	,FORCE_CELL_MARKING);
 }
@@ -401,6 +510,25 @@ void computeCurvatureVertex_NormalCycles_Projected(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
+{
+	Selection::Collector_WithinSphere<PFP> neigh(map, position, radius) ;
+	computeCurvatureVertex_NormalCycles_Projected<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+}
+
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles_Projected(
+	typename PFP::MAP& /*map*/,
+	Vertex v,
+	Selection::Collector_WithinSphere<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
 {
 	typedef typename PFP::REAL REAL ;
 	typedef typename PFP::VEC3 VEC3 ;
@@ -409,7 +537,6 @@ void computeCurvatureVertex_NormalCycles_Projected(
 	typedef Eigen::Matrix<REAL,3,3,Eigen::RowMajor> E_MATRIX;
 
 	// collect the normal cycle tensor
-	Selection::Collector_WithinSphere<PFP> neigh(map, position, radius) ;
 	neigh.collectAll(v) ;
 
 	MATRIX tensor(0) ;
@@ -426,114 +553,124 @@ void computeCurvatureVertex_NormalCycles_Projected(
 	normalCycles_SortAndSetEigenComponents<PFP>(ev,evec,kmax[v],kmin[v],Kmax[v],Kmin[v],Knormal[v],normal[v]);
 }
 
-//template <typename PFP>
-//void computeCurvatureVertices_NormalCycles(
-//	typename PFP::MAP& map,
-//	Algo::Surface::Selection::Collector<PFP>& neigh,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
-//{
-//	TraversorV<typename PFP::MAP> t(map) ;
-//	for(Vertex v = t.begin(); v != t.end(); v = t.next())
-//		computeCurvatureVertex_NormalCycles<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
-//}
-
-//template <typename PFP>
-//void computeCurvatureVertex_NormalCycles(
-//	Vertex v,
-//	Algo::Surface::Selection::Collector<PFP>& neigh,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
-//{
-//	typedef typename PFP::REAL REAL ;
-//	typedef typename PFP::VEC3 VEC3 ;
-//	typedef Geom::Matrix<3,3,REAL> MATRIX;
-//	typedef Eigen::Matrix<REAL,3,1> E_VEC3;
-//	typedef Eigen::Matrix<REAL,3,3,Eigen::RowMajor> E_MATRIX;
-
-//	// collect the normal cycle tensor
-//	neigh.collectAll(v) ;
-
-//	MATRIX tensor(0) ;
-//	neigh.computeNormalCyclesTensor(position, edgeangle, edgearea, tensor);
-
-//	// solve eigen problem
-//	Eigen::SelfAdjointEigenSolver<E_MATRIX> solver(Utils::convertRef<E_MATRIX>(tensor));
-//	const VEC3& ev = Utils::convertRef<VEC3>(solver.eigenvalues());
-//	const MATRIX& evec = Utils::convertRef<MATRIX>(solver.eigenvectors());
-
-//	normalCycles_SortAndSetEigenComponents<PFP>(ev,evec,kmax[v],kmin[v],Kmax[v],Kmin[v],Knormal[v],normal[v]);
-//}
-
-//template <typename PFP>
-//void computeCurvatureVertices_NormalCycles_Projected(
-//	typename PFP::MAP& map,
-//	Algo::Surface::Selection::Collector<PFP>& neigh,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
-//{
-//	TraversorV<typename PFP::MAP> t(map) ;
-//	for(Vertex v = t.begin(); v != t.end(); v = t.next())
-//		computeCurvatureVertex_NormalCycles_Projected<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
-//}
-
-//template <typename PFP>
-//void computeCurvatureVertex_NormalCycles_Projected(
-//	Vertex v,
-//	Algo::Surface::Selection::Collector<PFP>& neigh,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
-//	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
-//{
-//	typedef typename PFP::REAL REAL ;
-//	typedef typename PFP::VEC3 VEC3 ;
-//	typedef Geom::Matrix<3,3,REAL> MATRIX;
-//	typedef Eigen::Matrix<REAL,3,1> E_VEC3;
-//	typedef Eigen::Matrix<REAL,3,3,Eigen::RowMajor> E_MATRIX;
-
-//	// collect the normal cycle tensor
-//	neigh.collectAll(v) ;
-
-//	MATRIX tensor(0) ;
-//	neigh.computeNormalCyclesTensor(position, edgeangle, edgearea, tensor);
-
-//	// project the tensor
-//	normalCycles_ProjectTensor<PFP>(tensor, normal[v]);
-
-//	// solve eigen problem
-//	Eigen::SelfAdjointEigenSolver<E_MATRIX> solver(Utils::convertRef<E_MATRIX>(tensor));
-//	const VEC3& ev = Utils::convertRef<VEC3>(solver.eigenvalues());
-//	const MATRIX& evec = Utils::convertRef<MATRIX>(solver.eigenvectors());
-
-//	normalCycles_SortAndSetEigenComponents<PFP>(ev,evec,kmax[v],kmin[v],Kmax[v],Kmin[v],Knormal[v],normal[v]);
-//}
+template <typename PFP>
+void computeCurvatureVertices_NormalCycles(
+	typename PFP::MAP& map,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
+{
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::computeCurvatureVertices_NormalCycles<PFP>(map, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal);
+		return;
+	}
+
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		computeCurvatureVertex_NormalCycles<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+	}
+	,FORCE_CELL_MARKING);
+}
+
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles(
+	typename PFP::MAP& /*map*/,
+	Vertex v,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
+{
+	typedef typename PFP::REAL REAL ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef Geom::Matrix<3,3,REAL> MATRIX;
+	typedef Eigen::Matrix<REAL,3,3,Eigen::RowMajor> E_MATRIX;
+
+	MATRIX tensor(0) ;
+	normalCycles_computeTensor<PFP>(neigh, v, position, edgeangle, edgearea, tensor);
+
+	// solve eigen problem
+	Eigen::SelfAdjointEigenSolver<E_MATRIX> solver(Utils::convertRef<E_MATRIX>(tensor));
+	const VEC3& ev = Utils::convertRef<VEC3>(solver.eigenvalues());
+	const MATRIX& evec = Utils::convertRef<MATRIX>(solver.eigenvectors());
+
+	normalCycles_SortAndSetEigenComponents<PFP>(ev,evec,kmax[v],kmin[v],Kmax[v],Kmin[v],Knormal[v],normal[v]);
+}
+
+template <typename PFP>
+void computeCurvatureVertices_NormalCycles_Projected(
+	typename PFP::MAP& map,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
+{
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		Parallel::computeCurvatureVertices_NormalCycles_Projected<PFP>(map, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal);
+		return;
+	}
+
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		computeCurvatureVertex_NormalCycles_Projected<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+	}
+	,FORCE_CELL_MARKING);
+}
+
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles_Projected(
+	typename PFP::MAP& /*map*/,
+	Vertex v,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
+{
+	typedef typename PFP::REAL REAL ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef Geom::Matrix<3,3,REAL> MATRIX;
+	typedef Eigen::Matrix<REAL,3,3,Eigen::RowMajor> E_MATRIX;
+
+	MATRIX tensor(0) ;
+	normalCycles_computeTensor<PFP>(neigh, v, position, edgeangle, edgearea, tensor);
+
+	// project the tensor
+	normalCycles_ProjectTensor<PFP>(tensor, normal[v]);
+
+	// solve eigen problem
+	Eigen::SelfAdjointEigenSolver<E_MATRIX> solver(Utils::convertRef<E_MATRIX>(tensor));
+	const VEC3& ev = Utils::convertRef<VEC3>(solver.eigenvalues());
+	const MATRIX& evec = Utils::convertRef<MATRIX>(solver.eigenvectors());
+
+	normalCycles_SortAndSetEigenComponents<PFP>(ev,evec,kmax[v],kmin[v],Kmax[v],Kmin[v],Knormal[v],normal[v]);
+}
 
 template <typename PFP>
 void normalCycles_computeTensor(
@@ -618,6 +755,36 @@ void normalCycles_computeTensor(
 	tensor /= col.computeArea(position, edgearea);
 }
 
+template <typename PFP>
+void normalCycles_computeTensor(
+	const Algo::Surface::Selection::NeighborhoodCache<PFP>& neigh,
+	Vertex v,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	Geom::Matrix<3,3,typename PFP::REAL>& tensor)
+{
+	tensor.zero();
+
+	// edges inside the neighborhood
+	for (Edge e : neigh.getInsideEdges(v))
+	{
+		typename PFP::VEC3 ev = Algo::Geometry::vectorOutOfDart<PFP>(neigh.getMap(), e, position);
+		tensor += Geom::transposed_vectors_mult(ev,ev) * edgeangle[e] * (1.0f / ev.norm());
+	}
+
+	// edges on the border
+	const std::vector<Dart>& border = neigh.getBorder(v);
+	const std::vector<typename PFP::REAL>& ratios = neigh.getBorderRatios(v);
+	for (unsigned int i = 0; i < border.size(); ++i)
+	{
+		typename PFP::VEC3 ev = Algo::Geometry::vectorOutOfDart<PFP>(neigh.getMap(), border[i], position);
+		tensor += Geom::transposed_vectors_mult(ev,ev) * edgeangle[border[i]] * (1.0f / ev.norm()) * ratios[i];
+	}
+
+	tensor /= neigh.computeArea(v, edgearea);
+}
+
 template <typename PFP>
 void normalCycles_SortAndSetEigenComponents(
 	const typename PFP::VEC3& e_val,
@@ -702,21 +869,38 @@ void normalCycles_ProjectTensor(Geom::Matrix<3,3,typename PFP::REAL>& tensor, co
 namespace Parallel
 {
 
-//template <typename PFP>
-//void computeCurvatureVertices_QuadraticFitting(
-//	typename PFP::MAP& map,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
-//	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
-//	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
-//	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin)
-//{
-//	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
-//	{
-//		computeCurvatureVertex_QuadraticFitting<PFP>(map, v, position, normal, kmax, kmin, Kmax, Kmin) ;
-//	}, FORCE_CELL_MARKING);
-//}
+template <typename PFP>
+void computeCurvatureVertices_QuadraticFitting(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin)
+{
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
+	{
+		computeCurvatureVertex_QuadraticFitting<PFP>(map, v, position, normal, kmax, kmin, Kmax, Kmin) ;
+	}, FORCE_CELL_MARKING);
+}
+
+template <typename PFP>
+void computeCurvatureVertices_QuadraticFitting(
+	typename PFP::MAP& map,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin)
+{
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
+	{
+		computeCurvatureVertex_QuadraticFitting<PFP>(map, v, neigh, position, normal, kmax, kmin, Kmax, Kmin) ;
+	}, FORCE_CELL_MARKING);
+}
 
 template <typename PFP>
 void computeCurvatureVertices_NormalCycles(
@@ -742,9 +926,36 @@ void computeCurvatureVertices_NormalCycles(
 	if (!map.template isOrbitEmbedded<FACE>())
 		Algo::Topo::initAllOrbitsEmbedding<FACE>(map);
 
+	// one collector per thread, reused from vertex to vertex
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads ;
+	std::vector< Selection::Collector_WithinSphere<PFP> > collectors ;
+	collectors.reserve(std::max(nbth, 2u)) ;
+	for (unsigned int i = 0; i < std::max(nbth, 2u); ++i)
+		collectors.emplace_back(map, position, radius) ;
+
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int thr)
+	{
+		computeCurvatureVertex_NormalCycles<PFP>(map, v, collectors[thr], position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+	}, FORCE_CELL_MARKING, nbth);
+}
+
+template <typename PFP>
+void computeCurvatureVertices_NormalCycles(
+	typename PFP::MAP& map,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
+{
 	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
 	{
-		computeCurvatureVertex_NormalCycles<PFP>(map, v, radius, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+		computeCurvatureVertex_NormalCycles<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
 	}, FORCE_CELL_MARKING);
 }
 
@@ -772,9 +983,36 @@ void computeCurvatureVertices_NormalCycles_Projected(
 	if (!map.template isOrbitEmbedded<FACE>())
 		Algo::Topo::initAllOrbitsEmbedding<FACE>(map);
 
+	// one collector per thread, reused from vertex to vertex
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads ;
+	std::vector< Selection::Collector_WithinSphere<PFP> > collectors ;
+	collectors.reserve(std::max(nbth, 2u)) ;
+	for (unsigned int i = 0; i < std::max(nbth, 2u); ++i)
+		collectors.emplace_back(map, position, radius) ;
+
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int thr)
+	{
+		computeCurvatureVertex_NormalCycles_Projected<PFP>(map, v, collectors[thr], position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+	}, FORCE_CELL_MARKING, nbth);
+}
+
+template <typename PFP>
+void computeCurvatureVertices_NormalCycles_Projected(
+	typename PFP::MAP& map,
+	const Selection::NeighborhoodCache<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
+{
 	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
 	{
-		computeCurvatureVertex_NormalCycles_Projected<PFP>(map, v, radius, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+		computeCurvatureVertex_NormalCycles_Projected<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
 	}, FORCE_CELL_MARKING);
 }
 
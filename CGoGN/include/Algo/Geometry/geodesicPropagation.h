@@ -0,0 +1,177 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __GEODESIC_PROPAGATION_H__
+#define __GEODESIC_PROPAGATION_H__
+
+#include <vector>
+#include <functional>
+
+#include "Topology/generic/traversor/traversor2.h"
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/parallelLoop.h"
+#include "Utils/indexedHeap.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+/**
+ * Multi-source shortest paths on the graph of the vertices/edges of a surface.
+ * The graph is stored once in compact arrays (vertices are numbered from 0 to
+ * getNbVertices()-1), so that propagations do not traverse the map:
+ * - propagate: all seeds at once (Voronoi regions), with an indexed heap or
+ *   in parallel with buckets of width delta (delta-stepping);
+ * - insertSeed: add one seed to the current result, only its new region is visited;
+ * - propagateWithinRegion: distances from one vertex restricted to its region.
+ */
+template <typename PFP>
+class GeodesicPropagation
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::REAL REAL;
+
+public:
+	static const unsigned int NONE = 0xffffffff;
+
+private:
+	MAP& m_map;
+	const EdgeAttribute<REAL, MAP>& m_edgeCost;
+
+	// vertices
+	std::vector<Dart> m_vertexDart;
+	std::vector<unsigned int> m_vertexEmb;
+	std::vector<unsigned int> m_local;			// compact index of vertex embeddings
+
+	// edges: neighbours of vertex v are in [m_first[v], m_first[v+1][
+	std::vector<unsigned int> m_first;
+	std::vector<unsigned int> m_neighbour;
+	std::vector<Dart> m_neighbourDart;			// dart of the neighbour as given by Traversor2VVaE
+	std::vector<REAL> m_cost;
+
+	// results
+	std::vector<REAL> m_distance;
+	std::vector<unsigned int> m_region;
+	std::vector<unsigned int> m_pred;			// edge (slot) of the shortest path ending in v, NONE for seeds
+	unsigned int m_last;						// last vertex reached by propagate (farthest one)
+
+	Utils::IndexedHeap<REAL> m_front;
+	Utils::IndexedHeap<REAL, std::greater<REAL> > m_farthest;
+	bool m_farthestValid;
+
+	std::vector<unsigned int> m_touched;
+	std::vector<unsigned int> m_stamp;
+	unsigned int m_currentStamp;
+
+	void initPropagation(const std::vector<Dart>& seeds);
+
+	void propagateSequential();
+
+	void propagateParallel(REAL delta, unsigned int nbth);
+
+public:
+	GeodesicPropagation(MAP& map, const EdgeAttribute<REAL, MAP>& edgeCost);
+
+	/**
+	 * (re)build the graph from the map and the edge costs
+	 * (to call after a change of the topology or of the costs)
+	 */
+	void update();
+
+	unsigned int getNbVertices() const { return (unsigned int)(m_vertexDart.size()); }
+
+	Dart vertexDart(unsigned int v) const { return m_vertexDart[v]; }
+
+	unsigned int vertexEmbedding(unsigned int v) const { return m_vertexEmb[v]; }
+
+	unsigned int vertexIndex(Dart d) const { return m_local[m_map.template getEmbedding<VERTEX>(d)]; }
+
+	/**
+	 * compute distances and regions from all seeds (region of seeds[i] is i)
+	 * @param seeds the seeds
+	 * @param nbth number of threads (propagation by buckets if > 1)
+	 * @param delta width of buckets (0 for the mean cost of edges)
+	 */
+	void propagate(const std::vector<Dart>& seeds, unsigned int nbth = CGoGN::Parallel::NumberOfThreads, REAL delta = 0);
+
+	/**
+	 * add a seed to the result of propagate: only the vertices that are closer to
+	 * the new seed are visited (they are then given by getTouched)
+	 * @param v vertex index of the seed
+	 * @param region region number of the seed
+	 */
+	void insertSeed(unsigned int v, unsigned int region);
+
+	/**
+	 * recompute distances from v of the vertices of the region of v, with paths inside
+	 * the region (v becomes the root of the region, visited vertices are given by getTouched)
+	 */
+	void propagateWithinRegion(unsigned int v);
+
+	/// vertices visited by the last insertSeed / propagateWithinRegion
+	const std::vector<unsigned int>& getTouched() const { return m_touched; }
+
+	bool isReached(unsigned int v) const { return m_region[v] != NONE; }
+
+	REAL distance(unsigned int v) const { return m_distance[v]; }
+
+	unsigned int region(unsigned int v) const { return m_region[v]; }
+
+	/**
+	 * previous vertex on the shortest path as a dart of the edge (phi2 of the dart of v),
+	 * the dart of v for a seed
+	 */
+	Dart pathOrigin(unsigned int v) const;
+
+	/// last vertex reached by propagate
+	unsigned int lastVertex() const { return m_last; }
+
+	/// vertex with the maximal distance (maintained through insertSeed)
+	unsigned int farthestVertex();
+
+	/**
+	 * edges between two regions, as one dart per edge (dart of the vertex reached first)
+	 */
+	void getBorder(std::vector<Dart>& border) const;
+};
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Geometry/geodesicPropagation.hpp"
+
+#endif
@@ -0,0 +1,391 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <atomic>
+#include <limits>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+template <typename PFP>
+const unsigned int GeodesicPropagation<PFP>::NONE;
+
+template <typename PFP>
+GeodesicPropagation<PFP>::GeodesicPropagation(MAP& map, const EdgeAttribute<REAL, MAP>& edgeCost) :
+	m_map(map),
+	m_edgeCost(edgeCost),
+	m_last(NONE),
+	m_farthestValid(false),
+	m_currentStamp(0)
+{
+}
+
+template <typename PFP>
+void GeodesicPropagation<PFP>::update()
+{
+	m_vertexDart.clear();
+	m_vertexEmb.clear();
+	m_local.assign(m_map.template getAttributeContainer<VERTEX>().end(), NONE);
+
+	TraversorV<MAP> tv(m_map);
+	for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+	{
+		unsigned int emb = m_map.template getEmbedding<VERTEX>(d);
+		m_local[emb] = (unsigned int)(m_vertexDart.size());
+		m_vertexDart.push_back(d);
+		m_vertexEmb.push_back(emb);
+	}
+
+	unsigned int nbv = getNbVertices();
+	m_first.resize(nbv + 1);
+	m_neighbour.clear();
+	m_neighbourDart.clear();
+	m_cost.clear();
+	for (unsigned int v = 0; v < nbv; ++v)
+	{
+		m_first[v] = (unsigned int)(m_neighbour.size());
+		Traversor2VVaE<MAP> tn(m_map, m_vertexDart[v]);
+		for (Dart f = tn.begin(); f != tn.end(); f = tn.next())
+		{
+			m_neighbour.push_back(m_local[m_map.template getEmbedding<VERTEX>(f)]);
+			m_neighbourDart.push_back(f);
+			m_cost.push_back(m_edgeCost[f]);
+		}
+	}
+	m_first[nbv] = (unsigned int)(m_neighbour.size());
+
+	m_distance.assign(nbv, std::numeric_limits<REAL>::max());
+	m_region.assign(nbv, NONE);
+	m_pred.assign(nbv, NONE);
+	m_stamp.assign(nbv, 0);
+	m_currentStamp = 0;
+	m_front.init(nbv);
+	m_farthestValid = false;
+	m_last = NONE;
+}
+
+template <typename PFP>
+void GeodesicPropagation<PFP>::initPropagation(const std::vector<Dart>& seeds)
+{
+	unsigned int nbv = getNbVertices();
+	m_distance.assign(nbv, std::numeric_limits<REAL>::max());
+	m_region.assign(nbv, NONE);
+	m_pred.assign(nbv, NONE);
+	m_front.clear();
+	m_farthestValid = false;
+	m_last = NONE;
+
+	// seeds are stored in m_touched
+	m_touched.clear();
+	for (unsigned int i = 0; i < seeds.size(); ++i)
+	{
+		unsigned int v = vertexIndex(seeds[i]);
+		m_distance[v] = 0;
+		m_region[v] = i;
+		m_touched.push_back(v);
+	}
+}
+
+template <typename PFP>
+void GeodesicPropagation<PFP>::propagate(const std::vector<Dart>& seeds, unsigned int nbth, REAL delta)
+{
+	initPropagation(seeds);
+
+	if (delta <= 0 && !m_cost.empty())
+	{
+		double sum = 0.0;
+		for (unsigned int s = 0; s < m_cost.size(); ++s)
+			sum += m_cost[s];
+		delta = REAL(sum / m_cost.size());
+	}
+
+	if (nbth > 1 && delta > 0 && getNbVertices() > CGoGN::Parallel::SIZE_BUFFER_THREAD)
+		propagateParallel(delta, nbth);
+	else
+		propagateSequential();
+
+	m_touched.clear();
+}
+
+template <typename PFP>
+void GeodesicPropagation<PFP>::propagateSequential()
+{
+	for (unsigned int i = 0; i < m_touched.size(); ++i)
+		m_front.set(m_touched[i], 0);
+
+	while (!m_front.empty())
+	{
+		unsigned int v = m_front.pop();
+		m_last = v;
+		REAL dv = m_distance[v];
+		for (unsigned int s = m_first[v]; s < m_first[v+1]; ++s)
+		{
+			unsigned int u = m_neighbour[s];
+			REAL d = dv + m_cost[s];
+			if (d < m_distance[u])
+			{
+				m_distance[u] = d;
+				m_region[u] = m_region[v];
+				m_pred[u] = s;
+				m_front.set(u, d);
+			}
+		}
+	}
+}
+
+template <typename PFP>
+void GeodesicPropagation<PFP>::propagateParallel(REAL delta, unsigned int nbth)
+{
+	typedef std::pair<unsigned int, REAL> Entry;
+	unsigned int nbv = getNbVertices();
+
+	// one lock per vertex for its distance, region and predecessor
+	std::vector< std::atomic<bool> > locks(nbv);
+	for (unsigned int v = 0; v < nbv; ++v)
+		locks[v].store(false, std::memory_order_relaxed);
+	auto lock = [&] (unsigned int v) { while (locks[v].exchange(true, std::memory_order_acquire)) {} };
+	auto unlock = [&] (unsigned int v) { locks[v].store(false, std::memory_order_release); };
+
+	// vertices of bucket b have a distance in [b*delta, (b+1)*delta[
+	// a vertex may be in several buckets, only the entry of its last distance is valid
+	std::vector< std::vector<Entry> > buckets(1);
+	for (unsigned int i = 0; i < m_touched.size(); ++i)
+		buckets[0].push_back(Entry(m_touched[i], 0));
+
+	std::vector< std::vector<Entry> > current(nbth);
+	std::vector< std::vector<Entry> > later(nbth);
+
+	for (unsigned int b = 0; b < buckets.size(); ++b)
+	{
+		std::vector<Entry> frontier;
+		frontier.swap(buckets[b]);
+
+		// relax the bucket until no more distance falls into it
+		while (!frontier.empty())
+		{
+			CGoGN::Parallel::foreach_index(0, (unsigned int)(frontier.size()), [&] (unsigned int i, unsigned int th)
+			{
+				unsigned int v = frontier[i].first;
+				REAL dv = frontier[i].second;
+
+				lock(v);
+				bool valid = (m_distance[v] == dv);
+				unsigned int rv = m_region[v];
+				unlock(v);
+				if (!valid)
+					return;
+
+				for (unsigned int s = m_first[v]; s < m_first[v+1]; ++s)
+				{
+					unsigned int u = m_neighbour[s];
+					REAL d = dv + m_cost[s];
+					lock(u);
+					bool closer = d < m_distance[u];
+					if (closer)
+					{
+						m_distance[u] = d;
+						m_region[u] = rv;
+						m_pred[u] = s;
+					}
+					unlock(u);
+					if (closer)
+					{
+						if ((unsigned int)(d / delta) <= b)
+							current[th].push_back(Entry(u, d));
+						else
+							later[th].push_back(Entry(u, d));
+					}
+				}
+			}, nbth);
+
+			frontier.clear();
+			for (unsigned int t = 0; t < nbth; ++t)
+			{
+				frontier.insert(frontier.end(), current[t].begin(), current[t].end());
+				current[t].clear();
+				for (unsigned int i = 0; i < later[t].size(); ++i)
+				{
+					unsigned int bu = (unsigned int)(later[t][i].second / delta);
+					if (bu >= buckets.size())
+						buckets.resize(bu + 1);
+					buckets[bu].push_back(later[t][i]);
+				}
+				later[t].clear();
+			}
+		}
+	}
+
+	// farthest vertex
+	REAL dmax = -1;
+	for (unsigned int v = 0; v < nbv; ++v)
+	{
+		if (m_region[v] != NONE && m_distance[v] > dmax)
+		{
+			dmax = m_distance[v];
+			m_last = v;
+		}
+	}
+}
+
+template <typename PFP>
+void GeodesicPropagation<PFP>::insertSeed(unsigned int v, unsigned int region)
+{
+	m_touched.clear();
+	m_front.clear();
+
+	m_distance[v] = 0;
+	m_region[v] = region;
+	m_pred[v] = NONE;
+	m_front.set(v, 0);
+
+	// only vertices that get closer to the new seed are visited
+	while (!m_front.empty())
+	{
+		unsigned int x = m_front.pop();
+		m_touched.push_back(x);
+		REAL dx = m_distance[x];
+		for (unsigned int s = m_first[x]; s < m_first[x+1]; ++s)
+		{
+			unsigned int u = m_neighbour[s];
+			REAL d = dx + m_cost[s];
+			if (d < m_distance[u])
+			{
+				m_distance[u] = d;
+				m_region[u] = region;
+				m_pred[u] = s;
+				m_front.set(u, d);
+			}
+		}
+	}
+
+	if (m_farthestValid)
+	{
+		for (unsigned int i = 0; i < m_touched.size(); ++i)
+			m_farthest.set(m_touched[i], m_distance[m_touched[i]]);
+	}
+}
+
+template <typename PFP>
+void GeodesicPropagation<PFP>::propagateWithinRegion(unsigned int v)
+{
+	// stamps tell which vertices have been reached by this propagation
+	if (++m_currentStamp == 0)
+	{
+		m_stamp.assign(getNbVertices(), 0);
+		m_currentStamp = 1;
+	}
+
+	unsigned int r = m_region[v];
+	m_touched.clear();
+	m_front.clear();
+
+	m_stamp[v] = m_currentStamp;
+	m_distance[v] = 0;
+	m_pred[v] = NONE;
+	m_front.set(v, 0);
+
+	while (!m_front.empty())
+	{
+		unsigned int x = m_front.pop();
+		m_touched.push_back(x);
+		REAL dx = m_distance[x];
+		for (unsigned int s = m_first[x]; s < m_first[x+1]; ++s)
+		{
+			unsigned int u = m_neighbour[s];
+			if (m_region[u] != r)
+				continue;
+			REAL d = dx + m_cost[s];
+			if (m_stamp[u] != m_currentStamp || d < m_distance[u])
+			{
+				m_stamp[u] = m_currentStamp;
+				m_distance[u] = d;
+				m_pred[u] = s;
+				m_front.set(u, d);
+			}
+		}
+	}
+
+	m_farthestValid = false;
+}
+
+template <typename PFP>
+Dart GeodesicPropagation<PFP>::pathOrigin(unsigned int v) const
+{
+	if (m_pred[v] == NONE)
+		return m_vertexDart[v];
+	return m_map.phi2(m_neighbourDart[m_pred[v]]);
+}
+
+template <typename PFP>
+unsigned int GeodesicPropagation<PFP>::farthestVertex()
+{
+	if (!m_farthestValid)
+	{
+		m_farthest.init(getNbVertices());
+		for (unsigned int v = 0; v < getNbVertices(); ++v)
+			if (m_region[v] != NONE)
+				m_farthest.set(v, m_distance[v]);
+		m_farthestValid = true;
+	}
+	if (m_farthest.empty())
+		return NONE;
+	return m_farthest.top();
+}
+
+template <typename PFP>
+void GeodesicPropagation<PFP>::getBorder(std::vector<Dart>& border) const
+{
+	border.clear();
+	for (unsigned int v = 0; v < getNbVertices(); ++v)
+	{
+		if (m_region[v] == NONE)
+			continue;
+		for (unsigned int s = m_first[v]; s < m_first[v+1]; ++s)
+		{
+			unsigned int u = m_neighbour[s];
+			if (m_region[u] == NONE || m_region[u] == m_region[v])
+				continue;
+			// each edge is given once, from the vertex reached last
+			if (m_distance[u] < m_distance[v] || (m_distance[u] == m_distance[v] && u < v))
+				border.push_back(m_neighbourDart[s]);
+		}
+	}
+}
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
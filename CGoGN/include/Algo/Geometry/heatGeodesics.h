@@ -0,0 +1,138 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __ALGO_GEOMETRY_HEAT_GEODESICS_H__
+#define __ALGO_GEOMETRY_HEAT_GEODESICS_H__
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+#include "Geometry/vector_gen.h"
+#include "Topology/generic/parallelLoop.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+/**
+ * Geodesic distances on a triangle mesh by the heat method (Crane et al. 2013):
+ * - heat diffusion from the sources during a time t: (M + t L) u = delta
+ * - normalized opposite gradient of the heat on each face: X = -grad(u) / |grad(u)|
+ * - distance as the solution of the Poisson equation: L phi = div(X)
+ * where L is the cotan Laplacian (weights of computeCotanWeightEdges) and M the
+ * lumped (barycentric) mass matrix.
+ * Both systems are factorized once by factorize, each query then costs two
+ * back-substitutions and a parallel gradient/divergence pass.
+ * The map topology must not change (build a new solver otherwise).
+ */
+template <typename PFP>
+class HeatGeodesics
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	typedef Eigen::SparseMatrix<double, Eigen::ColMajor> ColMatrix ;
+
+protected:
+	MAP& m_map ;
+	VertexAttribute<unsigned int, MAP> m_index ;
+	unsigned int m_nbThreads ;
+
+	// a dart of each vertex (by index)
+	std::vector<Dart> m_vertices ;
+
+	// vertices of triangles, and triangles around each vertex
+	std::vector<unsigned int> m_triangles ;
+	std::vector<unsigned int> m_vertexTrianglesFirst ;
+	std::vector<unsigned int> m_vertexTriangles ;
+
+	// positions copied at factorization
+	std::vector<Geom::Vec3d> m_points ;
+
+	ColMatrix m_laplacian ;
+	std::vector<double> m_mass ;
+	double m_timeStep ;
+
+	Eigen::SimplicialLDLT<ColMatrix> m_heatSolver ;
+	Eigen::SimplicialLDLT<ColMatrix> m_poissonSolver ;
+	bool m_factorized ;
+
+	void assemble(const EdgeAttribute<REAL, MAP>& edgeWeight) ;
+
+	/**
+	 * gradients of the 3 hat functions of triangle t, and its area
+	 */
+	void gradientBasis(unsigned int t, Geom::Vec3d* g, double& area) const ;
+
+public:
+	/**
+	 * @param index vertex indices in [0,nbVertices[ (computeIndexCells<VERTEX>)
+	 */
+	HeatGeodesics(MAP& map, const VertexAttribute<unsigned int, MAP>& index, unsigned int nbVertices, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+	/**
+	 * build and factorize the heat and Poisson systems
+	 * @param position vertex positions
+	 * @param edgeWeight cotan weights (computeCotanWeightEdges)
+	 * @param timeFactor time step of diffusion = timeFactor * (mean edge length)^2
+	 * (increased on large meshes to keep the heat in the range of doubles)
+	 * @return false if a system could not be factorized
+	 */
+	bool factorize(const VertexAttribute<VEC3, MAP>& position, const EdgeAttribute<REAL, MAP>& edgeWeight, REAL timeFactor = 1) ;
+
+	bool isFactorized() const { return m_factorized ; }
+
+	/**
+	 * distance of all vertices to a set of source vertices
+	 * @return false if not factorized
+	 */
+	bool computeDistances(const std::vector<Dart>& sources, VertexAttribute<REAL, MAP>& distance) ;
+
+	bool computeDistances(Dart source, VertexAttribute<REAL, MAP>& distance)
+	{
+		return computeDistances(std::vector<Dart>(1, source), distance) ;
+	}
+} ;
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Geometry/heatGeodesics.hpp"
+
+#endif
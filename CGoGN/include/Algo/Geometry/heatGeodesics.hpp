@@ -0,0 +1,330 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Topology/generic/traversor/traversorCell.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+template <typename PFP>
+HeatGeodesics<PFP>::HeatGeodesics(MAP& map, const VertexAttribute<unsigned int, MAP>& index, unsigned int nbVertices, unsigned int nbth) :
+	m_map(map),
+	m_index(index),
+	m_nbThreads(nbth),
+	m_vertices(nbVertices),
+	m_timeStep(0),
+	m_factorized(false)
+{
+	foreach_cell<VERTEX>(m_map, [&] (Vertex v)
+	{
+		m_vertices[m_index[v]] = v.dart ;
+	});
+
+	foreach_cell<FACE>(m_map, [&] (Face f)
+	{
+		assert(m_map.phi1(m_map.phi1(m_map.phi1(f.dart))) == f.dart || !"HeatGeodesics: triangle meshes only") ;
+		m_triangles.push_back(m_index[f.dart]) ;
+		m_triangles.push_back(m_index[m_map.phi1(f.dart)]) ;
+		m_triangles.push_back(m_index[m_map.phi_1(f.dart)]) ;
+	});
+
+	// triangles around each vertex
+	const unsigned int nbT = (unsigned int)(m_triangles.size() / 3) ;
+	m_vertexTrianglesFirst.assign(nbVertices + 1, 0) ;
+	for (unsigned int i = 0; i < 3 * nbT; ++i)
+		++m_vertexTrianglesFirst[m_triangles[i] + 1] ;
+	for (unsigned int v = 0; v < nbVertices; ++v)
+		m_vertexTrianglesFirst[v+1] += m_vertexTrianglesFirst[v] ;
+	m_vertexTriangles.resize(3 * nbT) ;
+	std::vector<unsigned int> pos(m_vertexTrianglesFirst.begin(), m_vertexTrianglesFirst.end() - 1) ;
+	for (unsigned int i = 0; i < 3 * nbT; ++i)
+		m_vertexTriangles[pos[m_triangles[i]]++] = i / 3 ;
+}
+
+template <typename PFP>
+void HeatGeodesics<PFP>::assemble(const EdgeAttribute<REAL, MAP>& edgeWeight)
+{
+	const unsigned int nbV = (unsigned int)(m_vertices.size()) ;
+
+	// buffer of (degree + 1) entries for each row
+	std::vector<int> first(nbV + 1) ;
+	first[0] = 0 ;
+	for (unsigned int v = 0; v < nbV; ++v)
+	{
+		unsigned int deg = 1 ;
+		Dart d = m_vertices[v] ;
+		Dart it = d ;
+		do
+		{
+			++deg ;
+			it = m_map.phi2(m_map.phi_1(it)) ;
+		} while (it != d) ;
+		first[v+1] = first[v] + deg ;
+	}
+
+	std::vector<int> cols(first[nbV]) ;
+	std::vector<double> vals(first[nbV]) ;
+	std::vector<int> sizes(nbV + 1) ;
+
+	// positive semi-definite cotan matrix: L(i,j) = -w(ij), L(i,i) = sum of w(ij)
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		int* c = &cols[first[v]] ;
+		double* a = &vals[first[v]] ;
+		unsigned int k = 0 ;
+
+		double aii = 0 ;
+		Dart d = m_vertices[v] ;
+		Dart it = d ;
+		do
+		{
+			double w = double(edgeWeight[it]) ;
+			aii += w ;
+			c[k] = int(m_index[m_map.phi1(it)]) ;
+			a[k] = -w ;
+			++k ;
+			it = m_map.phi2(m_map.phi_1(it)) ;
+		} while (it != d) ;
+		c[k] = int(v) ;
+		a[k] = aii ;
+		++k ;
+
+		// sort the (few) entries of the row by column and merge multiple edges
+		for (unsigned int i = 1; i < k; ++i)
+		{
+			for (unsigned int j = i; j > 0 && c[j] < c[j-1]; --j)
+			{
+				std::swap(c[j], c[j-1]) ;
+				std::swap(a[j], a[j-1]) ;
+			}
+		}
+		unsigned int nb = 0 ;
+		for (unsigned int i = 0; i < k; ++i)
+		{
+			if (nb > 0 && c[nb-1] == c[i])
+				a[nb-1] += a[i] ;
+			else
+			{
+				c[nb] = c[i] ;
+				a[nb] = a[i] ;
+				++nb ;
+			}
+		}
+		sizes[v] = int(nb) ;
+	}, m_nbThreads) ;
+
+	// compact the rows
+	std::vector<int> outer(nbV + 1) ;
+	outer[0] = 0 ;
+	for (unsigned int v = 0; v < nbV; ++v)
+		outer[v+1] = outer[v] + sizes[v] ;
+
+	std::vector<int> inner(outer[nbV]) ;
+	std::vector<double> values(outer[nbV]) ;
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		std::copy(cols.begin() + first[v], cols.begin() + first[v] + sizes[v], inner.begin() + outer[v]) ;
+		std::copy(vals.begin() + first[v], vals.begin() + first[v] + sizes[v], values.begin() + outer[v]) ;
+	}, m_nbThreads) ;
+
+	// the matrix is symmetric: rows can be read as columns
+	m_laplacian = Eigen::MappedSparseMatrix<double, Eigen::ColMajor>(nbV, nbV, outer[nbV], &outer[0], &inner[0], &values[0]) ;
+
+	// lumped mass: a third of the area of the triangles around each vertex
+	m_mass.resize(nbV) ;
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		double m = 0 ;
+		for (unsigned int i = m_vertexTrianglesFirst[v]; i < m_vertexTrianglesFirst[v+1]; ++i)
+		{
+			Geom::Vec3d g[3] ;
+			double area ;
+			gradientBasis(m_vertexTriangles[i], g, area) ;
+			m += area / 3.0 ;
+		}
+		m_mass[v] = m ;
+	}, m_nbThreads) ;
+}
+
+template <typename PFP>
+void HeatGeodesics<PFP>::gradientBasis(unsigned int t, Geom::Vec3d* g, double& area) const
+{
+	const Geom::Vec3d& p0 = m_points[m_triangles[3*t]] ;
+	const Geom::Vec3d& p1 = m_points[m_triangles[3*t+1]] ;
+	const Geom::Vec3d& p2 = m_points[m_triangles[3*t+2]] ;
+
+	Geom::Vec3d n = (p1 - p0) ^ (p2 - p0) ;
+	double n2 = n.norm2() ;
+	area = 0.5 * std::sqrt(n2) ;
+	if (n2 == 0)
+	{
+		g[0] = g[1] = g[2] = Geom::Vec3d(0, 0, 0) ;
+		return ;
+	}
+
+	// grad of hat function i = N ^ (opposite edge) / 2A = n ^ e / |n|^2
+	g[0] = (n ^ (p2 - p1)) / n2 ;
+	g[1] = (n ^ (p0 - p2)) / n2 ;
+	g[2] = (n ^ (p1 - p0)) / n2 ;
+}
+
+template <typename PFP>
+bool HeatGeodesics<PFP>::factorize(const VertexAttribute<VEC3, MAP>& position, const EdgeAttribute<REAL, MAP>& edgeWeight, REAL timeFactor)
+{
+	const unsigned int nbV = (unsigned int)(m_vertices.size()) ;
+	const unsigned int nbT = (unsigned int)(m_triangles.size() / 3) ;
+
+	m_points.resize(nbV) ;
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		const VEC3& p = position[m_vertices[v]] ;
+		m_points[v] = Geom::Vec3d(p[0], p[1], p[2]) ;
+	}, m_nbThreads) ;
+
+	assemble(edgeWeight) ;
+
+	// time step from the mean edge length
+	double h = 0 ;
+	for (unsigned int t = 0; t < nbT; ++t)
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+			h += (m_points[m_triangles[3*t + (i+1)%3]] - m_points[m_triangles[3*t + i]]).norm() ;
+	}
+	h = nbT > 0 ? h / (3 * nbT) : 1.0 ;
+	m_timeStep = double(timeFactor) * h * h ;
+
+	// the heat decreases exponentially with distance/sqrt(t): on large meshes, t is
+	// increased so that it stays in the range of doubles (diagonal/sqrt(t) <= 300)
+	Geom::Vec3d bbMin(std::numeric_limits<double>::max()) ;
+	Geom::Vec3d bbMax(-std::numeric_limits<double>::max()) ;
+	for (unsigned int v = 0; v < nbV; ++v)
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			bbMin[i] = std::min(bbMin[i], m_points[v][i]) ;
+			bbMax[i] = std::max(bbMax[i], m_points[v][i]) ;
+		}
+	}
+	if (nbV > 0)
+	{
+		double sqrtT = (bbMax - bbMin).norm() / 300.0 ;
+		m_timeStep = std::max(m_timeStep, sqrtT * sqrtT) ;
+	}
+
+	// heat system: M + t L
+	ColMatrix heat = m_timeStep * m_laplacian ;
+	for (unsigned int v = 0; v < nbV; ++v)
+		heat.coeffRef(v, v) += m_mass[v] ;
+
+	// Poisson system: L (+ a tiny mass term that removes the constant kernel)
+	ColMatrix poisson = m_laplacian ;
+	for (unsigned int v = 0; v < nbV; ++v)
+		poisson.coeffRef(v, v) += 1e-8 * m_mass[v] / (h * h) ;
+
+	m_heatSolver.compute(heat) ;
+	m_poissonSolver.compute(poisson) ;
+
+	m_factorized = (m_heatSolver.info() == Eigen::Success && m_poissonSolver.info() == Eigen::Success) ;
+	return m_factorized ;
+}
+
+template <typename PFP>
+bool HeatGeodesics<PFP>::computeDistances(const std::vector<Dart>& sources, VertexAttribute<REAL, MAP>& distance)
+{
+	if (!m_factorized)
+		return false ;
+
+	const unsigned int nbV = (unsigned int)(m_vertices.size()) ;
+	const unsigned int nbT = (unsigned int)(m_triangles.size() / 3) ;
+
+	// heat diffusion
+	Eigen::VectorXd delta = Eigen::VectorXd::Zero(nbV) ;
+	for (unsigned int i = 0; i < sources.size(); ++i)
+		delta[m_index[sources[i]]] = 1.0 ;
+	Eigen::VectorXd u = m_heatSolver.solve(delta) ;
+
+	// normalized opposite gradient on each triangle
+	std::vector<Geom::Vec3d> field(nbT) ;
+	CGoGN::Parallel::foreach_index(0, nbT, [&] (unsigned int t, unsigned int)
+	{
+		Geom::Vec3d g[3] ;
+		double area ;
+		gradientBasis(t, g, area) ;
+		Geom::Vec3d grad = g[0] * u[m_triangles[3*t]] + g[1] * u[m_triangles[3*t+1]] + g[2] * u[m_triangles[3*t+2]] ;
+		double n = grad.norm() ;
+		field[t] = n > 0 ? grad / (-n) : Geom::Vec3d(0, 0, 0) ;
+	}, m_nbThreads) ;
+
+	// integrated divergence at each vertex: sum on its triangles of area * (grad hat . X)
+	Eigen::VectorXd div(nbV) ;
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		double b = 0 ;
+		for (unsigned int i = m_vertexTrianglesFirst[v]; i < m_vertexTrianglesFirst[v+1]; ++i)
+		{
+			unsigned int t = m_vertexTriangles[i] ;
+			Geom::Vec3d g[3] ;
+			double area ;
+			gradientBasis(t, g, area) ;
+			unsigned int c = (m_triangles[3*t] == v) ? 0 : ((m_triangles[3*t+1] == v) ? 1 : 2) ;
+			b += area * (g[c] * field[t]) ;
+		}
+		div[v] = b ;
+	}, m_nbThreads) ;
+
+	Eigen::VectorXd phi = m_poissonSolver.solve(div) ;
+
+	// distances are defined up to a constant: 0 on sources
+	double phiMin = std::numeric_limits<double>::max() ;
+	for (unsigned int i = 0; i < sources.size(); ++i)
+		phiMin = std::min(phiMin, phi[m_index[sources[i]]]) ;
+
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		distance[m_vertices[v]] = REAL(phi[v] - phiMin) ;
+	}, m_nbThreads) ;
+
+	return true ;
+}
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
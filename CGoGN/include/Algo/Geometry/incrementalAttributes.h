@@ -0,0 +1,150 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __ALGO_GEOMETRY_INCREMENTAL_ATTRIBUTES_H__
+#define __ALGO_GEOMETRY_INCREMENTAL_ATTRIBUTES_H__
+
+#include "Topology/generic/mapListener.h"
+#include "Topology/generic/attributeHandler.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+/**
+ * Incremental maintenance of attributes derived from the vertex positions:
+ * vertex normal, face area, face centroid and edge cotan weight.
+ * Each derived attribute is optional and registered by its setter (it is then
+ * computed on the whole map). Afterwards, the cells to recompute are tracked:
+ * - position writes are declared by setPosition or positionChanged
+ * - the topological operators of EmbeddedMap2 / EmbeddedMap3 notify the
+ *   vertices whose star has been modified (see MapListener)
+ * and update recomputes only the faces incident to the dirty vertices and
+ * the edges and vertices of these faces.
+ * update must be called before compacting the map (the dirty darts would
+ * be invalidated). Other maps (GMaps) do not notify their topological
+ * modifications: call positionChanged on the modified vertices or updateAll.
+ */
+template <typename PFP>
+class IncrementalAttributes : public MapListener
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+protected:
+	MAP& m_map ;
+	VertexAttribute<VEC3, MAP>& m_position ;
+
+	VertexAttribute<VEC3, MAP> m_vertexNormal ;
+	FaceAttribute<REAL, MAP> m_faceArea ;
+	FaceAttribute<VEC3, MAP> m_faceCentroid ;
+	EdgeAttribute<REAL, MAP> m_edgeCotanWeight ;
+
+	// darts of the vertices whose star must be recomputed: all the darts of
+	// each vertex are stored, so that it is still found if some of them are
+	// deleted by a later topological operation (may contain duplicates)
+	std::vector<Dart> m_dirty ;
+
+	inline void setDirty(Vertex v)
+	{
+		m_map.foreach_dart_of_orbit(v, [&] (Dart d) { m_dirty.push_back(d) ; }) ;
+	}
+
+	inline bool isDartValid(Dart d) const
+	{
+		return m_map.template getAttributeContainer<DART>().used(m_map.dartIndex(d)) ;
+	}
+
+	void computeFace(Face f) ;
+	void computeEdge(Edge e) ;
+	void computeVertex(Vertex v) ;
+
+public:
+	IncrementalAttributes(MAP& map, VertexAttribute<VEC3, MAP>& position) ;
+
+	~IncrementalAttributes() ;
+
+	/**
+	 * register the derived attributes (computed immediately on the whole map)
+	 */
+	void setVertexNormal(const VertexAttribute<VEC3, MAP>& normal) ;
+	void setFaceArea(const FaceAttribute<REAL, MAP>& area) ;
+	void setFaceCentroid(const FaceAttribute<VEC3, MAP>& centroid) ;
+	void setEdgeCotanWeight(const EdgeAttribute<REAL, MAP>& weight) ;
+
+	/**
+	 * write the position of v and mark it dirty
+	 */
+	inline void setPosition(Vertex v, const VEC3& p)
+	{
+		m_position[v] = p ;
+		setDirty(v) ;
+	}
+
+	/**
+	 * declare that the position of v has been written
+	 */
+	inline void positionChanged(Vertex v) { setDirty(v) ; }
+
+	/**
+	 * MapListener: called by the topological operators
+	 */
+	void vertexStarChanged(Dart d) { setDirty(Vertex(d)) ; }
+
+	inline bool isDirty() const { return !m_dirty.empty() ; }
+
+	/**
+	 * recompute the derived attributes of the cells affected since last update
+	 */
+	void update() ;
+
+	/**
+	 * recompute the derived attributes on the whole map
+	 */
+	void updateAll() ;
+} ;
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Geometry/incrementalAttributes.hpp"
+
+#endif
@@ -0,0 +1,205 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Topology/generic/dartmarker.h"
+#include "Topology/generic/cellmarker.h"
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/traversor/traversor2.h"
+
+#include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/area.h"
+#include "Algo/Geometry/centroid.h"
+#include "Algo/Geometry/laplacian.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+template <typename PFP>
+IncrementalAttributes<PFP>::IncrementalAttributes(MAP& map, VertexAttribute<VEC3, MAP>& position) :
+	m_map(map),
+	m_position(position)
+{
+	m_map.addListener(this) ;
+}
+
+template <typename PFP>
+IncrementalAttributes<PFP>::~IncrementalAttributes()
+{
+	m_map.removeListener(this) ;
+}
+
+template <typename PFP>
+void IncrementalAttributes<PFP>::setVertexNormal(const VertexAttribute<VEC3, MAP>& normal)
+{
+	m_vertexNormal = normal ;
+	if (m_vertexNormal.isValid())
+		computeNormalVertices<PFP>(m_map, m_position, m_vertexNormal) ;
+}
+
+template <typename PFP>
+void IncrementalAttributes<PFP>::setFaceArea(const FaceAttribute<REAL, MAP>& area)
+{
+	m_faceArea = area ;
+	if (m_faceArea.isValid())
+		computeAreaFaces<PFP>(m_map, m_position, m_faceArea) ;
+}
+
+template <typename PFP>
+void IncrementalAttributes<PFP>::setFaceCentroid(const FaceAttribute<VEC3, MAP>& centroid)
+{
+	m_faceCentroid = centroid ;
+	if (m_faceCentroid.isValid())
+		computeCentroidFaces<PFP>(m_map, m_position, m_faceCentroid) ;
+}
+
+template <typename PFP>
+void IncrementalAttributes<PFP>::setEdgeCotanWeight(const EdgeAttribute<REAL, MAP>& weight)
+{
+	m_edgeCotanWeight = weight ;
+	if (m_edgeCotanWeight.isValid())
+		computeCotanWeightEdges<PFP>(m_map, m_position, m_edgeCotanWeight) ;
+}
+
+template <typename PFP>
+void IncrementalAttributes<PFP>::computeFace(Face f)
+{
+	if (m_faceArea.isValid())
+		m_faceArea[f] = convexFaceArea<PFP>(m_map, f, m_position) ;
+	if (m_faceCentroid.isValid())
+		m_faceCentroid[f] = faceCentroid<PFP>(m_map, f, m_position) ;
+}
+
+template <typename PFP>
+void IncrementalAttributes<PFP>::computeEdge(Edge e)
+{
+	m_edgeCotanWeight[e] = computeCotanWeightEdge<PFP>(m_map, e.dart, m_position) ;
+}
+
+template <typename PFP>
+void IncrementalAttributes<PFP>::computeVertex(Vertex v)
+{
+	m_vertexNormal[v] = vertexNormal<PFP>(m_map, v, m_position) ;
+}
+
+template <typename PFP>
+void IncrementalAttributes<PFP>::update()
+{
+	if (m_dirty.empty())
+		return ;
+
+	// faces incident to the dirty vertices (deleted darts are skipped)
+	std::vector<Face> faces ;
+	faces.reserve(m_dirty.size()) ;
+	{
+		DartMarkerStore<MAP> mf(m_map) ;
+		CellMarkerStore<MAP, VERTEX> mv(m_map) ;
+		for (std::vector<Dart>::const_iterator it = m_dirty.begin(); it != m_dirty.end(); ++it)
+		{
+			if (!isDartValid(*it) || mv.isMarked(*it))
+				continue ;
+			mv.mark(*it) ;
+			foreach_incident2<FACE>(m_map, Vertex(*it), [&] (Face f)
+			{
+				if (!mf.isMarked(f.dart))
+				{
+					mf.markOrbit(f) ;
+					faces.push_back(f) ;
+				}
+			});
+		}
+	}
+	m_dirty.clear() ;
+
+	if (m_faceArea.isValid() || m_faceCentroid.isValid())
+	{
+		for (typename std::vector<Face>::const_iterator it = faces.begin(); it != faces.end(); ++it)
+			computeFace(*it) ;
+	}
+
+	// the cotan weight of an edge depends on the vertices of its incident faces
+	if (m_edgeCotanWeight.isValid())
+	{
+		DartMarkerStore<MAP> me(m_map) ;
+		for (typename std::vector<Face>::const_iterator it = faces.begin(); it != faces.end(); ++it)
+		{
+			foreach_incident2<EDGE>(m_map, *it, [&] (Edge e)
+			{
+				if (!me.isMarked(e.dart))
+				{
+					me.markOrbit(e) ;
+					computeEdge(e) ;
+				}
+			});
+		}
+	}
+
+	// the normal of a vertex depends on the vertices of its incident faces
+	if (m_vertexNormal.isValid())
+	{
+		CellMarkerStore<MAP, VERTEX> mv(m_map) ;
+		for (typename std::vector<Face>::const_iterator it = faces.begin(); it != faces.end(); ++it)
+		{
+			foreach_incident2<VERTEX>(m_map, *it, [&] (Vertex v)
+			{
+				if (!mv.isMarked(v))
+				{
+					mv.mark(v) ;
+					computeVertex(v) ;
+				}
+			});
+		}
+	}
+}
+
+template <typename PFP>
+void IncrementalAttributes<PFP>::updateAll()
+{
+	m_dirty.clear() ;
+
+	if (m_vertexNormal.isValid())
+		computeNormalVertices<PFP>(m_map, m_position, m_vertexNormal) ;
+	if (m_faceArea.isValid())
+		computeAreaFaces<PFP>(m_map, m_position, m_faceArea) ;
+	if (m_faceCentroid.isValid())
+		computeCentroidFaces<PFP>(m_map, m_position, m_faceCentroid) ;
+	if (m_edgeCotanWeight.isValid())
+		computeCotanWeightEdges<PFP>(m_map, m_position, m_edgeCotanWeight) ;
+}
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -7,6 +7,7 @@
 
 //#include "Topology/map/map2.h"
 #include "Topology/generic/traversor/traversor2.h"
+#include "Algo/Geometry/geodesicPropagation.h"
 
 namespace CGoGN
 {
@@ -28,26 +29,13 @@ class VoronoiDiagram
 	typedef typename PFP::REAL REAL;
 
 protected :
-	typedef struct
-	{
-		typename std::multimap<REAL,Dart>::iterator it ;
-		bool valid ;
-//		unsigned int region;
-		Dart pathOrigin;
-		static std::string CGoGNnameOfType() { return "VoronoiVertexInfo" ; }
-	} VoronoiVertexInfo ;
-
-	typedef NoTypeNameAttribute<VoronoiVertexInfo> VertexInfo ;
-
 	MAP& map;
 	const EdgeAttribute<REAL, MAP>& edgeCost; // weights on the graph edges
 	VertexAttribute<unsigned int, MAP>& regions; // region labels
 	std::vector<Dart> border;
 	std::vector<Dart> seeds;
 
-	VertexAttribute<VertexInfo, MAP> vertexInfo;
-	std::multimap<REAL,Dart> front ;
-	CellMarker<MAP, VERTEX> vmReached;
+	GeodesicPropagation<PFP> geodesics; // shortest paths engine (vertices are indexed from 0)
 
 public :
 	VoronoiDiagram (MAP& m, const EdgeAttribute<REAL, MAP>& c, VertexAttribute<unsigned int, MAP>& r);
@@ -65,11 +53,10 @@ public :
 	void computeDistancesWithinRegion (Dart seed);
 
 protected :
-	virtual void clear ();
-	void initFrontWithSeeds();
-	virtual void collectVertexFromFront(Dart e);
-	void addVertexToFront(Dart f, REAL d);
-	void updateVertexInFront(Dart f, REAL d);
+	// copy the result of the engine for vertex v into the attributes
+	virtual void storeVertex(unsigned int v);
+	void storeAllVertices();
+	void storeTouchedVertices();
 };
 
 template <typename PFP>
@@ -112,8 +99,7 @@ public :
 	REAL getGlobalEnergy() { return REAL(globalEnergy); }
 
 protected :
-	void clear();
-	void collectVertexFromFront(Dart e);
+	void storeVertex(unsigned int v);
 	REAL cumulateEnergyFromRoot(Dart e);
 	void cumulateEnergyAndGradientFromSeed(unsigned int numSeed);
 	Dart selectBestNeighborFromSeed(unsigned int numSeed);
@@ -19,24 +19,13 @@ VoronoiDiagram<PFP>::VoronoiDiagram (MAP& m, const EdgeAttribute<REAL, MAP>& p,
 	map(m),
 	edgeCost (p),
 	regions (r),
-	vmReached(m)
+	geodesics(m, p)
 {
-	vertexInfo = map.template addAttribute<VertexInfo, VERTEX, typename PFP::MAP>("vertexInfo");
 }
 
 template <typename PFP>
 VoronoiDiagram<PFP>::~VoronoiDiagram ()
 {
-	map.removeAttribute(vertexInfo);
-}
-
-template <typename PFP>
-void VoronoiDiagram<PFP>::clear ()
-{
-	regions.setAllValues(0);
-	border.clear();
-	front.clear();
-	vmReached.unmarkAll();
 }
 
 template <typename PFP>
@@ -51,7 +40,10 @@ void VoronoiDiagram<PFP>::setSeeds_random (unsigned int nseeds)
 {
 	seeds.clear();
 	srand ( (unsigned int)(time(NULL)) );
-	const unsigned int nbv = map.getNbCells(VERTEX);
+
+	// vertices are directly accessed by their index in the engine
+	geodesics.update();
+	const unsigned int nbv = geodesics.getNbVertices();
 
 	std::set<unsigned int> myVertices ;
 	while (myVertices.size() < nseeds)
@@ -59,21 +51,8 @@ void VoronoiDiagram<PFP>::setSeeds_random (unsigned int nseeds)
 		myVertices.insert(rand() % nbv);
 	}
 
-	std::set<unsigned int>::iterator it = myVertices.begin();
-	unsigned int n = 0;
-	TraversorV<MAP> tv (map);
-	Dart dit = tv.begin();
-
-	while (it != myVertices.end())
-	{
-		while(n<*it)
-		{
-			dit = tv.next();
-			++n;
-		}
-		seeds.push_back(dit);
-		it++;
-	}
+	for (std::set<unsigned int>::iterator it = myVertices.begin(); it != myVertices.end(); ++it)
+		seeds.push_back(geodesics.vertexDart(*it));
 
 	// random permutation = un-sort the seeds
 	for (unsigned int i = 0; i < nseeds; i++)
@@ -85,22 +64,6 @@ void VoronoiDiagram<PFP>::setSeeds_random (unsigned int nseeds)
 	}
 }
 
-template <typename PFP>
-void VoronoiDiagram<PFP>::initFrontWithSeeds ()
-{
-//	vmReached.unmarkAll();
-	clear();
-	for (unsigned int i = 0; i < seeds.size(); i++)
-	{
-		Dart d = seeds[i];
-		vmReached.mark(d);
-		vertexInfo[d].it = front.insert(std::pair<REAL,Dart>(0.0, d));
-		vertexInfo[d].valid = true;
-		regions[d] = i;
-		vertexInfo[d].pathOrigin = d;
-	}
-}
-
 //template <typename PFP>
 //void VoronoiDiagram<PFP>::setCost (const EdgeAttribute<typename PFP::REAL,typename PFP::MAP>& c)
 //{
@@ -108,132 +71,74 @@ void VoronoiDiagram<PFP>::initFrontWithSeeds ()
 //}
 
 template <typename PFP>
-void VoronoiDiagram<PFP>::collectVertexFromFront(Dart e)
+void VoronoiDiagram<PFP>::storeVertex(unsigned int v)
 {
-	regions[e] = regions[vertexInfo[e].pathOrigin];
-	front.erase(vertexInfo[e].it);
-	vertexInfo[e].valid=false;
+	unsigned int emb = geodesics.vertexEmbedding(v);
+	regions[emb] = geodesics.isReached(v) ? geodesics.region(v) : 0;
 }
 
 template <typename PFP>
-void VoronoiDiagram<PFP>::addVertexToFront(Dart f, REAL d)
+void VoronoiDiagram<PFP>::storeAllVertices()
 {
-	VertexInfo& vi (vertexInfo[f]);
-	vi.it = front.insert(std::pair<REAL,Dart>(d + edgeCost[f], f));
-	vi.valid = true;
-	vi.pathOrigin = map.phi2(f);
-	vmReached.mark(f);
+	// each vertex writes its own attribute values
+	CGoGN::Parallel::foreach_index(0, geodesics.getNbVertices(), [&] (unsigned int v, unsigned int)
+	{
+		storeVertex(v);
+	});
 }
 
 template <typename PFP>
-void VoronoiDiagram<PFP>::updateVertexInFront(Dart f, REAL d)
+void VoronoiDiagram<PFP>::storeTouchedVertices()
 {
-	VertexInfo& vi (vertexInfo[f]);
-	REAL dist = d + edgeCost[f];
-	if (dist < vi.it->first)
-	{
-		front.erase(vi.it);
-		vi.it = front.insert(std::pair<REAL,Dart>(dist, f));
-		vi.pathOrigin = map.phi2(f);
-	}
+	const std::vector<unsigned int>& touched = geodesics.getTouched();
+	for (unsigned int i = 0; i < touched.size(); ++i)
+		storeVertex(touched[i]);
 }
 
 template <typename PFP>
 Dart VoronoiDiagram<PFP>::computeDiagram ()
 {
-	initFrontWithSeeds();
-
-	Dart e;
-	while ( !front.empty() )
-	{
-		e = front.begin()->second;
-		REAL d = front.begin()->first;
+	geodesics.update();
+	geodesics.propagate(seeds);
 
-		collectVertexFromFront(e);
+	storeAllVertices();
+	geodesics.getBorder(border);
 
-		Traversor2VVaE<MAP> tv (map, e);
-		for (Dart f = tv.begin(); f != tv.end(); f=tv.next())
-		{
-			if (vmReached.isMarked(f))
-			{ // f has been reached
-				if (vertexInfo[f].valid) // f is in the front : update
-					updateVertexInFront(f,d);
-				else // f is not in the front any more (already collected) : detect a border edge
-				{
-					if ( regions[f] != regions[e] )
-						border.push_back(f);
-				}
-			}
-			else
-			{ // f has not been reached : add it to the front
-				addVertexToFront(f,d);
-			}
-		}
-	}
-	return e;
+	unsigned int last = geodesics.lastVertex();
+	return last == GeodesicPropagation<PFP>::NONE ? NIL : geodesics.vertexDart(last);
 }
 
 template <typename PFP>
 void VoronoiDiagram<PFP>::computeDiagram_incremental (unsigned int nseeds)
 {
 	seeds.clear();
+	geodesics.update();
 
 	// first seed
 	srand ((unsigned int)(time(NULL)) );
-	unsigned int s = rand() % map.getNbCells(VERTEX);
-	unsigned int n = 0;
-	TraversorV<MAP> tv (map);
-	Dart dit = tv.begin();
-	while(n < s)
-	{
-		dit = tv.next();
-		++n;
-	}
-	seeds.push_back(dit);
-
-	// add other seeds one by one
-	Dart e = computeDiagram();
+	unsigned int s = rand() % geodesics.getNbVertices();
+	seeds.push_back(geodesics.vertexDart(s));
+	geodesics.propagate(seeds);
 
+	// add other seeds one by one at the farthest vertex:
+	// only the region of the new seed is recomputed
 	for(unsigned int i = 1; i < nseeds ; i++)
 	{
-		seeds.push_back(e);
-		e = computeDiagram();
+		unsigned int e = geodesics.farthestVertex();
+		seeds.push_back(geodesics.vertexDart(e));
+		geodesics.insertSeed(e, i);
 	}
+
+	storeAllVertices();
+	geodesics.getBorder(border);
 }
 
 template <typename PFP>
 void VoronoiDiagram<PFP>::computeDistancesWithinRegion (Dart seed)
 {
-	// init
-	front.clear();
-	vmReached.unmarkAll();
-
-	vmReached.mark(seed);
-	vertexInfo[seed].it = front.insert(std::pair<REAL,Dart>(0.0, seed));
-	vertexInfo[seed].valid = true;
-	vertexInfo[seed].pathOrigin = seed;
-
-	//compute
-	while ( !front.empty() )
-	{
-		Dart e = front.begin()->second;
-		REAL d = front.begin()->first;
-
-		collectVertexFromFront(e);
-
-		Traversor2VVaE<MAP> tv (map, e);
-		for (Dart f = tv.begin(); f != tv.end(); f=tv.next())
-		{
-			if (vmReached.isMarked(f))
-			{ // f has been reached
-				if (vertexInfo[f].valid) updateVertexInFront(f,d); // f is in the front : update
-			}
-			else
-			{ // f has not been reached : add it to the front
-				if ( regions[f] == regions[e] ) addVertexToFront(f,d);
-			}
-		}
-	}
+	// only the vertices of the region are visited and stored
+	geodesics.propagateWithinRegion(geodesics.vertexIndex(seed));
+	storeTouchedVertices();
 }
 
 /***********************************************************
@@ -258,19 +163,18 @@ CentroidalVoronoiDiagram<PFP>::~CentroidalVoronoiDiagram ()
 }
 
 template <typename PFP>
-void CentroidalVoronoiDiagram<PFP>::clear ()
+void CentroidalVoronoiDiagram<PFP>::storeVertex(unsigned int v)
 {
-	VoronoiDiagram<PFP>::clear();
-	distances.setAllValues(0.0);
-}
-
-template <typename PFP>
-void CentroidalVoronoiDiagram<PFP>::collectVertexFromFront(Dart e)
-{
-	distances[e] = this->vertexInfo[e].it->first;
-	pathOrigins[e] = this->vertexInfo[e].pathOrigin;
+	VoronoiDiagram<PFP>::storeVertex(v);
 
-	VoronoiDiagram<PFP>::collectVertexFromFront(e);
+	unsigned int emb = this->geodesics.vertexEmbedding(v);
+	if (this->geodesics.isReached(v))
+	{
+		distances[emb] = this->geodesics.distance(v);
+		pathOrigins[emb] = this->geodesics.pathOrigin(v);
+	}
+	else
+		distances[emb] = 0.0;
 }
 
 
@@ -29,9 +29,11 @@
 
 #include "Topology/generic/attributeHandler.h"
 #include "Topology/generic/cellmarker.h"
+#include "Topology/generic/parallelLoop.h"
 #include "Geometry/vector_gen.h"
 #include "Utils/colorMaps.h"
 #include "Utils/vbo_base.h"
+#include "Algo/Histogram/quantileSketch.h"
 
 #ifdef WIN32
 #ifndef CGoGN_ALGO_API
@@ -132,12 +134,14 @@ public:
 /**
  * Histogram class
  * T must have operators -, / ,< ,>
+ * Data are never sorted: histogram and quantiles are computed in parallel
+ * in one (or two) pass(es) over the data.
  */
 class CGoGN_ALGO_API Histogram
 {
 //	std::vector<double> m_data;
 
-	mutable std::vector< std::pair<double, unsigned int> > m_dataIdx;
+	std::vector< std::pair<double, unsigned int> > m_dataIdx;
 	
 	/// number of classes in attribute
 	unsigned int m_nbclasses;
@@ -157,6 +161,12 @@ class CGoGN_ALGO_API Histogram
 	/// max value
 	double m_max;
 
+	/// real min value of data
+	double m_qmin;
+
+	/// real max value of data
+	double m_qmax;
+
 	/// interval width (in regular case)
 	double m_interWidth;
 	
@@ -171,16 +181,23 @@ class CGoGN_ALGO_API Histogram
 
 	HistoColorMap& m_hcolmap;
 
-	mutable bool m_sorted;
-
 	/// get data
 	double data(unsigned int i) const;
 
 	/// get idx of data in attribute
 	unsigned int idx(unsigned int i) const;
 
-	/// comparison function for sorting data
-	static bool dataComp( const std::pair<double, unsigned int>& a, const std::pair<double, unsigned int>& b);
+	/// number of threads used for computations
+	static unsigned int nbThreads();
+
+	/**
+	 * exact values of given ranks in data (as if sorted), by parallel selection:
+	 * a fine histogram locates the ranks, only values of the classes
+	 * that contain them are gathered and partially sorted.
+	 * @param ranks ranks (in [0,nb data[)
+	 * @param values values of ranks
+	 */
+	void selectRanks(const std::vector<unsigned int>& ranks, std::vector<double>& values) const;
 
 	/// update quantiles height from histo area for correct superposition
 	void quantilesAreaCorrection();
@@ -200,7 +217,6 @@ public:
 	/**
 	 * init data
 	 * @param attr the attribute to copy from
-	 * @param sortForQuantiles sort data vector for quantille generation
 	 */
 	template <typename ATTR>
 	void initData(const ATTR& attr);
@@ -258,9 +274,16 @@ public:
 	void populateHisto(unsigned int nbclasses = 0);
 
 	/**
-	 * compute the histogram with given number of classes
+	 * compute the exact quantiles (by parallel selection, data are not sorted)
+	 */
+	void populateQuantiles(unsigned int nbquantiles = 10);
+
+	/**
+	 * compute approximated quantiles in one parallel pass (with QuantileSketch)
+	 * @param nbquantiles number of quantiles
+	 * @param sketchSize size parameter of sketches (rank error ~ 1/sketchSize)
 	 */
-	void populateQuantiles(unsigned int nbclasses = 10);
+	void populateQuantilesApprox(unsigned int nbquantiles = 10, unsigned int sketchSize = 256);
 
 	/**
 	* which class belong a value
@@ -34,7 +34,8 @@ namespace Histogram
 {
 
 inline Histogram::Histogram( HistoColorMap& hcm):
- m_hcolmap(hcm),m_sorted(false)
+ m_nbclasses(0), m_min(0.0), m_max(0.0), m_qmin(0.0), m_qmax(0.0),
+ m_interWidth(0.0), m_maxBar(0), m_maxQBar(0.0), m_hcolmap(hcm)
 {
 }
 
@@ -70,12 +71,12 @@ inline double Histogram::getMax() const
 
 inline double Histogram::getQMin() const
 {
-	return m_dataIdx.front().first;
+	return m_qmin;
 }
 
 inline double Histogram::getQMax() const
 {
-	return m_dataIdx.back().first;
+	return m_qmax;
 }
 
 inline unsigned int Histogram::getMaxBar() const
@@ -130,16 +131,17 @@ inline void Histogram::initData(const ATTR& attr)
 			m_max = val;
 	}
 
+	m_qmin = m_min;
+	m_qmax = m_max;
+
 	m_hcolmap.setMin(m_min);
 	m_hcolmap.setMax(m_max);
-
-	m_sorted = false;
 }
 
 inline unsigned int Histogram::whichClass(double val) const
 {
 	if (val == m_max)
-		return uint32(m_populations.size()-1);
+		return m_nbclasses-1;
 	double x = (val - m_min)/m_interWidth;
 	if ((x<0) || (val>=m_max))
 		return -1;
@@ -148,43 +150,32 @@ inline unsigned int Histogram::whichClass(double val) const
 
 inline unsigned int Histogram::whichQuantille(double val) const
 {
-	unsigned int i=1;
-	while (val > m_interv[i])
-		++i;
-	return i-1;
+	// first bound >= val (last quantile for greater values)
+	std::vector<double>::const_iterator it = std::lower_bound(m_interv.begin() + 1, m_interv.end() - 1, val);
+	return uint32(it - (m_interv.begin() + 1));
 }
 
 template<typename ATTC>
 void Histogram::histoColorize(ATTC& colors)
 {
-	unsigned int nb = uint32(m_dataIdx.size());
-	for (unsigned int i = 0; i<nb; ++i)
+	// each data writes its own cell: no conflict between threads
+	Parallel::foreach_index(0, uint32(m_dataIdx.size()), [&] (unsigned int i, unsigned int)
 	{
-		unsigned int j = idx(i);
 		unsigned int c = whichClass(data(i));
 		if (c != 0xffffffff)
-			colors[j] = m_hcolmap.colorIndex(c);
-	}
+			colors[idx(i)] = m_hcolmap.colorIndex(c);
+	}, nbThreads());
 }
 
 template<typename ATTC>
 void Histogram::quantilesColorize(ATTC& colors, const std::vector<Geom::Vec3f>& tc)
 {
+	assert(tc.size() >= m_interv.size() - 1);
 
-	unsigned int nb = uint32(m_dataIdx.size());
-	unsigned int nbi = uint32(m_interv.size() - 1);
-
-	assert(tc.size() >= nbi);
-
-	unsigned int i=0;
-	unsigned int j=0;
-
-	while ((i<nb) && (j<nbi))
+	Parallel::foreach_index(0, uint32(m_dataIdx.size()), [&] (unsigned int i, unsigned int)
 	{
-		while ((i<nb) && (data(i) <= m_interv[j+1]))
-			colors[ idx(i++) ] = tc[j];
-		++j;
-	}
+		colors[idx(i)] = tc[whichQuantille(data(i))];
+	}, nbThreads());
 }
 
 /// get data
@@ -199,35 +190,27 @@ inline unsigned int Histogram::idx(unsigned int i) const
 	return m_dataIdx[i].second;
 }
 
-// comparison function for sorting data
-inline bool Histogram::dataComp( const std::pair<double, unsigned int>& a, const std::pair<double, unsigned int>& b)
+inline unsigned int Histogram::nbThreads()
 {
-	return a.first < b.first;
+	return Parallel::NumberOfThreads > 1 ? Parallel::NumberOfThreads : 1;
 }
 
 template <typename CELLMARKER>
 unsigned int Histogram::markCellsOfHistogramColumn(unsigned int c, CELLMARKER& cm) const
 {
-	if (!m_sorted)
-	{
-		std::sort(m_dataIdx.begin(),m_dataIdx.end(),dataComp);
-		m_sorted = true;
-	}
-
 	double bi = (m_max-m_min)/m_nbclasses * c + m_min;
 	double bs = (m_max-m_min)/m_nbclasses * (c+1) + m_min;
 
 	unsigned int nb = uint32(m_dataIdx.size());
-	unsigned int i=0;
-
-	while ((i<nb) && (data(i)< bi))
-		++i;
-
 	unsigned int nbc=0;
-	while ((i<nb) && (data(i)< bs))
+	for (unsigned int i = 0; i < nb; ++i)
 	{
-		cm.mark(idx(i++));
-		++nbc;
+		double v = data(i);
+		if ((v >= bi) && (v < bs))
+		{
+			cm.mark(idx(i));
+			++nbc;
+		}
 	}
 
 	return nbc;
@@ -240,16 +223,15 @@ unsigned int Histogram::markCellsOfQuantilesColumn(unsigned int c, CELLMARKER& c
 	double bs = m_interv[c+1];
 
 	unsigned int nb = uint32(m_dataIdx.size());
-	unsigned int i=0;
-
-	while ((i<nb) && (data(i)< bi))
-		++i;
-
 	unsigned int nbc=0;
-	while ((i<nb) && (data(i)< bs))
+	for (unsigned int i = 0; i < nb; ++i)
 	{
-		cm.mark(idx(i++));
-		++nbc;
+		double v = data(i);
+		if ((v >= bi) && (v < bs))
+		{
+			cm.mark(idx(i));
+			++nbc;
+		}
 	}
 
 	return nbc;
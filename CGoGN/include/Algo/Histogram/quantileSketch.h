@@ -0,0 +1,120 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __QUANTILE_SKETCH__
+#define __QUANTILE_SKETCH__
+
+#include <vector>
+#include <stdint.h>
+
+#ifdef WIN32
+#ifndef CGoGN_ALGO_API
+#if defined CGoGN_ALGO_DLL_EXPORT
+#define CGoGN_ALGO_API __declspec(dllexport)
+#else
+#define CGoGN_ALGO_API __declspec(dllimport)
+#endif
+#endif
+#else
+#define CGoGN_ALGO_API
+#endif
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Histogram
+{
+
+/**
+ * Streaming approximation of the quantiles of a set of values (KLL sketch).
+ * Values are kept in levels of compactors, a value of level h stands for 2^h input values ;
+ * when a level is full, it is sorted and one value out of two is promoted to the next level.
+ * The memory is O(k) whatever the number of values, and the rank error is O(n/k).
+ * Sketches of parts of the data (e.g. one per thread) can be merged.
+ */
+class CGoGN_ALGO_API QuantileSketch
+{
+	/// capacity of the top level
+	unsigned int m_k;
+
+	/// values of each level
+	std::vector< std::vector<double> > m_levels;
+
+	/// number of inserted values
+	uint64_t m_n;
+
+	/// number of values in levels
+	unsigned int m_size;
+
+	/// state of the generator choosing which values are promoted
+	uint32_t m_random;
+
+	unsigned int capacity(unsigned int level) const;
+
+	unsigned int maxSize() const;
+
+	void compress();
+
+	bool randomBit();
+
+public:
+	/**
+	 * @param k size parameter (accuracy vs memory)
+	 */
+	QuantileSketch(unsigned int k = 256);
+
+	void insert(double val);
+
+	/**
+	 * merge the values of another sketch into this one
+	 */
+	void merge(const QuantileSketch& qs);
+
+	/**
+	 * number of inserted values
+	 */
+	uint64_t count() const { return m_n; }
+
+	/**
+	 * approximate quantile
+	 * @param q rank in [0,1] (0 for min, 1 for max)
+	 */
+	double quantile(double q) const;
+
+	/**
+	 * approximate quantiles of several ranks (in [0,1])
+	 */
+	void quantiles(const std::vector<double>& q, std::vector<double>& values) const;
+};
+
+} // namespace Histogram
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#endif
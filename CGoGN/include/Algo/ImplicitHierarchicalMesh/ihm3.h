@@ -356,7 +356,8 @@ public:
 
 	//! Return true if the volume of d in the current level map
 	//! has already been subdivided to the next level
-	/*!
+	/*! The answer is the same for all the darts of the volume, whatever
+	 *  the subdivision of its neighbours
 	 */
 	bool volumeIsSubdivided(Dart d);
 
@@ -490,6 +491,15 @@ public:
 
 } // namespace Algo
 
+// implicit hierarchical maps set levels and ids of new darts in newDart
+template <typename MAP> struct BulkConstructible ;
+
+template <>
+struct BulkConstructible<Algo::Volume::IHM::ImplicitHierarchicalMap3>
+{
+	static const bool value = false ;
+} ;
+
 } // namespace CGoGN
 
 #include "Algo/ImplicitHierarchicalMesh/ihm3.hpp"
@@ -44,6 +44,13 @@ enum SubdivideType
 	S_QUAD
 } ;
 
+enum BalancePolicy
+{
+	B_NONE,		// no balancing
+	B_FACE,		// 2:1 balancing between volumes sharing a face
+	B_EDGE		// 2:1 balancing between volumes sharing an edge
+} ;
+
 
 
 
@@ -121,6 +128,33 @@ void coarsenFace(typename PFP::MAP& map, Dart d, VertexAttribute<typename PFP::V
 template <typename PFP>
 void coarsenVolume(typename PFP::MAP& map, Dart d, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position);
 
+/***********************************************************************************
+ *						 Balanced batch subdivision (sequential)					   *
+ ***********************************************************************************/
+
+/**
+ * Close a set of volumes to subdivide under a 2:1 balancing policy:
+ * a volume of level l is subdivided only if its neighbours (through faces or edges)
+ * are of level >= l, coarser neighbours are added to the set (recursively).
+ * Volumes are given by any of their darts at the current level.
+ * @param toSubdivide the oldest dart of each volume to subdivide, sorted by increasing level
+ */
+template <typename PFP>
+void balanceVolumes(typename PFP::MAP& map, const std::vector<Dart>& volumes, std::vector<Dart>& toSubdivide, BalancePolicy balance = B_FACE);
+
+/**
+ * Sequential balanced batch refinement: subdivide a set of volumes
+ * (subdivideVolumeClassic) after closing it with balanceVolumes.
+ * Volumes are subdivided one after the other, coarsest level first.
+ * There is no grouping of independent volumes and no parallelism: the implicit
+ * map has a single current level, changed by every query and operator, and all
+ * the volumes share the dart container and the markers.
+ * The current level of the map is not changed.
+ * @return the number of subdivided volumes
+ */
+template <typename PFP>
+unsigned int subdivideVolumes(typename PFP::MAP& map, const std::vector<Dart>& volumes, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, BalancePolicy balance = B_FACE);
+
 /***********************************************************************************
  *												Raffinement
  ***********************************************************************************/
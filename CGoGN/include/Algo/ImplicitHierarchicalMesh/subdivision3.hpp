@@ -26,6 +26,9 @@
 #include "Algo/Modelisation/subdivision.h"
 #include "Algo/Modelisation/extrusion.h"
 #include "Topology/generic/dartmarker.h"
+#include "Topology/generic/traversor/traversor3.h"
+
+#include <algorithm>
 
 namespace CGoGN
 {
@@ -1425,6 +1428,85 @@ void coarsenVolume(typename PFP::MAP& map, Dart d, VertexAttribute<typename PFP:
 
 
 
+/***********************************************************************************
+ *						 Balanced batch subdivision (sequential)					   *
+ ***********************************************************************************/
+
+template <typename PFP>
+void balanceVolumes(typename PFP::MAP& map, const std::vector<Dart>& volumes, std::vector<Dart>& toSubdivide, BalancePolicy balance)
+{
+	typedef typename PFP::MAP MAP;
+
+	DartMarkerStore<MAP> selected(map);
+	std::vector<std::pair<unsigned int, Dart> > work;	// level and oldest dart of selected volumes
+	work.reserve(volumes.size());
+
+	auto select = [&] (Dart d)
+	{
+		if (selected.isMarked(d) || map.isBoundaryMarked(3, d) || map.volumeIsSubdivided(d))
+			return;
+		Dart old = map.volumeOldestDart(d);
+		selected.markOrbit(Vol(old));
+		work.push_back(std::make_pair(map.volumeLevel(old), old));
+	};
+
+	for (std::vector<Dart>::const_iterator it = volumes.begin(); it != volumes.end(); ++it)
+		select(*it);
+
+	// a neighbour coarser than a selected volume must be subdivided first
+	// (work grows during the loop: neighbours are checked in turn)
+	for (unsigned int i = 0; balance != B_NONE && i < work.size(); ++i)
+	{
+		unsigned int l = work[i].first;
+		Dart d = work[i].second;
+		if (l == 0)
+			continue;
+
+		if (balance == B_FACE)
+		{
+			Traversor3WWaF<MAP> tra(map, d);
+			for (Dart n = tra.begin(); n != tra.end(); n = tra.next())
+			{
+				if (!map.isBoundaryMarked(3, n) && !selected.isMarked(n) && map.volumeLevel(n) < l)
+					select(n);
+			}
+		}
+		else
+		{
+			Traversor3WWaE<MAP> tra(map, d);
+			for (Dart n = tra.begin(); n != tra.end(); n = tra.next())
+			{
+				if (!map.isBoundaryMarked(3, n) && !selected.isMarked(n) && map.volumeLevel(n) < l)
+					select(n);
+			}
+		}
+	}
+
+	std::stable_sort(work.begin(), work.end(), [] (const std::pair<unsigned int, Dart>& a, const std::pair<unsigned int, Dart>& b)
+	{
+		return a.first < b.first;
+	});
+
+	toSubdivide.clear();
+	toSubdivide.reserve(work.size());
+	for (unsigned int i = 0; i < work.size(); ++i)
+		toSubdivide.push_back(work[i].second);
+}
+
+template <typename PFP>
+unsigned int subdivideVolumes(typename PFP::MAP& map, const std::vector<Dart>& volumes, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, BalancePolicy balance)
+{
+	std::vector<Dart> toSubdivide;
+	balanceVolumes<PFP>(map, volumes, toSubdivide, balance);
+
+	// toSubdivide is sorted by level: coarser neighbours are subdivided first
+	// (one volume at a time, see subdivision3.h)
+	for (std::vector<Dart>::iterator it = toSubdivide.begin(); it != toSubdivide.end(); ++it)
+		IHM::subdivideVolumeClassic<PFP>(map, *it, position);
+
+	return uint32(toSubdivide.size());
+}
+
 /* **************************************************************************************
  *    							USE WITH CAUTION										*
  ****************************************************************************************/
@@ -2682,7 +2764,7 @@ Dart subdivideVolumeGen(typename PFP::MAP& map, Dart d, VertexAttribute<typename
 		map.splitVolume(v) ;
 
 		//degree du sommet exterieur
-		unsigned int cornerDegree = map.Map2::vertexDegree(*edge);
+		unsigned int cornerDegree = map.PFP::MAP::ParentMap::vertexDegree(*edge);
 
 		//tourner autour du sommet pour connaitre le brin d'un sommet de valence < cornerDegree
 		bool found = false;
@@ -2690,7 +2772,7 @@ Dart subdivideVolumeGen(typename PFP::MAP& map, Dart d, VertexAttribute<typename
 		do
 		{
 
-			if(map.Map2::vertexDegree(map.phi2(map.phi1(e))) < cornerDegree)
+			if(map.PFP::MAP::ParentMap::vertexDegree(map.phi2(map.phi1(e))) < cornerDegree)
 			{
 				stop = map.phi2(map.phi1(e));
 				found = true;
@@ -2709,7 +2791,7 @@ Dart subdivideVolumeGen(typename PFP::MAP& map, Dart d, VertexAttribute<typename
 
 			do
 			{
-				if(map.Map2::vertexDegree(dd) < cornerDegree)
+				if(map.PFP::MAP::ParentMap::vertexDegree(dd) < cornerDegree)
 					found2 = true;
 				else
 					dd = map.phi1(dd);
@@ -2727,8 +2809,8 @@ Dart subdivideVolumeGen(typename PFP::MAP& map, Dart d, VertexAttribute<typename
 				map.splitFace(dd, stop);
 
 				//calcul de la taille des faces de chaque cote de stop
-				if(!( (map.Map2::faceDegree(map.phi_1(stop)) == 3 && map.Map2::faceDegree(map.phi2(map.phi_1(stop))) == 4) ||
-						(map.Map2::faceDegree(map.phi_1(stop)) == 4 && map.Map2::faceDegree(map.phi2(map.phi_1(stop))) == 3) ))
+				if(!( (map.PFP::MAP::ParentMap::faceDegree(map.phi_1(stop)) == 3 && map.PFP::MAP::ParentMap::faceDegree(map.phi2(map.phi_1(stop))) == 4) ||
+						(map.PFP::MAP::ParentMap::faceDegree(map.phi_1(stop)) == 4 && map.PFP::MAP::ParentMap::faceDegree(map.phi2(map.phi_1(stop))) == 3) ))
 				{
 					//std::cout << "octaedre ou hexaedre" << std::endl;
 
@@ -2750,7 +2832,7 @@ Dart subdivideVolumeGen(typename PFP::MAP& map, Dart d, VertexAttribute<typename
 						{
 							if(dd == stop)
 								finished = true;
-							else if(map.Map2::vertexDegree(dd) < cornerDegree)
+							else if(map.PFP::MAP::ParentMap::vertexDegree(dd) < cornerDegree)
 								found2 = true;
 							else
 								dd = map.phi1(dd);
@@ -2805,8 +2887,8 @@ Dart subdivideVolumeGen(typename PFP::MAP& map, Dart d, VertexAttribute<typename
 		Dart f2 = (*edges).second;
 
 		//si ce n'est pas un tetrahedre
-		if( !( (map.Map2::faceDegree(f2) == 3 && map.Map2::faceDegree(map.phi2(f2)) == 3 &&
-				map.Map2::faceDegree(map.phi2(map.phi_1(f2))) == 3) && map.Map2::vertexDegree(f2) == 3))
+		if( !( (map.PFP::MAP::ParentMap::faceDegree(f2) == 3 && map.PFP::MAP::ParentMap::faceDegree(map.phi2(f2)) == 3 &&
+				map.PFP::MAP::ParentMap::faceDegree(map.phi2(map.phi_1(f2))) == 3) && map.PFP::MAP::ParentMap::vertexDegree(f2) == 3))
 		{
 
 			//map.deleteVolume(map.phi3(map.phi2(map.phi1(oldEdges.front()))));
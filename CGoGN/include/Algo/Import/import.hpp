@@ -27,6 +27,10 @@
 #include "Container/fakeAttribute.h"
 #include "Algo/Modelisation/polyhedron.h"
 #include "Algo/Topo/basic.h"
+#include "Topology/generic/parallelLoop.h"
+
+#include <atomic>
+#include <algorithm>
 
 namespace CGoGN
 {
@@ -576,14 +580,75 @@ Dart createStampVolume(typename PFP::MAP& map)
 }
 
 
+/**
+ * face of a volume under construction: its sorted vertices
+ * (EMBNULL as last one for triangles) and one of its darts
+ */
+struct FaceKey
+{
+    unsigned int v[4];
+    Dart d;
+};
+
+inline bool sameFace(const FaceKey& a, const FaceKey& b)
+{
+    return a.v[0] == b.v[0] && a.v[1] == b.v[1] && a.v[2] == b.v[2] && a.v[3] == b.v[3];
+}
+
+/**
+ * sort face keys so that faces with same vertices are consecutive:
+ * parallel counting sort on the smallest vertex, then sort of each
+ * (small) bucket on the other vertices. The order does not depend on
+ * the number of threads.
+ * @param nbVertices upper bound of vertex embeddings
+ */
+inline void sortFaceKeys(std::vector<FaceKey>& keys, unsigned int nbVertices, unsigned int nbth = Parallel::NumberOfThreads)
+{
+    const unsigned int nbKeys = (unsigned int)(keys.size());
+
+    std::vector< std::atomic<unsigned int> > count(nbVertices);
+    Parallel::foreach_index(0, nbKeys, [&] (unsigned int i, unsigned int)
+    {
+        count[keys[i].v[0]].fetch_add(1, std::memory_order_relaxed);
+    }, nbth);
+
+    std::vector<unsigned int> first(nbVertices + 1);
+    first[0] = 0;
+    for (unsigned int v = 0; v < nbVertices; ++v)
+    {
+        first[v+1] = first[v] + count[v].load(std::memory_order_relaxed);
+        count[v].store(first[v], std::memory_order_relaxed);
+    }
+
+    std::vector<FaceKey> sorted(nbKeys);
+    Parallel::foreach_index(0, nbKeys, [&] (unsigned int i, unsigned int)
+    {
+        sorted[count[keys[i].v[0]].fetch_add(1, std::memory_order_relaxed)] = keys[i];
+    }, nbth);
+    std::vector< std::atomic<unsigned int> >().swap(count);
+
+    Parallel::foreach_index(0, nbVertices, [&] (unsigned int v, unsigned int)
+    {
+        if (first[v+1] - first[v] < 2)
+            return;
+        std::sort(sorted.begin() + first[v], sorted.begin() + first[v+1], [] (const FaceKey& a, const FaceKey& b)
+        {
+            if (a.v[1] != b.v[1]) return a.v[1] < b.v[1];
+            if (a.v[2] != b.v[2]) return a.v[2] < b.v[2];
+            if (a.v[3] != b.v[3]) return a.v[3] < b.v[3];
+            return a.d.index < b.d.index;
+        });
+    }, nbth);
+
+    keys.swap(sorted);
+}
+
 template <typename PFP>
 bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
 {
     typedef typename PFP::MAP MAP;
     typedef typename PFP::VEC3 VEC3;
 
-    VertexAutoAttribute< NoTypeNameAttribute< std::vector<Dart> >, MAP> vecDartsPerVertex(map, "incidents");
-
     unsigned int nbv = mtv.getNbVolumes();
     unsigned int index = 0;
     // buffer for tempo faces (used to remove degenerated edges)
@@ -640,34 +705,34 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
             vemb = edgesBuffer[0];		// get embedding
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             Dart dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 2.
             d = map.phi1(d);
             vemb = edgesBuffer[1];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 3.
             d = map.phi1(d);
             vemb = edgesBuffer[2];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 4.
             d = map.phi1(d);
             vemb = edgesBuffer[3];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
         }
         else if(nbf == 4) //tetrahedral case
         {
@@ -679,12 +744,11 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
                 vemb = edgesBuffer[j];		// get embedding
                 map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
 
-                //store darts per vertices to optimize reconstruction
+                //mark darts of created volumes
                 Dart dd = d;
                 do
                 {
                     m.mark(dd) ;
-                    vecDartsPerVertex[vemb].push_back(dd);
                     dd = map.phi1(map.phi2(dd));
                 } while(dd != d);
 
@@ -697,12 +761,11 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
             vemb = edgesBuffer[3];		// get embedding
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
 
-            //store darts per vertices to optimize reconstruction
+            //mark darts of created volumes
             Dart dd = d;
             do
             {
                 m.mark(dd) ;
-                vecDartsPerVertex[vemb].push_back(dd);
                 dd = map.phi1(map.phi2(dd));
             } while(dd != d);
 
@@ -715,46 +778,46 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
             vemb = edgesBuffer[0];		// get embedding
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             Dart dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 2.
             d = map.phi1(d);
             vemb = edgesBuffer[1];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 3.
             d = map.phi1(d);
             vemb = edgesBuffer[2];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 4.
             d = map.phi1(d);
             vemb = edgesBuffer[3];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 5.
             d = map.phi_1(map.phi2(d));
             vemb = edgesBuffer[4];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
         }
         else if(nbf == 6) //prism case
         {
@@ -764,54 +827,54 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
             vemb = edgesBuffer[0];		// get embedding
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             Dart dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 2.
             d = map.phi1(d);
             vemb = edgesBuffer[1];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 3.
             d = map.phi1(d);
             vemb = edgesBuffer[2];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 5.
             d = map.template phi<2112>(d);
             vemb = edgesBuffer[3];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 6.
             d = map.phi_1(d);
             vemb = edgesBuffer[4];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 7.
             d = map.phi_1(d);
             vemb = edgesBuffer[5];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
         }
         else if(nbf == 8) //hexahedral case
@@ -822,72 +885,72 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
             vemb = edgesBuffer[0];		// get embedding
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             Dart dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 2.
             d = map.phi1(d);
             vemb = edgesBuffer[1];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 3.
             d = map.phi1(d);
             vemb = edgesBuffer[2];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 4.
             d = map.phi1(d);
             vemb = edgesBuffer[3];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 5.
             d = map.template phi<2112>(d);
             vemb = edgesBuffer[4];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 6.
             d = map.phi_1(d);
             vemb = edgesBuffer[5];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 7.
             d = map.phi_1(d);
             vemb = edgesBuffer[6];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
             // 8.
             d = map.phi_1(d);
             vemb = edgesBuffer[7];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd); dd = map.phi1(map.phi2(dd));
+            m.mark(dd);
 
         }  //end of hexa
 
@@ -895,61 +958,86 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
 
     std::cout << " elements created " << std::endl;
 
-    //reconstruct neighbourhood
-    unsigned int nbBoundaryFaces = 0 ;
+    //reconstruct neighbourhood: faces of created volumes are identified
+    //by their sorted vertices and identical faces are sewn in a single pass
+    std::vector<FaceKey> faces;
+    faces.reserve(4 * std::size_t(nbv));
+    std::vector<Dart> boundary;
+
     for (Dart d = map.begin(); d != map.end(); map.next(d))
     {
-        if (m.isMarked(d))
+        if (!m.isMarked(d))
+            continue;
+        m.unmark(d);
+
+        // one key per face, given by its dart of smallest index
+        FaceKey k;
+        unsigned int deg = 0;
+        Dart dd = d;
+        do
         {
-            std::vector<Dart>& vec = vecDartsPerVertex[map.phi1(d)];
+            if (dd.index < d.index)
+                break;
+            if (deg < 4)
+                k.v[deg] = map.template getEmbedding<VERTEX>(dd);
+            ++deg;
+            dd = map.phi1(dd);
+        } while (dd != d);
+
+        if (dd != d)
+            continue;
+        if (deg > 4)
+        {
+            boundary.push_back(d);
+            continue;
+        }
+        if (deg == 3)
+            k.v[3] = EMBNULL;
+        std::sort(k.v, k.v + 4);
+        k.d = d;
+        faces.push_back(k);
+    }
+
+    sortFaceKeys(faces, map.template getAttributeContainer<VERTEX>().end());
 
+    for (std::size_t i = 0; i < faces.size(); )
+    {
+        std::size_t j = i + 1;
+        while (j < faces.size() && sameFace(faces[i], faces[j]))
+            ++j;
+
+        // faces with same vertices are sewn two by two
+        std::size_t k = i;
+        for (; k + 1 < j; k += 2)
+        {
+            Dart d = faces[k].d;
+            unsigned int e0 = map.template getEmbedding<VERTEX>(d);
+            unsigned int e1 = map.template getEmbedding<VERTEX>(map.phi1(d));
+
+            // dart of the other face that goes along the edge of d the other way
             Dart good_dart = NIL;
-            for(typename std::vector<Dart>::iterator it = vec.begin(); it != vec.end() && good_dart == NIL; ++it)
+            Dart it = faces[k+1].d;
+            do
             {
-                if(map.template getEmbedding<VERTEX>(map.phi1(*it)) == map.template getEmbedding<VERTEX>(d) &&
-                        map.template getEmbedding<VERTEX>(map.phi_1(*it)) == map.template getEmbedding<VERTEX>(map.phi1(map.phi1(d))))
-                {
-                    good_dart = *it ;
-                }
-            }
+                if (map.template getEmbedding<VERTEX>(it) == e1 && map.template getEmbedding<VERTEX>(map.phi1(it)) == e0)
+                    good_dart = it;
+                it = map.phi1(it);
+            } while (it != faces[k+1].d && good_dart == NIL);
 
             if (good_dart != NIL)
-            {
-                unsigned int degD = map.faceDegree(d);
-                unsigned int degGD = map.faceDegree(good_dart);
-
-                //std::cout << "degD = " << degD << " et degGD = " << degGD << std::endl;
-                if(degD == degGD)
-                {
-                    map.sewVolumes(d, good_dart, false);
-                    m.template unmarkOrbit<FACE>(d);
-                }
-//                else
-//                    std::cout << "erreur : degD != degGD" << std::endl;
-            }
+                map.sewVolumes(d, good_dart, false);
             else
             {
-                m.template unmarkOrbit<PFP::MAP::FACE_OF_PARENT>(d);
-                ++nbBoundaryFaces;
+                boundary.push_back(d);
+                boundary.push_back(faces[k+1].d);
             }
         }
-    }
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+        if (k < j)
+            boundary.push_back(faces[k].d);
 
+        i = j;
+    }
+    std::vector<FaceKey>().swap(faces);
 
     /*
     //reconstruct neighbourhood
@@ -1107,9 +1195,19 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
     }
     */
 
+    // close the boundary: holes are only searched from boundary faces
+    unsigned int nbBoundaryFaces = (unsigned int)(boundary.size());
     if (nbBoundaryFaces > 0)
     {
-        unsigned int nbH =  map.closeMap();
+        unsigned int nbH = 0;
+        for (std::vector<Dart>::iterator it = boundary.begin(); it != boundary.end(); ++it)
+        {
+            if (map.phi3(*it) == *it)
+            {
+                ++nbH;
+                map.closeHole(*it);
+            }
+        }
         CGoGNout << "Map closed (" << nbBoundaryFaces << " boundary faces / " << nbH << " holes)" << CGoGNendl;
     }
 
@@ -31,6 +31,8 @@
 //#include <tinyxml2.h>
 #include "Utils/xml.h"
 
+#include "Algo/Import/importChunked.h"
+
 namespace CGoGN
 {
 
@@ -69,6 +71,21 @@ inline float floatFromNas(std::string& s_v)
 	return x;
 }
 
+/**
+ * same as floatFromNas on a field [b,e) of a line
+ */
+template <typename REAL>
+inline REAL realFromNas(const char* b, const char* e)
+{
+	REAL x = REAL(0);
+	readReal(b, e, x);
+	// exponent may be given without 'e' (1.5-3 for 1.5e-3)
+	int ex;
+	if ((b < e) && ((*b == '-') || (*b == '+')) && readInt(b, e, ex))
+		x *= std::pow(REAL(10), REAL(ex));
+	return x;
+}
+
 
 template <typename PFP>
 bool MeshTablesVolume<PFP>::importMesh(const std::string& filename, std::vector<std::string>& attrNames)
@@ -144,271 +161,162 @@ bool MeshTablesVolume<PFP>::importTet(const std::string& filename, std::vector<s
 	AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
 
 	//open file
-	std::ifstream fp(filename.c_str(), std::ios::in);
-	if (!fp.good())
+	MappedFile file;
+	if (!file.open(filename))
 	{
 		CGoGNerr << "Unable to open file " << filename << CGoGNendl;
 		return false;
 	}
 
-	std::string ligne;
+	const char* p = file.begin();
+	const char* end = file.end();
 
-	// reading number of vertices
-	std::getline (fp, ligne);
-	std::stringstream oss(ligne);
-	oss >> m_nbVertices;
-
-	// reading number of tetrahedra
-	std::getline (fp, ligne);
-	std::stringstream oss2(ligne);
-	oss2 >> m_nbVolumes;
+	// reading number of vertices and of tetrahedra
+	if (!readUInt(p, end, m_nbVertices))
+	{
+		CGoGNerr << "Unreadable file " << filename << CGoGNendl;
+		return false;
+	}
+	p = nextLine(p, end);
+	if (!readUInt(p, end, m_nbVolumes))
+	{
+		CGoGNerr << "Unreadable file " << filename << CGoGNendl;
+		return false;
+	}
+	p = nextLine(p, end);
 
-	//reading vertices
+	//reading vertices: lines are parsed in parallel straight into the position attribute
 	std::vector<unsigned int> verticesID;
-	verticesID.reserve(m_nbVertices);
+	container.insertLines(m_nbVertices, verticesID);	// all the blocks are allocated at once
 
-	for(unsigned int i = 0; i < m_nbVertices; ++i)
-	{
-		do
+	unsigned int nbRead = parseLines(p, end, m_nbVertices,
+		[&] (unsigned int i, unsigned int, const char* b, const char* e)
 		{
-			std::getline (fp, ligne);
-		} while (ligne.size() == 0);
-
-		std::stringstream oss(ligne);
-
-		float x,y,z;
-		oss >> x;
-		oss >> y;
-		oss >> z;
-		// TODO : if required read other vertices attributes here
-		VEC3 pos(x,y,z);
-
-		unsigned int id = container.insertLine();
-		position[id] = pos;
-
-		verticesID.push_back(id);
+			REAL x = REAL(0), y = REAL(0), z = REAL(0);
+			readReal(b, e, x);
+			readReal(b, e, y);
+			readReal(b, e, z);
+			// TODO : if required read other vertices attributes here
+			position[verticesID[i]] = VEC3(x, y, z);
+		},
+		[] (unsigned int, unsigned int) {});
+
+	if (nbRead < m_nbVertices)
+	{
+		CGoGNerr << "Unexpected end of file " << filename << CGoGNendl;
+		return false;
 	}
 
+	auto vertex = [&] (unsigned int s) { return (s < m_nbVertices) ? verticesID[s] : EMBNULL; };
+
 	// reading volumes
-	m_nbFaces.reserve(m_nbVolumes*4);
-	m_emb.reserve(m_nbVolumes*12);
+	m_nbFaces.reserve(m_nbVolumes);
+	m_emb.reserve(m_nbVolumes*4);
 
-    unsigned int nbc = 0;
+	std::vector<ParsedVolume> volumes(std::min(m_nbVolumes, NB_LINES_CHUNK));
+	unsigned int nbc = 0;
+	bool valid = true;
 
-	for (unsigned int i = 0; i < m_nbVolumes ; ++i)
-	{
-		do
+	nbRead = parseLines(p, end, m_nbVolumes,
+		[&] (unsigned int, unsigned int slot, const char* b, const char* e)
 		{
-			std::getline (fp, ligne);
-		} while (ligne.size()==0);
-
-		std::stringstream oss(ligne);
-		int n;
-		oss >> n; // type of volumes
-
-
-        if(!oss.good())
-        {
-            oss.clear();
-            char dummy;
-            oss >> dummy; // type of volumes
-            oss >> dummy;
-
-            if(dummy == 'C')// connector
-            {
-                ++nbc;
-                m_nbFaces.push_back(3);
-
-                int s0,s1,s2,s3;
-
-                oss >> s0;
-                oss >> s1;
-                oss >> s2;
-                oss >> s3;
-
-                //std::cout << "connector " << s0 << " " << s1 << " " << s2 << " " << s3 << std::endl;
-
-                m_emb.push_back(verticesID[s0]);
-                m_emb.push_back(verticesID[s1]);
-                m_emb.push_back(verticesID[s2]);
-                m_emb.push_back(verticesID[s3]);
-            }
-        }
-		//tetrahedron
-        else if(n == 4)
-		{
-			m_nbFaces.push_back(4);
-
-			int s0,s1,s2,s3;
+			ParsedVolume& vol = volumes[slot];
+			vol = ParsedVolume();
 
-			oss >> s0;
-			oss >> s1;
-			oss >> s2;
-			oss >> s3;
-
-			typename PFP::VEC3 P = position[verticesID[s0]];
-			typename PFP::VEC3 A = position[verticesID[s1]];
-			typename PFP::VEC3 B = position[verticesID[s2]];
-            typename PFP::VEC3 C = position[verticesID[s3]];
-
-            if (Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::OVER)
+			unsigned int s[8];
+			int n;
+			if (!readInt(b, e, n)) // not a type of volume
 			{
-				int ui = s1;
-				s1 = s2;
-				s2 = ui;
+				b = skipBlanks(b, e);
+				if (b < e)
+					++b;
+				b = skipBlanks(b, e);
+				if ((b < e) && (*b == 'C') && readUInts(++b, e, s, 4)) // connector
+				{
+					vol.nbFaces = 3;
+					vol.nbVertices = 4;
+					for (unsigned int j = 0; j < 4; ++j)
+						vol.emb[j] = vertex(s[j]);
+				}
+				return;
 			}
 
-			m_emb.push_back(verticesID[s0]);
-			m_emb.push_back(verticesID[s1]);
-			m_emb.push_back(verticesID[s2]);
-			m_emb.push_back(verticesID[s3]);
-		}
-		//pyramid
-		else if(n == 5)
-		{
-			m_nbFaces.push_back(5);
+			if (((n != 4) && (n != 5) && (n != 6) && (n != 8)) || !readUInts(b, e, s, n))
+				return;
 
-			int s0,s1,s2,s3,s4;
-
-			oss >> s0;
-			oss >> s1;
-			oss >> s2;
-			oss >> s3;
-			oss >> s4;
-
-			typename PFP::VEC3 P = position[verticesID[s4]];
-			typename PFP::VEC3 A = position[verticesID[s0]];
-			typename PFP::VEC3 B = position[verticesID[s1]];
-			typename PFP::VEC3 C = position[verticesID[s2]];
-
-			// 1 pyra ok avec cette partie
-			if (Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::UNDER)
+			for (int j = 0; j < n; ++j)
 			{
-				unsigned int pt[5];
-				pt[0] = s4;
-				pt[1] = s0;
-				pt[2] = s1;
-				pt[3] = s2;
-				pt[4] = s3;
-
-				s0 = pt[0];
-				s1 = pt[1];
-				s2 = pt[2];
-				s3 = pt[3];
-				s4 = pt[4];
+				if (vertex(s[j]) == EMBNULL)
+				{
+					vol.nbFaces = short(n);
+					vol.nbVertices = 1;
+					vol.emb[0] = EMBNULL;
+					return;
+				}
 			}
 
-			m_emb.push_back(verticesID[s0]);
-			m_emb.push_back(verticesID[s1]);
-			m_emb.push_back(verticesID[s2]);
-			m_emb.push_back(verticesID[s3]);
-			m_emb.push_back(verticesID[s4]);
-		}
-		//prism
-		else if(n == 6)
-		{
-			m_nbFaces.push_back(6);
-
-			int s0,s1,s2,s3,s4,s5;
-
-			oss >> s0;
-			oss >> s1;
-			oss >> s2;
-			oss >> s3;
-			oss >> s4;
-			oss >> s5;
+			//tetrahedron
+			if (n == 4)
+			{
+				const VEC3& P = position[vertex(s[0])];
+				const VEC3& A = position[vertex(s[1])];
+				const VEC3& B = position[vertex(s[2])];
+				const VEC3& C = position[vertex(s[3])];
 
-			// 1 prism ok sans cette partie
-//			typename PFP::VEC3 P = position[verticesID[s5]];
-//			typename PFP::VEC3 A = position[verticesID[s0]];
-//			typename PFP::VEC3 B = position[verticesID[s1]];
-//			typename PFP::VEC3 C = position[verticesID[s2]];
+				if (Geom::testOrientation3D<VEC3>(P,A,B,C) == Geom::OVER)
+					std::swap(s[1], s[2]);
+			}
+			//pyramid
+			else if (n == 5)
+			{
+				const VEC3& P = position[vertex(s[4])];
+				const VEC3& A = position[vertex(s[0])];
+				const VEC3& B = position[vertex(s[1])];
+				const VEC3& C = position[vertex(s[2])];
 
-//			if (Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::OVER)
-//			{
-//				int pt[6];
-
-//				pt[0] = s0;
-//				pt[1] = s1;
-//				pt[2] = s2;
-//				pt[3] = s3;
-//				pt[4] = s4;
-//				pt[5] = s5;
-
-//				s0 = pt[0];
-//				s1 = pt[1];
-//				s2 = pt[2];
-//				s3 = pt[3];
-//				s4 = pt[4];
-//				s5 = pt[5];
+				if (Geom::testOrientation3D<VEC3>(P,A,B,C) == Geom::UNDER)
+				{
+					unsigned int pt[5] = { s[4], s[0], s[1], s[2], s[3] };
+					std::copy(pt, pt + 5, s);
+				}
+			}
+			//hexahedron (prisms are kept as they are)
+			else if (n == 8)
+			{
+				const VEC3& P = position[vertex(s[4])];
+				const VEC3& A = position[vertex(s[0])];
+				const VEC3& B = position[vertex(s[1])];
+				const VEC3& C = position[vertex(s[2])];
 
-//			}
+				if (Geom::testOrientation3D<VEC3>(P,A,B,C) == Geom::OVER)
+				{
+					std::swap(s[2], s[3]);
+					std::swap(s[6], s[7]);
+				}
+			}
 
-			m_emb.push_back(verticesID[s0]);
-			m_emb.push_back(verticesID[s1]);
-			m_emb.push_back(verticesID[s2]);
-			m_emb.push_back(verticesID[s3]);
-			m_emb.push_back(verticesID[s4]);
-			m_emb.push_back(verticesID[s5]);
-		}
-		//hexahedron
-		else if(n == 8)
+			vol.nbFaces = short(n);
+			vol.nbVertices = (unsigned short)(n);
+			for (int j = 0; j < n; ++j)
+				vol.emb[j] = vertex(s[j]);
+		},
+		[&] (unsigned int, unsigned int n)
 		{
-			m_nbFaces.push_back(8);
+			for (unsigned int i = 0; i < n; ++i)
+				if (volumes[i].nbFaces == 3)
+					++nbc;
+			valid = appendVolumes(volumes, n, m_nbFaces, m_emb) && valid;
+		});
 
-			int s0,s1,s2,s3,s4,s5,s6,s7;
-
-			oss >> s0;
-			oss >> s1;
-			oss >> s2;
-			oss >> s3;
-			oss >> s4;
-			oss >> s5;
-			oss >> s6;
-			oss >> s7;
-
-            typename PFP::VEC3 P = position[verticesID[s4]];
-            typename PFP::VEC3 A = position[verticesID[s0]];
-            typename PFP::VEC3 B = position[verticesID[s1]];
-            typename PFP::VEC3 C = position[verticesID[s2]];
-
-            // 1 hexa ok avec cette partie
-            if (Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::OVER)
-            {
-                unsigned int pt[8];
-                pt[0] = s0;
-                pt[1] = s1;
-                pt[2] = s3;
-                pt[3] = s2;
-                pt[4] = s4;
-                pt[5] = s5;
-                pt[6] = s7;
-                pt[7] = s6;
-
-                s0 = pt[0];
-                s1 = pt[1];
-                s2 = pt[2];
-                s3 = pt[3];
-                s4 = pt[4];
-                s5 = pt[5];
-                s6 = pt[6];
-                s7 = pt[7];
-            }
-
-			m_emb.push_back(verticesID[s0]);
-			m_emb.push_back(verticesID[s1]);
-			m_emb.push_back(verticesID[s2]);
-			m_emb.push_back(verticesID[s3]);
-			m_emb.push_back(verticesID[s4]);
-			m_emb.push_back(verticesID[s5]);
-			m_emb.push_back(verticesID[s6]);
-			m_emb.push_back(verticesID[s7]);
-		}
+	if (nbRead < m_nbVolumes || !valid)
+	{
+		CGoGNerr << (valid ? "Unexpected end of file " : "Invalid vertex index in file ") << filename << CGoGNendl;
+		return false;
 	}
+	m_nbVolumes = unsigned(m_nbFaces.size());
 
     std::cout << "#connectors = " << nbc << std::endl;
 
-	fp.close();
 	return true;
 }
 
@@ -566,125 +474,119 @@ bool MeshTablesVolume<PFP>::importNodeWithELERegions(const std::string& filename
 	AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
 
 	//open file
-	std::ifstream fnode(filenameNode.c_str(), std::ios::in);
-	if (!fnode.good())
+	MappedFile fnode;
+	if (!fnode.open(filenameNode))
 	{
 		CGoGNerr << "Unable to open file " << filenameNode << CGoGNendl;
 		return false;
 	}
 
-	std::ifstream fele(filenameELE.c_str(), std::ios::in);
-	if (!fele.good())
+	MappedFile fele;
+	if (!fele.open(filenameELE))
 	{
 		CGoGNerr << "Unable to open file " << filenameELE << CGoGNendl;
 		return false;
 	}
 
-	std::string line;
-
 	//Reading NODE file
 	//First line: [# of points] [dimension (must be 3)] [# of attributes] [# of boundary markers (0 or 1)]
-	unsigned int nbe;
+	const char* pn = skipEmptyLines(fnode.begin(), fnode.end());
+	if (!readUInt(pn, fnode.end(), m_nbVertices))
 	{
-		do
-		{
-			std::getline(fnode,line);
-		}while(line.size() == 0);
-
-		std::stringstream oss(line);
-		oss >> m_nbVertices;
-		oss >> nbe;
-		oss >> nbe;
-		oss >> nbe;
+		CGoGNerr << "Unreadable file " << filenameNode << CGoGNendl;
+		return false;
 	}
+	pn = nextLine(pn, fnode.end());
 
 	//Reading number of tetrahedra in ELE file
-	unsigned int nbv;
+	const char* pe = skipEmptyLines(fele.begin(), fele.end());
+	if (!readUInt(pe, fele.end(), m_nbVolumes))
 	{
-		do
-		{
-			std::getline(fele,line);
-		}while(line.size() == 0);
-
-		std::stringstream oss(line);
-		oss >> m_nbVolumes;
-		oss >> nbv ;
-		oss >> nbv;
+		CGoGNerr << "Unreadable file " << filenameELE << CGoGNendl;
+		return false;
 	}
+	pe = nextLine(pe, fele.end());
 
-	//Reading vertices
-	std::map<unsigned int,unsigned int> verticesMapID;
-
-	for(unsigned int i = 0 ; i < m_nbVertices ; ++i)
-	{
-		do
-		{
-			std::getline(fnode,line);
-		}while(line.size() == 0);
-
-		std::stringstream oss(line);
-
-		int idv;
-		oss >> idv;
+	//Reading vertices: lines are parsed in parallel straight into the position attribute
+	std::vector<unsigned int> verticesID;
+	container.insertLines(m_nbVertices, verticesID);	// all the blocks are allocated at once
 
-		float x,y,z;
-		oss >> x;
-		oss >> y;
-		oss >> z;
-		//we can read colors informations if exists
-		VEC3 pos(x,y,z);
+	std::vector<unsigned int> ids(m_nbVertices, EMBNULL);
 
-		unsigned int id = container.insertLine();
-		position[id] = pos;
-		verticesMapID.insert(std::pair<unsigned int, unsigned int>(idv,id));
+	unsigned int nbRead = parseLines(pn, fnode.end(), m_nbVertices,
+		[&] (unsigned int i, unsigned int, const char* b, const char* e)
+		{
+			REAL x = REAL(0), y = REAL(0), z = REAL(0);
+			readUInt(b, e, ids[i]);
+			readReal(b, e, x);
+			readReal(b, e, y);
+			readReal(b, e, z);
+			//we can read colors informations if exists
+			position[verticesID[i]] = VEC3(x, y, z);
+		},
+		[] (unsigned int, unsigned int) {});
+
+	if (nbRead < m_nbVertices)
+	{
+		CGoGNerr << "Unexpected end of file " << filenameNode << CGoGNendl;
+		return false;
 	}
 
-	// reading tetrahedra
-	m_nbFaces.reserve(m_nbVolumes*4);
-	m_emb.reserve(m_nbVolumes*12);
+	VertexIdMap verticesMapID;
+	verticesMapID.build(ids, verticesID);
+	std::vector<unsigned int>().swap(ids);
 
-	for(unsigned i = 0; i < m_nbVolumes ; ++i)
-	{
-		do
-		{
-			std::getline(fele,line);
-		} while(line.size() == 0);
+	// reading tetrahedra
+	m_nbFaces.reserve(m_nbVolumes);
+	m_emb.reserve(m_nbVolumes*4);
 
-		std::stringstream oss(line);
-		oss >> nbe;
+	std::vector<ParsedVolume> volumes(std::min(m_nbVolumes, NB_LINES_CHUNK));
+	bool valid = true;
 
-		m_nbFaces.push_back(4);
+	nbRead = parseLines(pe, fele.end(), m_nbVolumes,
+		[&] (unsigned int, unsigned int slot, const char* b, const char* e)
+		{
+			ParsedVolume& vol = volumes[slot];
+			vol.nbFaces = 4;
+			vol.nbVertices = 4;
 
-		int s0,s1,s2,s3;
+			unsigned int s[5];
+			if (!readUInts(b, e, s, 5))
+			{
+				vol.emb[0] = EMBNULL;
+				return;
+			}
 
-		oss >> s0;
-		oss >> s1;
-		oss >> s2;
-		oss >> s3;
+			for (unsigned int j = 0; j < 4; ++j)
+				vol.emb[j] = verticesMapID(s[j+1]);
+			if (std::find(vol.emb, vol.emb + 4, EMBNULL) != vol.emb + 4)
+				return;
 
-		typename PFP::VEC3 P = position[verticesMapID[s0]];
-		typename PFP::VEC3 A = position[verticesMapID[s1]];
-		typename PFP::VEC3 B = position[verticesMapID[s2]];
-		typename PFP::VEC3 C = position[verticesMapID[s3]];
+			const VEC3& P = position[vol.emb[0]];
+			const VEC3& A = position[vol.emb[1]];
+			const VEC3& B = position[vol.emb[2]];
+			const VEC3& C = position[vol.emb[3]];
 
-		if (Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::UNDER)
+			if (Geom::testOrientation3D<VEC3>(P,A,B,C) == Geom::UNDER)
+			{
+				unsigned int ui = vol.emb[0];
+				vol.emb[0] = vol.emb[3];
+				vol.emb[3] = vol.emb[2];
+				vol.emb[2] = vol.emb[1];
+				vol.emb[1] = ui;
+			}
+		},
+		[&] (unsigned int, unsigned int n)
 		{
-			int ui= s0;
-			s0 = s3;
-			s3 = s2;
-			s2 = s1;
-			s1 = ui;
-		}
+			valid = appendVolumes(volumes, n, m_nbFaces, m_emb) && valid;
+		});
 
-		m_emb.push_back(verticesMapID[s0]);
-		m_emb.push_back(verticesMapID[s1]);
-		m_emb.push_back(verticesMapID[s2]);
-		m_emb.push_back(verticesMapID[s3]);
+	if (nbRead < m_nbVolumes || !valid)
+	{
+		CGoGNerr << (valid ? "Unexpected end of file " : "Invalid vertex index in file ") << filenameELE << CGoGNendl;
+		return false;
 	}
 
-	fnode.close();
-	fele.close();
-
 	return true;
 }
 
@@ -803,8 +705,8 @@ template <typename PFP>
 bool MeshTablesVolume<PFP>::importTs(const std::string& filename, std::vector<std::string>& attrNames)
 {
 	// open file
-	std::ifstream fp(filename.c_str(), std::ios::in);
-	if (!fp.good())
+	MappedFile file;
+	if (!file.open(filename))
 	{
 		CGoGNerr << "Unable to open file " << filename << CGoGNendl;
 		return false;
@@ -826,86 +728,84 @@ bool MeshTablesVolume<PFP>::importTs(const std::string& filename, std::vector<st
 
 	AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
 
-	std::string ligne;
+	const char* p = file.begin();
+	const char* end = file.end();
 
 	// reading number of vertices/tetrahedra
-	std::getline (fp, ligne);
-	std::stringstream oss(ligne);
-	oss >> m_nbVertices;
-	oss >> m_nbVolumes;
+	if (!readUInt(p, end, m_nbVertices) || !readUInt(p, end, m_nbVolumes))
+	{
+		CGoGNerr << "Unreadable file " << filename << CGoGNendl;
+		return false;
+	}
+	p = nextLine(p, end);
 
-	//reading vertices
+	//reading vertices: lines are parsed in parallel straight into the attributes
 	std::vector<unsigned int> verticesID;
-	verticesID.reserve(m_nbVertices);
+	container.insertLines(m_nbVertices, verticesID);	// all the blocks are allocated at once
 
-	for(unsigned int i = 0; i < m_nbVertices; ++i)
-	{
-		do
+	unsigned int nbRead = parseLines(p, end, m_nbVertices,
+		[&] (unsigned int i, unsigned int, const char* b, const char* e)
 		{
-			std::getline (fp, ligne);
-		} while (ligne.size() == 0);
-
-		std::stringstream oss(ligne);
-
-		float x,y,z;
-		oss >> x;
-		oss >> y;
-		oss >> z;
-
-		VEC3 pos(x,y,z);
-
-		unsigned int id = container.insertLine();
-
-		position[id] = pos;
-		verticesID.push_back(id);
-
-		float scal;
-		oss >> scal;
-		scalar[id] = scal;
+			REAL x = REAL(0), y = REAL(0), z = REAL(0), scal = REAL(0);
+			readReal(b, e, x);
+			readReal(b, e, y);
+			readReal(b, e, z);
+			readReal(b, e, scal);
+			position[verticesID[i]] = VEC3(x, y, z);
+			scalar[verticesID[i]] = scal;
+		},
+		[] (unsigned int, unsigned int) {});
+
+	if (nbRead < m_nbVertices)
+	{
+		CGoGNerr << "Unexpected end of file " << filename << CGoGNendl;
+		return false;
 	}
 
 	//Read and embed all tetrahedrons
-	for(unsigned int i = 0; i < m_nbVolumes ; ++i)
-	{
-		do
-		{
-			std::getline(fp,ligne);
-		} while(ligne.size() == 0);
+	m_nbFaces.reserve(m_nbVolumes);
+	m_emb.reserve(m_nbVolumes*4);
 
-		std::stringstream oss(ligne);
+	std::vector<ParsedVolume> volumes(std::min(m_nbVolumes, NB_LINES_CHUNK));
+	bool valid = true;
 
-		m_nbFaces.push_back(4);
+	nbRead = parseLines(p, end, m_nbVolumes,
+		[&] (unsigned int, unsigned int slot, const char* b, const char* e)
+		{
+			ParsedVolume& vol = volumes[slot];
+			vol.nbFaces = 4;
+			vol.nbVertices = 4;
 
-		int s0,s1,s2,s3,nbe;
+			//if regions are defined they follow the vertices (ignored here)
+			unsigned int s[4];
+			if (!readUInts(b, e, s, 4) || (*std::max_element(s, s + 4) >= m_nbVertices))
+			{
+				vol.emb[0] = EMBNULL;
+				return;
+			}
 
-		oss >> s0;
-		oss >> s1;
-		oss >> s2;
-		oss >> s3;
+			const VEC3& P = position[verticesID[s[0]]];
+			const VEC3& A = position[verticesID[s[1]]];
+			const VEC3& B = position[verticesID[s[2]]];
+			const VEC3& C = position[verticesID[s[3]]];
 
-		typename PFP::VEC3 P = position[verticesID[s0]];
-		typename PFP::VEC3 A = position[verticesID[s1]];
-		typename PFP::VEC3 B = position[verticesID[s2]];
-		typename PFP::VEC3 C = position[verticesID[s3]];
+			if (Geom::testOrientation3D<VEC3>(P,A,B,C) == Geom::UNDER)
+				std::swap(s[1], s[2]);
 
-		if(Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::UNDER)
+			for (unsigned int j = 0; j < 4; ++j)
+				vol.emb[j] = verticesID[s[j]];
+		},
+		[&] (unsigned int, unsigned int n)
 		{
-			int ui = s1;
-			s1 = s2;
-			s2 = ui;
-		}
-
+			valid = appendVolumes(volumes, n, m_nbFaces, m_emb) && valid;
+		});
 
-		//if regions are defined use this number
-		oss >> nbe; //ignored here
-
-		m_emb.push_back(verticesID[s0]);
-		m_emb.push_back(verticesID[s1]);
-		m_emb.push_back(verticesID[s2]);
-		m_emb.push_back(verticesID[s3]);
+	if (nbRead < m_nbVolumes || !valid)
+	{
+		CGoGNerr << (valid ? "Unexpected end of file " : "Invalid vertex index in file ") << filename << CGoGNendl;
+		return false;
 	}
 
-	fp.close();
 	return true;
 }
 
@@ -913,8 +813,8 @@ template <typename PFP>
 bool MeshTablesVolume<PFP>::importNAS(const std::string& filename, std::vector<std::string>& attrNames)
 {
 	// open file
-	std::ifstream fp(filename.c_str(), std::ios::in);
-	if (!fp.good())
+	MappedFile file;
+	if (!file.open(filename))
 	{
 		CGoGNerr << "Unable to open file " << filename << CGoGNendl;
 		return false;
@@ -929,156 +829,136 @@ bool MeshTablesVolume<PFP>::importNAS(const std::string& filename, std::vector<s
 
 	AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
 
-	std::string ligne;
-	std::string tag;
+	const char* end = file.end();
 
-	std::getline (fp, ligne);
-	do
+	// fixed width fields of 8 chars
+	auto field = [] (const char* b, const char* e, unsigned int col, const char*& fb, const char*& fe)
 	{
-		std::getline (fp, ligne);
-		tag = ligne.substr(0,4);
-	} while (tag !="GRID");
+		fb = std::min(b + col, e);
+		fe = std::min(b + col + 8, e);
+	};
 
-	 m_nbVertices = 0;
-	//reading vertices
-	std::map<unsigned int, unsigned int> verticesMapID;
-	do
-	{
-		std::string s_v = ligne.substr(8,8);
-		unsigned int ind = atoi(s_v.c_str());
+	const char* p = nextLine(file.begin(), end);
+	while ((p < end) && !startsWith(p, end, "GRID"))
+		p = nextLine(p, end);
 
-		s_v = ligne.substr(24,8);
-		float x = floatFromNas(s_v);
-		s_v = ligne.substr(32,8);
-		float y = floatFromNas(s_v);
-		s_v = ligne.substr(40,8);
-		float z = floatFromNas(s_v);
+	m_nbVertices = 0;
+	for (const char* q = p; (q < end) && startsWith(q, end, "GRID"); q = nextLine(q, end))
+		++m_nbVertices;
 
-		VEC3 pos(x,y,z);
-		unsigned int id = container.insertLine();
-		position[id] = pos;
-		verticesMapID.insert(std::pair<unsigned int, unsigned int>(ind,id));
-		//		std::cout << "P: "<< ind << "   "<<x<<", "<<y<<", "<<z << std::endl;
-		std::getline (fp, ligne);
-		tag = ligne.substr(0,4);
-		m_nbVertices++;
-	} while (tag =="GRID");
-
-	m_nbVolumes = 0;
+	//reading vertices: lines are parsed in parallel straight into the position attribute
+	std::vector<unsigned int> verticesID;
+	container.insertLines(m_nbVertices, verticesID);	// all the blocks are allocated at once
 
-	do
-	{
-		std::string s_v = ligne.substr(0,6);
+	std::vector<unsigned int> ids(m_nbVertices, EMBNULL);
 
-		if (s_v == "CHEXA ")
+	parseLines(p, end, m_nbVertices,
+		[&] (unsigned int i, unsigned int, const char* b, const char* e)
 		{
-			m_nbFaces.push_back(8);
-			m_nbVolumes++;
-
-			s_v = ligne.substr(24,8);
-			unsigned int ind1 = atoi(s_v.c_str());
-			s_v = ligne.substr(32,8);
-			unsigned int ind2 = atoi(s_v.c_str());
-			s_v = ligne.substr(40,8);
-			unsigned int ind3 = atoi(s_v.c_str());
-			s_v = ligne.substr(48,8);
-			unsigned int ind4 = atoi(s_v.c_str());
-			s_v = ligne.substr(56,8);
-			unsigned int ind5 = atoi(s_v.c_str());
-			s_v = ligne.substr(64,8);
-			unsigned int ind6 = atoi(s_v.c_str());
-
-			std::getline (fp, ligne);
-			s_v = ligne.substr(8,8);
-			unsigned int ind7 = atoi(s_v.c_str());
-			s_v = ligne.substr(16,8);
-			unsigned int ind8 = atoi(s_v.c_str());
-
-			typename PFP::VEC3 P = position[verticesMapID[ind5]];
-			typename PFP::VEC3 A = position[verticesMapID[ind1]];
-			typename PFP::VEC3 B = position[verticesMapID[ind2]];
-			typename PFP::VEC3 C = position[verticesMapID[ind3]];
-
-			unsigned int v[8];
-
-			if (Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::OVER)
-			{
-				v[0] = ind4;
-				v[1] = ind3;
-				v[2] = ind2;
-				v[3] = ind1;
-				v[4] = ind8;
-				v[5] = ind7;
-				v[6] = ind6;
-				v[7] = ind5;
-			}
-			else
-			{
-				v[0] = ind1;
-				v[1] = ind2;
-				v[2] = ind3;
-				v[3] = ind4;
-				v[4] = ind5;
-				v[5] = ind6;
-				v[6] = ind7;
-				v[7] = ind8;
-			}
-
-			m_emb.push_back(verticesMapID[v[0]]);
-			m_emb.push_back(verticesMapID[v[1]]);
-			m_emb.push_back(verticesMapID[v[2]]);
-			m_emb.push_back(verticesMapID[v[3]]);
-			m_emb.push_back(verticesMapID[v[4]]);
-			m_emb.push_back(verticesMapID[v[5]]);
-			m_emb.push_back(verticesMapID[v[6]]);
-			m_emb.push_back(verticesMapID[v[7]]);
-		}
-		if (s_v == "CTETRA")
+			const char* fb;
+			const char* fe;
+			field(b, e, 8, fb, fe);
+			readUInt(fb, fe, ids[i]);
+			field(b, e, 24, fb, fe);
+			REAL x = realFromNas<REAL>(fb, fe);
+			field(b, e, 32, fb, fe);
+			REAL y = realFromNas<REAL>(fb, fe);
+			field(b, e, 40, fb, fe);
+			REAL z = realFromNas<REAL>(fb, fe);
+			position[verticesID[i]] = VEC3(x, y, z);
+		},
+		[] (unsigned int, unsigned int) {});
+
+	VertexIdMap verticesMapID;
+	verticesMapID.build(ids, verticesID);
+	std::vector<unsigned int>().swap(ids);
+
+	// reading volumes (until end of file, other lines are ignored)
+	std::vector<ParsedVolume> volumes(NB_LINES_CHUNK);
+	bool valid = true;
+
+	parseLines(p, end, std::numeric_limits<unsigned int>::max(),
+		[&] (unsigned int, unsigned int slot, const char* b, const char* e)
 		{
-			m_nbFaces.push_back(4);
-			m_nbVolumes++;
+			ParsedVolume& vol = volumes[slot];
+			vol = ParsedVolume();
 
-			s_v = ligne.substr(24,8);
-			unsigned int ind1 = atoi(s_v.c_str());
-			s_v = ligne.substr(32,8);
-			unsigned int ind2 = atoi(s_v.c_str());
-			s_v = ligne.substr(40,8);
-			unsigned int ind3 = atoi(s_v.c_str());
-			s_v = ligne.substr(48,8);
-			unsigned int ind4 = atoi(s_v.c_str());
+			const char* fb;
+			const char* fe;
+			unsigned int ind[8];
 
-			typename PFP::VEC3 P = position[verticesMapID[ind1]];
-			typename PFP::VEC3 A = position[verticesMapID[ind2]];
-			typename PFP::VEC3 B = position[verticesMapID[ind3]];
-			typename PFP::VEC3 C = position[verticesMapID[ind4]];
+			if (startsWith(b, e, "CHEXA "))
+			{
+				for (unsigned int j = 0; j < 6; ++j)
+				{
+					field(b, e, 24 + 8*j, fb, fe);
+					ind[j] = 0;
+					readUInt(fb, fe, ind[j]);
+				}
+				// last two vertices are on the continuation line
+				const char* b2 = nextLine(e, end);
+				const char* e2 = endOfLine(b2, end);
+				for (unsigned int j = 0; j < 2; ++j)
+				{
+					field(b2, e2, 8 + 8*j, fb, fe);
+					ind[6+j] = 0;
+					readUInt(fb, fe, ind[6+j]);
+				}
 
-			Geom::Vec4ui v;
+				vol.nbFaces = 8;
+				vol.nbVertices = 8;
+				for (unsigned int j = 0; j < 8; ++j)
+					vol.emb[j] = verticesMapID(ind[j]);
+				if (std::find(vol.emb, vol.emb + 8, EMBNULL) != vol.emb + 8)
+					return;
 
-			if (Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::OVER)
-			{
-				v[0] = ind4;
-				v[1] = ind3;
-				v[2] = ind2;
-				v[3] = ind1;
+				const VEC3& P = position[vol.emb[4]];
+				const VEC3& A = position[vol.emb[0]];
+				const VEC3& B = position[vol.emb[1]];
+				const VEC3& C = position[vol.emb[2]];
+
+				if (Geom::testOrientation3D<VEC3>(P,A,B,C) == Geom::OVER)
+				{
+					std::reverse(vol.emb, vol.emb + 4);
+					std::reverse(vol.emb + 4, vol.emb + 8);
+				}
 			}
-			else
+			else if (startsWith(b, e, "CTETRA"))
 			{
-				v[0] = ind1;
-				v[1] = ind2;
-				v[2] = ind3;
-				v[3] = ind4;
-			}
+				for (unsigned int j = 0; j < 4; ++j)
+				{
+					field(b, e, 24 + 8*j, fb, fe);
+					ind[j] = 0;
+					readUInt(fb, fe, ind[j]);
+				}
 
-			m_emb.push_back(verticesMapID[v[0]]);
-			m_emb.push_back(verticesMapID[v[1]]);
-			m_emb.push_back(verticesMapID[v[2]]);
-			m_emb.push_back(verticesMapID[v[3]]);
-		}
-		std::getline (fp, ligne);
-		tag = ligne.substr(0,4);
-	} while (!fp.eof());
+				vol.nbFaces = 4;
+				vol.nbVertices = 4;
+				for (unsigned int j = 0; j < 4; ++j)
+					vol.emb[j] = verticesMapID(ind[j]);
+				if (std::find(vol.emb, vol.emb + 4, EMBNULL) != vol.emb + 4)
+					return;
 
-	fp.close();
+				const VEC3& P = position[vol.emb[0]];
+				const VEC3& A = position[vol.emb[1]];
+				const VEC3& B = position[vol.emb[2]];
+				const VEC3& C = position[vol.emb[3]];
+
+				if (Geom::testOrientation3D<VEC3>(P,A,B,C) == Geom::OVER)
+					std::reverse(vol.emb, vol.emb + 4);
+			}
+		},
+		[&] (unsigned int, unsigned int n)
+		{
+			valid = appendVolumes(volumes, n, m_nbFaces, m_emb) && valid;
+		});
+
+	if (!valid)
+	{
+		CGoGNerr << "Invalid vertex index in file " << filename << CGoGNendl;
+		return false;
+	}
+	m_nbVolumes = unsigned(m_nbFaces.size());
 
 	return true;
 }
@@ -1097,256 +977,173 @@ bool MeshTablesVolume<PFP>::importMSH(const std::string& filename, std::vector<s
 	AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
 
 	// open file
-	std::ifstream fp(filename.c_str(), std::ios::in);
-	if (!fp.good())
+	MappedFile file;
+	if (!file.open(filename))
 	{
 		CGoGNerr << "Unable to open file " << filename << CGoGNendl;
 		return false;
 	}
 
-	std::string ligne;
-	unsigned int nbv=0;
-	//read $NODE
-	std::getline (fp, ligne);
+	const char* p = skipEmptyLines(file.begin(), file.end());
+	const char* end = file.end();
 
-	// reading number of vertices
-	std::getline (fp, ligne);
-	std::stringstream oss(ligne);
-	oss >> nbv;
-
-	//reading vertices
-	//	std::vector<unsigned int> verticesID;
-	std::map<unsigned int, unsigned int> verticesMapID;
-
-
-	//	verticesID.reserve(nbv);
-	for(unsigned int i = 0; i < nbv;++i)
+	// version 1 files start with $NOD, version 2 files with $MeshFormat (ascii only)
+	bool version2 = false;
+	if (startsWith(p, end, "$MeshFormat"))
 	{
-		do
+		p = nextLine(p, end);
+		double version = 0.0;
+		unsigned int fileType = 1;
+		if (!readReal(p, end, version) || !readUInt(p, end, fileType) || (version >= 3.0) || (fileType != 0))
 		{
-			std::getline (fp, ligne);
-		} while (ligne.size() == 0);
+			CGoGNerr << "Only ascii MSH files of version 1 or 2 are supported: " << filename << CGoGNendl;
+			return false;
+		}
+		version2 = true;
+		while ((p < end) && !startsWith(p, end, "$Nodes"))
+			p = nextLine(p, end);
+	}
 
-		std::stringstream oss(ligne);
-		unsigned int pipo;
-		float x,y,z;
-		oss >> pipo;
-		oss >> x;
-		oss >> y;
-		oss >> z;
-		// TODO : if required read other vertices attributes here
-		VEC3 pos(x,y,z);
+	//read $NOD
+	if (!startsWith(p, end, "$NOD") && !startsWith(p, end, "$Nodes"))
+	{
+		CGoGNerr << "Unreadable MSH file " << filename << CGoGNendl;
+		return false;
+	}
+	p = nextLine(p, end);
 
-		unsigned int id = container.insertLine();
-		position[id] = pos;
+	// reading number of vertices
+	unsigned int nbv = 0;
+	readUInt(p, end, nbv);
+	p = nextLine(p, end);
 
-		verticesMapID.insert(std::pair<unsigned int, unsigned int>(pipo,id));
-		//		verticesID.push_back(id);
-	}
+	//reading vertices: lines are parsed in parallel straight into the position attribute
+	std::vector<unsigned int> verticesID;
+	container.insertLines(nbv, verticesID);	// all the blocks are allocated at once
+
+	std::vector<unsigned int> ids(nbv, EMBNULL);
 
-	// ENNODE
-	std::getline (fp, ligne);
+	unsigned int nbRead = parseLines(p, end, nbv,
+		[&] (unsigned int i, unsigned int, const char* b, const char* e)
+		{
+			REAL x = REAL(0), y = REAL(0), z = REAL(0);
+			readUInt(b, e, ids[i]);
+			readReal(b, e, x);
+			readReal(b, e, y);
+			readReal(b, e, z);
+			// TODO : if required read other vertices attributes here
+			position[verticesID[i]] = VEC3(x, y, z);
+		},
+		[] (unsigned int, unsigned int) {});
+
+	if (nbRead < nbv)
+	{
+		CGoGNerr << "Unexpected end of file " << filename << CGoGNendl;
+		return false;
+	}
 
 	m_nbVertices = nbv;
 
+	VertexIdMap verticesMapID;
+	verticesMapID.build(ids, verticesID);
+	std::vector<unsigned int>().swap(ids);
+
 	// ELM
-	std::getline (fp, ligne);
+	while ((p < end) && !startsWith(p, end, "$ELM") && !startsWith(p, end, "$Elements"))
+		p = nextLine(p, end);
+	p = nextLine(p, end);
 
 	// reading number of elements
-	std::getline (fp, ligne);
-	unsigned int nbe=0;
-	std::stringstream oss2(ligne);
-	oss2 >> nbe;
+	unsigned int nbe = 0;
+	readUInt(p, end, nbe);
+	p = nextLine(p, end);
 
-	m_nbVolumes = nbe;
+	m_nbFaces.reserve(nbe);
+	m_emb.reserve(nbe*4);
 
+	// orientation of all volumes is given by the one of the first element
+	bool orientationKnown = false;
 	bool invertVol = false;
 
-	for(unsigned int i=0; i<nbe; ++i)
+	std::vector<ParsedVolume> volumes(std::min(nbe, NB_LINES_CHUNK));
+	bool valid = true;
+
+	auto parseElement = [&] (unsigned int, unsigned int slot, const char* b, const char* e)
 	{
-		unsigned int pipo,type_elm,nb;
-		fp >> pipo;
-		fp >> type_elm;
-		fp >> pipo;
-		fp >> pipo;
-		fp >> nb;
-
-		if ((type_elm==4) && (nb==4))
+		ParsedVolume& vol = volumes[slot];
+		vol = ParsedVolume();
+
+		// version 1: id type region elementary nb v0 ... / version 2: id type nbTags tags... v0 ...
+		unsigned int head[3];
+		if (!readUInts(b, e, head, 3))
+			return;
+		unsigned int type_elm = head[1];
+		unsigned int nb = 0;
+		if (version2)
 		{
-			Geom::Vec4ui v;
+			unsigned int tag;
+			for (unsigned int j = 0; j < head[2]; ++j)
+				readUInt(b, e, tag);
+			nb = (type_elm == 4) ? 4 : ((type_elm == 5) ? 8 : 0);
+		}
+		else
+		{
+			unsigned int elem;
+			readUInt(b, e, elem);
+			readUInt(b, e, nb);
+		}
 
-			m_nbFaces.push_back(4);
+		unsigned int v[8];
+		if (!(((type_elm == 4) && (nb == 4)) || ((type_elm == 5) && (nb == 8))) || !readUInts(b, e, v, nb))
+			return;
 
+		vol.nbFaces = short(nb);
+		vol.nbVertices = (unsigned short)(nb);
+		for (unsigned int j = 0; j < nb; ++j)
+			vol.emb[j] = verticesMapID(v[j]);
+		if (std::find(vol.emb, vol.emb + nb, EMBNULL) != vol.emb + nb)
+			return;
 
-			// test orientation of first tetra
-			if (i==0)
-			{
-				fp >> v[0];
-				fp >> v[1];
-				fp >> v[2];
-				fp >> v[3];
-
-				typename PFP::VEC3 P = position[verticesMapID[v[0]]];
-				typename PFP::VEC3 A = position[verticesMapID[v[1]]];
-				typename PFP::VEC3 B = position[verticesMapID[v[2]]];
-				typename PFP::VEC3 C = position[verticesMapID[v[3]]];
+		// test orientation of first element
+		if (!orientationKnown)
+		{
+			// tetrahedron: vertex 0 over face 1 2 3, hexahedron: vertex 4 over face 0 1 2
+			const unsigned int* f = (nb == 4) ? vol.emb + 1 : vol.emb;
+			const VEC3& P = position[vol.emb[(nb == 4) ? 0 : 4]];
+			const VEC3& A = position[f[0]];
+			const VEC3& B = position[f[1]];
+			const VEC3& C = position[f[2]];
+			invertVol = (Geom::testOrientation3D<VEC3>(P,A,B,C) == Geom::OVER);
+		}
 
-				if (Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::OVER)
-				{
-					invertVol=true;
-					unsigned int ui=v[0];
-					v[0] = v[3];
-					v[3] = v[2];
-					v[2] = v[1];
-					v[1] = ui;
-				}
-			}
+		if (invertVol)
+		{
+			if (nb == 4)
+				std::rotate(vol.emb, vol.emb + 3, vol.emb + 4);
 			else
 			{
-				if (invertVol)
-				{
-					fp >> v[1];
-					fp >> v[2];
-					fp >> v[3];
-					fp >> v[0];
-				}
-				else
-				{
-					fp >> v[0];
-					fp >> v[1];
-					fp >> v[2];
-					fp >> v[3];
-				}
+				std::reverse(vol.emb, vol.emb + 4);
+				std::reverse(vol.emb + 4, vol.emb + 8);
 			}
-			m_emb.push_back(verticesMapID[v[0]]);
-			m_emb.push_back(verticesMapID[v[1]]);
-			m_emb.push_back(verticesMapID[v[2]]);
-			m_emb.push_back(verticesMapID[v[3]]);
 		}
-		else
-		{
-			if ((type_elm==5) && (nb==8))
-			{
-				Geom::Vec4ui v;
+	};
 
-				m_nbFaces.push_back(8);
+	auto flush = [&] (unsigned int, unsigned int n)
+	{
+		valid = appendVolumes(volumes, n, m_nbFaces, m_emb) && valid;
+	};
 
-				if (i==0)
-				{
-					unsigned int last;
-					fp >> v[0];
-					fp >> v[1];
-					fp >> v[2];
-					fp >> v[3];
-					fp >> last;
-
-					typename PFP::VEC3 P = position[verticesMapID[last]];
-					typename PFP::VEC3 A = position[verticesMapID[v[0]]];
-					typename PFP::VEC3 B = position[verticesMapID[v[1]]];
-					typename PFP::VEC3 C = position[verticesMapID[v[2]]];
-
-					if (Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::OVER)
-					{
-
-						invertVol=true;
-						unsigned int ui = v[3];
-						v[3] = v[0];
-						v[0] = ui;
-						ui = v[2];
-						v[2] = v[1];
-						v[1] = ui;
-						// hexa.push_back(v);
-						m_emb.push_back(verticesMapID[v[0]]);
-						m_emb.push_back(verticesMapID[v[1]]);
-						m_emb.push_back(verticesMapID[v[2]]);
-						m_emb.push_back(verticesMapID[v[3]]);
-						v[3] = last;
-						fp >> v[2];
-						fp >> v[1];
-						fp >> v[0];
-						//hexa.push_back(v);
-						m_emb.push_back(verticesMapID[v[0]]);
-						m_emb.push_back(verticesMapID[v[1]]);
-						m_emb.push_back(verticesMapID[v[2]]);
-						m_emb.push_back(verticesMapID[v[3]]);
-					}
-					else
-					{
-						m_emb.push_back(verticesMapID[v[0]]);
-						m_emb.push_back(verticesMapID[v[1]]);
-						m_emb.push_back(verticesMapID[v[2]]);
-						m_emb.push_back(verticesMapID[v[3]]);
-						//hexa.push_back(v);
-						v[0] = last;
-						fp >> v[1];
-						fp >> v[2];
-						fp >> v[3];
-						//hexa.push_back(v);
-						m_emb.push_back(verticesMapID[v[0]]);
-						m_emb.push_back(verticesMapID[v[1]]);
-						m_emb.push_back(verticesMapID[v[2]]);
-						m_emb.push_back(verticesMapID[v[3]]);
-					}
-				}
-				else
-				{
-					if (invertVol)
-					{
-						fp >> v[3];
-						fp >> v[2];
-						fp >> v[1];
-						fp >> v[0];
-						m_emb.push_back(verticesMapID[v[0]]);
-						m_emb.push_back(verticesMapID[v[1]]);
-						m_emb.push_back(verticesMapID[v[2]]);
-						m_emb.push_back(verticesMapID[v[3]]);
-						//hexa.push_back(v);
-						fp >> v[3];
-						fp >> v[2];
-						fp >> v[1];
-						fp >> v[0];
-						m_emb.push_back(verticesMapID[v[0]]);
-						m_emb.push_back(verticesMapID[v[1]]);
-						m_emb.push_back(verticesMapID[v[2]]);
-						m_emb.push_back(verticesMapID[v[3]]);
-						//hexa.push_back(v);
-
-					}
-					else
-					{
-						fp >> v[0];
-						fp >> v[1];
-						fp >> v[2];
-						fp >> v[3];
-						m_emb.push_back(verticesMapID[v[0]]);
-						m_emb.push_back(verticesMapID[v[1]]);
-						m_emb.push_back(verticesMapID[v[2]]);
-						m_emb.push_back(verticesMapID[v[3]]);
-						//hexa.push_back(v);
-						fp >> v[0];
-						fp >> v[1];
-						fp >> v[2];
-						fp >> v[3];
-						m_emb.push_back(verticesMapID[v[0]]);
-						m_emb.push_back(verticesMapID[v[1]]);
-						m_emb.push_back(verticesMapID[v[2]]);
-						m_emb.push_back(verticesMapID[v[3]]);
-						//hexa.push_back(v);
-					}
-				}
-			}
-			else
-			{
-				for (unsigned int j=0; j<nb; ++j)
-				{
-					unsigned int v;
-					fp >> v;
-				}
-			}
-		}
-	}
+	nbRead = parseLines(p, end, std::min(nbe, 1u), parseElement, flush);
+	orientationKnown = true;
+	if (nbe > 1)
+		nbRead += parseLines(p, end, nbe - 1, parseElement, flush);
 
-	fp.close();
+	if (nbRead < nbe || !valid)
+	{
+		CGoGNerr << (valid ? "Unexpected end of file " : "Invalid vertex index in file ") << filename << CGoGNendl;
+		return false;
+	}
+	m_nbVolumes = unsigned(m_nbFaces.size());
 
 	return true;
 }
@@ -1723,190 +1520,121 @@ bool MeshTablesVolume<PFP>::importVTU(const std::string& filename, std::vector<s
 	//
 	AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
 
-
-	tinyxml2::XMLDocument doc;
-	tinyxml2::XMLError eResult = doc.LoadFile(filename.c_str());
-
-	if (XMLisError(eResult,"unable loading file"+filename))
+	MappedFile file;
+	if (!file.open(filename))
+	{
+		CGoGNerr << "unable loading file " << filename << CGoGNendl;
 		return false;
+	}
 
-	tinyxml2::XMLElement* vtu_node = doc.RootElement();
-
-	tinyxml2::XMLElement* grid_node = vtu_node->FirstChildElement("UnstructuredGrid");
-	tinyxml2::XMLElement* piece_node = grid_node->FirstChildElement("Piece");
-
-	eResult = piece_node->QueryUnsignedAttribute("NumberOfPoints",&m_nbVertices);
-	if (XMLisError(eResult,"unreadable VTU file: "+filename))
-		return false;
-	eResult = piece_node->QueryUnsignedAttribute("NumberOfCells",&m_nbVolumes);
-	if (XMLisError(eResult,"unreadable VTU file: "+filename))
+	// only the tags are scanned, DataArrays are decoded in place afterward
+	VTUReader vtu;
+	if (!vtu.parse(file.begin(), file.end()))
+	{
+		CGoGNerr << "unreadable VTU file: " << filename << " (" << vtu.error() << ")" << CGoGNendl;
 		return false;
+	}
+
+	m_nbVertices = vtu.nbPoints();
+	m_nbVolumes = vtu.nbCells();
 
 	CGoGNout << "Number of points = "<< m_nbVertices<< CGoGNendl;
 	CGoGNout << "Number of cells = "<< m_nbVolumes << CGoGNendl;
 
-	tinyxml2::XMLElement* points_node = piece_node->FirstChildElement("Points");
-	tinyxml2::XMLElement* array_node = points_node->FirstChildElement("DataArray");
-
 	std::vector<unsigned int> verticesID;
-	verticesID.reserve(m_nbVertices);
+	container.insertLines(m_nbVertices, verticesID);	// all the blocks are allocated at once
 
-	std::stringstream ss(array_node->GetText());
+	bool ok = vtu.template decode<REAL>(vtu.points(), 3 * std::size_t(m_nbVertices),
+		[&] (std::size_t i, REAL x) { position[verticesID[i/3]][i%3] = x; });
 
-	for (unsigned int i=0; i< m_nbVertices; ++i)
-	{
-		typename PFP::VEC3 P;
-		ss >> P[0]; ss >> P[1]; ss >> P[2];
-		unsigned int id = container.insertLine();
-		position[id] = P;
-		verticesID.push_back(id);
-	}
+	std::vector<unsigned int> offsets(m_nbVolumes);
+	ok = ok && vtu.template decode<unsigned int>(vtu.offsets(), m_nbVolumes,
+		[&] (std::size_t i, unsigned int o) { offsets[i] = o; });
 
-	tinyxml2::XMLElement* cell_node = piece_node->FirstChildElement("Cells");
-	array_node = cell_node->FirstChildElement("DataArray");
+	std::vector<unsigned char> typeVols(m_nbVolumes);
+	ok = ok && vtu.template decode<unsigned int>(vtu.types(), m_nbVolumes,
+		[&] (std::size_t i, unsigned int t) { typeVols[i] = (unsigned char)t; });
 
-	std::vector<unsigned char> typeVols;
-	typeVols.reserve(m_nbVolumes);
-	std::vector<unsigned int> offsets;
-	offsets.reserve(m_nbVolumes);
-	std::vector<unsigned int> indices;
-	indices.reserve(m_nbVolumes*4);
+	// connectivity is decoded straight into the table of embeddings
+	// that is then reordered and renumbered in place
+	const std::size_t nbIndices = (m_nbVolumes > 0) ? offsets.back() : 0;
+	m_emb.resize(nbIndices);
+	ok = ok && vtu.template decode<unsigned int>(vtu.connectivity(), nbIndices,
+		[&] (std::size_t i, unsigned int v) { m_emb[i] = v; });
 
-	while (array_node)
+	if (!ok)
 	{
-		std::string propName = XMLAttribute(array_node,"Name");
+		CGoGNerr << "Error reading VTU unreadable file: "<<filename<< CGoGNendl;
+		m_emb.clear();
+		return false;
+	}
 
-		if (propName == "")
+	Parallel::foreach_index(0, m_nbVolumes, [&] (unsigned int i, unsigned int)
+	{
+		const std::size_t b = (i == 0) ? 0 : offsets[i-1];
+		const std::size_t e = offsets[i];
+		unsigned int nb = (typeVols[i] == 12) ? 8 : ((typeVols[i] == 10) ? 4 : 0);
+		if ((nb == 0) || (e < b) || (e - b != nb) || (e > nbIndices))
 		{
-			CGoGNerr << "Error reading VTU unreadable file: "<<filename<< CGoGNendl;
-			return false;
+			typeVols[i] = 0;
+			return;
 		}
 
-		if (propName == "connectivity")
-		{
-			std::stringstream ss(array_node->GetText());
-			while (!ss.eof())
-			{
-				unsigned int ind;
-				ss >> ind;
-				indices.push_back(ind);
-			}
-		}
-		if (propName == "offsets")
-		{
-			std::stringstream ss(array_node->GetText());
-			for (unsigned int i=0; i< m_nbVolumes; ++i)
-			{
-				unsigned int o;
-				ss >> o;
-				offsets.push_back(o);
-			}
-		}
-		if (propName == "types")
+		unsigned int* pt = &m_emb[b];
+		for (unsigned int j = 0; j < nb; ++j)
 		{
-			bool unsupported = false;
-			std::stringstream ss(array_node->GetText());
-			for (unsigned int i=0; i< m_nbVolumes; ++i)
+			if (pt[j] >= m_nbVertices)
 			{
-				unsigned int t;
-				ss >> t;
-				if ((t != 12) && (t!= 10))
-				{
-					unsupported = true;
-					typeVols.push_back(0);
-				}
-				else
-				{
-					typeVols.push_back((unsigned char)t);
-				}
+				typeVols[i] = 0;
+				return;
 			}
-			if (unsupported)
-				CGoGNerr << "warning, some unsupported volume cell types"<< CGoGNendl;
+			pt[j] = verticesID[pt[j]];
 		}
-		array_node = array_node->NextSiblingElement("DataArray");
-	}
 
-	unsigned int currentOffset = 0;
-	for (unsigned int i=0; i< m_nbVolumes; ++i)
-	{
-		if (typeVols[i]==12)
+		if (nb == 8)
 		{
-			m_nbFaces.push_back(8);
+			const VEC3& P = position[pt[4]];
+			const VEC3& A = position[pt[0]];
+			const VEC3& B = position[pt[1]];
+			const VEC3& C = position[pt[2]];
 
-			unsigned int pt[8];
-			pt[0] = indices[currentOffset];
-			pt[1] = indices[currentOffset+1];
-			pt[2] = indices[currentOffset+2];
-			pt[3] = indices[currentOffset+3];
-			pt[4] = indices[currentOffset+4];
-			typename PFP::VEC3 P = position[verticesID[indices[currentOffset+4]]];
-			typename PFP::VEC3 A = position[verticesID[indices[currentOffset  ]]];
-			typename PFP::VEC3 B = position[verticesID[indices[currentOffset+1]]];
-			typename PFP::VEC3 C = position[verticesID[indices[currentOffset+2]]];
-
-			if (Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::OVER)
-			{
-
-				pt[0] = indices[currentOffset+3];
-				pt[1] = indices[currentOffset+2];
-				pt[2] = indices[currentOffset+1];
-				pt[3] = indices[currentOffset+0];
-				pt[4] = indices[currentOffset+7];
-				pt[5] = indices[currentOffset+6];
-				pt[6] = indices[currentOffset+5];
-				pt[7] = indices[currentOffset+4];
-			}
-			else
+			if (Geom::testOrientation3D<VEC3>(P,A,B,C) == Geom::OVER)
 			{
-				pt[0] = indices[currentOffset+0];
-				pt[1] = indices[currentOffset+1];
-				pt[2] = indices[currentOffset+2];
-				pt[3] = indices[currentOffset+3];
-				pt[4] = indices[currentOffset+4];
-				pt[5] = indices[currentOffset+5];
-				pt[6] = indices[currentOffset+6];
-				pt[7] = indices[currentOffset+7];
+				std::reverse(pt, pt + 4);
+				std::reverse(pt + 4, pt + 8);
 			}
-
-			m_emb.push_back(verticesID[pt[0]]);
-			m_emb.push_back(verticesID[pt[1]]);
-			m_emb.push_back(verticesID[pt[2]]);
-			m_emb.push_back(verticesID[pt[3]]);
-			m_emb.push_back(verticesID[pt[4]]);
-			m_emb.push_back(verticesID[pt[5]]);
-			m_emb.push_back(verticesID[pt[6]]);
-			m_emb.push_back(verticesID[pt[7]]);
-
 		}
-		else if (typeVols[i]==10)
+		else
 		{
-			m_nbFaces.push_back(4);
-
-			Geom::Vec4ui pt;
-			pt[0] = indices[currentOffset];
-			pt[1] = indices[currentOffset+1];
-			pt[2] = indices[currentOffset+2];
-			pt[3] = indices[currentOffset+3];
-
-			typename PFP::VEC3 P = position[verticesID[pt[0]]];
-			typename PFP::VEC3 A = position[verticesID[pt[1]]];
-			typename PFP::VEC3 B = position[verticesID[pt[2]]];
-			typename PFP::VEC3 C = position[verticesID[pt[3]]];
-
-			if (Geom::testOrientation3D<typename PFP::VEC3>(P,A,B,C) == Geom::OVER)
-			{
-				unsigned int ui=pt[1];
-				pt[1] = pt[2];
-				pt[2] = ui;
-			}
+			const VEC3& P = position[pt[0]];
+			const VEC3& A = position[pt[1]];
+			const VEC3& B = position[pt[2]];
+			const VEC3& C = position[pt[3]];
 
-			m_emb.push_back(verticesID[pt[0]]);
-			m_emb.push_back(verticesID[pt[1]]);
-			m_emb.push_back(verticesID[pt[2]]);
-			m_emb.push_back(verticesID[pt[3]]);
+			if (Geom::testOrientation3D<VEC3>(P,A,B,C) == Geom::OVER)
+				std::swap(pt[1], pt[2]);
 		}
-		currentOffset = offsets[i];
+	});
+
+	// unsupported cells are removed from the table
+	m_nbFaces.reserve(m_nbVolumes);
+	std::size_t last = 0;
+	for (unsigned int i = 0; i < m_nbVolumes; ++i)
+	{
+		if (typeVols[i] == 0)
+			continue;
+		const std::size_t b = (i == 0) ? 0 : offsets[i-1];
+		const unsigned int nb = (typeVols[i] == 12) ? 8 : 4;
+		m_nbFaces.push_back(short(nb));
+		if (last != b)
+			std::copy(m_emb.begin() + b, m_emb.begin() + b + nb, m_emb.begin() + last);
+		last += nb;
 	}
+	m_emb.resize(last);
+
+	if (m_nbFaces.size() < m_nbVolumes)
+		CGoGNerr << "warning, some unsupported volume cell types"<< CGoGNendl;
+	m_nbVolumes = unsigned(m_nbFaces.size());
 
 	return true;
 }
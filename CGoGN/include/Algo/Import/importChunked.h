@@ -0,0 +1,744 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef _IMPORT_CHUNKED_H
+#define _IMPORT_CHUNKED_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <atomic>
+#include <type_traits>
+
+#include "Topology/generic/dart.h"
+#include "Topology/generic/parallelLoop.h"
+
+#ifdef WIN32
+#ifndef CGoGN_ALGO_API
+#if defined CGoGN_ALGO_DLL_EXPORT
+#define CGoGN_ALGO_API __declspec(dllexport)
+#else
+#define CGoGN_ALGO_API __declspec(dllimport)
+#endif
+#endif
+#else
+#define CGoGN_ALGO_API
+#endif
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Volume
+{
+
+namespace Import
+{
+
+/**
+ * Read only view of a whole file.
+ * The file is memory mapped when the system allows it
+ * (it is read in one block otherwise), so that parsers
+ * can work on [begin(),end()) without any copy.
+ */
+class CGoGN_ALGO_API MappedFile
+{
+	const char* m_data;
+	std::size_t m_size;
+	void* m_mapping;
+	std::vector<char> m_buffer;
+
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+public:
+	MappedFile();
+
+	~MappedFile();
+
+	/**
+	 * map a file (a previously opened file is closed)
+	 * @return false if the file can not be read
+	 */
+	bool open(const std::string& filename);
+
+	void close();
+
+	inline bool isOpen() const { return m_data != NULL; }
+
+	inline const char* begin() const { return m_data; }
+
+	inline const char* end() const { return m_data + m_size; }
+
+	inline std::size_t size() const { return m_size; }
+};
+
+/**
+ * Number of lines whose starts are located before being parsed in parallel.
+ * Bounds the extra memory of line parsers whatever the size of the file.
+ */
+const unsigned int NB_LINES_CHUNK = 1 << 16;
+
+inline bool isBlank(char c)
+{
+	return (c == ' ') || (c == '\t') || (c == '\r');
+}
+
+inline bool isDigit(char c)
+{
+	return (c >= '0') && (c <= '9');
+}
+
+/**
+ * skip spaces, tabs and carriage returns (not end of lines)
+ */
+inline const char* skipBlanks(const char* p, const char* end)
+{
+	while ((p < end) && isBlank(*p))
+		++p;
+	return p;
+}
+
+/**
+ * @return position of the '\n' ending the line of p (or end)
+ */
+inline const char* endOfLine(const char* p, const char* end)
+{
+	while ((p < end) && (*p != '\n'))
+		++p;
+	return p;
+}
+
+/**
+ * @return start of the line following the line of p (or end)
+ */
+inline const char* nextLine(const char* p, const char* end)
+{
+	p = endOfLine(p, end);
+	return (p < end) ? p + 1 : end;
+}
+
+/**
+ * @return start of the first line from p that is not only made of blanks (or end)
+ */
+inline const char* skipEmptyLines(const char* p, const char* end)
+{
+	const char* q = skipBlanks(p, end);
+	while ((q < end) && (*q == '\n'))
+	{
+		p = q + 1;
+		q = skipBlanks(p, end);
+	}
+	return (q < end) ? p : end;
+}
+
+/**
+ * @return true if [p,end) starts with the null terminated string s
+ */
+inline bool startsWith(const char* p, const char* end, const char* s)
+{
+	while (*s != '\0')
+	{
+		if ((p >= end) || (*p != *s))
+			return false;
+		++p;
+		++s;
+	}
+	return true;
+}
+
+/**
+ * read an unsigned integer after optional blanks, p is moved after it
+ * @return false (p unchanged) if there is no number at p
+ */
+inline bool readUInt(const char*& p, const char* end, unsigned int& v)
+{
+	const char* q = skipBlanks(p, end);
+	if ((q < end) && (*q == '+'))
+		++q;
+	if ((q >= end) || !isDigit(*q))
+		return false;
+	unsigned int x = 0;
+	while ((q < end) && isDigit(*q))
+		x = x * 10 + (*q++ - '0');
+	v = x;
+	p = q;
+	return true;
+}
+
+/**
+ * read a signed integer after optional blanks, p is moved after it
+ * @return false (p unchanged) if there is no number at p
+ */
+inline bool readInt(const char*& p, const char* end, int& v)
+{
+	const char* q = skipBlanks(p, end);
+	bool neg = false;
+	if ((q < end) && ((*q == '-') || (*q == '+')))
+		neg = (*q++ == '-');
+	if ((q >= end) || !isDigit(*q))
+		return false;
+	unsigned int x;
+	readUInt(q, end, x);
+	v = neg ? -int(x) : int(x);
+	p = q;
+	return true;
+}
+
+/**
+ * read n unsigned integers
+ * @return false if one of them is missing
+ */
+inline bool readUInts(const char*& p, const char* end, unsigned int* v, unsigned int n)
+{
+	for (unsigned int i = 0; i < n; ++i)
+		if (!readUInt(p, end, v[i]))
+			return false;
+	return true;
+}
+
+/**
+ * read a decimal real number ([+-]digits[.digits][(e|E)[+-]digits])
+ * after optional blanks, p is moved after it.
+ * Does not need a null terminated buffer (unlike strtod)
+ * The number is computed directly in the floating point type T (float or double)
+ * when its digits fit in T
+ * @return false (p unchanged) if there is no number at p
+ */
+template <typename T>
+inline bool readReal(const char*& p, const char* end, T& v)
+{
+	static const double pow10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	const char* q = skipBlanks(p, end);
+	bool neg = false;
+	if ((q < end) && ((*q == '-') || (*q == '+')))
+		neg = (*q++ == '-');
+
+	unsigned long long m = 0;
+	unsigned int nbDigits = 0;
+	int e10 = 0;
+	bool digits = false;
+	while ((q < end) && isDigit(*q))
+	{
+		if (nbDigits < 19)
+		{
+			m = m * 10 + (*q - '0');
+			if (m != 0)
+				++nbDigits;
+		}
+		else
+			++e10;
+		digits = true;
+		++q;
+	}
+	if ((q < end) && (*q == '.'))
+	{
+		++q;
+		while ((q < end) && isDigit(*q))
+		{
+			if (nbDigits < 19)
+			{
+				m = m * 10 + (*q - '0');
+				if (m != 0)
+					++nbDigits;
+				--e10;
+			}
+			digits = true;
+			++q;
+		}
+	}
+	if (!digits)
+		return false;
+
+	if ((q < end) && ((*q == 'e') || (*q == 'E')))
+	{
+		const char* r = q + 1;
+		int e;
+		if ((r < end) && !isBlank(*r) && readInt(r, end, e))
+		{
+			e10 += e;
+			q = r;
+		}
+	}
+
+	// digits and power of ten exactly represented in T: computed in T with a
+	// single rounding. Otherwise (more digits than T holds) scaled in double
+	const int maxExactPow10 = (std::numeric_limits<T>::digits >= 53) ? 22 : 10;
+	T x;
+	if ((m < (1ull << std::numeric_limits<T>::digits)) && (e10 >= -maxExactPow10) && (e10 <= maxExactPow10))
+		x = (e10 >= 0) ? T(m) * T(pow10[e10]) : T(m) / T(pow10[-e10]);
+	else
+	{
+		double y = double(m);
+		if ((e10 >= 0) && (e10 <= 22))
+			y *= pow10[e10];
+		else if ((e10 < 0) && (e10 >= -22))
+			y /= pow10[-e10];
+		else
+			y *= std::pow(10.0, e10);
+		x = T(y);
+	}
+	v = neg ? -x : x;
+	p = q;
+	return true;
+}
+
+/**
+ * Parse the next nbLines non empty lines from p by chunks of NB_LINES_CHUNK lines:
+ * the lines of a chunk are located sequentially, then parsed in parallel,
+ * then the chunk is flushed sequentially (in file order).
+ * @param p current position, moved after the last parsed line
+ * @param end end of buffer
+ * @param nbLines maximum number of lines to parse
+ * @param parse void (unsigned int line, unsigned int slot, const char* begin, const char* end):
+ *        parse a line ([begin,end) without the '\n'), slot is the index of the line in its chunk.
+ *        Called concurrently: must only write data owned by its line or slot
+ * @param flush void (unsigned int firstLine, unsigned int nbLinesInChunk)
+ * @param nbth number of threads
+ * @return number of parsed lines (less than nbLines if end was reached)
+ */
+template <typename PARSE, typename FLUSH>
+unsigned int parseLines(const char*& p, const char* end, unsigned int nbLines, PARSE parse, FLUSH flush, unsigned int nbth = Parallel::NumberOfThreads)
+{
+	std::vector<const char*> lines;
+	lines.reserve(2 * std::min(nbLines, NB_LINES_CHUNK));
+
+	unsigned int done = 0;
+	while (done < nbLines)
+	{
+		unsigned int nbMax = std::min(nbLines - done, NB_LINES_CHUNK);
+		lines.clear();
+		unsigned int n = 0;
+		while (n < nbMax)
+		{
+			p = skipEmptyLines(p, end);
+			if (p >= end)
+				break;
+			const char* e = endOfLine(p, end);
+			lines.push_back(p);
+			lines.push_back(e);
+			p = (e < end) ? e + 1 : end;
+			++n;
+		}
+		if (n == 0)
+			break;
+
+		const unsigned int first = done;
+		Parallel::foreach_index(0, n, [&] (unsigned int i, unsigned int)
+		{
+			parse(first + i, i, lines[2*i], lines[2*i+1]);
+		}, nbth);
+
+		flush(first, n);
+		done += n;
+	}
+	return done;
+}
+
+/**
+ * Volume parsed from a line of a file: nbFaces is the code
+ * stored in MeshTablesVolume (0 for lines that are not a volume)
+ * and emb the embeddings of its nbVertices vertices.
+ */
+struct ParsedVolume
+{
+	short nbFaces;
+	unsigned short nbVertices;
+	unsigned int emb[8];
+
+	ParsedVolume(): nbFaces(0), nbVertices(0) {}
+};
+
+/**
+ * append the parsed volumes of a chunk to the tables of a MeshTablesVolume
+ * @return false if some embedding is EMBNULL (unknown vertex)
+ */
+inline bool appendVolumes(const std::vector<ParsedVolume>& vols, unsigned int nb, std::vector<short>& nbFaces, std::vector<unsigned int>& emb)
+{
+	bool ok = true;
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		const ParsedVolume& v = vols[i];
+		if (v.nbFaces == 0)
+			continue;
+		nbFaces.push_back(v.nbFaces);
+		for (unsigned int j = 0; j < v.nbVertices; ++j)
+		{
+			ok = ok && (v.emb[j] != EMBNULL);
+			emb.push_back(v.emb[j]);
+		}
+	}
+	return ok;
+}
+
+/**
+ * Map from vertex identifiers of a file to lines of the vertex container.
+ * Dense table when identifiers are compact, sorted table otherwise.
+ * Lookups are thread safe (unlike std::map::operator[]).
+ */
+class VertexIdMap
+{
+	unsigned int m_min;
+	std::vector<unsigned int> m_dense;
+	std::vector<std::pair<unsigned int, unsigned int> > m_sorted;
+
+public:
+	VertexIdMap(): m_min(0) {}
+
+	/**
+	 * build the map id[i] -> lines[i] (first occurrence wins for duplicated ids)
+	 */
+	void build(const std::vector<unsigned int>& ids, const std::vector<unsigned int>& lines)
+	{
+		m_dense.clear();
+		m_sorted.clear();
+		if (ids.empty())
+			return;
+
+		unsigned int mi = *std::min_element(ids.begin(), ids.end());
+		unsigned int ma = *std::max_element(ids.begin(), ids.end());
+		m_min = mi;
+
+		if (std::size_t(ma - mi) <= 2 * ids.size() + 1024)
+		{
+			m_dense.assign(std::size_t(ma - mi) + 1, EMBNULL);
+			for (std::size_t i = 0; i < ids.size(); ++i)
+			{
+				unsigned int& l = m_dense[ids[i] - mi];
+				if (l == EMBNULL)
+					l = lines[i];
+			}
+		}
+		else
+		{
+			m_sorted.reserve(ids.size());
+			for (std::size_t i = 0; i < ids.size(); ++i)
+				m_sorted.push_back(std::make_pair(ids[i], unsigned(i)));
+			std::sort(m_sorted.begin(), m_sorted.end());
+			for (std::size_t i = 0; i < m_sorted.size(); ++i)
+				m_sorted[i].second = lines[m_sorted[i].second];
+		}
+	}
+
+	/**
+	 * @return the line of vertex id or EMBNULL if unknown
+	 */
+	inline unsigned int operator()(unsigned int id) const
+	{
+		if (!m_dense.empty())
+		{
+			if ((id < m_min) || (id - m_min >= m_dense.size()))
+				return EMBNULL;
+			return m_dense[id - m_min];
+		}
+		std::vector<std::pair<unsigned int, unsigned int> >::const_iterator it =
+			std::lower_bound(m_sorted.begin(), m_sorted.end(), std::make_pair(id, 0u));
+		if ((it == m_sorted.end()) || (it->first != id))
+			return EMBNULL;
+		return it->second;
+	}
+};
+
+/**
+ * SAX like reader of VTK XML unstructured grid files (.vtu).
+ * parse() scans the tags of the file without building any document and only
+ * records where the DataArrays (points, connectivity, offsets, types) of the
+ * first Piece are. decode() then converts (in parallel) an array straight into
+ * the destination given by the caller.
+ * Data can be ascii, binary (base64) or appended (raw or base64), not compressed.
+ */
+class CGoGN_ALGO_API VTUReader
+{
+public:
+	enum DataType { VTU_UNKNOWN, VTU_INT8, VTU_UINT8, VTU_INT16, VTU_UINT16, VTU_INT32, VTU_UINT32, VTU_INT64, VTU_UINT64, VTU_FLOAT32, VTU_FLOAT64 };
+
+	enum DataFormat { VTU_ASCII, VTU_BINARY, VTU_APPENDED };
+
+	struct DataArray
+	{
+		DataType type;
+		DataFormat format;
+		unsigned int nbComponents;
+		/// offset in appended data
+		std::size_t offset;
+		/// content of the element (ascii and binary formats)
+		const char* begin;
+		const char* end;
+
+		DataArray(): type(VTU_UNKNOWN), format(VTU_ASCII), nbComponents(1), offset(0), begin(NULL), end(NULL) {}
+
+		inline bool isValid() const { return type != VTU_UNKNOWN; }
+	};
+
+protected:
+	const char* m_end;
+	unsigned int m_nbPoints;
+	unsigned int m_nbCells;
+	/// byte order of file is not the one of the host
+	bool m_swap;
+	/// size of the byte count header of binary data (UInt32 or UInt64)
+	unsigned int m_headerSize;
+	bool m_appendedBase64;
+	/// first byte after the '_' of AppendedData
+	const char* m_appended;
+
+	DataArray m_points;
+	DataArray m_connectivity;
+	DataArray m_offsets;
+	DataArray m_types;
+
+	std::string m_error;
+
+	static DataType dataType(const std::string& s);
+
+	/**
+	 * locate the binary data of an array (after its byte count header)
+	 * @param data first char of the stream holding the data
+	 * @param dataEnd end of available chars
+	 * @param base64 true if the stream is base64 encoded
+	 * @param offset byte offset of the first value in the decoded stream
+	 */
+	bool dataStream(const DataArray& a, const char*& data, const char*& dataEnd, bool& base64, std::size_t& offset) const;
+
+	static inline int base64Value(char c)
+	{
+		if ((c >= 'A') && (c <= 'Z')) return c - 'A';
+		if ((c >= 'a') && (c <= 'z')) return c - 'a' + 26;
+		if ((c >= '0') && (c <= '9')) return c - '0' + 52;
+		if (c == '+') return 62;
+		if (c == '/') return 63;
+		if (c == '=') return 0;
+		return -1;
+	}
+
+	template <typename T>
+	static T convert(const unsigned char* bytes, DataType t, bool swap);
+
+	template <typename T, typename STORE>
+	static bool decodeAscii(const char* begin, const char* end, std::size_t nbValues, STORE store, unsigned int nbth);
+
+public:
+	VTUReader();
+
+	/**
+	 * scan a VTU file held in [begin,end) (which must stay valid while decoding)
+	 * @return false if the file is not a readable unstructured grid (see error())
+	 */
+	bool parse(const char* begin, const char* end);
+
+	inline const std::string& error() const { return m_error; }
+
+	inline unsigned int nbPoints() const { return m_nbPoints; }
+
+	inline unsigned int nbCells() const { return m_nbCells; }
+
+	inline const DataArray& points() const { return m_points; }
+
+	inline const DataArray& connectivity() const { return m_connectivity; }
+
+	inline const DataArray& offsets() const { return m_offsets; }
+
+	inline const DataArray& types() const { return m_types; }
+
+	static unsigned int typeSize(DataType t);
+
+	/**
+	 * decode the nbValues first values of an array in parallel
+	 * @param store void (std::size_t index, T value), called concurrently for different indices
+	 * @return false if the array is missing, too short or not decodable
+	 */
+	template <typename T, typename STORE>
+	bool decode(const DataArray& a, std::size_t nbValues, STORE store, unsigned int nbth = Parallel::NumberOfThreads) const;
+};
+
+template <typename T>
+T VTUReader::convert(const unsigned char* bytes, DataType t, bool swap)
+{
+	unsigned char b[8];
+	unsigned int s = typeSize(t);
+	if (swap)
+	{
+		for (unsigned int j = 0; j < s; ++j)
+			b[j] = bytes[s - 1 - j];
+	}
+	else
+		std::memcpy(b, bytes, s);
+
+	switch (t)
+	{
+		case VTU_INT8:    { signed char x;        std::memcpy(&x, b, 1); return T(x); }
+		case VTU_UINT8:   { unsigned char x;      std::memcpy(&x, b, 1); return T(x); }
+		case VTU_INT16:   { short x;              std::memcpy(&x, b, 2); return T(x); }
+		case VTU_UINT16:  { unsigned short x;     std::memcpy(&x, b, 2); return T(x); }
+		case VTU_INT32:   { int x;                std::memcpy(&x, b, 4); return T(x); }
+		case VTU_UINT32:  { unsigned int x;       std::memcpy(&x, b, 4); return T(x); }
+		case VTU_INT64:   { long long x;          std::memcpy(&x, b, 8); return T(x); }
+		case VTU_UINT64:  { unsigned long long x; std::memcpy(&x, b, 8); return T(x); }
+		case VTU_FLOAT32: { float x;              std::memcpy(&x, b, 4); return T(x); }
+		case VTU_FLOAT64: { double x;             std::memcpy(&x, b, 8); return T(x); }
+		default: break;
+	}
+	return T(0);
+}
+
+template <typename T, typename STORE>
+bool VTUReader::decodeAscii(const char* begin, const char* end, std::size_t nbValues, STORE store, unsigned int nbth)
+{
+	// numbers are given to the chunk holding their first char:
+	// count them per chunk, then parse each chunk at its offset
+	const std::size_t CHUNK = 1 << 10;
+	const unsigned int nbChunks = unsigned((std::size_t(end - begin) + CHUNK - 1) / CHUNK);
+
+	auto isSpace = [] (char c) { return isBlank(c) || (c == '\n'); };
+	auto isStart = [&] (const char* q) { return !isSpace(*q) && ((q == begin) || isSpace(q[-1])); };
+
+	std::vector<std::size_t> first(nbChunks + 1, 0);
+	Parallel::foreach_index(0, nbChunks, [&] (unsigned int c, unsigned int)
+	{
+		const char* q = begin + c * CHUNK;
+		const char* e = std::min(q + CHUNK, end);
+		std::size_t n = 0;
+		for (; q < e; ++q)
+			if (isStart(q))
+				++n;
+		first[c + 1] = n;
+	}, nbth);
+
+	for (unsigned int c = 0; c < nbChunks; ++c)
+		first[c + 1] += first[c];
+	if (first[nbChunks] < nbValues)
+		return false;
+
+	std::atomic<bool> ok(true);
+	Parallel::foreach_index(0, nbChunks, [&] (unsigned int c, unsigned int)
+	{
+		const char* q = begin + c * CHUNK;
+		const char* e = std::min(q + CHUNK, end);
+		std::size_t i = first[c];
+		while ((q < e) && !isStart(q))
+			++q;
+		while ((q < e) && (i < nbValues))
+		{
+			// reals are read in their own type, integers through a double
+			typename std::conditional<std::is_floating_point<T>::value, T, double>::type x;
+			if (!readReal(q, end, x))
+			{
+				ok = false;
+				return;
+			}
+			store(i++, T(x));
+			while ((q < end) && isSpace(*q))
+				++q;
+		}
+	}, nbth);
+
+	return ok;
+}
+
+template <typename T, typename STORE>
+bool VTUReader::decode(const DataArray& a, std::size_t nbValues, STORE store, unsigned int nbth) const
+{
+	if (!a.isValid())
+		return false;
+
+	if (a.format == VTU_ASCII)
+		return decodeAscii<T>(a.begin, a.end, nbValues, store, nbth);
+
+	const char* data;
+	const char* dataEnd;
+	bool base64;
+	std::size_t offset;
+	if (!dataStream(a, data, dataEnd, base64, offset))
+		return false;
+
+	const std::size_t s = typeSize(a.type);
+	const std::size_t nbBytes = offset + nbValues * s;
+	const DataType type = a.type;
+	const bool swap = m_swap;
+
+	if (!base64)
+	{
+		if (std::size_t(dataEnd - data) < nbBytes)
+			return false;
+		const unsigned char* raw = reinterpret_cast<const unsigned char*>(data + offset);
+		Parallel::foreach_index(0, unsigned(nbValues), [&] (unsigned int i, unsigned int)
+		{
+			store(i, convert<T>(raw + i * s, type, swap));
+		}, nbth);
+		return true;
+	}
+
+	if (std::size_t(dataEnd - data) < 4 * ((nbBytes + 2) / 3))
+		return false;
+
+	// each value is decoded from the (at most 4) groups of 4 chars holding its bytes
+	std::atomic<bool> ok(true);
+	Parallel::foreach_index(0, unsigned(nbValues), [&] (unsigned int i, unsigned int)
+	{
+		unsigned char bytes[12];
+		const std::size_t b = offset + i * s;
+		const std::size_t g0 = b / 3;
+		const std::size_t g1 = (b + s - 1) / 3;
+		for (std::size_t g = g0; g <= g1; ++g)
+		{
+			const char* q = data + 4 * g;
+			int v0 = base64Value(q[0]);
+			int v1 = base64Value(q[1]);
+			int v2 = base64Value(q[2]);
+			int v3 = base64Value(q[3]);
+			if ((v0 | v1 | v2 | v3) < 0)
+			{
+				ok = false;
+				return;
+			}
+			unsigned char* o = bytes + 3 * (g - g0);
+			o[0] = (unsigned char)((v0 << 2) | (v1 >> 4));
+			o[1] = (unsigned char)((v1 << 4) | (v2 >> 2));
+			o[2] = (unsigned char)((v2 << 6) | v3);
+		}
+		store(i, convert<T>(bytes + (b - 3 * g0), type, swap));
+	}, nbth);
+
+	return ok;
+}
+
+} // namespace Import
+
+} // namespace Volume
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#endif
@@ -0,0 +1,152 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __LINEAR_SOLVING_LAPLACIAN_SOLVER__
+#define __LINEAR_SOLVING_LAPLACIAN_SOLVER__
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+#include "Topology/generic/cellmarker.h"
+#include "Topology/generic/parallelLoop.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace LinearSolving
+{
+
+/**
+ * Least squares Laplacian system with locked (constrained) vertices,
+ * the same system as setupVariables + addRowsRHS_Laplacian_Topo/Cotan
+ * (rows normalized) but kept between solves:
+ * - the Laplacian is assembled once in a compressed sparse matrix (in parallel)
+ * - the normal equations of the free vertices are factorized when the set
+ *   of locked vertices changes (symbolic + numeric) or when the weights change
+ *   (numeric only)
+ * - moving the locked vertices or changing the right hand side only needs a solve
+ * The map topology must not change (build a new solver otherwise).
+ */
+template <typename PFP>
+class LaplacianSolver
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	typedef Eigen::SparseMatrix<double, Eigen::RowMajor> RowMatrix ;
+	typedef Eigen::SparseMatrix<double, Eigen::ColMajor> ColMatrix ;
+
+protected:
+	MAP& m_map ;
+	VertexAttribute<unsigned int, MAP> m_index ;
+	unsigned int m_nbThreads ;
+
+	// a dart of each vertex (by index)
+	std::vector<Dart> m_vertices ;
+
+	// Laplacian, one normalized row per vertex
+	RowMatrix m_laplacian ;
+
+	// locked vertices and rank of each vertex among the free or the locked ones
+	std::vector<unsigned char> m_locked ;
+	std::vector<unsigned int> m_rank ;
+	std::vector<unsigned int> m_free ;
+	std::vector<unsigned int> m_lockedVertices ;
+	bool m_constrained ;
+
+	// columns of the free vertices, of the locked vertices and normal matrix of the free ones
+	ColMatrix m_lapFree ;
+	RowMatrix m_lapLocked ;
+	ColMatrix m_normal ;
+
+	Eigen::SimplicialLDLT<ColMatrix> m_solver ;
+	bool m_factorized ;
+
+	template <typename WEIGHT>
+	void assemble(const WEIGHT& weight) ;
+
+	void splitColumns() ;
+
+	void factorize(bool symbolic) ;
+
+	template <typename RHS, typename GET, typename SET>
+	bool solveComponents(unsigned int nbComp, const RHS& rhs, const GET& value, const SET& result) ;
+
+public:
+	/**
+	 * @param index vertex indices in [0,nbVertices[ (computeIndexCells<VERTEX>)
+	 */
+	LaplacianSolver(MAP& map, const VertexAttribute<unsigned int, MAP>& index, unsigned int nbVertices, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+	/**
+	 * topological Laplacian (addRows_Laplacian_Topo)
+	 */
+	void setTopoWeights() ;
+
+	/**
+	 * cotan Laplacian (addRows_Laplacian_Cotan), with weights of computeCotanWeightEdges
+	 */
+	void setCotanWeights(const EdgeAttribute<REAL, MAP>& edgeWeight, const VertexAttribute<REAL, MAP>& vertexArea) ;
+
+	/**
+	 * lock the vertices that are not marked by freeMarker
+	 * the system is factorized again only if the set of locked vertices changed
+	 * @return true if a factorization was computed
+	 */
+	bool setConstraints(const CellMarker<MAP, VERTEX>& freeMarker) ;
+
+	/**
+	 * force a new factorization at next setConstraints
+	 */
+	void resetConstraints() { m_constrained = false ; }
+
+	bool isFactorized() const { return m_factorized ; }
+
+	/**
+	 * solve the system for the free vertices
+	 * @param rhs right hand side (Laplacian coordinates) of each vertex
+	 * @param attr in: values of locked vertices, out: values of free vertices
+	 * @return false if the system could not be factorized
+	 */
+	bool solve(const VertexAttribute<VEC3, MAP>& rhs, VertexAttribute<VEC3, MAP>& attr) ;
+
+	bool solve(const VertexAttribute<VEC3, MAP>& rhs, VertexAttribute<VEC3, MAP>& attr, unsigned int coord) ;
+
+	bool solve(const VertexAttribute<REAL, MAP>& rhs, VertexAttribute<REAL, MAP>& attr) ;
+} ;
+
+} // namespace LinearSolving
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/LinearSolving/laplacianSolver.hpp"
+
+#endif
@@ -0,0 +1,368 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Topology/generic/traversor/traversorCell.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace LinearSolving
+{
+
+template <typename PFP>
+LaplacianSolver<PFP>::LaplacianSolver(MAP& map, const VertexAttribute<unsigned int, MAP>& index, unsigned int nbVertices, unsigned int nbth) :
+	m_map(map),
+	m_index(index),
+	m_nbThreads(nbth),
+	m_vertices(nbVertices),
+	m_locked(nbVertices, 0),
+	m_rank(nbVertices),
+	m_constrained(false),
+	m_factorized(false)
+{
+	foreach_cell<VERTEX>(m_map, [&] (Vertex v)
+	{
+		m_vertices[m_index[v]] = v.dart ;
+	});
+}
+
+template <typename PFP>
+template <typename WEIGHT>
+void LaplacianSolver<PFP>::assemble(const WEIGHT& weight)
+{
+	const unsigned int nbV = (unsigned int)(m_vertices.size()) ;
+
+	// buffer of (degree + 1) entries for each row
+	std::vector<int> first(nbV + 1) ;
+	first[0] = 0 ;
+	for (unsigned int v = 0; v < nbV; ++v)
+	{
+		unsigned int deg = 1 ;
+		Dart d = m_vertices[v] ;
+		Dart it = d ;
+		do
+		{
+			++deg ;
+			it = m_map.phi2(m_map.phi_1(it)) ;
+		} while (it != d) ;
+		first[v+1] = first[v] + deg ;
+	}
+
+	std::vector<int> cols(first[nbV]) ;
+	std::vector<double> vals(first[nbV]) ;
+	std::vector<int> sizes(nbV + 1) ;
+
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		int* c = &cols[first[v]] ;
+		double* a = &vals[first[v]] ;
+		unsigned int k = 0 ;
+
+		double aii = 0 ;
+		Dart d = m_vertices[v] ;
+		Dart it = d ;
+		do
+		{
+			double aij = weight(it, d) ;
+			aii += aij ;
+			c[k] = int(m_index[m_map.phi1(it)]) ;
+			a[k] = aij ;
+			++k ;
+			it = m_map.phi2(m_map.phi_1(it)) ;
+		} while (it != d) ;
+		c[k] = int(v) ;
+		a[k] = -aii ;
+		++k ;
+
+		// sort the (few) entries of the row by column and merge multiple edges
+		for (unsigned int i = 1; i < k; ++i)
+		{
+			for (unsigned int j = i; j > 0 && c[j] < c[j-1]; --j)
+			{
+				std::swap(c[j], c[j-1]) ;
+				std::swap(a[j], a[j-1]) ;
+			}
+		}
+		unsigned int nb = 0 ;
+		for (unsigned int i = 0; i < k; ++i)
+		{
+			if (nb > 0 && c[nb-1] == c[i])
+				a[nb-1] += a[i] ;
+			else
+			{
+				c[nb] = c[i] ;
+				a[nb] = a[i] ;
+				++nb ;
+			}
+		}
+
+		// same as NL_NORMALIZE_ROWS
+		double norm2 = 0 ;
+		for (unsigned int i = 0; i < nb; ++i)
+			norm2 += a[i] * a[i] ;
+		if (norm2 > 0)
+		{
+			double s = 1.0 / std::sqrt(norm2) ;
+			for (unsigned int i = 0; i < nb; ++i)
+				a[i] *= s ;
+		}
+
+		sizes[v] = int(nb) ;
+	}, m_nbThreads) ;
+
+	// compact the rows
+	std::vector<int> outer(nbV + 1) ;
+	outer[0] = 0 ;
+	for (unsigned int v = 0; v < nbV; ++v)
+		outer[v+1] = outer[v] + sizes[v] ;
+
+	std::vector<int> inner(outer[nbV]) ;
+	std::vector<double> values(outer[nbV]) ;
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		std::copy(cols.begin() + first[v], cols.begin() + first[v] + sizes[v], inner.begin() + outer[v]) ;
+		std::copy(vals.begin() + first[v], vals.begin() + first[v] + sizes[v], values.begin() + outer[v]) ;
+	}, m_nbThreads) ;
+
+	m_laplacian = Eigen::MappedSparseMatrix<double, Eigen::RowMajor>(nbV, nbV, outer[nbV], &outer[0], &inner[0], &values[0]) ;
+}
+
+template <typename PFP>
+void LaplacianSolver<PFP>::splitColumns()
+{
+	const unsigned int nbV = (unsigned int)(m_vertices.size()) ;
+
+	std::vector<int> outerF(nbV + 1) ;
+	std::vector<int> outerL(nbV + 1) ;
+	outerF[0] = 0 ;
+	outerL[0] = 0 ;
+	for (unsigned int v = 0; v < nbV; ++v)
+	{
+		int nbF = 0 ;
+		for (RowMatrix::InnerIterator it(m_laplacian, v); it; ++it)
+			nbF += m_locked[it.index()] ? 0 : 1 ;
+		outerF[v+1] = outerF[v] + nbF ;
+		outerL[v+1] = outerL[v] + int(m_laplacian.outerIndexPtr()[v+1] - m_laplacian.outerIndexPtr()[v]) - nbF ;
+	}
+
+	std::vector<int> innerF(std::max(outerF[nbV], 1)) ;
+	std::vector<double> valuesF(std::max(outerF[nbV], 1)) ;
+	std::vector<int> innerL(std::max(outerL[nbV], 1)) ;
+	std::vector<double> valuesL(std::max(outerL[nbV], 1)) ;
+
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		int f = outerF[v] ;
+		int l = outerL[v] ;
+		for (RowMatrix::InnerIterator it(m_laplacian, v); it; ++it)
+		{
+			if (m_locked[it.index()])
+			{
+				innerL[l] = int(m_rank[it.index()]) ;
+				valuesL[l++] = it.value() ;
+			}
+			else
+			{
+				innerF[f] = int(m_rank[it.index()]) ;
+				valuesF[f++] = it.value() ;
+			}
+		}
+	}, m_nbThreads) ;
+
+	const int nbFree = int(m_free.size()) ;
+	const int nbLocked = int(nbV) - nbFree ;
+	m_lapFree = Eigen::MappedSparseMatrix<double, Eigen::RowMajor>(nbV, nbFree, outerF[nbV], &outerF[0], &innerF[0], &valuesF[0]) ;
+	m_lapLocked = Eigen::MappedSparseMatrix<double, Eigen::RowMajor>(nbV, nbLocked, outerL[nbV], &outerL[0], &innerL[0], &valuesL[0]) ;
+}
+
+template <typename PFP>
+void LaplacianSolver<PFP>::factorize(bool symbolic)
+{
+	m_factorized = false ;
+	if (m_free.empty())
+		return ;
+
+	typename ColMatrix::Index nnz = m_normal.nonZeros() ;
+	m_normal = ColMatrix(m_lapFree.transpose()) * m_lapFree ;
+
+	// same pattern when only the weights changed (unless some become 0)
+	if (symbolic || m_normal.nonZeros() != nnz)
+		m_solver.analyzePattern(m_normal) ;
+	m_solver.factorize(m_normal) ;
+
+	m_factorized = (m_solver.info() == Eigen::Success) ;
+}
+
+template <typename PFP>
+void LaplacianSolver<PFP>::setTopoWeights()
+{
+	assemble([] (Dart, Dart) { return 1.0 ; }) ;
+
+	if (m_constrained)
+	{
+		splitColumns() ;
+		factorize(false) ;
+	}
+}
+
+template <typename PFP>
+void LaplacianSolver<PFP>::setCotanWeights(const EdgeAttribute<REAL, MAP>& edgeWeight, const VertexAttribute<REAL, MAP>& vertexArea)
+{
+	assemble([&] (Dart e, Dart v) { return double(edgeWeight[e] / vertexArea[v]) ; }) ;
+
+	if (m_constrained)
+	{
+		splitColumns() ;
+		factorize(false) ;
+	}
+}
+
+template <typename PFP>
+bool LaplacianSolver<PFP>::setConstraints(const CellMarker<MAP, VERTEX>& freeMarker)
+{
+	const unsigned int nbV = (unsigned int)(m_vertices.size()) ;
+
+	bool changed = !m_constrained ;
+	for (unsigned int v = 0; v < nbV; ++v)
+	{
+		unsigned char locked = freeMarker.isMarked(m_vertices[v]) ? 0 : 1 ;
+		if (locked != m_locked[v])
+		{
+			m_locked[v] = locked ;
+			changed = true ;
+		}
+	}
+	if (!changed)
+		return false ;
+
+	m_free.clear() ;
+	m_lockedVertices.clear() ;
+	for (unsigned int v = 0; v < nbV; ++v)
+	{
+		if (m_locked[v])
+		{
+			m_rank[v] = (unsigned int)(m_lockedVertices.size()) ;
+			m_lockedVertices.push_back(v) ;
+		}
+		else
+		{
+			m_rank[v] = (unsigned int)(m_free.size()) ;
+			m_free.push_back(v) ;
+		}
+	}
+
+	splitColumns() ;
+	factorize(true) ;
+	m_constrained = true ;
+
+	return true ;
+}
+
+template <typename PFP>
+template <typename RHS, typename GET, typename SET>
+bool LaplacianSolver<PFP>::solveComponents(unsigned int nbComp, const RHS& rhs, const GET& value, const SET& result)
+{
+	if (!m_factorized)
+		return false ;
+
+	const unsigned int nbV = (unsigned int)(m_vertices.size()) ;
+	const unsigned int nbFree = (unsigned int)(m_free.size()) ;
+
+	// residual of the rows with the locked values
+	Eigen::MatrixXd r(nbV, nbComp) ;
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		for (unsigned int c = 0; c < nbComp; ++c)
+		{
+			double x = rhs(v, c) ;
+			for (RowMatrix::InnerIterator it(m_lapLocked, v); it; ++it)
+				x -= it.value() * value(m_lockedVertices[it.index()], c) ;
+			r(v, c) = x ;
+		}
+	}, m_nbThreads) ;
+
+	// right hand side of the normal equations
+	Eigen::MatrixXd b(nbFree, nbComp) ;
+	CGoGN::Parallel::foreach_index(0, nbFree, [&] (unsigned int j, unsigned int)
+	{
+		for (unsigned int c = 0; c < nbComp; ++c)
+		{
+			double x = 0 ;
+			for (ColMatrix::InnerIterator it(m_lapFree, j); it; ++it)
+				x += it.value() * r(it.index(), c) ;
+			b(j, c) = x ;
+		}
+	}, m_nbThreads) ;
+
+	Eigen::MatrixXd x = m_solver.solve(b) ;
+	if (m_solver.info() != Eigen::Success)
+		return false ;
+
+	CGoGN::Parallel::foreach_index(0, nbFree, [&] (unsigned int j, unsigned int)
+	{
+		for (unsigned int c = 0; c < nbComp; ++c)
+			result(m_free[j], c, x(j, c)) ;
+	}, m_nbThreads) ;
+
+	return true ;
+}
+
+template <typename PFP>
+bool LaplacianSolver<PFP>::solve(const VertexAttribute<VEC3, MAP>& rhs, VertexAttribute<VEC3, MAP>& attr)
+{
+	return solveComponents(3,
+		[&] (unsigned int v, unsigned int c) { return double(rhs[m_vertices[v]][c]) ; },
+		[&] (unsigned int v, unsigned int c) { return double(attr[m_vertices[v]][c]) ; },
+		[&] (unsigned int v, unsigned int c, double x) { attr[m_vertices[v]][c] = REAL(x) ; }) ;
+}
+
+template <typename PFP>
+bool LaplacianSolver<PFP>::solve(const VertexAttribute<VEC3, MAP>& rhs, VertexAttribute<VEC3, MAP>& attr, unsigned int coord)
+{
+	return solveComponents(1,
+		[&] (unsigned int v, unsigned int) { return double(rhs[m_vertices[v]][coord]) ; },
+		[&] (unsigned int v, unsigned int) { return double(attr[m_vertices[v]][coord]) ; },
+		[&] (unsigned int v, unsigned int, double x) { attr[m_vertices[v]][coord] = REAL(x) ; }) ;
+}
+
+template <typename PFP>
+bool LaplacianSolver<PFP>::solve(const VertexAttribute<REAL, MAP>& rhs, VertexAttribute<REAL, MAP>& attr)
+{
+	return solveComponents(1,
+		[&] (unsigned int v, unsigned int) { return double(rhs[m_vertices[v]]) ; },
+		[&] (unsigned int v, unsigned int) { return double(attr[m_vertices[v]]) ; },
+		[&] (unsigned int v, unsigned int, double x) { attr[m_vertices[v]] = REAL(x) ; }) ;
+}
+
+} // namespace LinearSolving
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -205,6 +205,49 @@ void computeBoundaryConstraintDual(typename PFP::MAP& map, VertexAttribute<typen
 template <typename PFP>
 void computeBoundaryConstraintKeepingOldVerticesDual(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position);
 
+namespace Parallel
+{
+
+/**
+ * Catmull-Clark subdivision scheme, bulk parallel version
+ * The number of new darts and vertices is known in advance: they are all
+ * allocated at once, then the new topology is written from flat index
+ * tables and the stencils are evaluated in parallel.
+ * Only for maps based on MapMono with only vertices (and darts) embedded,
+ * other maps fall back to the sequential version.
+ * Boundary vertices use the cubic B-spline boundary rule.
+ * @param nbth number of threads
+ */
+template <typename PFP, typename EMBV>
+void CatmullClarkSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+/**
+ * Loop subdivision scheme, bulk parallel version
+ * (same conditions as Parallel::CatmullClarkSubdivision, non boundary faces must be triangles).
+ * Unlike the sequential version, new vertex positions are all computed from the old ones.
+ * @param nbth number of threads
+ */
+template <typename PFP, typename EMBV>
+void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+/**
+ * 2N+1 subdivision scheme, bulk parallel version
+ * (same conditions as Parallel::CatmullClarkSubdivision, the map must be closed).
+ * @param nbth number of threads
+ */
+template <typename PFP, typename EMBV>
+void TwoNPlusOneSubdivision(typename PFP::MAP& map, EMBV& attributs, float size, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+/**
+ * Doo-Sabin subdivision scheme, bulk parallel version
+ * (same conditions as Parallel::CatmullClarkSubdivision, the map must be closed).
+ * @param nbth number of threads
+ */
+template <typename PFP, typename EMBV>
+void DooSabin(typename PFP::MAP& map, EMBV& position, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+} // namespace Parallel
+
 } // namespace Modelisation
 
 } // namespace Surface
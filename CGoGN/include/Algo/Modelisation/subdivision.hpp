@@ -25,6 +25,8 @@
 #include "Algo/Geometry/basic.h"
 #include "Algo/Geometry/centroid.h"
 #include "Topology/generic/autoAttributeHandler.h"
+#include "Topology/generic/parallelLoop.h"
+#include "Topology/generic/mapBuilder.h"
 
 
 namespace CGoGN
@@ -1180,6 +1182,692 @@ void computeBoundaryConstraintKeepingOldVerticesDual(typename PFP::MAP& map, Ver
 	}
 }
 
+
+namespace Parallel
+{
+
+/**
+ * flat index tables of a surface map used by the bulk subdivisions
+ * (tables indexed by dart index: rank, edgeOf, faceOf, boundary)
+ */
+template <typename MAP>
+class SubdivisionTables
+{
+public:
+	std::vector<Dart> darts;				// all darts of the map
+	std::vector<Dart> edges;				// one dart per edge (non boundary one if any)
+	std::vector<Dart> faces;				// one dart per non boundary face
+	std::vector<Dart> vertices;				// one dart per vertex
+	std::vector<unsigned int> rank;			// rank of each dart in darts
+	std::vector<unsigned int> edgeOf;		// edge of each dart
+	std::vector<unsigned int> faceOf;		// face of each dart (EMBNULL on boundary)
+	std::vector<unsigned char> boundary;	// boundary mark of each dart
+	std::vector<unsigned int> phi1Of;		// rank of phi1 of each dart (indexed by rank, see snapshotRelations)
+	std::vector<unsigned int> phi_1Of;		// rank of phi_1 of each dart
+	std::vector<unsigned int> phi2Of;		// rank of phi2 of each dart
+
+	SubdivisionTables(MAP& map)
+	{
+		unsigned int nbIdx = map.template getAttributeContainer<DART>().realEnd();
+		rank.resize(nbIdx, EMBNULL);
+		edgeOf.resize(nbIdx, EMBNULL);
+		faceOf.resize(nbIdx, EMBNULL);
+		boundary.resize(nbIdx, 0);
+
+		darts.reserve(map.getNbDarts());
+		for (Dart d = map.begin(); d != map.end(); map.next(d))
+		{
+			rank[d.index] = uint32(darts.size());
+			boundary[d.index] = map.template isBoundaryMarked<2>(d) ? 1 : 0;
+			darts.push_back(d);
+		}
+
+		std::vector<unsigned char> vertexDone(map.template getAttributeContainer<VERTEX>().realEnd(), 0);
+		edges.reserve(darts.size() / 2);
+		for (typename std::vector<Dart>::const_iterator it = darts.begin(); it != darts.end(); ++it)
+		{
+			Dart d = *it;
+			if (edgeOf[d.index] == EMBNULL)
+			{
+				Dart dd = map.phi2(d);
+				edgeOf[d.index] = uint32(edges.size());
+				edgeOf[dd.index] = uint32(edges.size());
+				edges.push_back(boundary[d.index] ? dd : d);
+			}
+			if (!boundary[d.index] && faceOf[d.index] == EMBNULL)
+			{
+				Dart it2 = d;
+				do
+				{
+					faceOf[it2.index] = uint32(faces.size());
+					it2 = map.phi1(it2);
+				} while (it2 != d);
+				faces.push_back(d);
+			}
+			unsigned int v = map.template getEmbedding<VERTEX>(d);
+			if (!vertexDone[v])
+			{
+				vertexDone[v] = 1;
+				vertices.push_back(d);
+			}
+		}
+	}
+
+	/**
+	 * store the relations of the darts as ranks, so that they can be read
+	 * while the relations of the map are rewritten in parallel
+	 */
+	void snapshotRelations(MAP& map, unsigned int nbth)
+	{
+		const unsigned int nbD = uint32(darts.size());
+		phi1Of.resize(nbD);
+		phi_1Of.resize(nbD);
+		phi2Of.resize(nbD);
+		CGoGN::Parallel::foreach_index(0, nbD, [&] (unsigned int i, unsigned int)
+		{
+			Dart d = darts[i];
+			phi1Of[i] = rank[map.phi1(d).index];
+			phi_1Of[i] = rank[map.phi_1(d).index];
+			phi2Of[i] = rank[map.phi2(d).index];
+		}, nbth);
+	}
+};
+
+/**
+ * test if the map can be subdivided with the bulk parallel algorithms
+ */
+template <typename MAP>
+bool bulkSubdivisionAllowed(const MAP& map)
+{
+	if (!BulkConstructible<MAP>::value || !map.template isOrbitEmbedded<VERTEX>())
+		return false;
+	for (unsigned int orbit = EDGE; orbit < NB_ORBITS; ++orbit)
+	{
+		if (map.isOrbitEmbedded(orbit))
+			return false;
+	}
+	return true;
+}
+
+/**
+ * test if the map has boundary darts
+ */
+template <typename MAP>
+bool hasBoundary(const MAP& map)
+{
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		if (map.template isBoundaryMarked<2>(d))
+			return true;
+	}
+	return false;
+}
+
+/**
+ * new position of a boundary vertex (cubic B-spline rule), return false if vertex is not on boundary
+ */
+template <typename PFP, typename EMBV>
+bool boundaryVertexPoint(typename PFP::MAP& map, const EMBV& attributs, Dart v, typename EMBV::DATA_TYPE& res)
+{
+	Dart x = v;
+	do
+	{
+		if (map.template isBoundaryMarked<2>(x))
+		{
+			res = attributs[x] * 6.0f;
+			res += attributs[map.phi1(x)];
+			res += attributs[map.phi_1(x)];
+			res /= 8.0f;
+			return true;
+		}
+		x = map.phi2_1(x);
+	} while (x != v);
+	return false;
+}
+
+template <typename PFP, typename EMBV>
+void CatmullClarkSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbth)
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename EMBV::DATA_TYPE EMB;
+
+	if (!bulkSubdivisionAllowed<MAP>(map))
+	{
+		Modelisation::CatmullClarkSubdivision<PFP, EMBV>(map, attributs);
+		return;
+	}
+
+	SubdivisionTables<MAP> tab(map);
+	const unsigned int nbD = uint32(tab.darts.size());
+	const unsigned int nbE = uint32(tab.edges.size());
+	const unsigned int nbF = uint32(tab.faces.size());
+	const unsigned int nbV = uint32(tab.vertices.size());
+
+	// each non boundary dart gives 3 new darts (second half of edge, two inner edges)
+	// each boundary dart gives 1 new dart (second half of edge)
+	std::vector<unsigned int> first(nbD + 1);
+	first[0] = 0;
+	for (unsigned int i = 0; i < nbD; ++i)
+		first[i + 1] = first[i] + (tab.boundary[tab.darts[i].index] ? 1 : 3);
+
+	// allocate all new darts and vertices at once (edge points then face points)
+	MapBuilder<MAP> mp(map, nbth);
+	mp.newDarts(first[nbD]);
+	mp.template newCells<VERTEX>(nbE + nbF);
+	auto nd = [&] (unsigned int i) { return mp.dart(i); };
+	auto ev = [&] (unsigned int e) { return mp.template cell<VERTEX>(e); };
+	auto fv = [&] (unsigned int f) { return mp.template cell<VERTEX>(nbE + f); };
+
+	AttributeContainer& vcont = map.template getAttributeContainer<VERTEX>();
+
+	// face points
+	CGoGN::Parallel::foreach_index(0, nbF, [&] (unsigned int f, unsigned int)
+	{
+		Dart d = tab.faces[f];
+		EMB center(0.0);
+		unsigned int count = 0;
+		Dart it = d;
+		do
+		{
+			center += attributs[it];
+			++count;
+			it = map.phi1(it);
+		} while (it != d);
+		center /= float(count);
+		attributs[fv(f)] = center;
+		vcont.setNbRefs(fv(f), count + 1);
+	}, nbth);
+
+	// edge points
+	CGoGN::Parallel::foreach_index(0, nbE, [&] (unsigned int e, unsigned int)
+	{
+		Dart d = tab.edges[e];
+		Dart dd = map.phi2(d);
+		EMB ep = attributs[d];
+		ep += attributs[dd];
+		ep *= 0.5;
+		// referenced by h and b on non boundary sides, by h on boundary side
+		unsigned int nbRefs = 2;
+		if (tab.boundary[dd.index])
+			nbRefs += 1;
+		else
+		{
+			ep += (attributs[fv(tab.faceOf[d.index])] + attributs[fv(tab.faceOf[dd.index])]) / 4.0 - (ep / 2.0);
+			nbRefs += 2;
+		}
+		attributs[ev(e)] = ep;
+		vcont.setNbRefs(ev(e), nbRefs + 1);
+	}, nbth);
+
+	// vertex points (from old positions, face points and edge points)
+	std::vector<EMB> vp(nbV);
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		Dart vd = tab.vertices[v];
+		if (boundaryVertexPoint<PFP, EMBV>(map, attributs, vd, vp[v]))
+			return;
+
+		EMB sumFace(0.0);
+		EMB sumEdge(0.0);
+		int n = 0;
+		Dart x = vd;
+		do
+		{
+			sumFace += attributs[fv(tab.faceOf[x.index])];
+			sumEdge += attributs[ev(tab.edgeOf[x.index])];
+			++n;
+			x = map.phi2_1(x);
+		} while (x != vd);
+
+		EMB deltaV = attributs[vd] * float(-3*n);
+		deltaV += sumFace;
+		deltaV += 2.0*sumEdge;
+		deltaV /= float(n*n);
+		vp[v] = attributs[vd] + deltaV;
+	}, nbth);
+
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		attributs[tab.vertices[v]] = vp[v];
+	}, nbth);
+
+	// new topology: dart d (v0->v1) becomes the first half of its edge (v0->e),
+	// h the second half (e->v1), b the inner edge (e->c) and c the inner edge (c->e_prev)
+	AttributeMultiVector<Dart>* phi1 = mp.getPermutationAttribute(0);
+	AttributeMultiVector<Dart>* phi_1 = mp.getPermutationInvAttribute(0);
+	AttributeMultiVector<Dart>* phi2 = mp.getInvolutionAttribute(0);
+	AttributeMultiVector<unsigned int>* vEmb = map.template getEmbeddingAttributeVector<VERTEX>();
+
+	CGoGN::Parallel::foreach_index(0, nbD, [&] (unsigned int i, unsigned int)
+	{
+		Dart d = tab.darts[i];
+		Dart n1 = map.phi1(d);
+		Dart p1 = map.phi_1(d);
+		Dart o = map.phi2(d);
+
+		unsigned int fn = first[tab.rank[n1.index]];
+		unsigned int fp = first[tab.rank[p1.index]];
+		unsigned int fo = first[tab.rank[o.index]];
+		Dart h = nd(first[i]);
+
+		(*phi2)[d.index] = nd(fo);
+		(*phi2)[h.index] = o;
+		(*vEmb)[h.index] = ev(tab.edgeOf[d.index]);
+
+		if (tab.boundary[d.index])
+		{
+			(*phi1)[d.index] = h;
+			(*phi_1)[d.index] = nd(fp);
+			(*phi1)[h.index] = n1;
+			(*phi_1)[h.index] = d;
+			return;
+		}
+
+		Dart b = nd(first[i] + 1);
+		Dart c = nd(first[i] + 2);
+
+		(*phi1)[d.index] = b;
+		(*phi_1)[d.index] = nd(fp);
+		(*phi1)[b.index] = c;
+		(*phi_1)[b.index] = d;
+		(*phi1)[c.index] = nd(fp);
+		(*phi_1)[c.index] = b;
+		(*phi1)[h.index] = n1;
+		(*phi_1)[h.index] = nd(fn + 2);
+
+		(*phi2)[b.index] = nd(fn + 2);
+		(*phi2)[c.index] = nd(fp + 1);
+
+		(*vEmb)[b.index] = ev(tab.edgeOf[d.index]);
+		(*vEmb)[c.index] = fv(tab.faceOf[d.index]);
+	}, nbth);
+	map.touchTopology();
+
+	// boundary markers are bit vectors: mark new boundary darts sequentially
+	for (unsigned int i = 0; i < nbD; ++i)
+	{
+		if (tab.boundary[tab.darts[i].index])
+			map.template boundaryMark<2>(nd(first[i]));
+	}
+}
+
+template <typename PFP, typename EMBV>
+void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbth)
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename EMBV::DATA_TYPE EMB;
+
+	bool allowed = bulkSubdivisionAllowed<MAP>(map);
+	for (Dart d = map.begin(); allowed && d != map.end(); map.next(d))
+	{
+		if (!map.template isBoundaryMarked<2>(d) && map.template phi<111>(d) != d)
+			allowed = false;
+	}
+	if (!allowed)
+	{
+		Modelisation::LoopSubdivision<PFP, EMBV>(map, attributs);
+		return;
+	}
+
+	SubdivisionTables<MAP> tab(map);
+	const unsigned int nbD = uint32(tab.darts.size());
+	const unsigned int nbE = uint32(tab.edges.size());
+	const unsigned int nbV = uint32(tab.vertices.size());
+
+	// each non boundary dart gives 3 new darts (second half of edge, two inner edges)
+	// each boundary dart gives 1 new dart (second half of edge)
+	std::vector<unsigned int> first(nbD + 1);
+	first[0] = 0;
+	for (unsigned int i = 0; i < nbD; ++i)
+		first[i + 1] = first[i] + (tab.boundary[tab.darts[i].index] ? 1 : 3);
+
+	// allocate all new darts and vertices at once
+	MapBuilder<MAP> mp(map, nbth);
+	mp.newDarts(first[nbD]);
+	mp.template newCells<VERTEX>(nbE);
+	auto nd = [&] (unsigned int i) { return mp.dart(i); };
+	auto ev = [&] (unsigned int e) { return mp.template cell<VERTEX>(e); };
+
+	AttributeContainer& vcont = map.template getAttributeContainer<VERTEX>();
+
+	// edge points
+	CGoGN::Parallel::foreach_index(0, nbE, [&] (unsigned int e, unsigned int)
+	{
+		Dart d = tab.edges[e];
+		Dart dd = map.phi2(d);
+		EMB ep = attributs[d];
+		ep += attributs[dd];
+		ep *= 0.5;
+		// referenced by h, t and s of previous dart on non boundary sides, by h on boundary side
+		unsigned int nbRefs = 3;
+		if (tab.boundary[dd.index])
+			nbRefs += 1;
+		else
+		{
+			ep *= 0.75;
+			EMB temp = attributs[map.phi_1(d)];
+			temp += attributs[map.phi_1(dd)];
+			temp *= 1.0 / 8.0;
+			ep += temp;
+			nbRefs += 3;
+		}
+		attributs[ev(e)] = ep;
+		vcont.setNbRefs(ev(e), nbRefs + 1);
+	}, nbth);
+
+	// vertex points (from old positions only)
+	std::vector<EMB> vp(nbV);
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		Dart vd = tab.vertices[v];
+		if (boundaryVertexPoint<PFP, EMBV>(map, attributs, vd, vp[v]))
+			return;
+
+		EMB temp(0.0);
+		int n = 0;
+		Dart x = vd;
+		do
+		{
+			temp += attributs[map.phi1(x)];
+			++n;
+			x = map.phi2_1(x);
+		} while (x != vd);
+		EMB emcp = attributs[vd];
+		if (n == 6)
+		{
+			temp /= 16.0;
+			emcp *= 10.0/16.0;
+			emcp += temp;
+		}
+		else
+		{
+			double beta = Modelisation::betaF(n);
+			temp *= (beta / double(n));
+			emcp *= (1.0f - beta);
+			emcp += temp;
+		}
+		vp[v] = emcp;
+	}, nbth);
+
+	CGoGN::Parallel::foreach_index(0, nbV, [&] (unsigned int v, unsigned int)
+	{
+		attributs[tab.vertices[v]] = vp[v];
+	}, nbth);
+
+	// new topology: dart d (v0->v1) becomes the first half of its edge (v0->e),
+	// h the second half (e->v1), s the inner edge of the corner triangle of v1 (e_next->e)
+	// and t the edge of the central triangle (e->e_next)
+	AttributeMultiVector<Dart>* phi1 = mp.getPermutationAttribute(0);
+	AttributeMultiVector<Dart>* phi_1 = mp.getPermutationInvAttribute(0);
+	AttributeMultiVector<Dart>* phi2 = mp.getInvolutionAttribute(0);
+	AttributeMultiVector<unsigned int>* vEmb = map.template getEmbeddingAttributeVector<VERTEX>();
+
+	CGoGN::Parallel::foreach_index(0, nbD, [&] (unsigned int i, unsigned int)
+	{
+		Dart d = tab.darts[i];
+		Dart n1 = map.phi1(d);
+		Dart p1 = map.phi_1(d);
+		Dart o = map.phi2(d);
+
+		unsigned int fn = first[tab.rank[n1.index]];
+		unsigned int fp = first[tab.rank[p1.index]];
+		unsigned int fo = first[tab.rank[o.index]];
+		Dart h = nd(first[i]);
+
+		(*phi2)[d.index] = nd(fo);
+		(*phi2)[h.index] = o;
+		(*vEmb)[h.index] = ev(tab.edgeOf[d.index]);
+
+		if (tab.boundary[d.index])
+		{
+			(*phi1)[d.index] = h;
+			(*phi_1)[d.index] = nd(fp);
+			(*phi1)[h.index] = n1;
+			(*phi_1)[h.index] = d;
+			return;
+		}
+
+		Dart s = nd(first[i] + 1);
+		Dart t = nd(first[i] + 2);
+
+		(*phi1)[d.index] = nd(fp + 1);
+		(*phi_1)[d.index] = nd(fp);
+		(*phi1)[h.index] = n1;
+		(*phi_1)[h.index] = s;
+		(*phi1)[s.index] = h;
+		(*phi_1)[s.index] = n1;
+		(*phi1)[t.index] = nd(fn + 2);
+		(*phi_1)[t.index] = nd(fp + 2);
+
+		(*phi2)[s.index] = t;
+		(*phi2)[t.index] = s;
+
+		(*vEmb)[s.index] = ev(tab.edgeOf[n1.index]);
+		(*vEmb)[t.index] = ev(tab.edgeOf[d.index]);
+	}, nbth);
+	map.touchTopology();
+
+	// boundary markers are bit vectors: mark new boundary darts sequentially
+	for (unsigned int i = 0; i < nbD; ++i)
+	{
+		if (tab.boundary[tab.darts[i].index])
+			map.template boundaryMark<2>(nd(first[i]));
+	}
+}
+
+template <typename PFP, typename EMBV>
+void TwoNPlusOneSubdivision(typename PFP::MAP& map, EMBV& attributs, float size, unsigned int nbth)
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename EMBV::DATA_TYPE EMB;
+
+	if (!bulkSubdivisionAllowed<MAP>(map) || hasBoundary<MAP>(map))
+	{
+		Modelisation::TwoNPlusOneSubdivision<PFP, EMBV>(map, attributs, size);
+		return;
+	}
+
+	SubdivisionTables<MAP> tab(map);
+	tab.snapshotRelations(map, nbth);
+	const unsigned int nbD = uint32(tab.darts.size());
+
+	// a dart d (v0->v1) of a face gives two new vertices: A on its edge near v0
+	// and C, the inner corner of the face at v0, and 8 new darts:
+	// c1 (A->C), c2 (C->B) and c3 (B->v0) complete the corner quad of d, where B is
+	// the point near v0 on the edge of phi_1(d) ; e0 (A->A'), e1 (A'->C'), e2 (C'->C)
+	// and e3 (C->A) form the quad of the edge of d, where A' is A of phi2(d) and
+	// C' is C of phi1(d) ; m (C->C') is the edge of the central face
+	MapBuilder<MAP> mp(map, nbth);
+	mp.newDarts(8 * nbD);
+	mp.template newCells<VERTEX>(2 * nbD);
+	auto nd = [&] (unsigned int i, unsigned int k) { return mp.dart(8 * i + k); };
+	auto av = [&] (unsigned int i) { return mp.template cell<VERTEX>(i); };
+	auto cv = [&] (unsigned int i) { return mp.template cell<VERTEX>(nbD + i); };
+
+	AttributeContainer& vcont = map.template getAttributeContainer<VERTEX>();
+
+	// edge points
+	CGoGN::Parallel::foreach_index(0, nbD, [&] (unsigned int i, unsigned int)
+	{
+		const EMB& e1 = attributs[tab.darts[i]];
+		const EMB& e2 = attributs[tab.darts[tab.phi1Of[i]]];
+		attributs[av(i)] = e1*(1.0f-size)+e2*size;
+		vcont.setNbRefs(av(i), 4 + 1);
+	}, nbth);
+
+	// corner points
+	CGoGN::Parallel::foreach_index(0, nbD, [&] (unsigned int i, unsigned int)
+	{
+		const EMB& v = attributs[tab.darts[i]];
+		const EMB& a = attributs[av(i)];
+		const EMB& b = attributs[av(tab.phi2Of[tab.phi_1Of[i]])];
+		attributs[cv(i)] = v + (a - v) - (v - b);
+		vcont.setNbRefs(cv(i), 4 + 1);
+	}, nbth);
+
+	AttributeMultiVector<Dart>* phi1 = mp.getPermutationAttribute(0);
+	AttributeMultiVector<Dart>* phi_1 = mp.getPermutationInvAttribute(0);
+	AttributeMultiVector<Dart>* phi2 = mp.getInvolutionAttribute(0);
+	AttributeMultiVector<unsigned int>* vEmb = map.template getEmbeddingAttributeVector<VERTEX>();
+
+	CGoGN::Parallel::foreach_index(0, nbD, [&] (unsigned int i, unsigned int)
+	{
+		Dart d = tab.darts[i];
+		unsigned int n = tab.phi1Of[i];
+		unsigned int p = tab.phi_1Of[i];
+		unsigned int o = tab.phi2Of[i];
+
+		Dart c1 = nd(i, 0), c2 = nd(i, 1), c3 = nd(i, 2);
+		Dart e0 = nd(i, 3), e1 = nd(i, 4), e2 = nd(i, 5), e3 = nd(i, 6);
+		Dart m = nd(i, 7);
+
+		// corner quad
+		(*phi1)[d.index] = c1;		(*phi_1)[d.index] = c3;
+		(*phi1)[c1.index] = c2;		(*phi_1)[c1.index] = d;
+		(*phi1)[c2.index] = c3;		(*phi_1)[c2.index] = c1;
+		(*phi1)[c3.index] = d;		(*phi_1)[c3.index] = c2;
+		// edge quad
+		(*phi1)[e0.index] = e1;		(*phi_1)[e0.index] = e3;
+		(*phi1)[e1.index] = e2;		(*phi_1)[e1.index] = e0;
+		(*phi1)[e2.index] = e3;		(*phi_1)[e2.index] = e1;
+		(*phi1)[e3.index] = e0;		(*phi_1)[e3.index] = e2;
+		// central face
+		(*phi1)[m.index] = nd(n, 7);
+		(*phi_1)[m.index] = nd(p, 7);
+
+		(*phi2)[d.index] = nd(tab.phi1Of[o], 2);
+		(*phi2)[c1.index] = e3;
+		(*phi2)[c2.index] = nd(p, 4);
+		(*phi2)[c3.index] = tab.darts[tab.phi2Of[p]];
+		(*phi2)[e0.index] = nd(o, 3);
+		(*phi2)[e1.index] = nd(n, 1);
+		(*phi2)[e2.index] = m;
+		(*phi2)[e3.index] = c1;
+		(*phi2)[m.index] = e2;
+
+		(*vEmb)[c1.index] = av(i);
+		(*vEmb)[c2.index] = cv(i);
+		(*vEmb)[c3.index] = av(tab.phi2Of[p]);
+		(*vEmb)[e0.index] = av(i);
+		(*vEmb)[e1.index] = av(o);
+		(*vEmb)[e2.index] = cv(n);
+		(*vEmb)[e3.index] = cv(i);
+		(*vEmb)[m.index] = cv(i);
+	}, nbth);
+	map.touchTopology();
+}
+
+template <typename PFP, typename EMBV>
+void DooSabin(typename PFP::MAP& map, EMBV& position, unsigned int nbth)
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename EMBV::DATA_TYPE EMB;
+
+	if (!bulkSubdivisionAllowed<MAP>(map) || hasBoundary<MAP>(map))
+	{
+		Modelisation::DooSabin<PFP, EMBV>(map, position);
+		return;
+	}
+
+	SubdivisionTables<MAP> tab(map);
+	tab.snapshotRelations(map, nbth);
+	const unsigned int nbD = uint32(tab.darts.size());
+	const unsigned int nbF = uint32(tab.faces.size());
+
+	// a dart d (v0->v1) keeps its face and gets a new vertex, the corner of its face at v0,
+	// and 3 new darts: a (v1->v0) and b (v0->v0') in the quad of its edge, where v0' is the
+	// corner of phi2(d) at v0, and v (v0'->v0) in the face of v0
+	MapBuilder<MAP> mp(map, nbth);
+	mp.newDarts(3 * nbD);
+	mp.template newCells<VERTEX>(nbD);
+	auto nd = [&] (unsigned int i, unsigned int k) { return mp.dart(3 * i + k); };
+	auto cv = [&] (unsigned int i) { return mp.template cell<VERTEX>(i); };
+
+	AttributeContainer& vcont = map.template getAttributeContainer<VERTEX>();
+
+	// corner points
+	std::vector<std::vector<EMB> > buffers(std::max(nbth, 1u));
+	CGoGN::Parallel::foreach_index(0, nbF, [&] (unsigned int f, unsigned int thread)
+	{
+		std::vector<EMB>& buffer = buffers[thread];
+		buffer.clear();
+		Dart d = tab.faces[f];
+		Dart e = d;
+		do
+		{
+			buffer.push_back(position[e]);
+			e = map.phi1(e);
+		} while (e != d);
+
+		int N = int(buffer.size());
+		for (int i = 0; i < N; ++i)
+		{
+			EMB P(0);
+			for (int j = 0; j < N; ++j)
+			{
+				if (j==i)
+				{
+					typename PFP::REAL c1 = typename PFP::REAL(double(N + 5) / double(4 * N));
+					P += buffer[j]*c1;
+				}
+				else
+				{
+					typename PFP::REAL c2 = typename PFP::REAL((3.0 + 2.0*std::cos(2.0*M_PI*(double(i - j)) / double(N))) / (4.0*N));
+					P+= c2*buffer[j];
+				}
+			}
+			unsigned int c = cv(tab.rank[e.index]);
+			position[c] = P;
+			vcont.setNbRefs(c, 4 + 1);
+			e = map.phi1(e);
+		}
+	}, nbth);
+
+	// all the darts of the old vertices are embedded on new ones
+	std::vector<unsigned int> oldVertices(tab.vertices.size());
+	for (unsigned int v = 0; v < tab.vertices.size(); ++v)
+		oldVertices[v] = map.template getEmbedding<VERTEX>(tab.vertices[v]);
+
+	AttributeMultiVector<Dart>* phi1 = mp.getPermutationAttribute(0);
+	AttributeMultiVector<Dart>* phi_1 = mp.getPermutationInvAttribute(0);
+	AttributeMultiVector<Dart>* phi2 = mp.getInvolutionAttribute(0);
+	AttributeMultiVector<unsigned int>* vEmb = map.template getEmbeddingAttributeVector<VERTEX>();
+
+	CGoGN::Parallel::foreach_index(0, nbD, [&] (unsigned int i, unsigned int)
+	{
+		Dart d = tab.darts[i];
+		unsigned int n = tab.phi1Of[i];
+		unsigned int p = tab.phi_1Of[i];
+		unsigned int o = tab.phi2Of[i];
+		unsigned int r = tab.phi1Of[o];	// next dart around v0
+
+		Dart a = nd(i, 0), b = nd(i, 1), v = nd(i, 2);
+
+		// quad of the edge: a -> b -> a(phi2(d)) -> b(phi2(d))
+		(*phi1)[a.index] = b;				(*phi_1)[a.index] = nd(o, 1);
+		(*phi1)[b.index] = nd(o, 0);		(*phi_1)[b.index] = a;
+		// face of the vertex
+		(*phi1)[v.index] = nd(tab.phi2Of[p], 2);
+		(*phi_1)[v.index] = nd(r, 2);
+
+		(*phi2)[d.index] = a;
+		(*phi2)[a.index] = d;
+		(*phi2)[b.index] = v;
+		(*phi2)[v.index] = b;
+
+		(*vEmb)[d.index] = cv(i);
+		(*vEmb)[a.index] = cv(n);
+		(*vEmb)[b.index] = cv(i);
+		(*vEmb)[v.index] = cv(r);
+	}, nbth);
+	map.touchTopology();
+
+	for (std::vector<unsigned int>::const_iterator it = oldVertices.begin(); it != oldVertices.end(); ++it)
+		vcont.removeLine(*it);
+}
+
+} // namespace Parallel
+
 } // namespace Modelisation
 
 } // namespace Surface
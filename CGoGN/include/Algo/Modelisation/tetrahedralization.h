@@ -256,6 +256,42 @@ Dart flip1To3(typename PFP::MAP& map, Dart d);
 template <typename PFP>
 Dart edgeBisection(typename PFP::MAP& map, Dart d);
 
+/************************************************************************************************
+ *									Quality optimization										*
+ ************************************************************************************************/
+
+enum TetQualityMeasure { TQ_MIN_DIHEDRAL_ANGLE, TQ_RADIUS_RATIO };
+
+//!
+/*!
+ * quality of the tetrahedron (a,b,c,d), 1 for a regular tetrahedron, 0 for a flat one
+ * TQ_MIN_DIHEDRAL_ANGLE: smallest dihedral angle divided by the one of the regular tetrahedron
+ * TQ_RADIUS_RATIO: 3 * inradius / circumradius
+ */
+template <typename PFP>
+typename PFP::REAL tetQuality(const typename PFP::VEC3& a, const typename PFP::VEC3& b, const typename PFP::VEC3& c, const typename PFP::VEC3& d, TetQualityMeasure measure);
+
+//!
+/*!
+ *
+ */
+template <typename PFP>
+typename PFP::REAL tetQuality(typename PFP::MAP& map, Vol v, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, TetQualityMeasure measure);
+
+//!
+/*!
+ * improve the quality of a tetrahedral mesh with 2-3 and 3-2 flips of interior faces and edges
+ * Each pass evaluates all the flips in parallel (new tetrahedra must be valid and better than
+ * the worst old one by minGain), then applies a batch of flips with disjoint cavities, worst
+ * tetrahedra first. Topological changes are applied sequentially (dart allocation is not thread-safe).
+ * @param nbPasses max number of passes (stops before if nothing is flipped)
+ * @return the number of flips
+ */
+template <typename PFP>
+unsigned int optimizeQuality(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	TetQualityMeasure measure = TQ_MIN_DIHEDRAL_ANGLE, unsigned int nbPasses = 10, typename PFP::REAL minGain = typename PFP::REAL(1e-3),
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
 
 
 //namespace Tetgen
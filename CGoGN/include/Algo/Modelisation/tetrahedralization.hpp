@@ -25,6 +25,10 @@
 #include "Algo/Modelisation/subdivision.h"
 #include "Algo/Modelisation/subdivision3.h"
 #include "Topology/generic/traversor/traversor3.h"
+#include "Topology/generic/traversor/traversorCell.h"
+
+#include <algorithm>
+#include <cmath>
 
 
 namespace CGoGN
@@ -937,6 +941,278 @@ Dart edgeBisection(typename PFP::MAP& map, Dart d)
     return e;
 }
 
+/************************************************************************************************
+ *                				 Quality optimization                                           *
+ ************************************************************************************************/
+
+template <typename PFP>
+typename PFP::REAL tetQuality(const typename PFP::VEC3& a, const typename PFP::VEC3& b, const typename PFP::VEC3& c, const typename PFP::VEC3& d, TetQualityMeasure measure)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	const VEC3 u = b - a;
+	const VEC3 v = c - a;
+	const VEC3 w = d - a;
+	const REAL det = u * (v ^ w);
+	if (det == REAL(0))
+		return REAL(0);
+
+	if (measure == TQ_RADIUS_RATIO)
+	{
+		REAL area = ((u ^ v).norm() + (v ^ w).norm() + (w ^ u).norm() + ((c - b) ^ (d - b)).norm()) / REAL(2);
+		VEC3 num = (v ^ w) * u.norm2() + (w ^ u) * v.norm2() + (u ^ v) * w.norm2();
+		// inradius = 3V / area, circumradius = |num| / 12V with V = |det| / 6
+		REAL r = std::fabs(det) / (REAL(2) * area);
+		REAL R = num.norm() / (REAL(2) * std::fabs(det));
+		return REAL(3) * r / R;
+	}
+
+	// outward normals of the faces opposite to each vertex
+	const VEC3* P[4] = { &a, &b, &c, &d };
+	VEC3 n[4];
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		const VEC3& p0 = *P[(i+1)%4];
+		n[i] = (*P[(i+2)%4] - p0) ^ (*P[(i+3)%4] - p0);
+		if (n[i] * (*P[i] - p0) > REAL(0))
+			n[i] = -n[i];
+		n[i].normalize();
+	}
+
+	// dihedral angle of an edge is pi minus the angle of the normals of its 2 faces
+	REAL maxCos = REAL(-1);
+	for (unsigned int i = 0; i < 3; ++i)
+		for (unsigned int j = i + 1; j < 4; ++j)
+			maxCos = std::max(maxCos, -(n[i] * n[j]));
+
+	const REAL regular = std::acos(REAL(1) / REAL(3));
+	return std::acos(std::min(maxCos, REAL(1))) / regular;
+}
+
+template <typename PFP>
+typename PFP::REAL tetQuality(typename PFP::MAP& map, Vol v, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, TetQualityMeasure measure)
+{
+	Dart d = v.dart;
+	return tetQuality<PFP>(position[d], position[map.phi1(d)], position[map.phi_1(d)], position[map.phi_1(map.phi2(d))], measure);
+}
+
+namespace Optimization
+{
+
+// sign of the orientation of the tetrahedron (a,b,c,d)
+template <typename VEC3>
+inline int orientation(const VEC3& a, const VEC3& b, const VEC3& c, const VEC3& d)
+{
+	typename VEC3::DATA_TYPE det = (b - a) * ((c - a) ^ (d - a));
+	return (det > 0) - (det < 0);
+}
+
+// a flip of an interior face (2-3) or of an interior edge of degree 3 (3-2)
+template <typename REAL>
+struct Flip
+{
+	Dart d;
+	bool edge;
+	REAL before;	// quality of the worst old tetrahedron
+	REAL after;		// quality of the worst new tetrahedron
+
+	// worst tetrahedra first, then the best gain
+	bool operator<(const Flip& f) const
+	{
+		if (before != f.before)
+			return before < f.before;
+		if (after != f.after)
+			return after > f.after;
+		return d.index < f.d.index;
+	}
+};
+
+template <typename PFP>
+bool evaluateFlip23(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	TetQualityMeasure measure, typename PFP::REAL minGain, Flip<typename PFP::REAL>& flip)
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	const VEC3& a = position[d];
+	const VEC3& b = position[map.phi1(d)];
+	const VEC3& c = position[map.phi_1(d)];
+	Dart dp = map.phi_1(map.phi2(d));
+	Dart dq = map.phi_1(map.phi2(map.phi3(d)));
+	const VEC3& p = position[dp];
+	const VEC3& q = position[dq];
+
+	// new edge pq must go through the interior of the face
+	int o = orientation(p, q, a, b);
+	if (o == 0 || orientation(p, q, b, c) != o || orientation(p, q, c, a) != o)
+		return false;
+
+	REAL before = std::min(tetQuality<PFP>(a, b, c, p, measure), tetQuality<PFP>(a, b, c, q, measure));
+	REAL after = std::min(tetQuality<PFP>(a, b, p, q, measure), std::min(tetQuality<PFP>(b, c, p, q, measure), tetQuality<PFP>(c, a, p, q, measure)));
+	if (after < before + minGain)
+		return false;
+
+	// p and q must not be already linked (traversor uses markers of the calling thread)
+	unsigned int qEmb = map.template getEmbedding<VERTEX>(dq);
+	Traversor3VVaE<MAP> tv(map, dp);
+	for (Dart it = tv.begin(); it != tv.end(); it = tv.next())
+	{
+		if (map.template getEmbedding<VERTEX>(it) == qEmb)
+			return false;
+	}
+
+	flip.d = d;
+	flip.edge = false;
+	flip.before = before;
+	flip.after = after;
+	return true;
+}
+
+template <typename PFP>
+bool evaluateFlip32(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	TetQualityMeasure measure, typename PFP::REAL minGain, Flip<typename PFP::REAL>& flip)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	const VEC3& a = position[d];
+	const VEC3& b = position[map.phi1(d)];
+
+	// third vertices of the 3 faces around the edge
+	Dart e1 = map.alpha2(d);
+	Dart e2 = map.alpha2(e1);
+	const VEC3& r0 = position[map.phi_1(d)];
+	const VEC3& r1 = position[map.phi_1(e1)];
+	const VEC3& r2 = position[map.phi_1(e2)];
+
+	// edge ab must go through the interior of the new face
+	int o = orientation(a, b, r0, r1);
+	if (o == 0 || orientation(a, b, r1, r2) != o || orientation(a, b, r2, r0) != o)
+		return false;
+	int oa = orientation(r0, r1, r2, a);
+	if (oa == 0 || orientation(r0, r1, r2, b) != -oa)
+		return false;
+
+	REAL before = std::min(tetQuality<PFP>(a, b, r0, r1, measure), std::min(tetQuality<PFP>(a, b, r1, r2, measure), tetQuality<PFP>(a, b, r2, r0, measure)));
+	REAL after = std::min(tetQuality<PFP>(r0, r1, r2, a, measure), tetQuality<PFP>(r0, r1, r2, b, measure));
+	if (after < before + minGain)
+		return false;
+
+	flip.d = d;
+	flip.edge = true;
+	flip.before = before;
+	flip.after = after;
+	return true;
+}
+
+} // namespace Optimization
+
+template <typename PFP>
+unsigned int optimizeQuality(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	TetQualityMeasure measure, unsigned int nbPasses, typename PFP::REAL minGain, unsigned int nbth)
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::REAL REAL ;
+	typedef Optimization::Flip<REAL> Flip;
+
+	assert(isTetrahedralization<PFP>(map));
+
+	if (nbth < 1)
+		nbth = 1;
+
+	unsigned int nbFlips = 0;
+	for (unsigned int pass = 0; pass < nbPasses; ++pass)
+	{
+		// evaluation of all possible flips, one buffer per thread
+		std::vector< std::vector<Flip> > found(nbth);
+
+		auto evalFace = [&] (Face f, unsigned int thr)
+		{
+			Dart d = f.dart;
+			if (map.isBoundaryFace(d))
+				return;
+			Flip flip;
+			if (Optimization::evaluateFlip23<PFP>(map, d, position, measure, minGain, flip))
+				found[thr].push_back(flip);
+		};
+
+		auto evalEdge = [&] (Edge e, unsigned int thr)
+		{
+			Dart d = e.dart;
+			if (map.isBoundaryEdge(d) || map.edgeDegree(d) != 3)
+				return;
+			Flip flip;
+			if (Optimization::evaluateFlip32<PFP>(map, d, position, measure, minGain, flip))
+				found[thr].push_back(flip);
+		};
+
+		if (nbth > 1)
+		{
+			CGoGN::Parallel::foreach_cell<FACE>(map, evalFace, AUTO, nbth);
+			CGoGN::Parallel::foreach_cell<EDGE>(map, evalEdge, AUTO, nbth);
+		}
+		else
+		{
+			foreach_cell<FACE>(map, [&] (Face f) { evalFace(f, 0); });
+			foreach_cell<EDGE>(map, [&] (Edge e) { evalEdge(e, 0); });
+		}
+
+		std::vector<Flip> queue;
+		for (unsigned int i = 0; i < nbth; ++i)
+			queue.insert(queue.end(), found[i].begin(), found[i].end());
+		std::vector< std::vector<Flip> >().swap(found);
+		std::sort(queue.begin(), queue.end());
+
+		// keep flips whose cavities (modified tetrahedra) do not overlap
+		std::vector<Flip> batch;
+		{
+			DartMarkerStore<MAP> busy(map);
+			Dart tets[3];
+			for (typename std::vector<Flip>::const_iterator it = queue.begin(); it != queue.end(); ++it)
+			{
+				unsigned int nb = 0;
+				if (it->edge)
+				{
+					tets[nb++] = it->d;
+					tets[nb++] = map.alpha2(it->d);
+					tets[nb++] = map.alpha2(map.alpha2(it->d));
+				}
+				else
+				{
+					tets[nb++] = it->d;
+					tets[nb++] = map.phi3(it->d);
+				}
+
+				bool free = true;
+				for (unsigned int i = 0; i < nb && free; ++i)
+					free = !busy.isMarked(tets[i]);
+				if (!free)
+					continue;
+
+				for (unsigned int i = 0; i < nb; ++i)
+					busy.template markOrbit<VOLUME>(tets[i]);
+				batch.push_back(*it);
+			}
+		}
+
+		if (batch.empty())
+			break;
+
+		for (typename std::vector<Flip>::const_iterator it = batch.begin(); it != batch.end(); ++it)
+		{
+			if (it->edge)
+				swap3To2<PFP>(map, it->d);
+			else
+				swap2To3<PFP>(map, it->d);
+		}
+		nbFlips += (unsigned int)(batch.size());
+	}
+
+	return nbFlips;
+}
+
 //namespace Tetgen
 //{
 
@@ -64,7 +64,7 @@ private:
 	Algo::Surface::Decimation::Selector<PFP>* m_selector ;
 	std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*> m_approximators ;
 	std::vector<Algo::Surface::Decimation::PredictorGen<PFP>*> m_predictors ;
-	std::vector<VSplit<PFP>*> m_splits ;
+	std::vector<VSplitRecord> m_splits ;
 	unsigned int m_cur ;
 
 	Algo::Surface::Decimation::Approximator<PFP, VEC3, EDGE>* m_positionApproximator ;
@@ -74,10 +74,18 @@ private:
 	double m_detailAmount ;
 	bool m_localFrameDetailVectors ;
 
-	std::vector<VEC3> originalDetailVectors ;
+	std::vector<VEC3> originalDetailVectors ;	// split vertices - approximated vertex (2 per split)
+	std::vector<VEC3> originalPositions ;		// split vertices before quantization (2 per split)
+	std::vector<VEC3> m_codebook ;	// quantized detail vectors (indexed by VSplitRecord::detail1 & 2)
 	bool quantizationInitialized, quantizationApplied ;
 	Utils::Quantization<VEC3>* q ;
 
+	// PM read from a stream : the splits that are not decoded yet and, for each
+	// transmitted vertex, one of its darts and its embedding
+	std::vector<VSplitCode> m_codes ;
+	std::vector<Dart> m_vertexDarts ;
+	std::vector<unsigned int> m_vertexLines ;
+
 public:
 	ProgressiveMesh(
 		MAP& map,
@@ -90,23 +98,34 @@ public:
             MAP& map, DartMarker<MAP>& inactive,
 			Algo::Surface::Decimation::Selector<PFP>* selector, std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*>& approximators,
             VertexAttribute<VEC3, MAP>& position) ;
+	/**
+	 * PM without selector nor approximators : its base mesh and its splits are read from a file (see loadSplits)
+	 */
+	ProgressiveMesh(MAP& map, DartMarker<MAP>& inactive, VertexAttribute<VEC3, MAP>& position) ;
 	~ProgressiveMesh() ;
 
 	bool initOk() { return m_initOk ; }
 
 	void createPM(unsigned int percentWantedVertices) ;
 
-	std::vector<VSplit<PFP>*>& splits() { return m_splits ; }
+	std::vector<VSplitRecord>& splits() { return m_splits ; }
 	Algo::Surface::Decimation::Selector<PFP>* selector() { return m_selector ; }
 	std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*>& approximators() { return m_approximators ; }
 	std::vector<Algo::Surface::Decimation::PredictorGen<PFP>*>& predictors() { return m_predictors ; }
 
-	void edgeCollapse(VSplit<PFP>* vs) ;
-	void vertexSplit(VSplit<PFP>* vs) ;
+	void edgeCollapse(const VSplitRecord& vs) ;
+	void vertexSplit(const VSplitRecord& vs) ;
 
 	void coarsen() ;
 	void refine() ;
 
+	/**
+	 * apply (resp. revert) the collapse of a split record, whatever the current level
+	 * (used by the selective refinement, which checks the legality of the record)
+	 */
+	void collapseRecord(const VSplitRecord& vs) ;
+	void splitRecord(const VSplitRecord& vs) ;
+
 	void gotoLevel(unsigned int goal) ;
 	unsigned int& currentLevel() { return m_cur ; }
 	unsigned int nbSplits() { return (unsigned int)(m_splits.size()) ; }
@@ -122,6 +141,22 @@ public:
 	void quantizeDetailVectors(unsigned int nbClasses) ;
 	void quantizeDetailVectors(float distortion) ;
 	void resetDetailVectors() ;
+	const std::vector<VEC3>& codebook() const { return m_codebook ; }
+
+	/**
+	 * write the PM in a binary file, in the order of a progressive transmission :
+	 * the base mesh (positions and faces), the codebook of the detail vectors,
+	 * then the splits from the coarsest to the finest
+	 * the detail vectors must have been quantized (quantizeDetailVectors)
+	 */
+	bool saveSplits(const std::string& filename) ;
+
+	/**
+	 * read a PM written by saveSplits in an empty map : the base mesh is built
+	 * and the splits are decoded when they are first applied (refine, gotoLevel)
+	 * only the positions are transmitted
+	 */
+	bool loadSplits(const std::string& filename) ;
 
 //	float getDifferentialEntropy() { return q->getDifferentialEntropy() ; }
 //	float getDiscreteEntropy() { return q->getDiscreteEntropy() ; }
@@ -129,7 +164,13 @@ public:
 //	void calculCourbeDebitDistortion(float distortion) ;
 
 private:
+	void releaseSplits() ;
+
+	void applySplit(unsigned int i) ;
+	void decodeSplit(unsigned int i) ;
+
 	void initQuantization() ;
+	void setQuantizedDetails() ;
 } ;
 
 } //namespace PMesh
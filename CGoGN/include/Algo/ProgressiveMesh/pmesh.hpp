@@ -172,11 +172,23 @@ ProgressiveMesh<PFP>::ProgressiveMesh(
 	quantizationApplied = false ;
 }
 
+template <typename PFP>
+ProgressiveMesh<PFP>::ProgressiveMesh(
+		MAP& map, DartMarker<MAP>& inactive,
+		VertexAttribute<VEC3, MAP>& pos
+	) :
+	m_map(map), position(pos), inactiveMarker(inactive), m_selector(NULL), m_cur(0), m_positionApproximator(NULL), m_initOk(true)
+{
+	m_detailAmount = REAL(1) ;
+	m_localFrameDetailVectors = false ;
+	quantizationInitialized = false ;
+	quantizationApplied = false ;
+}
+
 template <typename PFP>
 ProgressiveMesh<PFP>::~ProgressiveMesh()
 {
-	for(unsigned int i = 0; i < m_splits.size(); ++i)
-		delete m_splits[i] ;
+	releaseSplits() ;
 	if(m_selector)
 		delete m_selector ;
 	for(typename std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*>::iterator it = m_approximators.begin(); it != m_approximators.end(); ++it)
@@ -205,8 +217,12 @@ void ProgressiveMesh<PFP>::createPM(unsigned int percentWantedVertices)
 		Dart d2 = m_map.phi2(m_map.phi_1(d)) ;
 		Dart dd2 = m_map.phi2(m_map.phi_1(m_map.phi2(d))) ;
 
-		VSplit<PFP>* vs = new VSplit<PFP>(m_map, d, dd2, d2) ;	// create new VSplit node
-		m_splits.push_back(vs) ;								// and store it
+		VSplitRecord vs ;			// create new split record
+		vs.edge = d.index ;
+		vs.rightEdge = dd2.index ;
+		vs.leftEdge = d2.index ;
+		vs.detail1 = EMBNULL ;
+		vs.detail2 = EMBNULL ;
 
 		for(typename std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*>::iterator it = m_approximators.begin(); it != m_approximators.end(); ++it)
 		{
@@ -218,12 +234,14 @@ void ProgressiveMesh<PFP>::createPM(unsigned int percentWantedVertices)
 
 		edgeCollapse(vs) ;							// collapse edge
 
-		unsigned int newV = Algo::Topo::setOrbitEmbeddingOnNewCell<VERTEX>(m_map,d2);
-		unsigned int newE1 = Algo::Topo::setOrbitEmbeddingOnNewCell<EDGE>(m_map,d2);
-		unsigned int newE2 = Algo::Topo::setOrbitEmbeddingOnNewCell<EDGE>(m_map,dd2);
-		vs->setApproxV(newV) ;
-		vs->setApproxE1(newE1) ;
-		vs->setApproxE2(newE2) ;
+		// the records keep a reference on the approximated embeddings
+		vs.approxV = Algo::Topo::setOrbitEmbeddingOnNewCell<VERTEX>(m_map,d2);
+		vs.approxE1 = Algo::Topo::setOrbitEmbeddingOnNewCell<EDGE>(m_map,d2);
+		vs.approxE2 = Algo::Topo::setOrbitEmbeddingOnNewCell<EDGE>(m_map,dd2);
+		m_map.template getAttributeContainer<VERTEX>().refLine(vs.approxV) ;
+		m_map.template getAttributeContainer<EDGE>().refLine(vs.approxE1) ;
+		m_map.template getAttributeContainer<EDGE>().refLine(vs.approxE2) ;
+		m_splits.push_back(vs) ;					// and store it
 
 		for(typename std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*>::iterator it = m_approximators.begin(); it != m_approximators.end(); ++it)
 			(*it)->affectApprox(d2);				// affect data to the resulting vertex
@@ -243,9 +261,9 @@ void ProgressiveMesh<PFP>::createPM(unsigned int percentWantedVertices)
 }
 
 template <typename PFP>
-void ProgressiveMesh<PFP>::edgeCollapse(VSplit<PFP>* vs)
+void ProgressiveMesh<PFP>::edgeCollapse(const VSplitRecord& vs)
 {
-	Dart d = vs->getEdge() ;
+	Dart d(vs.edge) ;
 	Dart dd = m_map.phi2(d) ;
 
 	inactiveMarker.template markOrbit<FACE>(d) ;
@@ -255,12 +273,12 @@ void ProgressiveMesh<PFP>::edgeCollapse(VSplit<PFP>* vs)
 }
 
 template <typename PFP>
-void ProgressiveMesh<PFP>::vertexSplit(VSplit<PFP>* vs)
+void ProgressiveMesh<PFP>::vertexSplit(const VSplitRecord& vs)
 {
-	Dart d = vs->getEdge() ;
+	Dart d(vs.edge) ;
 	Dart dd = m_map.phi2(d) ;
-	Dart d2 = vs->getLeftEdge() ;
-	Dart dd2 = vs->getRightEdge() ;
+	Dart d2(vs.leftEdge) ;
+	Dart dd2(vs.rightEdge) ;
 
 	m_map.insertTrianglePair(d, d2, dd2) ;
 
@@ -269,25 +287,136 @@ void ProgressiveMesh<PFP>::vertexSplit(VSplit<PFP>* vs)
 }
 
 template <typename PFP>
-void ProgressiveMesh<PFP>::coarsen()
+inline void ProgressiveMesh<PFP>::collapseRecord(const VSplitRecord& vs)
 {
-	if(m_cur == m_splits.size())
-		return ;
+	Dart d2(vs.leftEdge) ;
+	Dart dd2(vs.rightEdge) ;
 
-	VSplit<PFP>* vs = m_splits[m_cur] ; // get the split node
-	++m_cur ;
+	edgeCollapse(vs) ;	// collapse edge
 
-	// Dart d = vs->getEdge() ;
-	// Dart dd = m_map.phi2(d) ;		// get some darts
-	Dart d2 = vs->getLeftEdge() ;
-	Dart dd2 = vs->getRightEdge() ;
+	Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, d2, vs.approxV) ;
+	if(vs.approxE1 != EMBNULL)
+	{
+		Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d2, vs.approxE1) ;
+		Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd2, vs.approxE2) ;
+	}
+}
 
-	edgeCollapse(vs) ;	// collapse edge
+template <typename PFP>
+inline void ProgressiveMesh<PFP>::splitRecord(const VSplitRecord& vs)
+{
+	Dart d(vs.edge) ;
+	Dart dd = m_map.phi2(d) ; 		// get some darts
+	Dart dd2(vs.rightEdge) ;
+	Dart d2(vs.leftEdge) ;
+	Dart d1 = m_map.phi2(d2) ;
+	Dart dd1 = m_map.phi2(dd2) ;
 
-    Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, d2, vs->getApproxV()) ;
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d2, vs->getApproxE1()) ;
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd2, vs->getApproxE2()) ;
+	unsigned int v1 = m_map.template getEmbedding<VERTEX>(d) ;				// get the embedding
+	unsigned int v2 = m_map.template getEmbedding<VERTEX>(dd) ;			// of the new vertices
+	unsigned int e1 = EMBNULL, e2 = EMBNULL, e3 = EMBNULL, e4 = EMBNULL ;
+	if(vs.approxE1 != EMBNULL)	// no edge embedding in a transmitted PM
+	{
+		e1 = m_map.template getEmbedding<EDGE>(m_map.phi1(d)) ;
+		e2 = m_map.template getEmbedding<EDGE>(m_map.phi_1(d)) ;	// and new edges
+		e3 = m_map.template getEmbedding<EDGE>(m_map.phi1(dd)) ;
+		e4 = m_map.template getEmbedding<EDGE>(m_map.phi_1(dd)) ;
+	}
+
+	vertexSplit(vs) ; // split vertex
 
+	// when the splits are applied out of order, the opposite vertices of the
+	// inserted triangles may have changed since the record was collapsed
+	m_map.template setDartEmbedding<VERTEX>(m_map.phi_1(d), m_map.template getEmbedding<VERTEX>(m_map.phi1(d2))) ;
+	m_map.template setDartEmbedding<VERTEX>(m_map.phi_1(dd), m_map.template getEmbedding<VERTEX>(m_map.phi1(dd2))) ;
+
+	Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, d, v1) ;	// embed the
+	Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, dd, v2) ;	// new vertices
+	if(vs.approxE1 != EMBNULL)
+	{
+		Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d1, e1) ;
+		Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d2, e2) ;	// and new edges
+		Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd1, e3) ;
+		Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd2, e4) ;
+	}
+
+	// the split vertices are placed from the approximated one with the quantized details
+	if(vs.detail1 != EMBNULL)
+	{
+		const VEC3& p = position[vs.approxV] ;
+		position[v1] = p + m_codebook[vs.detail1] ;
+		position[v2] = p + m_codebook[vs.detail2] ;
+	}
+}
+
+template <typename PFP>
+inline void ProgressiveMesh<PFP>::applySplit(unsigned int i)
+{
+	if(m_splits[i].edge == EMBNULL)
+		decodeSplit(i) ;
+	else
+		splitRecord(m_splits[i]) ;
+}
+
+template <typename PFP>
+void ProgressiveMesh<PFP>::decodeSplit(unsigned int i)
+{
+	const VSplitCode& c = m_codes[i] ;
+	unsigned int lv = m_vertexLines[c.vertex] ;
+
+	// darts that go from the split vertex to the left & right vertices
+	Dart d2 = NIL ;
+	Dart dd2 = NIL ;
+	Dart it = m_vertexDarts[c.vertex] ;
+	do
+	{
+		unsigned int e = m_map.template getEmbedding<VERTEX>(m_map.phi1(it)) ;
+		if(e == m_vertexLines[c.left])
+			d2 = it ;
+		else if(e == m_vertexLines[c.right])
+			dd2 = it ;
+		it = m_map.phi2(m_map.phi_1(it)) ;
+	} while(it != m_vertexDarts[c.vertex]) ;
+	assert(d2 != NIL && dd2 != NIL) ;
+
+	Dart d = m_map.newFace(3, false) ;
+	Dart dd = m_map.newFace(3, false) ;
+	m_map.sewFaces(d, dd, false) ;
+	m_map.insertTrianglePair(d, d2, dd2) ;
+
+	// the record keeps a reference on the split vertex, as in createPM
+	m_map.template getAttributeContainer<VERTEX>().refLine(lv) ;
+	m_map.template initDartEmbedding<VERTEX>(m_map.phi_1(d), m_vertexLines[c.left]) ;
+	m_map.template initDartEmbedding<VERTEX>(m_map.phi_1(dd), m_vertexLines[c.right]) ;
+	unsigned int v1 = Algo::Topo::setOrbitEmbeddingOnNewCell<VERTEX>(m_map, d) ;
+	unsigned int v2 = Algo::Topo::setOrbitEmbeddingOnNewCell<VERTEX>(m_map, dd) ;
+	position[v1] = position[lv] + m_codebook[c.detail1] ;
+	position[v2] = position[lv] + m_codebook[c.detail2] ;
+
+	VSplitRecord& vs = m_splits[i] ;
+	vs.edge = d.index ;
+	vs.rightEdge = dd2.index ;
+	vs.leftEdge = d2.index ;
+	vs.approxV = lv ;
+	vs.approxE1 = EMBNULL ;
+	vs.approxE2 = EMBNULL ;
+	vs.detail1 = c.detail1 ;
+	vs.detail2 = c.detail2 ;
+
+	m_vertexDarts.push_back(d) ;
+	m_vertexLines.push_back(v1) ;
+	m_vertexDarts.push_back(dd) ;
+	m_vertexLines.push_back(v2) ;
+}
+
+template <typename PFP>
+void ProgressiveMesh<PFP>::coarsen()
+{
+	if(m_cur == m_splits.size())
+		return ;
+
+	collapseRecord(m_splits[m_cur]) ;
+	++m_cur ;
 }
 
 template <typename PFP>
@@ -297,21 +426,16 @@ void ProgressiveMesh<PFP>::refine()
 		return ;
 
 	--m_cur ;
-	VSplit<PFP>* vs = m_splits[m_cur] ; // get the split node
+	if(m_splits[m_cur].edge == EMBNULL)
+	{
+		decodeSplit(m_cur) ;
+		return ;
+	}
 
-	Dart d = vs->getEdge() ;
-	Dart dd = m_map.phi2(d) ; 		// get some darts
-	Dart dd2 = vs->getRightEdge() ;
-	Dart d2 = vs->getLeftEdge() ;
-	Dart d1 = m_map.phi2(d2) ;
-	Dart dd1 = m_map.phi2(dd2) ;
+	const VSplitRecord& vs = m_splits[m_cur] ; // get the split record
 
-	unsigned int v1 = m_map.template getEmbedding<VERTEX>(d) ;				// get the embedding
-	unsigned int v2 = m_map.template getEmbedding<VERTEX>(dd) ;			// of the new vertices
-	unsigned int e1 = m_map.template getEmbedding<EDGE>(m_map.phi1(d)) ;
-	unsigned int e2 = m_map.template getEmbedding<EDGE>(m_map.phi_1(d)) ;	// and new edges
-	unsigned int e3 = m_map.template getEmbedding<EDGE>(m_map.phi1(dd)) ;
-	unsigned int e4 = m_map.template getEmbedding<EDGE>(m_map.phi_1(dd)) ;
+	Dart d2(vs.leftEdge) ;
+	Dart dd2(vs.rightEdge) ;
 
 	if(!m_predictors.empty())
 	{
@@ -330,14 +454,7 @@ void ProgressiveMesh<PFP>::refine()
 		localFrame.invert(invLocalFrame) ;
 	}
 
-	vertexSplit(vs) ; // split vertex
-
-	Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, d, v1) ;	// embed the
-	Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, dd, v2) ;	// new vertices
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d1, e1) ;
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d2, e2) ;	// and new edges
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd1, e3) ;
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd2, e4) ;
+	splitRecord(vs) ;
 
 //	if(!m_predictors.empty())
 //	{
@@ -372,8 +489,17 @@ void ProgressiveMesh<PFP>::gotoLevel(unsigned int l)
 		return ;
 
 	if(l > m_cur)
-		while(m_cur != l)
-			coarsen() ;
+	{
+		// a range of collapses only involves the records
+		for(; m_cur < l; ++m_cur)
+			collapseRecord(m_splits[m_cur]) ;
+	}
+	else if(m_predictors.empty() && !m_localFrameDetailVectors)
+	{
+		// same for a range of splits when there is no prediction to apply
+		while(m_cur > l)
+			applySplit(--m_cur) ;
+	}
 	else
 		while(m_cur != l)
 			refine() ;
@@ -408,7 +534,7 @@ void ProgressiveMesh<PFP>::setDetailAmount(double a)
 template <typename PFP>
 void ProgressiveMesh<PFP>::localizeDetailVectors()
 {
-	if(m_positionApproximator->getPredictor() && !m_localFrameDetailVectors)
+	if(m_positionApproximator && m_positionApproximator->getPredictor() && !m_localFrameDetailVectors)
 	{
 		bool quantizationWasApplied = quantizationApplied ;
 		unsigned int nbCodeVectors = 0 ;
@@ -421,8 +547,8 @@ void ProgressiveMesh<PFP>::localizeDetailVectors()
 		gotoLevel(nbSplits()) ;
 		while(m_cur > 0)
 		{
-			Dart d = m_splits[m_cur-1]->getEdge() ;
-			Dart dd2 = m_splits[m_cur-1]->getRightEdge() ;
+			Dart d(m_splits[m_cur-1].edge) ;
+			Dart dd2(m_splits[m_cur-1].rightEdge) ;
 			typename PFP::MATRIX33 localFrame = Algo::Geometry::vertexLocalFrame<PFP>(m_map, dd2, position) ;
 			VEC3 det = m_positionApproximator->getDetail(d) ;
 			det = localFrame * det ;
@@ -452,8 +578,8 @@ void ProgressiveMesh<PFP>::globalizeDetailVectors()
 		gotoLevel(nbSplits()) ;
 		while(m_cur > 0)
 		{
-			Dart d = m_splits[m_cur-1]->getEdge() ;
-			Dart dd2 = m_splits[m_cur-1]->getRightEdge() ;
+			Dart d(m_splits[m_cur-1].edge) ;
+			Dart dd2(m_splits[m_cur-1].rightEdge) ;
 			typename PFP::MATRIX33 localFrame = Algo::Geometry::vertexLocalFrame<PFP>(m_map, dd2, position) ;
 			typename PFP::MATRIX33 invLocalFrame ;
 			localFrame.invert(invLocalFrame) ;
@@ -472,16 +598,25 @@ void ProgressiveMesh<PFP>::globalizeDetailVectors()
 template <typename PFP>
 void ProgressiveMesh<PFP>::initQuantization()
 {
-//	if(m_positionApproximator->getPredictor() && !quantizationInitialized)
-//	{
-//		gotoLevel(nbSplits()) ;
-//		originalDetailVectors.resize(m_splits.size()) ;
-//		for(unsigned int i = 0; i < m_splits.size(); ++i)
-//			originalDetailVectors[i] = m_positionApproximator->getDetail(m_splits[i]->getEdge(),0) ;
-//		q = new Algo::PMesh::Quantization<VEC3>(originalDetailVectors) ;
-//		quantizationInitialized = true ;
-//		CGoGNout << "  Differential Entropy -> " << q->getDifferentialEntropy() << CGoGNendl ;
-//	}
+	// the detail vectors of a transmitted PM are already quantized
+	if(!m_splits.empty() && m_vertexLines.empty() && !quantizationInitialized)
+	{
+		gotoLevel(nbSplits()) ;
+		originalPositions.resize(2 * m_splits.size()) ;
+		originalDetailVectors.resize(2 * m_splits.size()) ;
+		for(unsigned int i = 0; i < m_splits.size(); ++i)
+		{
+			Dart d(m_splits[i].edge) ;
+			const VEC3& p = position[m_splits[i].approxV] ;
+			originalPositions[2*i] = position[m_map.template getEmbedding<VERTEX>(d)] ;
+			originalPositions[2*i+1] = position[m_map.template getEmbedding<VERTEX>(m_map.phi2(d))] ;
+			originalDetailVectors[2*i] = originalPositions[2*i] - p ;
+			originalDetailVectors[2*i+1] = originalPositions[2*i+1] - p ;
+		}
+		q = new Utils::Quantization<VEC3>(originalDetailVectors) ;
+		quantizationInitialized = true ;
+		CGoGNout << "  Differential Entropy -> " << q->getDifferentialEntropy() << CGoGNendl ;
+	}
 }
 
 template <typename PFP>
@@ -493,8 +628,7 @@ void ProgressiveMesh<PFP>::quantizeDetailVectors(unsigned int nbClasses)
 		gotoLevel(nbSplits()) ;
 		std::vector<VEC3> resultat;
 		q->vectorQuantizationNbRegions(nbClasses, resultat) ;
-		for(unsigned int i = 0; i < m_splits.size(); ++i)
-			m_positionApproximator->setDetail(m_splits[i]->getEdge(), 0, resultat[i]) ;
+		setQuantizedDetails() ;
 		quantizationApplied = true ;
 		gotoLevel(0) ;
 		CGoGNout << "Discrete Entropy -> " << q->getDiscreteEntropy() << " (codebook size : " << q->getNbCodeVectors() << ")" << CGoGNendl ;
@@ -517,8 +651,7 @@ void ProgressiveMesh<PFP>::quantizeDetailVectors(float distortion)
 		gotoLevel(nbSplits()) ;
 		std::vector<typename PFP::VEC3> resultat;
 		q->vectorQuantizationDistortion(distortion, resultat) ;
-		for(unsigned int i = 0; i < m_splits.size(); ++i)
-			m_positionApproximator->setDetail(m_splits[i]->getEdge(), resultat[i]) ;
+		setQuantizedDetails() ;
 		quantizationApplied = true ;
 		gotoLevel(0) ;
 		CGoGNout << "Discrete Entropy -> " << q->getDiscreteEntropy() << " (codebook size : " << q->getNbCodeVectors() << ")" << CGoGNendl ;
@@ -532,7 +665,14 @@ void ProgressiveMesh<PFP>::resetDetailVectors()
 	{
 		gotoLevel(nbSplits()) ;
 		for(unsigned int i = 0; i < m_splits.size(); ++i)
-			m_positionApproximator->setDetail(m_splits[i]->getEdge(), originalDetailVectors[i]) ;
+		{
+			Dart d(m_splits[i].edge) ;
+			position[m_map.template getEmbedding<VERTEX>(d)] = originalPositions[2*i] ;
+			position[m_map.template getEmbedding<VERTEX>(m_map.phi2(d))] = originalPositions[2*i+1] ;
+			m_splits[i].detail1 = EMBNULL ;
+			m_splits[i].detail2 = EMBNULL ;
+		}
+		m_codebook.clear() ;
 		delete q ;
 		quantizationInitialized = false ;
 		quantizationApplied = false ;
@@ -540,6 +680,286 @@ void ProgressiveMesh<PFP>::resetDetailVectors()
 	}
 }
 
+template <typename PFP>
+void ProgressiveMesh<PFP>::setQuantizedDetails()
+{
+	std::vector<unsigned int> codes ;
+	q->getCodebook(m_codebook, codes) ;
+
+	// the codes are chosen from the positions rebuilt at the coarser levels (as they
+	// are rebuilt by the receiver), so that the quantization errors do not add up
+	Utils::KdTree<VEC3> codebookTree ;
+	codebookTree.build(m_codebook) ;
+	gotoLevel(nbSplits()) ;
+	while(m_cur > 0)
+	{
+		VSplitRecord& vs = m_splits[m_cur-1] ;
+		const VEC3& p = position[vs.approxV] ;
+		vs.detail1 = codebookTree.nearest(originalPositions[2*(m_cur-1)] - p) ;
+		vs.detail2 = codebookTree.nearest(originalPositions[2*(m_cur-1)+1] - p) ;
+		applySplit(--m_cur) ;
+	}
+}
+
+template <typename PFP>
+void ProgressiveMesh<PFP>::releaseSplits()
+{
+	AttributeContainer& vcont = m_map.template getAttributeContainer<VERTEX>() ;
+	AttributeContainer& econt = m_map.template getAttributeContainer<EDGE>() ;
+	for(unsigned int i = 0; i < m_splits.size(); ++i)
+	{
+		if(m_splits[i].approxV != EMBNULL) vcont.unrefLine(m_splits[i].approxV) ;
+		if(m_splits[i].approxE1 != EMBNULL) econt.unrefLine(m_splits[i].approxE1) ;
+		if(m_splits[i].approxE2 != EMBNULL) econt.unrefLine(m_splits[i].approxE2) ;
+	}
+	m_splits.clear() ;
+	m_codebook.clear() ;
+	m_codes.clear() ;
+	m_vertexDarts.clear() ;
+	m_vertexLines.clear() ;
+}
+
+template <typename PFP>
+bool ProgressiveMesh<PFP>::saveSplits(const std::string& filename)
+{
+	if(!quantizationApplied)
+	{
+		CGoGNerr << "saveSplits: the detail vectors are not quantized" << CGoGNendl ;
+		return false ;
+	}
+
+	CGoGNostream fs(filename.c_str(), std::ios::out|std::ios::binary) ;
+	if (!fs)
+	{
+		CGoGNerr << "Unable to open file for writing: " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	unsigned int level = m_cur ;
+	gotoLevel(nbSplits()) ;
+
+	// base mesh : the vertices are numbered in their order of appearance in the faces
+	std::vector<unsigned int> vertexId(m_map.template getAttributeContainer<VERTEX>().end(), EMBNULL) ;
+	std::vector<VEC3> positions ;
+	std::vector<unsigned int> faces ;	// degree of the face followed by its vertices
+	unsigned int nbFaces = 0 ;
+	foreach_cell<FACE>(m_map, [&] (Face f)
+	{
+		if(inactiveMarker.isMarked(f.dart))
+			return ;
+		++nbFaces ;
+		faces.push_back(m_map.faceDegree(f.dart)) ;
+		Dart it = f.dart ;
+		do
+		{
+			unsigned int v = m_map.template getEmbedding<VERTEX>(it) ;
+			if(vertexId[v] == EMBNULL)
+			{
+				vertexId[v] = uint32(positions.size()) ;
+				positions.push_back(position[v]) ;
+			}
+			faces.push_back(vertexId[v]) ;
+			it = m_map.phi1(it) ;
+		} while(it != f.dart) ;
+	});
+
+	// splits, from the coarsest one : the two new vertices of each split are numbered after the others
+	std::vector<VSplitCode> codes ;
+	codes.reserve(m_splits.size()) ;
+	unsigned int nbVertices = uint32(positions.size()) ;
+	while(m_cur > 0)
+	{
+		const VSplitRecord& vs = m_splits[m_cur-1] ;
+		VSplitCode c ;
+		c.vertex = vertexId[vs.approxV] ;
+		c.left = vertexId[m_map.template getEmbedding<VERTEX>(m_map.phi1(Dart(vs.leftEdge)))] ;
+		c.right = vertexId[m_map.template getEmbedding<VERTEX>(m_map.phi1(Dart(vs.rightEdge)))] ;
+		c.detail1 = vs.detail1 ;
+		c.detail2 = vs.detail2 ;
+		codes.push_back(c) ;
+
+		applySplit(--m_cur) ;
+		Dart d(vs.edge) ;
+		vertexId[m_map.template getEmbedding<VERTEX>(d)] = nbVertices++ ;
+		vertexId[m_map.template getEmbedding<VERTEX>(m_map.phi2(d))] = nbVertices++ ;
+	}
+	gotoLevel(level) ;
+
+	char buff[16] ;
+	memset(buff, 0, 16) ;
+	memcpy(buff, "CGoGN_PMesh", 12) ;
+	fs.write(buff, 16) ;
+
+	unsigned int header[7] ;
+	header[0] = 2 ;		// version
+	header[1] = uint32(sizeof(VEC3)) ;
+	header[2] = uint32(positions.size()) ;
+	header[3] = nbFaces ;
+	header[4] = uint32(faces.size()) ;
+	header[5] = uint32(m_codebook.size()) ;
+	header[6] = uint32(codes.size()) ;
+	fs.write(reinterpret_cast<const char*>(header), 7*sizeof(unsigned int)) ;
+
+	if (!positions.empty())
+		fs.write(reinterpret_cast<const char*>(&positions[0]), positions.size()*sizeof(VEC3)) ;
+	if (!faces.empty())
+		fs.write(reinterpret_cast<const char*>(&faces[0]), faces.size()*sizeof(unsigned int)) ;
+	if (!m_codebook.empty())
+		fs.write(reinterpret_cast<const char*>(&m_codebook[0]), m_codebook.size()*sizeof(VEC3)) ;
+	if (!codes.empty())
+		fs.write(reinterpret_cast<const char*>(&codes[0]), codes.size()*sizeof(VSplitCode)) ;
+
+	return true ;
+}
+
+template <typename PFP>
+bool ProgressiveMesh<PFP>::loadSplits(const std::string& filename)
+{
+	if(m_map.begin() != m_map.end())
+	{
+		CGoGNerr << "loadSplits: the map is not empty" << CGoGNendl ;
+		return false ;
+	}
+
+	CGoGNistream fs(filename.c_str(), std::ios::in|std::ios::binary) ;
+	if (!fs)
+	{
+		CGoGNerr << "Unable to open file for loading: " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	char buff[16] ;
+	fs.read(buff, 16) ;
+	unsigned int header[7] ;
+	fs.read(reinterpret_cast<char*>(header), 7*sizeof(unsigned int)) ;
+	if (!fs.good() || strncmp(buff, "CGoGN_PMesh", 12) != 0 || header[0] != 2 || header[1] != sizeof(VEC3))
+	{
+		CGoGNerr << "Wrong progressive mesh file: " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	// the map is empty : the previous splits have no embedding to release
+	m_splits.clear() ;
+	m_codes.clear() ;
+	m_vertexDarts.clear() ;
+	m_vertexLines.clear() ;
+	if(quantizationInitialized)
+	{
+		delete q ;
+		quantizationInitialized = false ;
+		quantizationApplied = false ;
+	}
+
+	std::vector<VEC3> positions(header[2]) ;
+	std::vector<unsigned int> faces(header[4]) ;
+	std::vector<VSplitCode> codes(header[6]) ;
+	m_codebook.resize(header[5]) ;
+	if (!positions.empty())
+		fs.read(reinterpret_cast<char*>(&positions[0]), positions.size()*sizeof(VEC3)) ;
+	if (!faces.empty())
+		fs.read(reinterpret_cast<char*>(&faces[0]), faces.size()*sizeof(unsigned int)) ;
+	if (!m_codebook.empty())
+		fs.read(reinterpret_cast<char*>(&m_codebook[0]), m_codebook.size()*sizeof(VEC3)) ;
+	if (!codes.empty())
+		fs.read(reinterpret_cast<char*>(&codes[0]), codes.size()*sizeof(VSplitCode)) ;
+	if (!fs.good())
+	{
+		m_codebook.clear() ;
+		CGoGNerr << "Truncated progressive mesh file: " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	// check the indices before building anything
+	const unsigned int nbVertices = header[2] ;
+	bool valid = true ;
+	unsigned int k = 0 ;
+	for(unsigned int f = 0; valid && f < header[3]; ++f)
+	{
+		valid = k < faces.size() && faces[k] >= 3 && k + faces[k] < faces.size() ;
+		for(unsigned int j = 1; valid && j <= faces[k]; ++j)
+			valid = faces[k+j] < nbVertices ;
+		k += valid ? faces[k] + 1 : 0 ;
+	}
+	valid = valid && k == faces.size() ;
+	for(unsigned int i = 0; valid && i < codes.size(); ++i)
+	{
+		const VSplitCode& c = codes[i] ;
+		unsigned int n = nbVertices + 2*i ;	// number of vertices when the split is applied
+		valid = c.vertex < n && c.left < n && c.right < n && c.detail1 < m_codebook.size() && c.detail2 < m_codebook.size() ;
+	}
+	if(!valid)
+	{
+		m_codebook.clear() ;
+		CGoGNerr << "Invalid progressive mesh file: " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	// base mesh
+	m_vertexLines.resize(nbVertices) ;
+	m_vertexDarts.resize(nbVertices) ;
+	std::vector< std::vector<Dart> > vertexDarts(nbVertices) ;
+	std::vector<unsigned int> lineVertex ;
+	for(unsigned int i = 0; i < nbVertices; ++i)
+	{
+		m_vertexLines[i] = m_map.template newCell<VERTEX>() ;
+		position[m_vertexLines[i]] = positions[i] ;
+		if(lineVertex.size() <= m_vertexLines[i])
+			lineVertex.resize(m_vertexLines[i] + 1, EMBNULL) ;
+		lineVertex[m_vertexLines[i]] = i ;
+	}
+	for(k = 0; k < faces.size(); k += faces[k] + 1)
+	{
+		Dart d = m_map.newFace(faces[k], false) ;
+		for(unsigned int j = 1; j <= faces[k]; ++j)
+		{
+			m_map.template initDartEmbedding<VERTEX>(d, m_vertexLines[faces[k+j]]) ;
+			m_vertexDarts[faces[k+j]] = d ;
+			vertexDarts[faces[k+j]].push_back(d) ;
+			d = m_map.phi1(d) ;
+		}
+	}
+	// the dart of an edge (v,w) is sewn with the one of (w,v)
+	for(unsigned int v = 0; v < nbVertices; ++v)
+	{
+		for(std::vector<Dart>::iterator it = vertexDarts[v].begin(); it != vertexDarts[v].end(); ++it)
+		{
+			if(m_map.phi2(*it) != *it)
+				continue ;
+			unsigned int w = m_map.template getEmbedding<VERTEX>(m_map.phi1(*it)) ;
+			std::vector<Dart>& wDarts = vertexDarts[lineVertex[w]] ;
+			for(std::vector<Dart>::iterator jt = wDarts.begin(); jt != wDarts.end(); ++jt)
+			{
+				if(m_map.phi2(*jt) == *jt && m_map.template getEmbedding<VERTEX>(m_map.phi1(*jt)) == m_vertexLines[v])
+				{
+					m_map.sewFaces(*it, *jt, false) ;
+					break ;
+				}
+			}
+		}
+	}
+	m_map.closeMap() ;
+
+	// splits : decoded when they are applied
+	m_splits.resize(codes.size()) ;
+	m_codes.resize(codes.size()) ;
+	for(unsigned int i = 0; i < codes.size(); ++i)
+	{
+		VSplitRecord& vs = m_splits[codes.size()-1-i] ;
+		vs.edge = EMBNULL ;
+		vs.rightEdge = EMBNULL ;
+		vs.leftEdge = EMBNULL ;
+		vs.approxV = EMBNULL ;
+		vs.approxE1 = EMBNULL ;
+		vs.approxE2 = EMBNULL ;
+		vs.detail1 = EMBNULL ;
+		vs.detail2 = EMBNULL ;
+		m_codes[codes.size()-1-i] = codes[i] ;
+	}
+	m_cur = uint32(m_splits.size()) ;
+
+	return true ;
+}
+
 /*
 template <typename PFP>
 float ProgressiveMesh<PFP>::computeDistance2()
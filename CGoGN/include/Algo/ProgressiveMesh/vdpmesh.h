@@ -0,0 +1,178 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __VDPMESH__
+#define __VDPMESH__
+
+#include "Algo/ProgressiveMesh/pmesh.h"
+
+#include "Geometry/vector_gen.h"
+#include "Geometry/matrix.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace PMesh
+{
+
+/**
+ * camera used to drive the selective refinement :
+ * the 6 clipping planes and the eye position, in object space
+ */
+template <typename REAL>
+class ViewFrustum
+{
+public:
+	typedef Geom::Vector<3,REAL> VEC3 ;
+	typedef Geom::Vector<4,REAL> VEC4 ;
+	typedef Geom::Matrix<4,4,REAL> MATRIX44 ;
+
+private:
+	VEC4 m_planes[6] ;
+	VEC3 m_eye ;
+	REAL m_pixelScale ;
+
+public:
+	/**
+	 * @param projModelView the product projection * modelview (column vectors convention)
+	 * @param eye the position of the camera in object space
+	 * @param viewportHeight the height of the viewport in pixels
+	 * @param fovy the vertical field of view (radians)
+	 */
+	ViewFrustum(const MATRIX44& projModelView, const VEC3& eye, unsigned int viewportHeight, REAL fovy) ;
+
+	const VEC3& eye() const { return m_eye ; }
+
+	/**
+	 * test if a sphere is completely outside of the frustum
+	 */
+	bool isOutside(const VEC3& center, REAL radius) const ;
+
+	/**
+	 * size in pixels of a deviation at the given distance of the eye
+	 * (the distance is taken to the nearest point of the bounding sphere)
+	 */
+	REAL screenError(const VEC3& center, REAL radius, REAL deviation) const ;
+} ;
+
+/**
+ * Selective (view-dependent) refinement of a progressive mesh [Hoppe 97]
+ * The splits of the ProgressiveMesh are applied out of order : split where the
+ * screen-space deviation of a vertex exceeds a threshold, collapse elsewhere.
+ * A split or a collapse is legal if the cells it involves are in the same
+ * configuration as when the PM was built; illegal splits are forced by first
+ * applying the splits they depend on.
+ * While the selective refinement is in use, the levels of the ProgressiveMesh
+ * are not meaningful : use gotoLevel of this class to come back to a level.
+ */
+template <typename PFP>
+class ViewDependentPMesh
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+private:
+	// dependency information of a split, gathered when replaying the collapses
+	struct SplitDependency
+	{
+		unsigned int d1 ;		// the two other neighbours (phi2 of phi1) of the
+		unsigned int dd1 ;		// collapsed triangles (rightEdge and leftEdge are the first ones)
+		unsigned int v1 ;		// embeddings of the two vertices
+		unsigned int v2 ;		// of the collapsed edge
+		unsigned int parent ;	// split that collapses the resulting vertex (NONE if root)
+		REAL radius ;			// bounding sphere radius of the vertices merged in the resulting vertex
+		REAL deviation ;		// geometric deviation of the collapse (and of its descendants)
+	} ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+	MAP& m_map ;
+	ProgressiveMesh<PFP>& m_pmesh ;
+	VertexAttribute<VEC3, MAP>& m_position ;
+	DartMarker<MAP>& m_inactive ;
+
+	std::vector<SplitDependency> m_deps ;
+	std::vector<unsigned char> m_collapsed ;
+	DartAttribute<unsigned int, MAP> m_faceSplit ;	// split that removes the face of a dart
+
+	std::vector<unsigned int> m_stack ;
+	unsigned int m_refineCursor ;
+	unsigned int m_coarsenCursor ;
+	unsigned int m_nbCollapsed ;
+
+	bool vertexActive(unsigned int i) const ;
+	bool collapseLegal(unsigned int i) const ;
+	bool needsRefinement(const ViewFrustum<REAL>& view, REAL tau, unsigned int i) const ;
+
+	void split(unsigned int i) ;
+	void collapse(unsigned int i) ;
+	void forceSplit(unsigned int i) ;
+
+public:
+	/**
+	 * build the dependencies by replaying all the collapses of the PM
+	 * (the PM is left fully coarsened)
+	 */
+	ViewDependentPMesh(MAP& map, ProgressiveMesh<PFP>& pm, VertexAttribute<VEC3, MAP>& position, DartMarker<MAP>& inactive) ;
+	~ViewDependentPMesh() ;
+
+	/**
+	 * adapt the mesh to the view : split the vertices whose deviation projects to more
+	 * than tau pixels and collapse the others
+	 * @param budget time budget in milliseconds (0 for no limit)
+	 * @return true if the adaptation is complete, false if it has to be continued
+	 * in the next call (budget exhausted)
+	 */
+	bool adaptRefinement(const ViewFrustum<REAL>& view, REAL tau, double budget = 0.0) ;
+
+	/**
+	 * go back to a level of the global split sequence
+	 */
+	void gotoLevel(unsigned int l) ;
+
+	unsigned int nbCollapsed() const { return m_nbCollapsed ; }
+	bool isCollapsed(unsigned int i) const { return m_collapsed[i] != 0 ; }
+} ;
+
+} // namespace PMesh
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/ProgressiveMesh/vdpmesh.hpp"
+
+#endif
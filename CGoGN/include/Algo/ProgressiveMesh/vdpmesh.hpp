@@ -0,0 +1,319 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace PMesh
+{
+
+/************************************************************************************
+ *                                  VIEW FRUSTUM                                    *
+ ************************************************************************************/
+
+template <typename REAL>
+ViewFrustum<REAL>::ViewFrustum(const MATRIX44& projModelView, const VEC3& eye, unsigned int viewportHeight, REAL fovy) :
+	m_eye(eye)
+{
+	// planes are combinations of the rows of the projection (left/right, bottom/top, near/far)
+	for(unsigned int i = 0; i < 3; ++i)
+	{
+		for(unsigned int j = 0; j < 4; ++j)
+		{
+			m_planes[2*i][j] = projModelView(3, j) + projModelView(i, j) ;
+			m_planes[2*i+1][j] = projModelView(3, j) - projModelView(i, j) ;
+		}
+	}
+	for(unsigned int i = 0; i < 6; ++i)
+	{
+		REAL n = VEC3(m_planes[i][0], m_planes[i][1], m_planes[i][2]).norm() ;
+		if(n > REAL(0))
+			m_planes[i] /= n ;
+	}
+
+	m_pixelScale = REAL(viewportHeight) / (REAL(2) * std::tan(fovy / REAL(2))) ;
+}
+
+template <typename REAL>
+bool ViewFrustum<REAL>::isOutside(const VEC3& center, REAL radius) const
+{
+	for(unsigned int i = 0; i < 6; ++i)
+	{
+		const VEC4& p = m_planes[i] ;
+		if(p[0]*center[0] + p[1]*center[1] + p[2]*center[2] + p[3] < -radius)
+			return true ;
+	}
+	return false ;
+}
+
+template <typename REAL>
+REAL ViewFrustum<REAL>::screenError(const VEC3& center, REAL radius, REAL deviation) const
+{
+	REAL dist = (center - m_eye).norm() - radius ;
+	if(dist <= REAL(0))
+		return deviation > REAL(0) ? std::numeric_limits<REAL>::max() : REAL(0) ;
+	return deviation * m_pixelScale / dist ;
+}
+
+/************************************************************************************
+ *                              SELECTIVE REFINEMENT                                *
+ ************************************************************************************/
+
+template <typename PFP>
+ViewDependentPMesh<PFP>::ViewDependentPMesh(MAP& map, ProgressiveMesh<PFP>& pm, VertexAttribute<VEC3, MAP>& position, DartMarker<MAP>& inactive) :
+	m_map(map),
+	m_pmesh(pm),
+	m_position(position),
+	m_inactive(inactive)
+{
+	std::vector<VSplitRecord>& splits = m_pmesh.splits() ;
+	unsigned int nbSplits = uint32(splits.size()) ;
+
+	m_faceSplit = m_map.template addAttribute<unsigned int, DART, MAP>("vdpm_faceSplit") ;
+	m_deps.resize(nbSplits) ;
+	m_collapsed.assign(nbSplits, 0) ;
+
+	// vertex line -> split that creates it
+	std::vector<unsigned int> lineSplit(m_map.template getAttributeContainer<VERTEX>().end(), NONE) ;
+
+	m_pmesh.gotoLevel(0) ;
+	for(unsigned int i = 0; i < nbSplits; ++i)
+	{
+		const VSplitRecord& vs = splits[i] ;
+		SplitDependency& dep = m_deps[i] ;
+
+		Dart d(vs.edge) ;
+		Dart dd = m_map.phi2(d) ;
+		dep.d1 = m_map.phi2(m_map.phi1(d)).index ;
+		dep.dd1 = m_map.phi2(m_map.phi1(dd)).index ;
+		dep.v1 = m_map.template getEmbedding<VERTEX>(d) ;
+		dep.v2 = m_map.template getEmbedding<VERTEX>(dd) ;
+		dep.parent = NONE ;
+
+		const VEC3& center = m_position[vs.approxV] ;
+		REAL r1 = (m_position[dep.v1] - center).norm() ;
+		REAL r2 = (m_position[dep.v2] - center).norm() ;
+		dep.deviation = std::max(r1, r2) ;
+		unsigned int c1 = lineSplit[dep.v1] ;
+		if(c1 != NONE)
+		{
+			m_deps[c1].parent = i ;
+			r1 += m_deps[c1].radius ;
+			dep.deviation = std::max(dep.deviation, m_deps[c1].deviation) ;
+		}
+		unsigned int c2 = lineSplit[dep.v2] ;
+		if(c2 != NONE)
+		{
+			m_deps[c2].parent = i ;
+			r2 += m_deps[c2].radius ;
+			dep.deviation = std::max(dep.deviation, m_deps[c2].deviation) ;
+		}
+		dep.radius = std::max(r1, r2) ;
+
+		m_faceSplit[d] = i ;
+		m_faceSplit[m_map.phi1(d)] = i ;
+		m_faceSplit[m_map.phi_1(d)] = i ;
+		m_faceSplit[dd] = i ;
+		m_faceSplit[m_map.phi1(dd)] = i ;
+		m_faceSplit[m_map.phi_1(dd)] = i ;
+
+		m_pmesh.collapseRecord(vs) ;
+		m_collapsed[i] = 1 ;
+		lineSplit[vs.approxV] = i ;
+	}
+	m_pmesh.currentLevel() = nbSplits ;
+
+	m_nbCollapsed = nbSplits ;
+	m_refineCursor = nbSplits ;
+	m_coarsenCursor = 0 ;
+}
+
+template <typename PFP>
+ViewDependentPMesh<PFP>::~ViewDependentPMesh()
+{
+	m_map.removeAttribute(m_faceSplit) ;
+}
+
+template <typename PFP>
+inline bool ViewDependentPMesh<PFP>::vertexActive(unsigned int i) const
+{
+	const VSplitRecord& vs = m_pmesh.splits()[i] ;
+	return m_map.template getEmbedding<VERTEX>(Dart(vs.leftEdge)) == vs.approxV ;
+}
+
+template <typename PFP>
+bool ViewDependentPMesh<PFP>::collapseLegal(unsigned int i) const
+{
+	// both vertices are active and the four neighbours of the triangles are the original ones
+	const VSplitRecord& vs = m_pmesh.splits()[i] ;
+	const SplitDependency& dep = m_deps[i] ;
+	Dart d(vs.edge) ;
+	Dart dd = m_map.phi2(d) ;
+	return
+		m_map.template getEmbedding<VERTEX>(d) == dep.v1 &&
+		m_map.template getEmbedding<VERTEX>(dd) == dep.v2 &&
+		m_map.phi2(m_map.phi_1(d)).index == vs.leftEdge &&
+		m_map.phi2(m_map.phi_1(dd)).index == vs.rightEdge &&
+		m_map.phi2(m_map.phi1(d)).index == dep.d1 &&
+		m_map.phi2(m_map.phi1(dd)).index == dep.dd1 ;
+}
+
+template <typename PFP>
+inline bool ViewDependentPMesh<PFP>::needsRefinement(const ViewFrustum<REAL>& view, REAL tau, unsigned int i) const
+{
+	const SplitDependency& dep = m_deps[i] ;
+	const VEC3& center = m_position[m_pmesh.splits()[i].approxV] ;
+	if(view.isOutside(center, dep.radius))
+		return false ;
+	return view.screenError(center, dep.radius, dep.deviation) > tau ;
+}
+
+template <typename PFP>
+inline void ViewDependentPMesh<PFP>::split(unsigned int i)
+{
+	m_pmesh.splitRecord(m_pmesh.splits()[i]) ;
+	m_collapsed[i] = 0 ;
+	--m_nbCollapsed ;
+}
+
+template <typename PFP>
+inline void ViewDependentPMesh<PFP>::collapse(unsigned int i)
+{
+	m_pmesh.collapseRecord(m_pmesh.splits()[i]) ;
+	m_collapsed[i] = 1 ;
+	++m_nbCollapsed ;
+}
+
+template <typename PFP>
+void ViewDependentPMesh<PFP>::forceSplit(unsigned int i)
+{
+	// the splits a split depends on all come later in the sequence : the ones that
+	// removed the faces around the collapsed triangles and the one that merged its vertex
+	m_stack.clear() ;
+	m_stack.push_back(i) ;
+	while(!m_stack.empty())
+	{
+		unsigned int k = m_stack.back() ;
+		if(!m_collapsed[k])
+		{
+			m_stack.pop_back() ;
+			continue ;
+		}
+
+		// the four faces around the collapsed triangles must be active
+		const VSplitRecord& vs = m_pmesh.splits()[k] ;
+		Dart f[4] = { Dart(vs.leftEdge), Dart(m_deps[k].d1), Dart(vs.rightEdge), Dart(m_deps[k].dd1) } ;
+		unsigned int j = 0 ;
+		while(j < 4 && !m_inactive.isMarked(f[j]))
+			++j ;
+		if(j < 4)
+			m_stack.push_back(m_faceSplit[f[j]]) ;
+		else if(!vertexActive(k))
+		{
+			assert(m_deps[k].parent != NONE) ;
+			m_stack.push_back(m_deps[k].parent) ;
+		}
+		else
+		{
+			m_stack.pop_back() ;
+			split(k) ;
+		}
+	}
+}
+
+template <typename PFP>
+bool ViewDependentPMesh<PFP>::adaptRefinement(const ViewFrustum<REAL>& view, REAL tau, double budget)
+{
+	unsigned int nbSplits = uint32(m_deps.size()) ;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now() ;
+	unsigned int count = 0 ;
+	auto exhausted = [&] () -> bool
+	{
+		if(budget <= 0.0 || (++count & 63) != 0)
+			return false ;
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() > budget ;
+	} ;
+
+	// coarse to fine : the children of a vertex are considered after it is split
+	while(m_refineCursor > 0)
+	{
+		unsigned int i = --m_refineCursor ;
+		if(m_collapsed[i] && vertexActive(i) && needsRefinement(view, tau, i))
+			forceSplit(i) ;
+		if(exhausted())
+			return false ;
+	}
+
+	// fine to coarse : a vertex may be collapsed once its children are
+	while(m_coarsenCursor < nbSplits)
+	{
+		unsigned int i = m_coarsenCursor++ ;
+		if(!m_collapsed[i] && !needsRefinement(view, tau, i) && collapseLegal(i))
+			collapse(i) ;
+		if(exhausted())
+			return false ;
+	}
+
+	m_refineCursor = nbSplits ;
+	m_coarsenCursor = 0 ;
+	return true ;
+}
+
+template <typename PFP>
+void ViewDependentPMesh<PFP>::gotoLevel(unsigned int l)
+{
+	unsigned int nbSplits = uint32(m_deps.size()) ;
+	if(l > nbSplits)
+		return ;
+
+	// splits in reverse order are always legal, then collapses in order
+	for(unsigned int i = nbSplits; i-- > 0; )
+		if(m_collapsed[i])
+			split(i) ;
+	for(unsigned int i = 0; i < l; ++i)
+		collapse(i) ;
+	m_pmesh.currentLevel() = l ;
+
+	m_refineCursor = nbSplits ;
+	m_coarsenCursor = 0 ;
+}
+
+} // namespace PMesh
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
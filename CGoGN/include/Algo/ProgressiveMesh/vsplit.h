@@ -37,6 +37,39 @@ namespace Surface
 namespace PMesh
 {
 
+/**
+ * compact record of a vertex split, as stored in the contiguous split
+ * stream of ProgressiveMesh (32 bytes, no pointer)
+ * darts are given by their index, embeddings by their container line
+ */
+struct VSplitRecord
+{
+	unsigned int edge ;			// the collapsed edge (EMBNULL while the split is not decoded)
+	unsigned int rightEdge ;	// the two edges that are sewn
+	unsigned int leftEdge ;		// when the edge is collapsed
+	unsigned int approxV ;		// embedding of the resulting vertex
+	unsigned int approxE1 ;		// embeddings of the
+	unsigned int approxE2 ;		// two resulting edges
+	unsigned int detail1 ;		// indices of the quantized detail vectors of the two
+	unsigned int detail2 ;		// split vertices (EMBNULL if none)
+} ;
+
+/**
+ * vertex split as it is transmitted : it only refers to the vertices of the
+ * mesh being refined, numbered in their order of creation (vertices of the base
+ * mesh first, then the two vertices of each split)
+ * the new vertices are placed at the position of the split vertex plus their
+ * quantized detail vector
+ */
+struct VSplitCode
+{
+	unsigned int vertex ;		// the split vertex
+	unsigned int left ;			// the vertices opposite to the
+	unsigned int right ;		// new edge in the inserted triangles
+	unsigned int detail1 ;		// indices of the detail vectors in the codebook
+	unsigned int detail2 ;
+} ;
+
 template <typename PFP>
 class VSplit 
 {
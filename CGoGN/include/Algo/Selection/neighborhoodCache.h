@@ -0,0 +1,124 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __NEIGHBORHOOD_CACHE_H__
+#define __NEIGHBORHOOD_CACHE_H__
+
+#include "Algo/Selection/collector.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Selection
+{
+
+/*********************************************************
+ * Neighborhood Cache
+ *********************************************************/
+
+/*
+ * store for each vertex of the map:
+ * ring = adjacent vertices (1-ring)
+ * insideEdges, border = cells collected by a Collector_WithinSphere of given radius
+ * borderRatios = part of each border edge inside the sphere
+ * so that several per-vertex computations (curvatures...) can share
+ * a single collection. Collection is done in parallel if NumberOfThreads > 1.
+ * The cache must be updated when the positions or the topology change.
+ */
+template <typename PFP>
+class NeighborhoodCache
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	struct Neighborhood
+	{
+		std::vector<Dart> ring ;
+		std::vector<Edge> insideEdges ;
+		std::vector<Dart> border ;
+		std::vector<REAL> borderRatios ;
+	} ;
+
+protected:
+	MAP& m_map ;
+	const VertexAttribute<VEC3, MAP>& m_position ;
+	REAL m_radius ;
+
+	std::vector<Neighborhood> m_neighborhoods ;
+
+	void collect(Vertex v, Collector_WithinSphere<PFP>& col) ;
+
+	inline const Neighborhood& neighborhood(Vertex v) const
+	{
+		return m_neighborhoods[m_map.template getEmbedding<VERTEX>(v)] ;
+	}
+
+public:
+	/**
+	 * @param radius radius of the collected spheres (only the 1-rings are collected if radius <= 0)
+	 */
+	NeighborhoodCache(MAP& map, const VertexAttribute<VEC3, MAP>& position, REAL radius) ;
+
+	/**
+	 * collect again all the neighborhoods
+	 */
+	void update() ;
+
+	inline void setRadius(REAL r) { m_radius = r ; update() ; }
+	inline REAL getRadius() const { return m_radius ; }
+
+	inline MAP& getMap() const { return m_map ; }
+	inline const VertexAttribute<VEC3, MAP>& getPosition() const { return m_position ; }
+
+	inline const std::vector<Dart>& getRing(Vertex v) const { return neighborhood(v).ring ; }
+	inline const std::vector<Edge>& getInsideEdges(Vertex v) const { return neighborhood(v).insideEdges ; }
+	inline const std::vector<Dart>& getBorder(Vertex v) const { return neighborhood(v).border ; }
+	inline const std::vector<REAL>& getBorderRatios(Vertex v) const { return neighborhood(v).borderRatios ; }
+
+	/**
+	 * area of the neighborhood of v (as Collector_WithinSphere::computeArea)
+	 */
+	REAL computeArea(Vertex v, const EdgeAttribute<REAL, MAP>& edgearea) const ;
+} ;
+
+} // namespace Selection
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Selection/neighborhoodCache.hpp"
+
+#endif
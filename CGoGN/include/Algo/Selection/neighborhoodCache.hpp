@@ -0,0 +1,132 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Algo/Topo/basic.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Selection
+{
+
+template <typename PFP>
+NeighborhoodCache<PFP>::NeighborhoodCache(MAP& map, const VertexAttribute<VEC3, MAP>& position, REAL radius) :
+	m_map(map),
+	m_position(position),
+	m_radius(radius)
+{
+	update() ;
+}
+
+template <typename PFP>
+void NeighborhoodCache<PFP>::collect(Vertex v, Collector_WithinSphere<PFP>& col)
+{
+	Neighborhood& n = m_neighborhoods[m_map.template getEmbedding<VERTEX>(v)] ;
+
+	n.ring.clear() ;
+	foreach_adjacent2<EDGE>(m_map, v, [&] (Vertex it)
+	{
+		n.ring.push_back(it.dart) ;
+	});
+
+	n.insideEdges.clear() ;
+	n.border.clear() ;
+	n.borderRatios.clear() ;
+	if (m_radius > 0)
+	{
+		col.collectAll(v) ;
+		n.insideEdges = col.getInsideEdges() ;
+		n.border = col.getBorder() ;
+		n.borderRatios.reserve(n.border.size()) ;
+		for (Dart d : n.border)
+			n.borderRatios.push_back(col.borderEdgeRatio(d, m_position)) ;
+	}
+}
+
+template <typename PFP>
+void NeighborhoodCache<PFP>::update()
+{
+	m_neighborhoods.clear() ;
+	m_neighborhoods.resize(m_position.end()) ;
+
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads ;
+	if (nbth > 1)
+	{
+		// markers of lazily embedded orbits would create embeddings concurrently
+		if (!m_map.template isOrbitEmbedded<VERTEX>())
+			Algo::Topo::initAllOrbitsEmbedding<VERTEX>(m_map) ;
+		if (!m_map.template isOrbitEmbedded<EDGE>())
+			Algo::Topo::initAllOrbitsEmbedding<EDGE>(m_map) ;
+		if (!m_map.template isOrbitEmbedded<FACE>())
+			Algo::Topo::initAllOrbitsEmbedding<FACE>(m_map) ;
+
+		std::vector< Collector_WithinSphere<PFP> > collectors ;
+		collectors.reserve(nbth) ;
+		for (unsigned int i = 0; i < nbth; ++i)
+			collectors.emplace_back(m_map, m_position, m_radius) ;
+
+		CGoGN::Parallel::foreach_cell<VERTEX>(m_map, [&] (Vertex v, unsigned int thr)
+		{
+			collect(v, collectors[thr]) ;
+		}, FORCE_CELL_MARKING, nbth) ;
+	}
+	else
+	{
+		Collector_WithinSphere<PFP> col(m_map, m_position, m_radius) ;
+		foreach_cell<VERTEX>(m_map, [&] (Vertex v)
+		{
+			collect(v, col) ;
+		}, FORCE_CELL_MARKING) ;
+	}
+}
+
+template <typename PFP>
+typename PFP::REAL NeighborhoodCache<PFP>::computeArea(Vertex v, const EdgeAttribute<REAL, MAP>& edgearea) const
+{
+	const Neighborhood& n = neighborhood(v) ;
+	REAL area = 0 ;
+
+	for (Edge e : n.insideEdges)
+		area += edgearea[e] ;
+
+	for (unsigned int i = 0; i < n.border.size(); ++i)
+		area += n.borderRatios[i] * edgearea[n.border[i]] ;
+
+	return area ;
+}
+
+} // namespace Selection
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
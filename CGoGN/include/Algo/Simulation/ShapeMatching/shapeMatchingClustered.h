@@ -0,0 +1,117 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2013, IGG Team, ICube, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "shapeMatching.h"
+
+#include <Eigen/SVD>
+
+#include "Topology/generic/parallelLoop.h"
+
+#ifndef _SHAPE_MATCHING_CLUSTERED_H_
+#define _SHAPE_MATCHING_CLUSTERED_H_
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Simulation
+{
+
+namespace ShapeMatching
+{
+
+/**
+ * Region-based shape matching: one cluster per vertex made of its k-ring.
+ * Clusters overlap, each one is matched with its own rotation (in parallel)
+ * and the goal of a vertex is the average of the goals of its clusters.
+ * All the buffers are allocated in initialize() (to call again if the
+ * topology changes), so that a step does not allocate.
+ */
+template <typename PFP>
+class ShapeMatchingClustered : public ShapeMatching<PFP>
+{
+public:
+    typedef typename PFP::MAP MAP;
+    typedef typename PFP::VEC3 VEC3;
+    typedef typename PFP::REAL REAL;
+
+protected:
+    unsigned int m_ringSize;
+
+    // clusters: members of cluster c are m_members[m_clusterOffsets[c] .. m_clusterOffsets[c+1][
+    std::vector<unsigned int> m_clusterOffsets;
+    std::vector<unsigned int> m_members;
+    std::vector<double> m_clusterInvMass;
+
+    // q_{i} = x^{0}_{i} - x^{0}_{cm} of each member in its cluster
+    std::vector<Eigen::Vector3d> m_restOffsets;
+
+    // goal of each member computed by its cluster
+    std::vector<Eigen::Vector3d> m_memberGoals;
+
+    // vertices and for each one its slots in m_members
+    std::vector<unsigned int> m_vertices;
+    std::vector<unsigned int> m_vertexOffsets;
+    std::vector<unsigned int> m_vertexSlots;
+
+    static Eigen::Matrix3d rotation(const Eigen::Matrix3d& apq);
+
+public:
+    /**
+     * @param ringSize size of the neighborhood of each cluster (number of rings of edge-adjacent vertices)
+     */
+    ShapeMatchingClustered(MAP& map, VertexAttribute<VEC3, MAP>& position, VertexAttribute<REAL, MAP>& mass, unsigned int ringSize = 1);
+
+    ~ShapeMatchingClustered()
+    { }
+
+    unsigned int nbClusters() const { return (unsigned int)(m_clusterOffsets.size()) - 1; }
+
+    void initialize();
+
+    void shapeMatch();
+
+    void computeVelocities(VertexAttribute<VEC3, MAP>& velocity, VertexAttribute<VEC3, MAP>& fext, REAL h, REAL alpha);
+
+    void applyVelocities(VertexAttribute<VEC3, MAP>& velocity, REAL h);
+};
+
+} // namespace ShapeMatching
+
+} // namespace Simulation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "shapeMatchingClustered.hpp"
+
+#endif
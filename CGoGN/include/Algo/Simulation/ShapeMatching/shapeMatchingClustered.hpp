@@ -0,0 +1,251 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2013, IGG Team, ICube, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Topology/generic/traversor/traversor2.h"
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/cellmarker.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Simulation
+{
+
+namespace ShapeMatching
+{
+
+template <typename PFP>
+ShapeMatchingClustered<PFP>::ShapeMatchingClustered(MAP& map, VertexAttribute<VEC3, MAP>& position, VertexAttribute<REAL, MAP>& mass, unsigned int ringSize) :
+    ShapeMatching<PFP>(map, position, mass),
+    m_ringSize(ringSize)
+{
+    m_clusterOffsets.push_back(0);
+}
+
+/**
+ * Polar decomposition A_{pq} = R * S with SVD (robust to flat clusters)
+ */
+template <typename PFP>
+Eigen::Matrix3d ShapeMatchingClustered<PFP>::rotation(const Eigen::Matrix3d& apq)
+{
+    Eigen::JacobiSVD<Eigen::Matrix3d> svd(apq, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    Eigen::Matrix3d U = svd.matrixU();
+    const Eigen::Matrix3d& V = svd.matrixV();
+
+    // no reflection
+    if ((U * V.transpose()).determinant() < 0.0)
+        U.col(2) = -U.col(2);
+
+    return U * V.transpose();
+}
+
+/**
+ * Build the clusters (k-ring of each vertex) and pre-compute
+ * their rest mass centers and the \f$ q_{i} \f$ of their members
+ */
+template <typename PFP>
+void ShapeMatchingClustered<PFP>::initialize()
+{
+    MAP& map = this->m_map;
+    const VertexAttribute<VEC3, MAP>& position = this->m_position;
+    const VertexAttribute<REAL, MAP>& mass = this->m_mass;
+
+    m_clusterOffsets.clear();
+    m_members.clear();
+    m_clusterOffsets.push_back(0);
+
+    CellMarker<MAP, VERTEX> inCluster(map);
+    std::vector<Vertex> front;
+    std::vector<Vertex> next;
+    TraversorV<MAP> tv(map);
+    for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+    {
+        unsigned int first = (unsigned int)(m_members.size());
+
+        front.clear();
+        front.push_back(d);
+        inCluster.mark(d);
+        m_members.push_back(map.template getEmbedding<VERTEX>(d));
+        for (unsigned int r = 0; r < m_ringSize && !front.empty(); ++r)
+        {
+            next.clear();
+            for (typename std::vector<Vertex>::const_iterator it = front.begin(); it != front.end(); ++it)
+            {
+                Traversor2VVaE<MAP> tav(map, *it);
+                for (Dart a = tav.begin(); a != tav.end(); a = tav.next())
+                {
+                    if (!inCluster.isMarked(a))
+                    {
+                        inCluster.mark(a);
+                        m_members.push_back(map.template getEmbedding<VERTEX>(a));
+                        next.push_back(a);
+                    }
+                }
+            }
+            front.swap(next);
+        }
+
+        for (unsigned int k = first; k < m_members.size(); ++k)
+            inCluster.unmark(m_members[k]);
+
+        m_clusterOffsets.push_back((unsigned int)(m_members.size()));
+    }
+
+    const unsigned int nbC = nbClusters();
+    m_clusterInvMass.resize(nbC);
+    m_restOffsets.resize(m_members.size());
+    m_memberGoals.resize(m_members.size());
+
+    // slots of each vertex in the clusters
+    m_vertices.clear();
+    std::vector<unsigned int> rank(position.end(), EMBNULL);
+    std::vector<unsigned int> count;
+    for (unsigned int k = 0; k < m_members.size(); ++k)
+    {
+        unsigned int& r = rank[m_members[k]];
+        if (r == EMBNULL)
+        {
+            r = (unsigned int)(m_vertices.size());
+            m_vertices.push_back(m_members[k]);
+            count.push_back(0);
+        }
+        ++count[r];
+    }
+
+    m_vertexOffsets.resize(m_vertices.size() + 1);
+    m_vertexOffsets[0] = 0;
+    for (unsigned int v = 0; v < m_vertices.size(); ++v)
+    {
+        m_vertexOffsets[v+1] = m_vertexOffsets[v] + count[v];
+        count[v] = m_vertexOffsets[v];
+    }
+    m_vertexSlots.resize(m_members.size());
+    for (unsigned int k = 0; k < m_members.size(); ++k)
+        m_vertexSlots[count[rank[m_members[k]]]++] = k;
+
+    // rest configuration of each cluster
+    CGoGN::Parallel::foreach_index(0, nbC, [&] (unsigned int c, unsigned int)
+    {
+        Eigen::Vector3d x0cm = Eigen::Vector3d::Zero();
+        double m = 0.0;
+        for (unsigned int k = m_clusterOffsets[c]; k < m_clusterOffsets[c+1]; ++k)
+        {
+            const VEC3& x = position[m_members[k]];
+            x0cm += double(mass[m_members[k]]) * Eigen::Vector3d(x[0], x[1], x[2]);
+            m += mass[m_members[k]];
+        }
+        m_clusterInvMass[c] = 1.0 / m;
+        x0cm *= m_clusterInvMass[c];
+
+        for (unsigned int k = m_clusterOffsets[c]; k < m_clusterOffsets[c+1]; ++k)
+        {
+            const VEC3& x = position[m_members[k]];
+            m_restOffsets[k] = Eigen::Vector3d(x[0], x[1], x[2]) - x0cm;
+        }
+    });
+}
+
+template <typename PFP>
+void ShapeMatchingClustered<PFP>::shapeMatch()
+{
+    const VertexAttribute<VEC3, MAP>& position = this->m_position;
+    const VertexAttribute<REAL, MAP>& mass = this->m_mass;
+
+    // goals of the members of each cluster
+    CGoGN::Parallel::foreach_index(0, nbClusters(), [&] (unsigned int c, unsigned int)
+    {
+        const unsigned int first = m_clusterOffsets[c];
+        const unsigned int last = m_clusterOffsets[c+1];
+
+        Eigen::Vector3d xcm = Eigen::Vector3d::Zero();
+        for (unsigned int k = first; k < last; ++k)
+        {
+            const VEC3& x = position[m_members[k]];
+            xcm += double(mass[m_members[k]]) * Eigen::Vector3d(x[0], x[1], x[2]);
+        }
+        xcm *= m_clusterInvMass[c];
+
+        // A_{pq} = Sum_i{ m_{i} p_{i} q_i^{T} }
+        Eigen::Matrix3d apq = Eigen::Matrix3d::Zero();
+        for (unsigned int k = first; k < last; ++k)
+        {
+            const VEC3& x = position[m_members[k]];
+            Eigen::Vector3d p = Eigen::Vector3d(x[0], x[1], x[2]) - xcm;
+            apq += double(mass[m_members[k]]) * p * m_restOffsets[k].transpose();
+        }
+
+        Eigen::Matrix3d R = rotation(apq);
+
+        for (unsigned int k = first; k < last; ++k)
+            m_memberGoals[k] = R * m_restOffsets[k] + xcm; // g_{i} = R * q_i + x_{cm}
+    });
+
+    // blending of the goals of the clusters of each vertex
+    CGoGN::Parallel::foreach_index(0, (unsigned int)(m_vertices.size()), [&] (unsigned int v, unsigned int)
+    {
+        Eigen::Vector3d g = Eigen::Vector3d::Zero();
+        for (unsigned int s = m_vertexOffsets[v]; s < m_vertexOffsets[v+1]; ++s)
+            g += m_memberGoals[m_vertexSlots[s]];
+        g /= double(m_vertexOffsets[v+1] - m_vertexOffsets[v]);
+
+        this->m_goal[m_vertices[v]] = VEC3(REAL(g(0)), REAL(g(1)), REAL(g(2)));
+    });
+}
+
+// \alpha : stiffness | v_i : velocity | f_ext : force exterieure
+template <typename PFP>
+void ShapeMatchingClustered<PFP>::computeVelocities(VertexAttribute<VEC3, MAP>& velocity, VertexAttribute<VEC3, MAP>& fext, REAL h, REAL alpha)
+{
+    CGoGN::Parallel::foreach_index(0, (unsigned int)(m_vertices.size()), [&] (unsigned int v, unsigned int)
+    {
+        unsigned int i = m_vertices[v];
+        velocity[i] = velocity[i] + alpha * ((this->m_goal[i] - this->m_position[i]) / h ) + (h * fext[i]) / this->m_mass[i];
+    });
+}
+
+template <typename PFP>
+void ShapeMatchingClustered<PFP>::applyVelocities(VertexAttribute<VEC3, MAP>& velocity, REAL h)
+{
+    CGoGN::Parallel::foreach_index(0, (unsigned int)(m_vertices.size()), [&] (unsigned int v, unsigned int)
+    {
+        unsigned int i = m_vertices[v];
+        this->m_position[i] = this->m_position[i] + h * velocity[i];
+    });
+}
+
+} // namespace ShapeMatching
+
+} // namespace Simulation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
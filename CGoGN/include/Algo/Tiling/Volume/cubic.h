@@ -23,6 +23,9 @@
 *******************************************************************************/
 
 #include "Algo/Tiling/tiling.h"
+#include "Topology/generic/mapBuilder.h"
+
+#include <type_traits>
 
 #ifndef _TILING_CUBIC_H_
 #define _TILING_CUBIC_H_
@@ -53,7 +56,8 @@ class Grid : public Algo::Surface::Tilings::Tiling<PFP>
 
 public:
     Grid(MAP& map, unsigned int x, unsigned int y, unsigned int z):
-		Algo::Surface::Tilings::Tiling<PFP>(map, x, y, z)
+		Algo::Surface::Tilings::Tiling<PFP>(map, x, y, z),
+		m_verticesEmbedded(false)
     {
 		grid3D(x, y, z);
     }
@@ -112,7 +116,22 @@ protected:
     /*! @param x nb of squares in x
      */
     Dart grid1D(unsigned int x);
+
+    //! Create a 3D grid in one pass with a MapBuilder (oriented maps based on MapMono only)
+    /*! @param x nb of squares in x
+     *  @param y nb of squares in y
+     *  @param z nb of squares in z
+     *  @return false if the map does not allow it
+     */
+    bool grid3DBulk(unsigned int x, unsigned int y, unsigned int z, std::true_type);
+
+    bool grid3DBulk(unsigned int x, unsigned int y, unsigned int z, std::false_type);
     //@}
+
+    /**
+     * vertices have been embedded during the bulk construction
+     */
+    bool m_verticesEmbedded;
 };
 
 } // namespace Cubic
@@ -45,6 +45,9 @@ namespace Cubic
 template <typename PFP>
 void Grid<PFP>::grid3D(unsigned int x, unsigned int y, unsigned int z)
 {
+    if (grid3DBulk(x, y, z, std::is_same<typename MAP::IMPL, MapMono>()))
+        return;
+
     this->m_tableVertDarts.clear();
     this->m_tableVertDarts.reserve((x+1)*(y+1)*(z+1));
 
@@ -157,6 +160,114 @@ Dart Grid<PFP>::grid1D(unsigned int x)
     return d0;
 }
 
+template <typename PFP>
+bool Grid<PFP>::grid3DBulk(unsigned int, unsigned int, unsigned int, std::false_type)
+{
+    return false;
+}
+
+template <typename PFP>
+bool Grid<PFP>::grid3DBulk(unsigned int x, unsigned int y, unsigned int z, std::true_type)
+{
+    MapBuilder<MAP> mb(this->m_map);
+    if (!BulkConstructible<MAP>::value || !mb.isOriented() || MAP::DIMENSION != 3 || x == 0 || y == 0 || z == 0)
+        return false;
+
+    // corners of the cube are numbered with bits (x,y,z)
+    // faces have the same order and orientation as in createHexahedron
+    const unsigned int faces[6][4] = { {4,0,1,5}, {6,4,5,7}, {2,6,7,3}, {0,2,3,1}, {0,4,6,2}, {5,1,3,7} };
+
+    // topology of one cube: origin of darts, phi2 and phi3 (dart of neighbour cube)
+    unsigned int orig[24], dest[24], axis[24], side[24], tphi2[24], tphi3[24], cornerDart[8];
+    for (unsigned int t = 0; t < 24; ++t)
+    {
+        orig[t] = faces[t/4][t%4];
+        dest[t] = faces[t/4][(t+1)%4];
+        cornerDart[orig[t]] = t;
+    }
+    for (unsigned int t = 0; t < 24; ++t)
+    {
+        const unsigned int* f = faces[t/4];
+        for (unsigned int a = 0; a < 3; ++a)
+        {
+            unsigned int b = 1u << a;
+            if ((f[0] & b) == (f[1] & b) && (f[0] & b) == (f[2] & b))
+            {
+                axis[t] = a;
+                side[t] = (f[0] & b) ? 1 : 0;
+            }
+        }
+    }
+    for (unsigned int t = 0; t < 24; ++t)
+    {
+        unsigned int b = 1u << axis[t];
+        for (unsigned int u = 0; u < 24; ++u)
+        {
+            if (orig[u] == dest[t] && dest[u] == orig[t])
+                tphi2[t] = u;
+            if (orig[u] == (dest[t] ^ b) && dest[u] == (orig[t] ^ b))
+                tphi3[t] = u;
+        }
+    }
+
+    const unsigned int nbCubes = x*y*z;
+    const unsigned int size[3] = { x, y, z };
+    mb.newDarts(24*nbCubes);
+
+    mb.setPhi1([&] (unsigned int i) { return (i/4)*4 + (i+1)%4; });
+    mb.setPhi2([&] (unsigned int i) { return (i/24)*24 + tphi2[i%24]; });
+    mb.setPhi3([&] (unsigned int i) -> unsigned int
+    {
+        unsigned int c = i/24;
+        unsigned int t = i%24;
+        unsigned int coord[3] = { c%x, (c/x)%y, c/(x*y) };
+        if (side[t] == 0)
+        {
+            if (coord[axis[t]] == 0)
+                return EMBNULL;
+            --coord[axis[t]];
+        }
+        else
+        {
+            if (coord[axis[t]] == size[axis[t]]-1)
+                return EMBNULL;
+            ++coord[axis[t]];
+        }
+        return 24*(coord[0] + x*(coord[1] + y*coord[2])) + tphi3[t];
+    });
+
+    if (this->m_map.template isOrbitEmbedded<VERTEX>())
+    {
+        mb.template newCells<VERTEX>((x+1)*(y+1)*(z+1));
+        mb.template setEmbeddings<VERTEX>([&] (unsigned int i)
+        {
+            unsigned int c = i/24;
+            unsigned int o = orig[i%24];
+            return (c%x + (o&1)) + (x+1)*(((c/x)%y + ((o>>1)&1)) + (y+1)*(c/(x*y) + ((o>>2)&1)));
+        });
+        m_verticesEmbedded = true;
+    }
+
+    // one dart per vertex
+    this->m_tableVertDarts.clear();
+    this->m_tableVertDarts.reserve((x+1)*(y+1)*(z+1));
+    for (unsigned int k = 0; k <= z; ++k)
+    {
+        for (unsigned int j = 0; j <= y; ++j)
+        {
+            for (unsigned int i = 0; i <= x; ++i)
+            {
+                unsigned int c = (i < x ? i : x-1) + x*((j < y ? j : y-1) + y*(k < z ? k : z-1));
+                unsigned int o = (i < x ? 0 : 1) | (j < y ? 0 : 2) | (k < z ? 0 : 4);
+                this->m_tableVertDarts.push_back(mb.dart(24*c + cornerDart[o]));
+            }
+        }
+    }
+
+    mb.closeMap();
+    return true;
+}
+
 template <typename PFP>
 void Grid<PFP>::embedIntoGrid(VertexAttribute<VEC3, MAP>& position, float x, float y, float z)
 {
@@ -175,7 +286,8 @@ void Grid<PFP>::embedIntoGrid(VertexAttribute<VEC3, MAP>& position, float x, flo
                 typename PFP::VEC3 pos(-x/2.0f + dx*float(k), -y/2.0f + dy*float(j), -z/2.0f + dz*float(i));
                 Dart d = this->m_tableVertDarts[ i*nbs+j*(this->m_nx+1)+k ];
 
-				Algo::Topo::setOrbitEmbeddingOnNewCell<VERTEX>(this->m_map, d);
+				if (!m_verticesEmbedded)
+					Algo::Topo::setOrbitEmbeddingOnNewCell<VERTEX>(this->m_map, d);
                 position[d] = pos;
             }
         }
@@ -145,6 +145,25 @@ protected:
 	 */
 	std::map<std::string, RegisteredBaseAttribute*>* m_attributes_registry_map;
 
+	/**
+	 * allocator of the blocks of all attributes
+	 */
+	BlockAllocator* m_allocator;
+
+	/**
+	 * number of lines of blocks, as a shift and a mask for index computations
+	 */
+	unsigned int m_blockSize;
+	unsigned int m_blockShift;
+	unsigned int m_blockMask;
+
+	/**
+	 * add the blocks needed by nb more lines to all attributes
+	 * @param init initialize the new blocks
+	 * @return index of the first new block
+	 */
+	unsigned int reserveBlocks(unsigned int nb, bool init);
+
 public:
 	AttributeContainer();
 
@@ -362,12 +381,58 @@ public:
 	 */
 	void clear(bool clearAttrib = false);
 
+	/**
+	 * set the allocator of the blocks of all attributes (default is heap)
+	 * only possible when no block has been allocated (before first insertion or after clear)
+	 * @return false if blocks are already allocated
+	 */
+	bool setBlockAllocator(BlockAllocator* alloc);
+
+	BlockAllocator* getBlockAllocator() const { return m_allocator; }
+
+	/**
+	 * set the number of lines of the blocks of all attributes (_BLOCKSIZE_ by default)
+	 * only possible when no block has been allocated (before first insertion or after clear)
+	 * @param bs power of 2 in [256,65536]
+	 * @return false if blocks are already allocated or if bs is not valid
+	 */
+	bool setBlockSize(unsigned int bs);
+
+	unsigned int getBlockSize() const { return m_blockSize; }
+
 	/**
 	 * container compacting
 	 * @param mapOldNew table that contains a map from old indices to new indices (holes -> 0xffffffff)
 	 */
 	void compact(std::vector<unsigned int>& mapOldNew);
 
+	/**
+	 * reserve memory (blocks of all attributes) for nb lines,
+	 * so that nb lines can be inserted without any allocation
+	 * @param nb number of lines
+	 */
+	void reserve(unsigned int nb);
+
+	/**
+	 * reserve memory for nb lines as reserve does, but with a first touch allocator
+	 * the new blocks are left uninitialized, so that their pages are placed by the
+	 * threads that initialize them: initBlock must be called on each block of
+	 * [returned value, getNbBlocks()[ before any use (empty range with other allocators)
+	 * @param nb number of lines
+	 * @return index of the first block to initialize
+	 */
+	unsigned int reserveFirstTouch(unsigned int nb);
+
+	/**
+	 * initialize the block b of all attributes (see reserveFirstTouch)
+	 */
+	void initBlock(unsigned int b);
+
+	/**
+	 * number of blocks of the attributes
+	 */
+	unsigned int getNbBlocks() const;
+
 	/**
 	 * Test the fragmentation of container,
 	 * in fact just size/max_size
@@ -385,6 +450,14 @@ public:
 	*/
 	unsigned int insertLine();
 
+	/**
+	* insert nb lines in the container, all the needed blocks are allocated at once
+	* @param nb number of lines to insert
+	* @param lines (OUT) indices of the new lines (appended to the vector)
+	* @return true if the new lines form the contiguous range [lines[s], lines[s]+nb[ (no hole has been reused)
+	*/
+	bool insertLines(unsigned int nb, std::vector<unsigned int>& lines);
+
 	/**
 	* remove a line in the container
 	* @param index index of the line to remove
@@ -401,6 +474,16 @@ public:
 	 */
 	inline void initMarkersOfLine(unsigned int index);
 
+	/**
+	 * initialize the nb consecutive lines starting at index (an element of each attribute)
+	 */
+	inline void initLines(unsigned int index, unsigned int nb);
+
+	/**
+	 * initialize all markers of the nb consecutive lines starting at index
+	 */
+	inline void initMarkersOfLines(unsigned int index, unsigned int nb);
+
 	/**
 	 * copy the content of line src in line dst
 	 */
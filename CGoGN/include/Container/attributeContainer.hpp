@@ -92,6 +92,8 @@ AttributeMultiVector<T>* AttributeContainer::addAttribute(const std::string& att
 
 	amv->setOrbit(m_orbit) ;
 	amv->setIndex(index) ;
+	amv->setBlockAllocator(m_allocator) ;
+	amv->setBlockSize(m_blockSize) ;
 
 	// generate a name for the attribute if no one was given
 	if (attribName == "")
@@ -129,6 +131,8 @@ void AttributeContainer::addAttribute(const std::string& attribName, const std::
 	m_tableAttribs[index] = amv;
 	amv->setOrbit(m_orbit) ;
 	amv->setIndex(index) ;
+	amv->setBlockAllocator(m_allocator) ;
+	amv->setBlockSize(m_blockSize) ;
 
 	// generate a name for the attribute if no one was given
 	if (attribName == "")
@@ -224,7 +228,7 @@ inline unsigned int AttributeContainer::size() const
 
 inline unsigned int AttributeContainer::capacity() const
 {
-	return uint32(m_holesBlocks.size() * _BLOCKSIZE_);
+	return uint32(m_holesBlocks.size() * m_blockSize);
 }
 
 inline unsigned int AttributeContainer::memoryTotalSize() const
@@ -239,7 +243,7 @@ inline unsigned int AttributeContainer::memorySize() const
 
 inline bool AttributeContainer::used(unsigned int index) const
 {
-	return m_holesBlocks[index / _BLOCKSIZE_]->used(index % _BLOCKSIZE_) != 0;
+	return m_holesBlocks[index >> m_blockShift]->used(index & m_blockMask) != 0;
 }
 
 inline float AttributeContainer::fragmentation()
@@ -357,6 +361,23 @@ inline void AttributeContainer::initMarkersOfLine(unsigned int index)
 	}
 }
 
+inline void AttributeContainer::initLines(unsigned int index, unsigned int nb)
+{
+	for(unsigned int i = 0; i < m_tableAttribs.size(); ++i)
+	{
+		if (m_tableAttribs[i] != NULL)
+			m_tableAttribs[i]->initElts(index, nb);
+	}
+}
+
+inline void AttributeContainer::initMarkersOfLines(unsigned int index, unsigned int nb)
+{
+	for(unsigned int i = 0; i < m_tableMarkerAttribs.size(); ++i)
+	{
+		m_tableMarkerAttribs[i]->initElts(index, nb);
+	}
+}
+
 inline void AttributeContainer::copyLine(unsigned int dstIndex, unsigned int srcIndex)
 {
 	for(unsigned int i = 0; i < m_tableAttribs.size(); ++i)
@@ -373,12 +394,12 @@ inline void AttributeContainer::copyLine(unsigned int dstIndex, unsigned int src
 
 inline void AttributeContainer::refLine(unsigned int index)
 {
-	m_holesBlocks[index / _BLOCKSIZE_]->ref(index % _BLOCKSIZE_);
+	m_holesBlocks[index >> m_blockShift]->ref(index & m_blockMask);
 }
 
 inline bool AttributeContainer::unrefLine(unsigned int index)
 {
-	if (m_holesBlocks[index / _BLOCKSIZE_]->unref(index % _BLOCKSIZE_))
+	if (m_holesBlocks[index >> m_blockShift]->unref(index & m_blockMask))
 	{
 		--m_size;
 		return true;
@@ -388,15 +409,15 @@ inline bool AttributeContainer::unrefLine(unsigned int index)
 
 inline unsigned int AttributeContainer::getNbRefs(unsigned int index) const
 {
-	unsigned int bi = index / _BLOCKSIZE_;
-	unsigned int j = index % _BLOCKSIZE_;
+	unsigned int bi = index >> m_blockShift;
+	unsigned int j = index & m_blockMask;
 
 	return m_holesBlocks[bi]->nbRefs(j);
 }
 
 inline void AttributeContainer::setNbRefs(unsigned int index, unsigned int nb)
 {
-	m_holesBlocks[index / _BLOCKSIZE_]->setNbRefs(index % _BLOCKSIZE_, nb);
+	m_holesBlocks[index >> m_blockShift]->setNbRefs(index & m_blockMask, nb);
 }
 
 /**************************************
@@ -466,7 +487,7 @@ template <typename T>
 inline T& AttributeContainer::getData(unsigned int attrIndex, unsigned int eltIndex)
 {
 	assert(eltIndex < m_maxSize || !"getData: element index out of bounds");
-	assert(m_holesBlocks[eltIndex / _BLOCKSIZE_]->used(eltIndex % _BLOCKSIZE_) || !"getData: element does not exist");
+	assert(m_holesBlocks[eltIndex >> m_blockShift]->used(eltIndex & m_blockMask) || !"getData: element does not exist");
 	assert((m_tableAttribs[attrIndex] != NULL) || !"getData: attribute does not exist");
 
 	AttributeMultiVector<T>* atm = dynamic_cast<AttributeMultiVector<T>*>(m_tableAttribs[attrIndex]);
@@ -479,7 +500,7 @@ template <typename T>
 inline const T& AttributeContainer::getData(unsigned int attrIndex, unsigned int eltIndex) const
 {
 	assert(eltIndex < m_maxSize || !"getData: element index out of bounds");
-	assert(m_holesBlocks[eltIndex / _BLOCKSIZE_]->used(eltIndex % _BLOCKSIZE_) || !"getData: element does not exist");
+	assert(m_holesBlocks[eltIndex >> m_blockShift]->used(eltIndex & m_blockMask) || !"getData: element does not exist");
 	assert((m_tableAttribs[attrIndex] != NULL) || !"getData: attribute does not exist");
 
 	AttributeMultiVector<T>* atm = dynamic_cast<AttributeMultiVector<T>*>(m_tableAttribs[attrIndex]);
@@ -492,7 +513,7 @@ template <typename T>
 inline void AttributeContainer::setData(unsigned int attrIndex, unsigned int eltIndex, const T& data)
 {
 	assert(eltIndex < m_maxSize || !"getData: element index out of bounds");
-	assert(m_holesBlocks[eltIndex / _BLOCKSIZE_]->used(eltIndex % _BLOCKSIZE_) || !"getData: element does not exist");
+	assert(m_holesBlocks[eltIndex >> m_blockShift]->used(eltIndex & m_blockMask) || !"getData: element does not exist");
 	assert((m_tableAttribs[attrIndex] != NULL) || !"getData: attribute does not exist");
 
 	AttributeMultiVector<T>* atm = dynamic_cast<AttributeMultiVector<T>*>(m_tableAttribs[attrIndex]);
@@ -30,10 +30,15 @@
 #include <sstream>
 #include <fstream>
 #include <cstring>
+#include <cassert>
+#include <new>
+#include <algorithm>
+#include <type_traits>
 
 #include <typeinfo>
 
 #include "Container/sizeblock.h"
+#include "Container/blockAllocator.h"
 
 namespace CGoGN
 {
@@ -79,6 +84,18 @@ protected:
 	 */
 	unsigned int m_index;
 
+	/**
+	 * allocator of the blocks (given by the container)
+	 */
+	BlockAllocator* m_allocator;
+
+	/**
+	 * number of elements of blocks (given by the container), as a shift and a mask
+	 */
+	unsigned int m_blockSize;
+	unsigned int m_blockShift;
+	unsigned int m_blockMask;
+
 public:
 	AttributeMultiVectorGen(const std::string& strName, const std::string& strType);
 
@@ -123,10 +140,19 @@ public:
 	CGoGNCodeType getTypeCode() const;
 
 	/**
-	 * get block size
+	 * get / set block size (set it only when there is no block)
 	 */
 	unsigned int getBlockSize() const;
 
+	void setBlockSize(unsigned int bs);
+
+	/**
+	 * get / set the allocator of blocks (set it only when there is no block)
+	 */
+	BlockAllocator* getBlockAllocator() const;
+
+	void setBlockAllocator(BlockAllocator* alloc);
+
 	/**************************************
 	 *       MULTI VECTOR MANAGEMENT      *
 	 **************************************/
@@ -141,6 +167,17 @@ public:
 	*/
 	virtual void setNbBlocks(unsigned int nbb) = 0;
 
+	/**
+	* increase the number of blocks to nbb without initializing the new blocks:
+	* initBlock must be called on each of them before any use
+	*/
+	virtual void allocBlocks(unsigned int nbb) = 0;
+
+	/**
+	* initialize the block b (construction of elements, clear of markers)
+	*/
+	virtual void initBlock(unsigned int b) = 0;
+
 	virtual unsigned int getNbBlocks() const = 0;
 
 //	virtual void addBlocksBefore(unsigned int nbb) = 0;
@@ -173,6 +210,11 @@ public:
 
 	virtual void initElt(unsigned int id) = 0;
 
+	/**
+	 * init the nb consecutive elements starting at id (block by block)
+	 */
+	virtual void initElts(unsigned int id, unsigned int nb) = 0;
+
 	virtual void copyElt(unsigned int dst, unsigned int src) = 0;
 
 	virtual void swapElt(unsigned int id1, unsigned int id2) = 0;
@@ -216,6 +258,16 @@ class AttributeMultiVector : public AttributeMultiVectorGen
 
 	inline void setTypeCode();
 
+	/**
+	 * allocate and construct a block with the allocator
+	 */
+	T* newBlock();
+
+	/**
+	 * destroy and release a block with the allocator
+	 */
+	void deleteBlock(T* ptr);
+
 public:
 	AttributeMultiVector(const std::string& strName, const std::string& strType);
 
@@ -233,6 +285,10 @@ public:
 
 	void setNbBlocks(unsigned int nbb);
 
+	void allocBlocks(unsigned int nbb);
+
+	void initBlock(unsigned int b);
+
 	unsigned int getNbBlocks() const;
 
 	void addBlocksBefore(unsigned int nbb);
@@ -274,6 +330,8 @@ public:
 
 	void initElt(unsigned int id);
 
+	void initElts(unsigned int id, unsigned int nb);
+
 	void copyElt(unsigned int dst, unsigned int src);
 
 	void swapElt(unsigned int id1, unsigned int id2);
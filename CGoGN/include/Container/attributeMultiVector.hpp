@@ -27,10 +27,13 @@ namespace CGoGN
 {
 
 inline AttributeMultiVectorGen::AttributeMultiVectorGen(const std::string& strName, const std::string& strType):
-	m_attrName(strName), m_typeName(strType)
+	m_attrName(strName), m_typeName(strType), m_allocator(BlockAllocator::defaultAllocator()),
+	m_blockSize(_BLOCKSIZE_), m_blockShift(blockSizeShift(_BLOCKSIZE_)), m_blockMask(_BLOCKSIZE_ - 1)
 {}
 
-inline AttributeMultiVectorGen::AttributeMultiVectorGen()
+inline AttributeMultiVectorGen::AttributeMultiVectorGen():
+	m_allocator(BlockAllocator::defaultAllocator()),
+	m_blockSize(_BLOCKSIZE_), m_blockShift(blockSizeShift(_BLOCKSIZE_)), m_blockMask(_BLOCKSIZE_ - 1)
 {}
 
 inline AttributeMultiVectorGen::~AttributeMultiVectorGen()
@@ -82,7 +85,16 @@ inline void AttributeMultiVectorGen::setTypeName(const std::string& n)
 
 inline unsigned int AttributeMultiVectorGen::getBlockSize() const
 {
-	return _BLOCKSIZE_ ;
+	return m_blockSize ;
+}
+
+inline void AttributeMultiVectorGen::setBlockSize(unsigned int bs)
+{
+	assert(getNbBlocks() == 0 || !"setBlockSize: blocks already allocated");
+	assert(validBlockSize(bs) || !"setBlockSize: block size must be a power of 2 in [256,65536]");
+	m_blockSize = bs;
+	m_blockShift = blockSizeShift(bs);
+	m_blockMask = bs - 1;
 }
 
 inline CGoGNCodeType AttributeMultiVectorGen::getTypeCode() const
@@ -90,6 +102,17 @@ inline CGoGNCodeType AttributeMultiVectorGen::getTypeCode() const
 	return m_typeCode;
 }
 
+inline BlockAllocator* AttributeMultiVectorGen::getBlockAllocator() const
+{
+	return m_allocator;
+}
+
+inline void AttributeMultiVectorGen::setBlockAllocator(BlockAllocator* alloc)
+{
+	assert(getNbBlocks() == 0 || !"setBlockAllocator: blocks already allocated");
+	m_allocator = alloc;
+}
+
 /***************************************************************************************************/
 /***************************************************************************************************/
 
@@ -111,7 +134,45 @@ template <typename T>
 AttributeMultiVector<T>::~AttributeMultiVector()
 {
 	for (typename std::vector< T* >::iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
-		delete[] (*it);
+		deleteBlock(*it);
+}
+
+/// construction / destruction of the elements of a block (nothing to do for trivial types, as new T[])
+template <typename T>
+inline void constructBlock(T* /*ptr*/, unsigned int /*nb*/, std::true_type)
+{}
+
+template <typename T>
+inline void constructBlock(T* ptr, unsigned int nb, std::false_type)
+{
+	for (unsigned int i = 0; i < nb; ++i)
+		new (ptr + i) T;
+}
+
+template <typename T>
+inline void destroyBlock(T* /*ptr*/, unsigned int /*nb*/, std::true_type)
+{}
+
+template <typename T>
+inline void destroyBlock(T* ptr, unsigned int nb, std::false_type)
+{
+	for (unsigned int i = 0; i < nb; ++i)
+		ptr[i].~T();
+}
+
+template <typename T>
+T* AttributeMultiVector<T>::newBlock()
+{
+	T* ptr = static_cast<T*>(m_allocator->allocate(m_blockSize * sizeof(T)));
+	constructBlock(ptr, m_blockSize, typename std::is_trivial<T>::type());
+	return ptr;
+}
+
+template <typename T>
+void AttributeMultiVector<T>::deleteBlock(T* ptr)
+{
+	destroyBlock(ptr, m_blockSize, typename std::is_trivial<T>::type());
+	m_allocator->deallocate(ptr, m_blockSize * sizeof(T));
 }
 
 template <typename T>
@@ -129,10 +190,10 @@ inline AttributeMultiVectorGen* AttributeMultiVector<T>::new_obj()
 template <typename T>
 inline void AttributeMultiVector<T>::addBlock()
 {
-	T* ptr = new T[_BLOCKSIZE_];
+	T* ptr = newBlock();
 	m_tableData.push_back(ptr);
 	// init
-//	T* endPtr = ptr + _BLOCKSIZE_;
+//	T* endPtr = ptr + m_blockSize;
 //	while (ptr != endPtr)
 //		*ptr++ = T(0);
 }
@@ -148,11 +209,24 @@ void AttributeMultiVector<T>::setNbBlocks(unsigned int nbb)
 	else
 	{
 		for (size_t i = nbb; i < m_tableData.size(); ++i)
-			delete[] m_tableData[i];
+			deleteBlock(m_tableData[i]);
 		m_tableData.resize(nbb);
 	}
 }
 
+template <typename T>
+void AttributeMultiVector<T>::allocBlocks(unsigned int nbb)
+{
+	for (size_t i = m_tableData.size(); i < nbb; ++i)
+		m_tableData.push_back(static_cast<T*>(m_allocator->allocate(m_blockSize * sizeof(T))));
+}
+
+template <typename T>
+void AttributeMultiVector<T>::initBlock(unsigned int b)
+{
+	constructBlock(m_tableData[b], m_blockSize, typename std::is_trivial<T>::type());
+}
+
 template <typename T>
 unsigned int AttributeMultiVector<T>::getNbBlocks() const
 {
@@ -189,9 +263,14 @@ bool AttributeMultiVector<T>::copy(const AttributeMultiVectorGen* atmvg)
 		CGoGNerr << "trying to swap attributes with different type names" << CGoGNendl;
 		return false;
 	}
+	if (atmv->m_blockSize != m_blockSize)
+	{
+		CGoGNerr << "trying to copy attributes with different block sizes" << CGoGNendl;
+		return false;
+	}
 
 	for (unsigned int i = 0; i < atmv->m_tableData.size(); ++i)
-		std::memcpy(m_tableData[i], atmv->m_tableData[i], _BLOCKSIZE_ * sizeof(T));
+		std::memcpy(m_tableData[i], atmv->m_tableData[i], m_blockSize * sizeof(T));
 
 	return true;
 }
@@ -213,6 +292,10 @@ bool AttributeMultiVector<T>::swap(AttributeMultiVectorGen* atmvg)
 	}
 
 	m_tableData.swap(atmv->m_tableData) ;
+	std::swap(m_allocator, atmv->m_allocator);
+	std::swap(m_blockSize, atmv->m_blockSize);
+	std::swap(m_blockShift, atmv->m_blockShift);
+	std::swap(m_blockMask, atmv->m_blockMask);
 	return true;
 }
 
@@ -232,6 +315,18 @@ bool AttributeMultiVector<T>::merge(const AttributeMultiVectorGen& att)
 		return false;
 	}
 
+	if (attrib->m_allocator != m_allocator)
+	{
+		CGoGNerr << "trying to merge attributes with different block allocators" << CGoGNendl;
+		return false;
+	}
+
+	if (attrib->m_blockSize != m_blockSize)
+	{
+		CGoGNerr << "trying to merge attributes with different block sizes" << CGoGNendl;
+		return false;
+	}
+
 	for (typename std::vector<T*>::const_iterator it = attrib->m_tableData.begin(); it != attrib->m_tableData.end(); ++it)
 		m_tableData.push_back(*it);
 
@@ -242,7 +337,7 @@ template <typename T>
 inline void AttributeMultiVector<T>::clear()
 {
 	for (typename std::vector< T* >::iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
-		delete[] (*it);
+		deleteBlock(*it);
 	m_tableData.clear();
 }
 
@@ -259,19 +354,19 @@ inline int AttributeMultiVector<T>::getSizeOfType() const
 template <typename T>
 inline T& AttributeMultiVector<T>::operator[](unsigned int i)
 {
-	return m_tableData[i / _BLOCKSIZE_][i % _BLOCKSIZE_];
+	return m_tableData[i >> m_blockShift][i & m_blockMask];
 }
 
 template <typename T>
 inline const T& AttributeMultiVector<T>::operator[](unsigned int i) const
 {
-	return m_tableData[i / _BLOCKSIZE_][i % _BLOCKSIZE_];
+	return m_tableData[i >> m_blockShift][i & m_blockMask];
 }
 
 template <typename T>
 unsigned int AttributeMultiVector<T>::getBlocksPointers(std::vector<void*>& addr, unsigned int& byteBlockSize) const
 {
-	byteBlockSize = _BLOCKSIZE_ * sizeof(T);
+	byteBlockSize = m_blockSize * sizeof(T);
 
 	addr.reserve(m_tableData.size());
 	addr.clear();
@@ -289,21 +384,48 @@ unsigned int AttributeMultiVector<T>::getBlocksPointers(std::vector<void*>& addr
 template <typename T>
 inline void AttributeMultiVector<T>::initElt(unsigned int id)
 {
-	m_tableData[id / _BLOCKSIZE_][id % _BLOCKSIZE_] = T(); // T(0);
+	m_tableData[id >> m_blockShift][id & m_blockMask] = T(); // T(0);
+}
+
+/// value initialization of a range of elements: memset for trivial types, fill otherwise
+template <typename T>
+inline void initRangeOfElts(T* begin, T* end, std::true_type)
+{
+	memset(static_cast<void*>(begin), 0, (end - begin) * sizeof(T));
+}
+
+template <typename T>
+inline void initRangeOfElts(T* begin, T* end, std::false_type)
+{
+	std::fill(begin, end, T());
+}
+
+template <typename T>
+void AttributeMultiVector<T>::initElts(unsigned int id, unsigned int nb)
+{
+	unsigned int end = id + nb;
+	while (id < end)
+	{
+		unsigned int b = id >> m_blockShift;
+		unsigned int i = id & m_blockMask;
+		unsigned int j = std::min(m_blockSize, i + (end - id));
+		initRangeOfElts(m_tableData[b] + i, m_tableData[b] + j, typename std::is_trivial<T>::type());
+		id += j - i;
+	}
 }
 
 template <typename T>
 inline void AttributeMultiVector<T>::copyElt(unsigned int dst, unsigned int src)
 {
-	m_tableData[dst / _BLOCKSIZE_][dst % _BLOCKSIZE_] = m_tableData[src / _BLOCKSIZE_][src % _BLOCKSIZE_];
+	m_tableData[dst >> m_blockShift][dst & m_blockMask] = m_tableData[src >> m_blockShift][src & m_blockMask];
 }
 
 template <typename T>
 void AttributeMultiVector<T>::swapElt(unsigned int id1, unsigned int id2)
 {
-	T data = m_tableData[id1 / _BLOCKSIZE_][id1 % _BLOCKSIZE_] ;
-	m_tableData[id1 / _BLOCKSIZE_][id1 % _BLOCKSIZE_] = m_tableData[id2 / _BLOCKSIZE_][id2 % _BLOCKSIZE_] ;
-	m_tableData[id2 / _BLOCKSIZE_][id2 % _BLOCKSIZE_] = data ;
+	T data = m_tableData[id1 >> m_blockShift][id1 & m_blockMask] ;
+	m_tableData[id1 >> m_blockShift][id1 & m_blockMask] = m_tableData[id2 >> m_blockShift][id2 & m_blockMask] ;
+	m_tableData[id2 >> m_blockShift][id2 & m_blockMask] = data ;
 }
 
 template <typename T>
@@ -336,13 +458,13 @@ void AttributeMultiVector<T>::saveBin(CGoGNostream& fs, unsigned int id)
 	fs.write(reinterpret_cast<const char*>(buffer),(len1+len2)*sizeof(char));
 
 	nbs[0] = int(m_tableData.size());
-	nbs[1] = nbs[0] * _BLOCKSIZE_* sizeof(T);
+	nbs[1] = nbs[0] * m_blockSize * sizeof(T);
 	fs.write(reinterpret_cast<const char*>(nbs),2*sizeof(unsigned int));
 
 	// store data blocks
 	for(unsigned int i=0; i<nbs[0]; ++i)
 	{
-		fs.write(reinterpret_cast<const char*>(m_tableData[i]),_BLOCKSIZE_*sizeof(T));
+		fs.write(reinterpret_cast<const char*>(m_tableData[i]),m_blockSize*sizeof(T));
 	}
 }
 
@@ -376,8 +498,8 @@ bool AttributeMultiVector<T>::loadBin(CGoGNistream& fs)
 	m_tableData.resize(nb);
 	for(unsigned int i = 0; i < nb; ++i)
 	{
-		T* ptr = new T[_BLOCKSIZE_];
-		fs.read(reinterpret_cast<char*>(ptr),_BLOCKSIZE_*sizeof(T));
+		T* ptr = newBlock();
+		fs.read(reinterpret_cast<char*>(ptr),m_blockSize*sizeof(T));
 		m_tableData[i] = ptr;
 	}
 
@@ -392,19 +514,19 @@ inline bool AttributeMultiVectorGen::skipLoadBin(CGoGNistream& fs)
 	// get number of byte to skip
 	unsigned int nbb = nbs[1];
 
-	// check if nbb ok
-	if (nbb % _BLOCKSIZE_ != 0)
+	// check if nbb ok (blocks of any size are multiple of the smallest one)
+	if (nbb % _MIN_BLOCKSIZE_ != 0)
 	{
 		CGoGNerr << "Error skipping wrong number of byte in attributes reading"<< CGoGNendl;
 		return false;
 	}
 
 	// skip data (no seek because of pb with gzstream)
-	char* ptr = new char[_BLOCKSIZE_];
+	char* ptr = new char[_MIN_BLOCKSIZE_];
 	while (nbb != 0)
 	{
-		nbb -= _BLOCKSIZE_;
-		fs.read(reinterpret_cast<char*>(ptr),_BLOCKSIZE_);
+		nbb -= _MIN_BLOCKSIZE_;
+		fs.read(reinterpret_cast<char*>(ptr),_MIN_BLOCKSIZE_);
 	}
 	delete[] ptr;
 
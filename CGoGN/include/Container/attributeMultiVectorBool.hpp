@@ -72,8 +72,8 @@ public:
 
 	void addBlock()
 	{
-		unsigned int* ptr = new unsigned int[_BLOCKSIZE_/32];
-		memset(ptr,0,_BLOCKSIZE_/8);
+		unsigned int* ptr = static_cast<unsigned int*>(m_allocator->allocate(m_blockSize/8));
+		memset(ptr,0,m_blockSize/8);
 		m_tableData.push_back(ptr);
 //		std::cout << "Marker "<<this->getName()<<" - addBlock"<< std::endl;
 	}
@@ -88,13 +88,24 @@ public:
 		else
 		{
 			for (size_t i = m_tableData.size()-1; i>=nbb; --i)
-				delete[] m_tableData[i];
+				m_allocator->deallocate(m_tableData[i], m_blockSize/8);
 
 			m_tableData.resize(nbb);
 		}
 	}
 
 
+	void allocBlocks(unsigned int nbb)
+	{
+		for (size_t i = m_tableData.size(); i < nbb; ++i)
+			m_tableData.push_back(static_cast<unsigned int*>(m_allocator->allocate(m_blockSize/8)));
+	}
+
+	void initBlock(unsigned int b)
+	{
+		memset(m_tableData[b],0,m_blockSize/8);
+	}
+
 	unsigned int getNbBlocks() const
 	{
 		return uint32(m_tableData.size());
@@ -118,7 +129,7 @@ public:
 //		}
 
 		for (unsigned int i = 0; i < atmv->m_tableData.size(); ++i)
-			memcpy(m_tableData[i],atmv->m_tableData[i],_BLOCKSIZE_/8);
+			memcpy(m_tableData[i],atmv->m_tableData[i],m_blockSize/8);
 
 		return true;
 	}
@@ -139,6 +150,10 @@ public:
 		}
 
 		m_tableData.swap(atmv->m_tableData) ;
+		std::swap(m_allocator, atmv->m_allocator);
+		std::swap(m_blockSize, atmv->m_blockSize);
+		std::swap(m_blockShift, atmv->m_blockShift);
+		std::swap(m_blockMask, atmv->m_blockMask);
 		return true;
 	}
 
@@ -157,6 +172,18 @@ public:
 			return false;
 		}
 
+		if (attrib->m_allocator != m_allocator)
+		{
+			CGoGNerr << "trying to merge attributes with different block allocators" << CGoGNendl;
+			return false;
+		}
+
+		if (attrib->m_blockSize != m_blockSize)
+		{
+			CGoGNerr << "trying to merge attributes with different block sizes" << CGoGNendl;
+			return false;
+		}
+
 		for (auto it = attrib->m_tableData.begin(); it != attrib->m_tableData.end(); ++it)
 			m_tableData.push_back(*it);
 
@@ -166,7 +193,7 @@ public:
 	void clear()
 	{
 		for (auto it=m_tableData.begin(); it !=m_tableData.end(); ++it)
-			delete[] *it;
+			m_allocator->deallocate(*it, m_blockSize/8);
 		m_tableData.clear();
 	}
 
@@ -180,10 +207,10 @@ public:
 		for (unsigned int i = 0; i < m_tableData.size(); ++i)
 		{
 			unsigned int *ptr =m_tableData[i];
-			for (unsigned int j=0; j<_BLOCKSIZE_/32;++j)
+			for (unsigned int j=0; j<m_blockSize/32;++j)
 				*ptr++ = 0;
 		}
-		//memset(m_tableData[i],0,_BLOCKSIZE_/8);
+		//memset(m_tableData[i],0,m_blockSize/8);
 	}
 
 	inline void allTrue()
@@ -191,10 +218,10 @@ public:
 		for (unsigned int i = 0; i < m_tableData.size(); ++i)
 		{
 			unsigned int *ptr =m_tableData[i];
-			for (unsigned int j=0; j<_BLOCKSIZE_/32;++j)
+			for (unsigned int j=0; j<m_blockSize/32;++j)
 				*ptr++ = 0xffffffff;
 		}
-		//memset(m_tableData[i],0,_BLOCKSIZE_/8);
+		//memset(m_tableData[i],0,m_blockSize/8);
 	}
 
 	inline bool isAllFalse()
@@ -202,7 +229,7 @@ public:
 		for (unsigned int i = 0; i < m_tableData.size(); ++i)
 		{
 			unsigned int *ptr =m_tableData[i];
-			for (unsigned int j=0; j<_BLOCKSIZE_/32;++j)
+			for (unsigned int j=0; j<m_blockSize/32;++j)
 				if (*ptr++ != 0)
 					return false;
 		}
@@ -214,7 +241,7 @@ public:
 		for (unsigned int i = 0; i < m_tableData.size(); ++i)
 		{
 			unsigned int *ptr =m_tableData[i];
-			for (unsigned int j=0; j<_BLOCKSIZE_/32;++j)
+			for (unsigned int j=0; j<m_blockSize/32;++j)
 				if (*ptr++ != 0xffffffff)
 					return false;
 		}
@@ -228,8 +255,8 @@ public:
 
 	inline void setFalse(unsigned int i)
 	{
-		unsigned int jj = i / _BLOCKSIZE_;
-		unsigned int j = i % _BLOCKSIZE_;
+		unsigned int jj = i >> m_blockShift;
+		unsigned int j = i & m_blockMask;
 		unsigned int x = j/32;
 		unsigned int y = j%32;
 		unsigned int mask = 1 << y;
@@ -238,8 +265,8 @@ public:
 
 	inline void setTrue(unsigned int i)
 	{
-		unsigned int jj = i / _BLOCKSIZE_;
-		unsigned int j = i % _BLOCKSIZE_;
+		unsigned int jj = i >> m_blockShift;
+		unsigned int j = i & m_blockMask;
 		unsigned int x = j/32;
 		unsigned int y = j%32;
 		unsigned int mask = 1 << y;
@@ -248,8 +275,8 @@ public:
 
 	inline void setVal(unsigned int i, bool b)
 	{
-		unsigned int jj = i / _BLOCKSIZE_;
-		unsigned int j = i % _BLOCKSIZE_;
+		unsigned int jj = i >> m_blockShift;
+		unsigned int j = i & m_blockMask;
 		unsigned int x = j/32;
 		unsigned int y = j%32;
 		unsigned int mask = 1 << y;
@@ -266,8 +293,8 @@ public:
 	 */
 	inline bool operator[](unsigned int i) const
 	{
-		unsigned int jj = i / _BLOCKSIZE_;
-		unsigned int j = i % _BLOCKSIZE_;
+		unsigned int jj = i >> m_blockShift;
+		unsigned int j = i & m_blockMask;
 		unsigned int x = j/32;
 		unsigned int y = j%32;
 
@@ -301,6 +328,26 @@ public:
 		setFalse(id);
 	}
 
+	void initElts(unsigned int id, unsigned int nb)
+	{
+		unsigned int end = id + nb;
+		// bits before the first full word
+		while (id < end && (id % 32) != 0)
+			setFalse(id++);
+		// full words
+		while (end - id >= 32)
+		{
+			unsigned int jj = id >> m_blockShift;
+			unsigned int j = id & m_blockMask;
+			unsigned int nbw = std::min((m_blockSize - j) / 32, (end - id) / 32);
+			memset(m_tableData[jj] + j/32, 0, nbw * sizeof(unsigned int));
+			id += 32 * nbw;
+		}
+		// remaining bits
+		while (id < end)
+			setFalse(id++);
+	}
+
 	inline void copyElt(unsigned int dst, unsigned int src)
 	{
 		setVal(dst,this->operator [](src));
@@ -361,11 +408,11 @@ public:
 		fs.write(reinterpret_cast<const char*>(buffer),(len1+len2)*sizeof(char));
 
 		nbs[0] = int(m_tableData.size());
-		nbs[1] = nbs[0] * _BLOCKSIZE_/32;
+		nbs[1] = nbs[0] * m_blockSize/32;
 		fs.write(reinterpret_cast<const char*>(nbs),2*sizeof(unsigned int));
 
 		for (auto ptrIt = m_tableData.begin(); ptrIt!=m_tableData.end(); ++ptrIt)
-			fs.write(reinterpret_cast<const char*>(*ptrIt),_BLOCKSIZE_/8);
+			fs.write(reinterpret_cast<const char*>(*ptrIt),m_blockSize/8);
 	}
 
 
@@ -385,8 +432,8 @@ public:
 
 		for(unsigned int i = 0; i < nb; ++i)
 		{
-			m_tableData[i] = new unsigned int[_BLOCKSIZE_/32];
-			fs.read(reinterpret_cast<char*>(m_tableData[i]),_BLOCKSIZE_/8);
+			m_tableData[i] = static_cast<unsigned int*>(m_allocator->allocate(m_blockSize/8));
+			fs.read(reinterpret_cast<char*>(m_tableData[i]),m_blockSize/8);
 		}
 
 		return true;
@@ -0,0 +1,201 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __BLOCK_ALLOCATOR_H__
+#define __BLOCK_ALLOCATOR_H__
+
+#include <cstddef>
+#include <vector>
+#include <map>
+#include <mutex>
+
+namespace CGoGN
+{
+
+/**
+ * Allocator of the memory blocks of AttributeMultiVectors.
+ * A container (or a map) can be given its own allocator before its first line insertion,
+ * all the blocks of its attributes are then allocated and released through it.
+ * Allocators are not owned by containers and must outlive them.
+ */
+class BlockAllocator
+{
+public:
+	virtual ~BlockAllocator() {}
+
+	/**
+	 * allocate a block of nbBytes bytes (suitably aligned for any type)
+	 */
+	virtual void* allocate(std::size_t nbBytes) = 0;
+
+	/**
+	 * release a block allocated with the same number of bytes
+	 */
+	virtual void deallocate(void* ptr, std::size_t nbBytes) = 0;
+
+	/**
+	 * are the pages of blocks placed by the first thread that writes them ?
+	 * (blocks are then initialized in parallel when possible, see AttributeContainer::reserveFirstTouch)
+	 */
+	virtual bool isFirstTouch() const { return false; }
+
+	/**
+	 * default allocator (heap), shared by all containers
+	 */
+	static BlockAllocator* defaultAllocator();
+};
+
+/**
+ * blocks allocated on the heap, one by one
+ */
+class HeapBlockAllocator : public BlockAllocator
+{
+public:
+	void* allocate(std::size_t nbBytes);
+
+	void deallocate(void* ptr, std::size_t nbBytes);
+};
+
+/**
+ * blocks are cut in large arenas obtained from the system (mmap on linux),
+ * released blocks are kept in free lists (by size) for reuse.
+ * Arenas are released with the allocator.
+ */
+class ArenaBlockAllocator : public BlockAllocator
+{
+protected:
+	struct Arena
+	{
+		char* ptr;
+		std::size_t size;
+	};
+
+	std::size_t m_arenaSize;
+
+	std::vector<Arena> m_arenas;
+
+	/// free space at the end of the current arena
+	char* m_current;
+	std::size_t m_remaining;
+
+	/// released blocks (by size)
+	std::map<std::size_t, std::vector<void*> > m_freeBlocks;
+
+	std::mutex m_mutex;
+
+	/**
+	 * get a new arena from the system
+	 * @param size (IN/OUT) size wanted, size really obtained
+	 */
+	virtual char* newArena(std::size_t& size);
+
+	/**
+	 * give back an arena to the system
+	 */
+	void releaseArena(char* ptr, std::size_t size);
+
+public:
+	/**
+	 * @param arenaSize size of arenas in bytes (blocks larger than an arena get their own arena)
+	 */
+	ArenaBlockAllocator(std::size_t arenaSize);
+
+	~ArenaBlockAllocator();
+
+	void* allocate(std::size_t nbBytes);
+
+	void deallocate(void* ptr, std::size_t nbBytes);
+
+	/**
+	 * total size of arenas in bytes
+	 */
+	std::size_t reservedMemory() const;
+
+	/**
+	 * release all arenas (all blocks must have been released before)
+	 */
+	void releaseAll();
+};
+
+/**
+ * arenas of 2 MB aligned on 2 MB and advised for transparent huge pages (linux),
+ * so that the blocks of large maps use few TLB entries
+ */
+class HugePageBlockAllocator : public ArenaBlockAllocator
+{
+public:
+	static const std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+	/**
+	 * @param nbHugePages number of huge pages by arena
+	 */
+	HugePageBlockAllocator(unsigned int nbHugePages = 1);
+
+protected:
+	char* newArena(std::size_t& size);
+};
+
+/**
+ * NUMA aware arenas (linux).
+ * FIRST_TOUCH: pages are not touched at allocation, they are placed on the node of the thread that
+ * first writes them, use it with a parallel initialization (MapBuilder, foreach_cell with pinned threads).
+ * MapBuilder initializes the blocks in its threads, blocks added by single line insertions are
+ * initialized by the inserting thread.
+ * INTERLEAVE: pages of arenas are interleaved on all nodes (mbind), that balances memory bandwidth
+ * of all sockets for traversals that do not follow the thread/data affinity.
+ */
+class NumaBlockAllocator : public ArenaBlockAllocator
+{
+public:
+	enum Policy { FIRST_TOUCH, INTERLEAVE };
+
+	/**
+	 * @param policy placement of pages
+	 * @param arenaSize size of arenas in bytes
+	 */
+	NumaBlockAllocator(Policy policy = FIRST_TOUCH, std::size_t arenaSize = 32 * 1024 * 1024);
+
+	Policy getPolicy() const { return m_policy; }
+
+	bool isFirstTouch() const { return m_policy == FIRST_TOUCH; }
+
+	/**
+	 * number of NUMA nodes of the system (1 if unknown)
+	 */
+	static unsigned int getNbNodes();
+
+	/**
+	 * cpus of a NUMA node (empty if unknown or if the node has only memory)
+	 */
+	static std::vector<unsigned int> getNodeCpus(unsigned int node);
+
+protected:
+	Policy m_policy;
+
+	char* newArena(std::size_t& size);
+};
+
+} // namespace CGoGN
+
+#endif
@@ -55,11 +55,17 @@ protected:
 	*/
 	unsigned int m_nb;
 
+	/**
+	* max number of elements in block
+	*/
+	unsigned int m_blockSize;
+
 public:
 	/**
 	* constructor
+	* @param blockSize max number of elements in block
 	*/
-	HoleBlockRef();
+	HoleBlockRef(unsigned int blockSize = _BLOCKSIZE_);
 
 	/**
 	 * copy constructor
@@ -83,6 +89,15 @@ public:
 	*/
 	unsigned int newRefElt(unsigned int& nbEltsMax);
 
+	/**
+	* add at most nb elements (holes first, then at the end of block) with refCount = 1
+	* @param nb number of elements wanted
+	* @param nbEltsMax (IN/OUT) max number of element stored
+	* @param indices (OUT) table that receives the indices of the new elements
+	* @return number of elements added (limited by the room left in block)
+	*/
+	unsigned int newRefElts(unsigned int nb, unsigned int& nbEltsMax, unsigned int* indices);
+
 	/**
 	* remove an element
 	*/
@@ -96,7 +111,7 @@ public:
 	/**
 	* is the block full
 	*/
-	inline bool full() const { return m_nb == _BLOCKSIZE_;  }
+	inline bool full() const { return m_nb == m_blockSize;  }
 
 	/**
 	*  is the block empty
@@ -28,7 +28,44 @@
 #include "Utils/gzstream.h"
 #include "Utils/cgognStream.h"
 
-const unsigned int _BLOCKSIZE_ = 4096;
+/**
+ * default number of elements stored in each block of the attribute containers
+ * (set at configuration time with cmake -DCGoGN_BLOCKSIZE=...).
+ * Each container can be given its own block size at run time before its first
+ * insertion (AttributeContainer::setBlockSize, GenericMap::setBlockSize):
+ * small blocks save memory for maps with few cells, large blocks reduce
+ * the number of block indirections for huge maps.
+ * Block sizes are powers of 2 in [256,65536] (MarkerBool packs them in 32 bits words)
+ */
+#ifndef CGOGN_BLOCKSIZE
+#define CGOGN_BLOCKSIZE 4096
+#endif
+
+const unsigned int _BLOCKSIZE_ = CGOGN_BLOCKSIZE;
+const unsigned int _MIN_BLOCKSIZE_ = 256;
+const unsigned int _MAX_BLOCKSIZE_ = 65536;
+
+static_assert((_BLOCKSIZE_ & (_BLOCKSIZE_ - 1)) == 0, "CGOGN_BLOCKSIZE must be a power of 2");
+static_assert(_BLOCKSIZE_ >= _MIN_BLOCKSIZE_ && _BLOCKSIZE_ <= _MAX_BLOCKSIZE_, "CGOGN_BLOCKSIZE must be in [256,65536]");
+
+/**
+ * is bs a valid block size (power of 2 in [256,65536])
+ */
+inline bool validBlockSize(unsigned int bs)
+{
+	return (bs & (bs - 1)) == 0 && bs >= _MIN_BLOCKSIZE_ && bs <= _MAX_BLOCKSIZE_;
+}
+
+/**
+ * log2 of a block size: index / blockSize == index >> blockSizeShift(blockSize)
+ */
+inline unsigned int blockSizeShift(unsigned int bs)
+{
+	unsigned int shift = 0;
+	while ((1u << shift) < bs)
+		++shift;
+	return shift;
+}
 
 //typedef std::ifstream CGoGNistream;
 //typedef std::ofstream CGoGNostream;
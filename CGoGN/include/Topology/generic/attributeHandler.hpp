@@ -300,6 +300,9 @@ public:
 
 	void operator()()
 	{
+		if (PinThreads)
+			pinThisThread(m_id);
+
 		while (!m_finished)
 		{
 			for (std::vector<unsigned int>::const_iterator it = m_ids.begin(); it != m_ids.end(); ++it)
@@ -33,6 +33,7 @@
 #include <list>
 #include <vector>
 #include <map>
+#include <algorithm>
 
 #include "Container/attributeContainer.h"
 #include "Container/fakeAttribute.h"
@@ -41,6 +42,7 @@
 #include "Topology/generic/cells.h"
 #include "Topology/generic/marker.h"
 #include "Topology/generic/functor.h"
+#include "Topology/generic/mapListener.h"
 
 #include <thread>
 #include <mutex>
@@ -57,6 +59,25 @@ namespace Parallel
  */
 CGoGN_TOPO_API extern int NumberOfThreads;
 
+/**
+ * @brief if true the threads of parallel traversals are pinned on NUMA nodes
+ * (thread i on the cpus of node numaNodeOfThread(i)), to keep the affinity with data placed by first touch
+ */
+CGoGN_TOPO_API extern bool PinThreads;
+
+/**
+ * @brief NUMA node of thread id when pinned (threads are spread round robin over the nodes that have cpus)
+ * @param id thread id
+ */
+CGoGN_TOPO_API unsigned int numaNodeOfThread(unsigned int id);
+
+/**
+ * @brief pin the calling thread on the cpus of NUMA node numaNodeOfThread(id) (linux only)
+ * @param id thread id
+ * @return true if the thread has been pinned
+ */
+CGoGN_TOPO_API bool pinThisThread(unsigned int id);
+
 /**
  * @brief get number of cores of computer (threads, /2 if hyperthreading)
  * @param hyperthreading
@@ -188,6 +209,11 @@ protected:
 	std::multimap<AttributeMultiVectorGen*, AttributeHandlerGen*> attributeHandlers ;
 	std::mutex attributeHandlersMutex;
 
+	/**
+	 * Listeners of the topological operators
+	 */
+	std::vector<MapListener*> m_listeners ;
+
 public:
 	static const unsigned int UNKNOWN_ATTRIB = AttributeContainer::UNKNOWN ;
 
@@ -233,6 +259,21 @@ public:
 	 */
 	virtual void clear(bool removeAttrib) ;
 
+	/**
+	 * set the allocator of the blocks of all the containers of the map (heap by default)
+	 * must be done on an empty map (just after construction or clear)
+	 * @return false if a container has already allocated blocks
+	 */
+	bool setBlockAllocator(BlockAllocator* alloc) ;
+
+	/**
+	 * set the number of lines of the attribute blocks of all the containers of the map
+	 * (power of 2 in [256,65536], _BLOCKSIZE_ by default)
+	 * must be done on an empty map (just after construction or clear)
+	 * @return false if the size is not valid or a container has already allocated blocks
+	 */
+	bool setBlockSize(unsigned int bs) ;
+
 
 	/****************************************
 	 *     MANIPULATOR MANAGEMENT           *
@@ -422,6 +463,26 @@ public:
 
 	void printDartsTable();
 
+	/****************************************
+	 *         TOPOLOGY LISTENERS           *
+	 ****************************************/
+	/**
+	 * register a listener notified by the topological operators
+	 */
+	inline void addListener(MapListener* l) ;
+
+	/**
+	 * unregister a listener
+	 */
+	inline void removeListener(MapListener* l) ;
+
+protected:
+	/**
+	 * notify the listeners that the closed star of the vertex of d has been modified
+	 */
+	inline void notifyVertexStarChanged(Dart d) ;
+
+public:
 	/****************************************
 	 *   EMBEDDING ATTRIBUTES MANAGEMENT    *
 	 ****************************************/
@@ -101,6 +101,28 @@ inline void GenericMap::setExternalThreadsAuthorization(bool b)
 	}
 }
 
+/****************************************
+ *         TOPOLOGY LISTENERS           *
+ ****************************************/
+
+inline void GenericMap::addListener(MapListener* l)
+{
+	m_listeners.push_back(l) ;
+}
+
+inline void GenericMap::removeListener(MapListener* l)
+{
+	std::vector<MapListener*>::iterator it = std::find(m_listeners.begin(), m_listeners.end(), l) ;
+	if (it != m_listeners.end())
+		m_listeners.erase(it) ;
+}
+
+inline void GenericMap::notifyVertexStarChanged(Dart d)
+{
+	for (std::vector<MapListener*>::iterator it = m_listeners.begin(); it != m_listeners.end(); ++it)
+		(*it)->vertexStarChanged(d) ;
+}
+
 
 /****************************************
  *         BUFFERS MANAGEMENT           *
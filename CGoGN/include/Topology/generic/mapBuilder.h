@@ -0,0 +1,205 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __MAP_BUILDER_H__
+#define __MAP_BUILDER_H__
+
+#include <vector>
+
+#include "Topology/generic/mapImpl/mapMono.h"
+#include "Topology/generic/parallelLoop.h"
+
+namespace CGoGN
+{
+
+/**
+ * can darts of MAP be created in bulk ?
+ * MapBuilder only initializes relations, embeddings and markers of new darts:
+ * maps that redefine newDart to set other dart data (levels and ids of the
+ * implicit hierarchical maps) specialize this trait to false.
+ */
+template <typename MAP>
+struct BulkConstructible
+{
+	static const bool value = true;
+};
+
+/**
+ * Bulk construction of a map from flat index tables.
+ * Darts (and cells of each orbit) created by the builder are numbered locally
+ * in creation order. Relations and embeddings are given as tables (or functions)
+ * of these local indices and are written in parallel directly in the relation
+ * and embedding attributes of the map, without any sewing operation.
+ * An EMBNULL entry in an involution table leaves the dart free (fixed point),
+ * such holes can be closed afterwards with closeMap().
+ * Works on maps implemented with MapMono (EmbeddedMap2, EmbeddedMap3 ...).
+ */
+template <typename MAP>
+class MapBuilder : public MapMonoProtected
+{
+protected:
+	MAP& m_map;
+
+	unsigned int m_nbth;
+
+	std::vector<Dart> m_darts;
+
+	std::vector<unsigned int> m_cells[NB_ORBITS];
+
+	/**
+	 * reserve nb lines in a container, new blocks are initialized in parallel
+	 */
+	void reserveLines(AttributeContainer& cont, unsigned int nb);
+
+public:
+	/**
+	 * @param map the map to fill
+	 * @param nbth number of threads used to fill the tables
+	 */
+	MapBuilder(MAP& map, unsigned int nbth = Parallel::NumberOfThreads);
+
+	/**
+	 * is the map an oriented map (phi1 permutation) or a generalized map
+	 */
+	bool isOriented() const { return getNbPermutations() == 1; }
+
+	/****************************************
+	 *           DARTS & CELLS              *
+	 ****************************************/
+
+	/**
+	 * reserve memory for nb new darts
+	 */
+	void reserveDarts(unsigned int nb);
+
+	/**
+	 * reserve memory for nb new cells of orbit ORBIT
+	 */
+	template <unsigned int ORBIT>
+	void reserveCells(unsigned int nb);
+
+	/**
+	 * create nb new darts
+	 * @return the local index of the first one
+	 */
+	unsigned int newDarts(unsigned int nb);
+
+	/**
+	 * create nb new cells of orbit ORBIT (orbit must be embedded)
+	 * @return the local index of the first one
+	 */
+	template <unsigned int ORBIT>
+	unsigned int newCells(unsigned int nb);
+
+	unsigned int nbDarts() const { return uint32(m_darts.size()); }
+
+	/**
+	 * dart of local index i
+	 */
+	Dart dart(unsigned int i) const { return m_darts[i]; }
+
+	template <unsigned int ORBIT>
+	unsigned int nbCells() const { return uint32(m_cells[ORBIT].size()); }
+
+	/**
+	 * container index of the cell of local index i
+	 */
+	template <unsigned int ORBIT>
+	unsigned int cell(unsigned int i) const { return m_cells[ORBIT][i]; }
+
+	/****************************************
+	 *             RELATIONS                *
+	 ****************************************/
+
+	/**
+	 * set the permutation i (and its inverse) of all the darts of the builder
+	 * @param perm function (or table) that gives the local index of the image of each local index
+	 */
+	template <typename FUNC>
+	void setPermutation(unsigned int i, FUNC perm);
+
+	/**
+	 * set the involution i of all the darts of the builder
+	 * @param inv function (or table) that gives the local index of the image of each local index (EMBNULL for a free dart)
+	 */
+	template <typename FUNC>
+	void setInvolution(unsigned int i, FUNC inv);
+
+	void setPermutation(unsigned int i, const std::vector<unsigned int>& perm);
+
+	void setInvolution(unsigned int i, const std::vector<unsigned int>& inv);
+
+	/**
+	 * phi1 of oriented maps (permutation 0)
+	 */
+	template <typename TABLE>
+	void setPhi1(const TABLE& phi1) { setPermutation(0, phi1); }
+
+	/**
+	 * phi2 of oriented maps (involution 0)
+	 */
+	template <typename TABLE>
+	void setPhi2(const TABLE& phi2) { setInvolution(0, phi2); }
+
+	/**
+	 * phi3 of oriented maps (involution 1)
+	 */
+	template <typename TABLE>
+	void setPhi3(const TABLE& phi3) { setInvolution(1, phi3); }
+
+	/****************************************
+	 *             EMBEDDINGS               *
+	 ****************************************/
+
+	/**
+	 * embed all the darts of the builder on cells created by newCells<ORBIT>
+	 * reference counters of the cells are set accordingly
+	 * @param emb function (or table) that gives the local cell index of each local dart index (EMBNULL for no embedding)
+	 */
+	template <unsigned int ORBIT, typename FUNC>
+	void setEmbeddings(FUNC emb);
+
+	template <unsigned int ORBIT>
+	void setEmbeddings(const std::vector<unsigned int>& emb);
+
+	/****************************************
+	 *              BOUNDARY                *
+	 ****************************************/
+
+	/**
+	 * close the holes left by the free darts of the builder (phi2 in 2D, phi3 in 3D)
+	 * boundary darts are created, sewn, embedded and boundary marked in bulk,
+	 * the result is the same as map.closeMap(). Falls back on map.closeMap()
+	 * when the map is not oriented, when its darts can not be created in bulk
+	 * (see BulkConstructible) or when an orbit that closeHole would embed
+	 * on new cells (boundary faces of 2-maps ...) is embedded.
+	 */
+	void closeMap();
+};
+
+} // namespace CGoGN
+
+#include "Topology/generic/mapBuilder.hpp"
+
+#endif
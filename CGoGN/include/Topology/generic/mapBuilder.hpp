@@ -0,0 +1,363 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+namespace CGoGN
+{
+
+template <typename MAP>
+MapBuilder<MAP>::MapBuilder(MAP& map, unsigned int nbth) :
+	MapMonoProtected(map),
+	m_map(map),
+	m_nbth(nbth)
+{}
+
+template <typename MAP>
+void MapBuilder<MAP>::reserveLines(AttributeContainer& cont, unsigned int nb)
+{
+	// with a first touch allocator the new blocks are initialized by the threads,
+	// that places their pages on the nodes of the threads (when they are pinned)
+	unsigned int firstBlock = cont.reserveFirstTouch(nb);
+	Parallel::foreach_index(firstBlock, cont.getNbBlocks(), [&] (unsigned int b, unsigned int)
+	{
+		cont.initBlock(b);
+	}, m_nbth, 1);
+}
+
+template <typename MAP>
+void MapBuilder<MAP>::reserveDarts(unsigned int nb)
+{
+	reserveLines(m_map.template getAttributeContainer<DART>(), nb);
+	m_darts.reserve(m_darts.size() + nb);
+}
+
+template <typename MAP>
+template <unsigned int ORBIT>
+void MapBuilder<MAP>::reserveCells(unsigned int nb)
+{
+	assert(m_map.template isOrbitEmbedded<ORBIT>() || !"Invalid parameter: orbit not embedded");
+	reserveLines(m_map.template getAttributeContainer<ORBIT>(), nb);
+	m_cells[ORBIT].reserve(m_cells[ORBIT].size() + nb);
+}
+
+/// collect the embedding vectors of all embedded orbits
+template <typename MAP, unsigned int ORBIT>
+struct EmbeddingVectors
+{
+	static void get(MAP& map, std::vector<AttributeMultiVector<unsigned int>*>& embs)
+	{
+		AttributeMultiVector<unsigned int>* emb = map.template getEmbeddingAttributeVector<ORBIT>();
+		if (emb != NULL)
+			embs.push_back(emb);
+		EmbeddingVectors<MAP, ORBIT+1>::get(map, embs);
+	}
+};
+
+template <typename MAP>
+struct EmbeddingVectors<MAP, NB_ORBITS>
+{
+	static void get(MAP&, std::vector<AttributeMultiVector<unsigned int>*>&) {}
+};
+
+template <typename MAP>
+unsigned int MapBuilder<MAP>::newDarts(unsigned int nb)
+{
+	unsigned int first = uint32(m_darts.size());
+	if (nb == 0)
+		return first;
+	reserveDarts(nb);
+
+	AttributeContainer& cont = m_map.template getAttributeContainer<DART>();
+	std::vector<unsigned int> lines;
+	if (cont.insertLines(nb, lines))
+		cont.initMarkersOfLines(lines.front(), nb);
+	else
+	{
+		for (unsigned int i = 0; i < nb; ++i)
+			cont.initMarkersOfLine(lines[i]);
+	}
+	for (unsigned int i = 0; i < nb; ++i)
+		m_darts.push_back(Dart::create(lines[i]));
+
+	// new darts are fixed points of all relations and are not embedded
+	std::vector<AttributeMultiVector<Dart>*> relations;
+	for (unsigned int i = 0; i < getNbPermutations(); ++i)
+	{
+		relations.push_back(getPermutationAttribute(i));
+		relations.push_back(getPermutationInvAttribute(i));
+	}
+	for (unsigned int i = 0; i < getNbInvolutions(); ++i)
+		relations.push_back(getInvolutionAttribute(i));
+
+	std::vector<AttributeMultiVector<unsigned int>*> embs;
+	EmbeddingVectors<MAP, DART>::get(m_map, embs);
+
+	Parallel::foreach_index(first, first + nb, [&] (unsigned int j, unsigned int)
+	{
+		Dart d = m_darts[j];
+		for (unsigned int i = 0; i < relations.size(); ++i)
+			(*relations[i])[d.index] = d;
+		for (unsigned int i = 0; i < embs.size(); ++i)
+			(*embs[i])[d.index] = EMBNULL;
+	}, m_nbth);
+	m_map.touchTopology();
+
+	return first;
+}
+
+template <typename MAP>
+template <unsigned int ORBIT>
+unsigned int MapBuilder<MAP>::newCells(unsigned int nb)
+{
+	unsigned int first = uint32(m_cells[ORBIT].size());
+	if (nb == 0)
+		return first;
+	reserveCells<ORBIT>(nb);
+
+	AttributeContainer& cont = m_map.template getAttributeContainer<ORBIT>();
+	std::vector<unsigned int> lines;
+	if (cont.insertLines(nb, lines))
+		cont.initMarkersOfLines(lines.front(), nb);
+	else
+	{
+		for (unsigned int i = 0; i < nb; ++i)
+			cont.initMarkersOfLine(lines[i]);
+	}
+	m_cells[ORBIT].insert(m_cells[ORBIT].end(), lines.begin(), lines.end());
+	return first;
+}
+
+template <typename MAP>
+template <typename FUNC>
+void MapBuilder<MAP>::setPermutation(unsigned int i, FUNC perm)
+{
+	AttributeMultiVector<Dart>* phi = getPermutationAttribute(i);
+	AttributeMultiVector<Dart>* phi_inv = getPermutationInvAttribute(i);
+
+	Parallel::foreach_index(0, nbDarts(), [&] (unsigned int j, unsigned int)
+	{
+		Dart d = m_darts[j];
+		Dart e = m_darts[perm(j)];
+		(*phi)[d.index] = e;
+		(*phi_inv)[e.index] = d;
+	}, m_nbth);
+	m_map.touchTopology();
+}
+
+template <typename MAP>
+template <typename FUNC>
+void MapBuilder<MAP>::setInvolution(unsigned int i, FUNC inv)
+{
+	AttributeMultiVector<Dart>* phi = getInvolutionAttribute(i);
+
+	Parallel::foreach_index(0, nbDarts(), [&] (unsigned int j, unsigned int)
+	{
+		unsigned int k = inv(j);
+		Dart d = m_darts[j];
+		(*phi)[d.index] = (k == EMBNULL) ? d : m_darts[k];
+	}, m_nbth);
+	m_map.touchTopology();
+}
+
+template <typename MAP>
+void MapBuilder<MAP>::setPermutation(unsigned int i, const std::vector<unsigned int>& perm)
+{
+	assert(perm.size() == m_darts.size());
+	setPermutation(i, [&] (unsigned int j) { return perm[j]; });
+}
+
+template <typename MAP>
+void MapBuilder<MAP>::setInvolution(unsigned int i, const std::vector<unsigned int>& inv)
+{
+	assert(inv.size() == m_darts.size());
+	setInvolution(i, [&] (unsigned int j) { return inv[j]; });
+}
+
+template <typename MAP>
+template <unsigned int ORBIT, typename FUNC>
+void MapBuilder<MAP>::setEmbeddings(FUNC emb)
+{
+	assert(m_map.template isOrbitEmbedded<ORBIT>() || !"Invalid parameter: orbit not embedded");
+
+	AttributeMultiVector<unsigned int>* embVect = m_map.template getEmbeddingAttributeVector<ORBIT>();
+	AttributeContainer& cont = m_map.template getAttributeContainer<ORBIT>();
+	const std::vector<unsigned int>& cells = m_cells[ORBIT];
+
+	Parallel::foreach_index(0, nbDarts(), [&] (unsigned int j, unsigned int)
+	{
+		unsigned int c = emb(j);
+		(*embVect)[m_darts[j].index] = (c == EMBNULL) ? EMBNULL : cells[c];
+	}, m_nbth);
+
+	// reference counters (stored as nb refs + 1)
+	std::vector<unsigned int> nbRefs(cells.size(), 1);
+	for (unsigned int j = 0; j < nbDarts(); ++j)
+	{
+		unsigned int c = emb(j);
+		if (c != EMBNULL)
+			++nbRefs[c];
+	}
+	Parallel::foreach_index(0, uint32(cells.size()), [&] (unsigned int c, unsigned int)
+	{
+		cont.setNbRefs(cells[c], nbRefs[c]);
+	}, m_nbth);
+}
+
+template <typename MAP>
+template <unsigned int ORBIT>
+void MapBuilder<MAP>::setEmbeddings(const std::vector<unsigned int>& emb)
+{
+	assert(emb.size() == m_darts.size());
+	setEmbeddings<ORBIT>([&] (unsigned int j) { return emb[j]; });
+}
+
+template <typename MAP>
+void MapBuilder<MAP>::closeMap()
+{
+	const unsigned int DIM = MAP::DIMENSION;
+
+	bool bulk = isOriented() && BulkConstructible<MAP>::value;
+	for (unsigned int orb = FACE; orb < NB_ORBITS; ++orb)
+	{
+		if (orb == VOLUME && DIM == 3)
+			continue;	// boundary volumes are not embedded
+		if (orb == FACE && DIM == 3)
+			continue;	// boundary faces share the embedding of their phi3
+		if (m_map.isOrbitEmbedded(orb))
+			bulk = false;
+	}
+	if (!bulk)
+	{
+		m_map.closeMap();
+		return;
+	}
+
+	AttributeMultiVector<Dart>* phi1 = getPermutationAttribute(0);
+	AttributeMultiVector<Dart>* phi_1 = getPermutationInvAttribute(0);
+	AttributeMultiVector<Dart>* phi2 = getInvolutionAttribute(0);
+	AttributeMultiVector<Dart>* phiD = getInvolutionAttribute(DIM - 2);
+
+	// free darts (in creation order) and their boundary dart index
+	std::vector<unsigned int> freeDarts;
+	std::vector<unsigned int> boundaryOf(m_map.template getAttributeContainer<DART>().realEnd(), EMBNULL);
+	for (unsigned int j = 0; j < nbDarts(); ++j)
+	{
+		Dart d = m_darts[j];
+		if ((*phiD)[d.index] == d)
+		{
+			boundaryOf[d.index] = uint32(freeDarts.size());
+			freeDarts.push_back(j);
+		}
+	}
+	if (freeDarts.empty())
+		return;
+
+	const unsigned int nbB = uint32(freeDarts.size());
+	const unsigned int first = newDarts(nbB);
+
+	// the free test can not use phiD that is written during the loop
+	auto isFree = [&] (Dart d) { return boundaryOf[d.index] != EMBNULL; };
+	auto boundary = [&] (Dart d) { return m_darts[first + boundaryOf[d.index]]; };
+
+	Parallel::foreach_index(0, nbB, [&] (unsigned int k, unsigned int)
+	{
+		Dart f = m_darts[freeDarts[k]];
+		Dart b = m_darts[first + k];
+		(*phiD)[f.index] = b;
+		(*phiD)[b.index] = f;
+
+		if (DIM == 3)
+		{
+			// boundary faces are the phi3 images of the free faces with reversed orientation
+			Dart bp = boundary((*phi_1)[f.index]);
+			(*phi1)[b.index] = bp;
+			(*phi_1)[bp.index] = b;
+			// turn around the edge until the next free dart
+			Dart e = (*phi2)[f.index];
+			while (!isFree(e))
+				e = (*phi2)[(*phiD)[e.index].index];
+			(*phi2)[b.index] = boundary(e);
+		}
+		else
+		{
+			// next free dart of the hole (as in Map2::closeHole)
+			Dart g = (*phi1)[f.index];
+			while (!isFree(g))
+				g = (*phi1)[(*phi2)[g.index].index];
+			Dart bg = boundary(g);
+			(*phi1)[bg.index] = b;
+			(*phi_1)[b.index] = bg;
+		}
+	}, m_nbth);
+	m_map.touchTopology();
+
+	// embeddings: vertex of the boundary dart is the one of phi1 of its free dart,
+	// edge (and face in 3D) is the one of the free dart
+	std::vector<AttributeMultiVector<unsigned int>*> embs;
+	std::vector<AttributeContainer*> conts;
+	std::vector<bool> fromPhi1;
+	AttributeMultiVector<unsigned int>* orbitEmbs[3] = {
+		m_map.template getEmbeddingAttributeVector<VERTEX>(),
+		m_map.template getEmbeddingAttributeVector<EDGE>(),
+		m_map.template getEmbeddingAttributeVector<FACE>()
+	};
+	for (unsigned int orb = VERTEX; orb <= FACE; ++orb)
+	{
+		if (orbitEmbs[orb - VERTEX] != NULL)
+		{
+			embs.push_back(orbitEmbs[orb - VERTEX]);
+			conts.push_back(&(m_map.getAttributeContainer(orb)));
+			fromPhi1.push_back(orb == VERTEX);
+		}
+	}
+
+	if (!embs.empty())
+	{
+		Parallel::foreach_index(0, nbB, [&] (unsigned int k, unsigned int)
+		{
+			Dart f = m_darts[freeDarts[k]];
+			Dart b = m_darts[first + k];
+			Dart f1 = (*phi1)[f.index];
+			for (unsigned int i = 0; i < embs.size(); ++i)
+				(*embs[i])[b.index] = (*embs[i])[fromPhi1[i] ? f1.index : f.index];
+		}, m_nbth);
+
+		// reference counters are not thread safe
+		for (unsigned int k = 0; k < nbB; ++k)
+		{
+			Dart b = m_darts[first + k];
+			for (unsigned int i = 0; i < embs.size(); ++i)
+			{
+				unsigned int e = (*embs[i])[b.index];
+				if (e != EMBNULL)
+					conts[i]->refLine(e);
+			}
+		}
+	}
+
+	// boundary markers are not thread safe
+	for (unsigned int k = 0; k < nbB; ++k)
+		m_map.template boundaryMark<DIM>(m_darts[first + k]);
+}
+
+} // namespace CGoGN
@@ -29,6 +29,8 @@
 
 #include "Topology/dll.h"
 
+#include <atomic>
+
 
 namespace CGoGN
 {
@@ -39,19 +41,22 @@ class CGoGN_TOPO_API MapMono : public GenericMap
 	template<typename MAP> friend class DartMarkerStore ;
 
 public:
-	MapMono()
+	MapMono(): m_topoRevision(0)
 	{}
 
 	inline virtual void clear(bool removeAttrib);
 
 protected:
 	// protected copy constructor to prevent the copy of map
-	MapMono(const MapMono& m): GenericMap(m){}
+	MapMono(const MapMono& m): GenericMap(m), m_topoRevision(0){}
 
 	std::vector<AttributeMultiVector<Dart>*> m_involution;
 	std::vector<AttributeMultiVector<Dart>*> m_permutation;
 	std::vector<AttributeMultiVector<Dart>*> m_permutation_inv;
 
+	// incremented by each modification of the darts or of the relations
+	std::atomic<unsigned int> m_topoRevision;
+
 	/****************************************
 	 *          DARTS MANAGEMENT            *
 	 ****************************************/
@@ -69,6 +74,19 @@ public:
 
 	inline AttributeContainer& getDartContainer();
 
+	/**
+	 * number of topological modifications (dart creation/deletion, sew/unsew,
+	 * direct writes in a relation attribute) done since the creation of the map:
+	 * allows to detect that data computed from the relations is out of date
+	 */
+	inline unsigned int getTopoRevision() const;
+
+	/**
+	 * to be called after writing directly in the relation attributes
+	 * (getInvolutionAttribute, getPermutationAttribute, ...)
+	 */
+	inline void touchTopology();
+
 	/****************************************
 	 *        RELATIONS MANAGEMENT          *
 	 ****************************************/
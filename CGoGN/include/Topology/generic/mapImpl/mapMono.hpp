@@ -28,6 +28,7 @@ namespace CGoGN
 inline void MapMono::clear(bool removeAttrib)
 {
 	GenericMap::clear(removeAttrib) ;
+	++m_topoRevision ;
 	if (removeAttrib)
 	{
 		m_permutation.clear();
@@ -43,6 +44,7 @@ inline void MapMono::clear(bool removeAttrib)
 inline Dart MapMono::newDart()
 {
 	Dart d = GenericMap::newDart() ;
+	++m_topoRevision ;
 
 	for (unsigned int i = 0; i < m_permutation.size(); ++i)
 		(*m_permutation[i])[d.index] = d ;
@@ -56,6 +58,7 @@ inline Dart MapMono::newDart()
 
 inline void MapMono::deleteDart(Dart d)
 {
+	++m_topoRevision ;
 	deleteDartLine(d.index) ;
 }
 
@@ -79,6 +82,16 @@ inline AttributeContainer& MapMono::getDartContainer()
 	return m_attribs[DART];
 }
 
+inline unsigned int MapMono::getTopoRevision() const
+{
+	return m_topoRevision;
+}
+
+inline void MapMono::touchTopology()
+{
+	++m_topoRevision;
+}
+
 /****************************************
  *        RELATIONS MANAGEMENT          *
  ****************************************/
@@ -150,6 +163,7 @@ inline Dart MapMono::getPermutationInv(Dart d) const
 template <int I>
 inline void MapMono::involutionSew(Dart d, Dart e)
 {
+	++m_topoRevision ;
 	assert((*m_involution[I])[d.index] == d) ;
 	assert((*m_involution[I])[e.index] == e) ;
 	(*m_involution[I])[d.index] = e ;
@@ -159,6 +173,7 @@ inline void MapMono::involutionSew(Dart d, Dart e)
 template <int I>
 inline void MapMono::involutionUnsew(Dart d)
 {
+	++m_topoRevision ;
 	Dart e = (*m_involution[I])[d.index] ;
 	(*m_involution[I])[d.index] = d ;
 	(*m_involution[I])[e.index] = e ;
@@ -167,6 +182,7 @@ inline void MapMono::involutionUnsew(Dart d)
 template <int I>
 inline void MapMono::permutationSew(Dart d, Dart e)
 {
+	++m_topoRevision ;
 	Dart f = (*m_permutation[I])[d.index] ;
 	Dart g = (*m_permutation[I])[e.index] ;
 	(*m_permutation[I])[d.index] = g ;
@@ -178,6 +194,7 @@ inline void MapMono::permutationSew(Dart d, Dart e)
 template <int I>
 inline void MapMono::permutationUnsew(Dart d)
 {
+	++m_topoRevision ;
 	Dart e = (*m_permutation[I])[d.index] ;
 	Dart f = (*m_permutation[I])[e.index] ;
 	(*m_permutation[I])[d.index] = f ;
@@ -116,6 +116,11 @@ public:
 
 	inline AttributeContainer& getDartContainer();
 
+	/**
+	 * same interface as MapMono: no topological revision is kept here
+	 */
+	inline void touchTopology();
+
 	/**
 	 * get the insertion level of a dart
 	 */
@@ -156,6 +156,10 @@ inline AttributeContainer& MapMulti::getDartContainer()
 	return m_mrattribs;
 }
 
+inline void MapMulti::touchTopology()
+{
+}
+
 inline void MapMulti::incDartLevel(Dart d) const
 {
 	++((*m_mrLevels)[d.index]) ;
@@ -0,0 +1,54 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __MAP_LISTENER_H__
+#define __MAP_LISTENER_H__
+
+#include "Topology/generic/dart.h"
+
+namespace CGoGN
+{
+
+/**
+ * Interface of the objects that are notified of the topological modifications
+ * done by the operators of embedded maps (cutEdge, collapseEdge, splitFace, ...)
+ * A listener is registered with GenericMap::addListener and must be removed
+ * (GenericMap::removeListener) before being destroyed.
+ */
+class MapListener
+{
+public:
+	virtual ~MapListener() {}
+
+	/**
+	 * called after a topological operator for each vertex whose closed star
+	 * (incident cells and cells of the incident faces) has been modified
+	 * @param d a dart of the modified vertex (valid after the operation)
+	 */
+	virtual void vertexStarChanged(Dart d) = 0 ;
+} ;
+
+} // namespace CGoGN
+
+#endif
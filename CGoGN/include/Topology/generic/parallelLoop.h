@@ -0,0 +1,107 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __PARALLEL_LOOP_H__
+#define __PARALLEL_LOOP_H__
+
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#include "Topology/generic/genericmap.h"
+
+namespace CGoGN
+{
+
+namespace Parallel
+{
+
+/**
+ * apply a function on each index of [begin,end) with nbth threads
+ * indices are given to threads by chunks (of SIZE_BUFFER_THREAD by default) so that
+ * unbalanced work is shared. The calling thread is used as thread 0.
+ * The function must not use markers or traversors of a map
+ * (threads are not registered in the map).
+ * @param begin first index
+ * @param end last index + 1
+ * @param func function to apply: void (unsigned int index, unsigned int threadId) with threadId in [0,nbth[
+ * @param nbth number of threads (1 for sequential execution)
+ * @param chunkSize number of indices given at once to a thread (1 for a few heavy tasks)
+ */
+template <typename FUNC>
+void foreach_index(unsigned int begin, unsigned int end, FUNC func, unsigned int nbth = NumberOfThreads, unsigned int chunkSize = SIZE_BUFFER_THREAD)
+{
+	if (end <= begin)
+		return;
+
+	if (nbth < 2 || (end - begin) <= chunkSize)
+	{
+		for (unsigned int i = begin; i < end; ++i)
+			func(i, 0);
+		return;
+	}
+
+	unsigned int nbChunks = (end - begin + chunkSize - 1) / chunkSize;
+	if (nbth > nbChunks)
+		nbth = nbChunks;
+
+	std::atomic<unsigned int> nextChunk(0);
+
+	auto work = [&] (unsigned int id)
+	{
+		unsigned int c = nextChunk++;
+		while (c < nbChunks)
+		{
+			unsigned int first = begin + c * chunkSize;
+			unsigned int last = (c == nbChunks - 1) ? end : first + chunkSize;
+			for (unsigned int i = first; i < last; ++i)
+				func(i, id);
+			c = nextChunk++;
+		}
+	};
+
+	// the calling thread is never pinned
+	auto pinnedWork = [&] (unsigned int id)
+	{
+		if (PinThreads)
+			pinThisThread(id);
+		work(id);
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(nbth - 1);
+	for (unsigned int i = 1; i < nbth; ++i)
+		threads.push_back(std::thread(pinnedWork, i));
+
+	work(0);
+
+	for (unsigned int i = 0; i < nbth - 1; ++i)
+		threads[i].join();
+}
+
+} // namespace Parallel
+
+} // namespace CGoGN
+
+#endif
@@ -678,6 +678,9 @@ public:
 		// first thing to do set the thread id in genericMap
 		m_threadId = std::this_thread::get_id();
 
+		if (PinThreads)
+			pinThisThread(m_id);
+
 		while (!m_finished)
 		{
 			for (typename std::vector<CELL>::const_iterator it = m_cells.begin(); it != m_cells.end(); ++it)
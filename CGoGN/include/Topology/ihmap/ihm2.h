@@ -301,6 +301,16 @@ public:
 };
 
 
+
+// implicit hierarchical maps set levels and ids of new darts in newDart
+template <typename MAP> struct BulkConstructible ;
+
+template <>
+struct BulkConstructible<ImplicitHierarchicalMap2>
+{
+	static const bool value = false ;
+} ;
+
 } //namespace CGoGN
 
 #include "Topology/ihmap/ihm2.hpp"
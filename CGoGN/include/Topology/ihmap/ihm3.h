@@ -29,6 +29,8 @@
 
 #include "Topology/dll.h"
 
+#include <vector>
+
 
 namespace CGoGN
 {
@@ -54,6 +56,25 @@ private:
 
     AttributeMultiVector<unsigned int>* m_nextLevelCell[NB_ORBITS] ;
 
+    //! flat phi1, phi_1 & phi2 tables of one level (indexed by dart index)
+    struct LevelCache
+    {
+        std::vector<Dart> phi1 ;
+        std::vector<Dart> phi_1 ;
+        std::vector<Dart> phi2 ;
+    } ;
+
+    bool m_levelCacheEnabled ;
+    std::vector<LevelCache*> m_levelCache ;
+    const LevelCache* m_curLevelCache ;
+    unsigned int m_levelCacheRevision ;	// topological revision of the map the tables were built on
+
+    inline bool isLevelCacheValid() const ;
+
+    void updateCurrentLevelCache() ;
+
+    void clearLevelCache() ;
+
 public:
     ImplicitHierarchicalMap3() ;
 
@@ -95,6 +116,10 @@ public:
 
     inline Dart newDart() ;
 
+    inline void deleteDart(Dart d) ;
+
+    inline void compactTopo() ;
+
     inline Dart phi1(Dart d) const;
 
     inline Dart phi_1(Dart d) const;
@@ -184,6 +209,26 @@ public:
 
     void setDartLevel(Dart d, unsigned int i) ;
 
+    /***************************************************
+     *               LEVEL SNAPSHOT                    *
+     ***************************************************/
+
+    //! Enable or disable the level snapshot mode
+    /*! When enabled, phi1, phi_1 and phi2 of the current level are stored in
+     *  flat tables (built when the level is changed and kept for each visited level)
+     *  so that traversals at a fixed level do not walk through finer darts.
+     *  Any topological modification (dart creation or deletion, sewing, change of
+     *  a dart level, edge id or face id) makes the tables out of date: they are no
+     *  longer read, are dropped at the next level change and the mode is disabled.
+     *  Enable it again once the adaptation is done.
+     */
+    void enableLevelCache(bool b = true) ;
+
+    bool isLevelCacheEnabled() const ;
+
+    //! Drop the level tables and disable the level snapshot mode
+    inline void invalidateLevelCache() ;
+
     /***************************************************
      *                  ID MANAGEMENT                  *
      ***************************************************/
@@ -297,6 +342,16 @@ public:
 //};
 
 
+
+// implicit hierarchical maps set levels and ids of new darts in newDart
+template <typename MAP> struct BulkConstructible ;
+
+template <>
+struct BulkConstructible<ImplicitHierarchicalMap3>
+{
+	static const bool value = false ;
+} ;
+
 } //namespace CGoGN
 
 #include "Topology/ihmap/ihm3.hpp"
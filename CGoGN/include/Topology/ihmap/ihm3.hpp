@@ -72,6 +72,7 @@ inline void ImplicitHierarchicalMap3::update_topo_shortcuts()
  ***************************************************/
 inline Dart ImplicitHierarchicalMap3::newDart()
 {
+	invalidateLevelCache() ;
 	Dart d = TOPO_MAP::newDart() ;
     m_dartLevel[d] = m_curLevel ;
     if(m_curLevel > m_maxLevel)			// update max level
@@ -79,9 +80,24 @@ inline Dart ImplicitHierarchicalMap3::newDart()
     return d ;
 }
 
+inline void ImplicitHierarchicalMap3::deleteDart(Dart d)
+{
+	invalidateLevelCache() ;
+	TOPO_MAP::deleteDart(d) ;
+}
+
+inline void ImplicitHierarchicalMap3::compactTopo()
+{
+	invalidateLevelCache() ;
+	TOPO_MAP::compactTopo() ;
+}
+
 inline Dart ImplicitHierarchicalMap3::phi1(Dart d) const
 {
     assert(m_dartLevel[d] <= m_curLevel || !"Access to a dart introduced after current level") ;
+    if (isLevelCacheValid())
+        return m_curLevelCache->phi1[d.index] ;
+
     bool finished = false ;
 
     unsigned int edgeId = m_edgeId[d] ;
@@ -107,6 +123,9 @@ inline Dart ImplicitHierarchicalMap3::phi1(Dart d) const
 inline Dart ImplicitHierarchicalMap3::phi_1(Dart d) const
 {
     assert(m_dartLevel[d] <= m_curLevel || !"Access to a dart introduced after current level") ;
+    if (isLevelCacheValid())
+        return m_curLevelCache->phi_1[d.index] ;
+
     bool finished = false ;
 
     Dart it = Map3::phi_1(d) ;
@@ -151,6 +170,8 @@ inline Dart ImplicitHierarchicalMap3::phi2bis(Dart d) const
 inline Dart ImplicitHierarchicalMap3::phi2(Dart d) const
 {
     assert(m_dartLevel[d] <= m_curLevel || !"Access to a dart introduced after current level") ;
+    if (isLevelCacheValid())
+        return m_curLevelCache->phi2[d.index] ;
 
     return Map3::phi2(Map3::phi_1(phi1(d))) ;
 }
@@ -459,12 +480,14 @@ inline void ImplicitHierarchicalMap3::incCurrentLevel()
 {
 	assert(m_curLevel < m_maxLevel || "incCurrentLevel : already at maximum resolution level");
 	++m_curLevel ;
+	updateCurrentLevelCache() ;
 }
 
 inline void ImplicitHierarchicalMap3::decCurrentLevel()
 {
 	assert(m_curLevel > 0 || "decCurrentLevel : already at minimum resolution level");
 	--m_curLevel ;
+	updateCurrentLevelCache() ;
 }
 
 inline unsigned int ImplicitHierarchicalMap3::getCurrentLevel() const
@@ -475,6 +498,7 @@ inline unsigned int ImplicitHierarchicalMap3::getCurrentLevel() const
 inline void ImplicitHierarchicalMap3::setCurrentLevel(unsigned int l)
 {
     m_curLevel = l ;
+    updateCurrentLevelCache() ;
 }
 
 inline unsigned int ImplicitHierarchicalMap3::getMaxLevel() const
@@ -489,9 +513,30 @@ inline unsigned int ImplicitHierarchicalMap3::getDartLevel(Dart d) const
 
 inline void ImplicitHierarchicalMap3::setDartLevel(Dart d, unsigned int l)
 {
+    invalidateLevelCache() ;
     m_dartLevel[d] = l ;
 }
 
+/***************************************************
+ *               LEVEL SNAPSHOT                    *
+ ***************************************************/
+
+inline bool ImplicitHierarchicalMap3::isLevelCacheEnabled() const
+{
+    return m_levelCacheEnabled ;
+}
+
+inline void ImplicitHierarchicalMap3::invalidateLevelCache()
+{
+    if (m_levelCacheEnabled)
+        clearLevelCache() ;
+}
+
+inline bool ImplicitHierarchicalMap3::isLevelCacheValid() const
+{
+    return m_curLevelCache != NULL && m_levelCacheRevision == getTopoRevision() ;
+}
+
 /***************************************************
  *             EDGE ID MANAGEMENT                  *
  ***************************************************/
@@ -509,6 +554,7 @@ inline unsigned int ImplicitHierarchicalMap3::getEdgeId(Dart d)
 
 inline void ImplicitHierarchicalMap3::setEdgeId(Dart d, unsigned int i)
 {
+	invalidateLevelCache() ;
 	Dart e = d;
 
 	do
@@ -523,6 +569,7 @@ inline void ImplicitHierarchicalMap3::setEdgeId(Dart d, unsigned int i)
 
 inline void ImplicitHierarchicalMap3::setDartEdgeId(Dart d, unsigned int i)
 {
+	invalidateLevelCache() ;
 	m_edgeId[d] = i;
 }
 
@@ -596,6 +643,7 @@ inline unsigned int ImplicitHierarchicalMap3::getFaceId(Dart d)
 
 inline void ImplicitHierarchicalMap3::setFaceId(unsigned int orbit, Dart d)
 {
+    invalidateLevelCache() ;
     //Mise a jour de l'id de face pour les brins autour d'une arete
     if(orbit == EDGE)
     {
@@ -613,6 +661,7 @@ inline void ImplicitHierarchicalMap3::setFaceId(unsigned int orbit, Dart d)
 
 inline void ImplicitHierarchicalMap3::setFaceId(Dart d, unsigned int i, unsigned int orbit)
 {
+    invalidateLevelCache() ;
 
     //Mise a jour de l'id de face pour les brins autour de la face
     if(orbit == FACE)
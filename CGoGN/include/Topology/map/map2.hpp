@@ -1261,6 +1261,7 @@ void Map2<MAP_IMPL>::reverseOrientation()
 	DartAttribute<Dart, Map2<MAP_IMPL> > n_phi_1(this, this->getPermutationInvAttribute(0)) ;
 
 	this->swapAttributes(n_phi1, n_phi_1) ;
+	this->touchTopology() ;
 }
 
 template <typename MAP_IMPL>
@@ -1285,6 +1286,7 @@ void Map2<MAP_IMPL>::computeDual()
 
 	this->removeAttribute(new_phi1) ;
 	this->removeAttribute(new_phi_1) ;
+	this->touchTopology() ;
 
 	this->swapEmbeddingContainers(VERTEX, FACE) ;
 
@@ -0,0 +1,194 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __COMPACT_SPHERICAL_HARMONICS_H__
+#define __COMPACT_SPHERICAL_HARMONICS_H__
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "Geometry/vector_gen.h"
+#include "Utils/sphericalHarmonics.h"
+#include "Utils/half.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+ * access to the components of a SH coefficient (scalar or Geom::Vector)
+ */
+template <typename Tcoef>
+struct SHCoefComponents
+{
+	static const unsigned int size = 1;
+	template <typename Tscalar> static Tscalar get(const Tcoef& c, unsigned int) { return Tscalar(c); }
+	template <typename Tscalar> static void set(Tcoef& c, unsigned int, Tscalar v) { c = Tcoef(v); }
+};
+
+template <unsigned int DIM, typename T>
+struct SHCoefComponents< Geom::Vector<DIM, T> >
+{
+	static const unsigned int size = DIM;
+	template <typename Tscalar> static Tscalar get(const Geom::Vector<DIM, T>& c, unsigned int k) { return Tscalar(c[k]); }
+	template <typename Tscalar> static void set(Geom::Vector<DIM, T>& c, unsigned int k, Tscalar v) { c[k] = T(v); }
+};
+
+/**
+ * Spherical harmonics with a compact storage, to be used as attribute of large maps.
+ * The object itself is only the index of a slot in a pool shared by all the objects of the class ;
+ * a slot contains exactly get_nb_coefs() coefficients, whose components are stored as Tstorage
+ * (Tscalar, float, or Half for half precision).
+ * The slots are allocated in large pages, so that the coefficients of the vertices created
+ * one after the other are contiguous in memory.
+ *
+ * The level is the one of SphericalHarmonics<Tscalar,Tcoef> and must not be changed while
+ * objects of the class exist. Values are converted from / to Tscalar for all computations.
+ * Creation and destruction of objects are thread-safe : each thread takes its slots from and gives
+ * them back to its own cache, the shared pool is only locked to exchange slots by batches.
+ * Attributes of this type can be uploaded one coefficient at a time with VBO::updateDataConversion
+ * (with a conversion function returning get_coef(l, m)).
+ */
+template <typename Tscalar, typename Tcoef, typename Tstorage = Tscalar>
+class CompactSphericalHarmonics
+{
+public:
+	typedef SphericalHarmonics<Tscalar, Tcoef> SH;
+	typedef SHCoefComponents<Tcoef> Components;
+
+	static const unsigned int nb_components = Components::size;
+
+private:
+	class Pool
+	{
+	public:
+		static const unsigned int SLOTS_PER_PAGE = 16384;
+		static const unsigned int MAX_PAGES = 16384;
+		static const unsigned int BATCH = 256;	// number of slots exchanged between a thread cache and the pool
+
+	private:
+		// free slots of a thread (the ones of an older generation of the pool are forgotten)
+		struct Cache
+		{
+			unsigned int generation;
+			std::vector<unsigned int> slots;
+
+			Cache() : generation(0) {}
+			~Cache() { pool().giveBack(*this, 0); }
+		};
+
+		std::atomic<unsigned int> m_slotSize;	// number of Tstorage values in a slot
+		std::vector<Tstorage*> m_pages;			// never reallocated : slots can be read during allocations
+		unsigned int m_nbPages;
+		unsigned int m_nbSlots;					// slots already given in the pages
+		std::atomic<unsigned int> m_nbUsed;
+		std::atomic<unsigned int> m_generation;	// incremented when the pages are freed
+		std::vector<unsigned int> m_freeSlots;
+		std::mutex m_mutex;
+
+		static Cache& cache();
+
+		void clear();
+		void refill(Cache& c, unsigned int slotSize);
+		void giveBack(Cache& c, std::size_t nbKept);
+
+	public:
+		Pool();
+		~Pool();
+
+		unsigned int acquire(unsigned int slotSize);
+		void release(unsigned int slot);
+
+		Tstorage* data(unsigned int slot) const { return m_pages[slot / SLOTS_PER_PAGE] + (slot % SLOTS_PER_PAGE) * m_slotSize.load(std::memory_order_relaxed); }
+
+		unsigned int nbUsed() const { return m_nbUsed; }
+		std::size_t memory() const { return std::size_t(m_nbPages) * SLOTS_PER_PAGE * m_slotSize.load() * sizeof(Tstorage); }
+	};
+
+	static Pool& pool();
+
+	unsigned int m_slot;
+
+	static unsigned int slot_size() { return SH::get_nb_coefs() * nb_components; }
+
+	Tstorage* data() { return pool().data(m_slot); }
+	const Tstorage* data() const { return pool().data(m_slot); }
+
+public:
+	// construction, destruction
+	CompactSphericalHarmonics();
+	CompactSphericalHarmonics(const CompactSphericalHarmonics&);
+	CompactSphericalHarmonics(const SH& sh);
+	~CompactSphericalHarmonics();
+
+	static int get_resolution() { return SH::get_resolution(); }
+	static int get_nb_coefs() { return SH::get_nb_coefs(); }
+
+	static unsigned int get_nb_instances() { return pool().nbUsed(); }
+	static std::size_t get_pool_memory() { return pool().memory(); } // in bytes
+
+	// coefficients (converted from / to the storage type)
+	Tcoef get_coef(int l, int m) const;
+	void set_coef(int l, int m, const Tcoef& c);
+
+	void get(SH& sh) const;
+	void set(const SH& sh);
+	SH to_sh() const { SH sh; get(sh); return sh; }
+
+	// nb_coefs * nb_components stored values, coefficient by coefficient (e.g. for GPU upload)
+	const Tstorage* get_stored_values() const { return data(); }
+
+	// evaluation at n directions whose basis values are given (see SH::evaluate_basis)
+	void evaluate_batch(unsigned int n, const Tscalar* basis, Tcoef* result) const;
+
+	template <typename TS, typename TC, typename TST> friend std::ostream& operator<< (std::ostream& os, const CompactSphericalHarmonics<TS,TC,TST>& sh);
+
+	// operators
+	void operator= (const CompactSphericalHarmonics&);
+	void operator= (const SH& sh) { set(sh); }
+	void operator+= (const CompactSphericalHarmonics&);
+	CompactSphericalHarmonics operator+ (const CompactSphericalHarmonics&) const;
+	void operator-= (const CompactSphericalHarmonics&);
+	CompactSphericalHarmonics operator- (const CompactSphericalHarmonics&) const;
+	void operator*= (Tscalar);
+	CompactSphericalHarmonics operator* (Tscalar) const;
+	void operator/= (Tscalar);
+	CompactSphericalHarmonics operator/ (Tscalar) const;
+
+	friend void swap(CompactSphericalHarmonics& a, CompactSphericalHarmonics& b) { std::swap(a.m_slot, b.m_slot); }
+
+	std::string CGoGNnameOfType() const { return "CompactSphericalHarmonics"; }
+};
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#include "Utils/compactSphericalHarmonics.hpp"
+
+#endif
@@ -0,0 +1,351 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/*************************************************************************
+pool of coefficients
+**************************************************************************/
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::Pool::Pool() :
+	m_slotSize(0),
+	m_pages(MAX_PAGES, NULL),
+	m_nbPages(0),
+	m_nbSlots(0),
+	m_nbUsed(0),
+	m_generation(1)
+{}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::Pool::~Pool()
+{
+	clear();
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+typename CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::Pool::Cache& CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::Pool::cache()
+{
+	static thread_local Cache c;
+	return c;
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::Pool::clear()
+{
+	for (unsigned int i = 0; i < m_nbPages; ++i)
+	{
+		delete[] m_pages[i];
+		m_pages[i] = NULL;
+	}
+	m_nbPages = 0;
+	m_nbSlots = 0;
+	m_freeSlots.clear();
+	++m_generation;
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::Pool::refill(Cache& c, unsigned int slotSize)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (slotSize != m_slotSize)
+	{
+		// the level has changed : no object can use the current pages
+		assert(m_nbUsed == 0 || !"CompactSphericalHarmonics: level changed while objects exist");
+		clear();
+		m_slotSize = slotSize;
+	}
+	if (c.generation != m_generation)
+	{
+		c.slots.clear();
+		c.generation = m_generation;
+	}
+
+	// free slots first, then new ones, in the order of the pages
+	while (c.slots.size() < BATCH && !m_freeSlots.empty())
+	{
+		c.slots.push_back(m_freeSlots.back());
+		m_freeSlots.pop_back();
+	}
+	if (c.slots.size() < BATCH)
+	{
+		unsigned int nb = BATCH - (unsigned int)(c.slots.size());
+		for (unsigned int s = m_nbSlots + nb; s > m_nbSlots; --s)	// the first new slot is taken first
+			c.slots.push_back(s - 1);
+		m_nbSlots += nb;
+		while (m_nbSlots > m_nbPages * SLOTS_PER_PAGE)
+		{
+			assert(m_nbPages < MAX_PAGES || !"CompactSphericalHarmonics: pool is full");
+			m_pages[m_nbPages++] = new Tstorage[std::size_t(SLOTS_PER_PAGE) * m_slotSize];
+		}
+	}
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::Pool::giveBack(Cache& c, std::size_t nbKept)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (c.generation == m_generation)
+		m_freeSlots.insert(m_freeSlots.end(), c.slots.begin() + nbKept, c.slots.end());
+	c.slots.resize(nbKept);
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+unsigned int CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::Pool::acquire(unsigned int slotSize)
+{
+	Cache& c = cache();
+	if (c.slots.empty() || c.generation != m_generation || slotSize != m_slotSize.load(std::memory_order_relaxed))
+		refill(c, slotSize);
+
+	++m_nbUsed;
+	unsigned int s = c.slots.back();
+	c.slots.pop_back();
+	return s;
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::Pool::release(unsigned int slot)
+{
+	Cache& c = cache();
+	if (c.generation != m_generation)
+	{
+		// slots of freed pages
+		c.slots.clear();
+		c.generation = m_generation;
+	}
+
+	--m_nbUsed;
+	c.slots.push_back(slot);
+	if (c.slots.size() > 2 * BATCH)
+		giveBack(c, BATCH);
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+typename CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::Pool& CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::pool()
+{
+	static Pool p;
+	return p;
+}
+
+/*************************************************************************
+construction, destruction
+**************************************************************************/
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::CompactSphericalHarmonics()
+{
+	assert ( (SH::get_nb_coefs() > 0) || !" maybe you forgot to call set_level()");
+	m_slot = pool().acquire(slot_size());
+	Tstorage* d = data();
+	std::fill(d, d + slot_size(), Tstorage(0));
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::CompactSphericalHarmonics(const CompactSphericalHarmonics& sh)
+{
+	m_slot = pool().acquire(slot_size());
+	const Tstorage* s = sh.data();
+	std::copy(s, s + slot_size(), data());
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::CompactSphericalHarmonics(const SH& sh)
+{
+	assert ( (SH::get_nb_coefs() > 0) || !" maybe you forgot to call set_level()");
+	m_slot = pool().acquire(slot_size());
+	set(sh);
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::~CompactSphericalHarmonics()
+{
+	pool().release(m_slot);
+}
+
+/*************************************************************************
+coefficients
+**************************************************************************/
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+Tcoef CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::get_coef(int l, int m) const
+{
+	assert (l >= 0 && l <= get_resolution());
+	assert (m >= (-l) && m <= l);
+	const Tstorage* d = data() + (l*(l+1)+m) * nb_components;
+	Tcoef c;
+	for (unsigned int k = 0; k < nb_components; ++k)
+		Components::set(c, k, Tscalar(d[k]));
+	return c;
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::set_coef(int l, int m, const Tcoef& c)
+{
+	assert (l >= 0 && l <= get_resolution());
+	assert (m >= (-l) && m <= l);
+	Tstorage* d = data() + (l*(l+1)+m) * nb_components;
+	for (unsigned int k = 0; k < nb_components; ++k)
+		d[k] = Tstorage(Components::template get<Tscalar>(c, k));
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::get(SH& sh) const
+{
+	for (int l = 0; l <= get_resolution(); ++l)
+		for (int m = -l; m <= l; ++m)
+			sh.get_coef(l, m) = get_coef(l, m);
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::set(const SH& sh)
+{
+	for (int l = 0; l <= get_resolution(); ++l)
+		for (int m = -l; m <= l; ++m)
+			set_coef(l, m, sh.get_coef(l, m));
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::evaluate_batch(unsigned int n, const Tscalar* basis, Tcoef* result) const
+{
+	const int nb_coefs = get_nb_coefs();
+	const Tstorage* d = data();
+	for (unsigned int p = 0; p < n; ++p)
+		result[p] = Tcoef(0);
+	for (int i = 0; i < nb_coefs; ++i)
+	{
+		Tcoef c;
+		for (unsigned int k = 0; k < nb_components; ++k)
+			Components::set(c, k, Tscalar(d[i*nb_components + k]));
+		const Tscalar* b = basis + i*n;
+		for (unsigned int p = 0; p < n; ++p)
+			result[p] += c * b[p];
+	}
+}
+
+/*************************************************************************
+I/O
+**************************************************************************/
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+std::ostream& operator<< (std::ostream& os, const CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>& sh)
+{
+	for (int l = 0; l <= sh.get_resolution(); l++)
+	{
+		for (int m = -l; m <= l; m++)
+			os << sh.get_coef(l,m) << "\t";
+		os << std::endl;
+	}
+	return os;
+}
+
+/*************************************************************************
+operators
+**************************************************************************/
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::operator= (const CompactSphericalHarmonics& sh)
+{
+	const Tstorage* s = sh.data();
+	std::copy(s, s + slot_size(), data());
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::operator+= (const CompactSphericalHarmonics& sh)
+{
+	const unsigned int n = slot_size();
+	Tstorage* d = data();
+	const Tstorage* s = sh.data();
+	for (unsigned int i = 0; i < n; ++i)
+		d[i] = Tstorage(Tscalar(d[i]) + Tscalar(s[i]));
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage> CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::operator+ (const CompactSphericalHarmonics& sh) const
+{
+	CompactSphericalHarmonics res(*this);
+	res += sh;
+	return res;
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::operator-= (const CompactSphericalHarmonics& sh)
+{
+	const unsigned int n = slot_size();
+	Tstorage* d = data();
+	const Tstorage* s = sh.data();
+	for (unsigned int i = 0; i < n; ++i)
+		d[i] = Tstorage(Tscalar(d[i]) - Tscalar(s[i]));
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage> CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::operator- (const CompactSphericalHarmonics& sh) const
+{
+	CompactSphericalHarmonics res(*this);
+	res -= sh;
+	return res;
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::operator*= (Tscalar s)
+{
+	const unsigned int n = slot_size();
+	Tstorage* d = data();
+	for (unsigned int i = 0; i < n; ++i)
+		d[i] = Tstorage(Tscalar(d[i]) * s);
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage> CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::operator* (Tscalar s) const
+{
+	CompactSphericalHarmonics res(*this);
+	res *= s;
+	return res;
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+void CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::operator/= (Tscalar s)
+{
+	const unsigned int n = slot_size();
+	Tstorage* d = data();
+	for (unsigned int i = 0; i < n; ++i)
+		d[i] = Tstorage(Tscalar(d[i]) / s);
+}
+
+template <typename Tscalar, typename Tcoef, typename Tstorage>
+CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage> CompactSphericalHarmonics<Tscalar,Tcoef,Tstorage>::operator/ (Tscalar s) const
+{
+	CompactSphericalHarmonics res(*this);
+	res /= s;
+	return res;
+}
+
+} // namespace Utils
+
+} // namespace CGoGN
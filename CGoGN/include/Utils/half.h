@@ -0,0 +1,111 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __UTILS_HALF_H__
+#define __UTILS_HALF_H__
+
+#include <cstring>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+ * 16 bits floating point number (IEEE 754 binary16), for storage only:
+ * conversions from float round to nearest even, arithmetic is done in float.
+ */
+class Half
+{
+	uint16_t m_bits;
+
+	static inline uint32_t asUint(float f) { uint32_t u; memcpy(&u, &f, sizeof(u)); return u; }
+	static inline float asFloat(uint32_t u) { float f; memcpy(&f, &u, sizeof(f)); return f; }
+
+public:
+	Half() : m_bits(0) {}
+
+	Half(float f) : m_bits(fromFloat(f)) {}
+
+	operator float() const { return toFloat(m_bits); }
+
+	uint16_t bits() const { return m_bits; }
+
+	static std::string CGoGNnameOfType() { return "Half"; }
+
+	static uint16_t fromFloat(float f)
+	{
+		const uint32_t f32infty = 255u << 23;
+		const uint32_t f16max = (127u + 16u) << 23;
+		const uint32_t denormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+		uint32_t u = asUint(f);
+		uint32_t sign = u & 0x80000000u;
+		u ^= sign;
+
+		uint16_t h;
+		if (u >= f16max)					// overflow, inf or NaN
+			h = (u > f32infty) ? 0x7e00 : 0x7c00;
+		else if (u < (113u << 23))			// subnormal or zero : rounding done by the float addition
+			h = uint16_t(asUint(asFloat(u) + asFloat(denormMagic)) - denormMagic);
+		else
+		{
+			uint32_t mantOdd = (u >> 13) & 1u;
+			u += ((15u - 127u) << 23) + 0xfffu;
+			u += mantOdd;
+			h = uint16_t(u >> 13);
+		}
+		return uint16_t(h | (sign >> 16));
+	}
+
+	static float toFloat(uint16_t h)
+	{
+		const uint32_t shiftedExp = 0x7c00u << 13;
+
+		uint32_t u = (h & 0x7fffu) << 13;
+		uint32_t exp = shiftedExp & u;
+		u += (127u - 15u) << 23;
+		if (exp == shiftedExp)				// inf or NaN
+			u += (128u - 16u) << 23;
+		else if (exp == 0)					// subnormal or zero
+		{
+			u += 1u << 23;
+			u = asUint(asFloat(u) - asFloat(113u << 23));
+		}
+		return asFloat(u | (uint32_t(h & 0x8000u) << 16));
+	}
+
+	friend std::ostream& operator<<(std::ostream& out, const Half& h) { return out << float(h); }
+	friend std::istream& operator>>(std::istream& in, Half& h) { float f; in >> f; h = Half(f); return in; }
+};
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
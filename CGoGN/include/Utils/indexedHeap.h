@@ -0,0 +1,214 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __INDEXED_HEAP_H__
+#define __INDEXED_HEAP_H__
+
+#include <vector>
+#include <functional>
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+ * Binary heap of elements identified by an index in [0,n[, each with a key.
+ * The position of each element in the heap is stored, so that the key of an
+ * element can be changed (both ways) in O(log n) without duplicates in the heap
+ * (replaces a std::multimap<KEY, ELT> + stored iterators).
+ * COMPARE(a,b) is true if key a has priority on key b (std::less: min-heap).
+ */
+template <typename KEY, typename COMPARE = std::less<KEY> >
+class IndexedHeap
+{
+public:
+	static const unsigned int NONE = 0xffffffff ;
+
+private:
+	std::vector<unsigned int> m_heap ;		// elements in heap order
+	std::vector<unsigned int> m_position ;	// position of each element in heap (NONE if not in heap)
+	std::vector<KEY> m_keys ;				// key of each element
+	COMPARE m_comp ;
+
+	void moveUp(unsigned int p) ;
+	void moveDown(unsigned int p) ;
+
+	inline void place(unsigned int p, unsigned int e)
+	{
+		m_heap[p] = e ;
+		m_position[e] = p ;
+	}
+
+public:
+	IndexedHeap(unsigned int n = 0) { init(n) ; }
+
+	/**
+	 * set the number of elements and empty the heap
+	 */
+	void init(unsigned int n) ;
+
+	/**
+	 * empty the heap (in O(size))
+	 */
+	void clear() ;
+
+	bool empty() const { return m_heap.empty() ; }
+
+	unsigned int size() const { return (unsigned int)(m_heap.size()) ; }
+
+	bool contains(unsigned int e) const { return m_position[e] != NONE ; }
+
+	/// key of an element (last key given to it)
+	const KEY& key(unsigned int e) const { return m_keys[e] ; }
+
+	/// element with the highest priority
+	unsigned int top() const { return m_heap.front() ; }
+
+	const KEY& topKey() const { return m_keys[m_heap.front()] ; }
+
+	/**
+	 * insert an element, or change its key if already in heap
+	 */
+	void set(unsigned int e, const KEY& k) ;
+
+	/**
+	 * remove and return the element with the highest priority
+	 */
+	unsigned int pop() ;
+
+	/**
+	 * remove an element (if in heap)
+	 */
+	void remove(unsigned int e) ;
+} ;
+
+template <typename KEY, typename COMPARE>
+const unsigned int IndexedHeap<KEY, COMPARE>::NONE ;
+
+template <typename KEY, typename COMPARE>
+void IndexedHeap<KEY, COMPARE>::init(unsigned int n)
+{
+	m_heap.clear() ;
+	m_position.assign(n, NONE) ;
+	m_keys.resize(n) ;
+}
+
+template <typename KEY, typename COMPARE>
+void IndexedHeap<KEY, COMPARE>::clear()
+{
+	for (unsigned int i = 0; i < m_heap.size(); ++i)
+		m_position[m_heap[i]] = NONE ;
+	m_heap.clear() ;
+}
+
+template <typename KEY, typename COMPARE>
+void IndexedHeap<KEY, COMPARE>::moveUp(unsigned int p)
+{
+	unsigned int e = m_heap[p] ;
+	while (p > 0)
+	{
+		unsigned int parent = (p - 1) / 2 ;
+		if (!m_comp(m_keys[e], m_keys[m_heap[parent]]))
+			break ;
+		place(p, m_heap[parent]) ;
+		p = parent ;
+	}
+	place(p, e) ;
+}
+
+template <typename KEY, typename COMPARE>
+void IndexedHeap<KEY, COMPARE>::moveDown(unsigned int p)
+{
+	unsigned int e = m_heap[p] ;
+	unsigned int n = (unsigned int)(m_heap.size()) ;
+	while (true)
+	{
+		unsigned int child = 2 * p + 1 ;
+		if (child >= n)
+			break ;
+		if (child + 1 < n && m_comp(m_keys[m_heap[child + 1]], m_keys[m_heap[child]]))
+			++child ;
+		if (!m_comp(m_keys[m_heap[child]], m_keys[e]))
+			break ;
+		place(p, m_heap[child]) ;
+		p = child ;
+	}
+	place(p, e) ;
+}
+
+template <typename KEY, typename COMPARE>
+void IndexedHeap<KEY, COMPARE>::set(unsigned int e, const KEY& k)
+{
+	unsigned int p = m_position[e] ;
+	if (p == NONE)
+	{
+		m_keys[e] = k ;
+		m_heap.push_back(e) ;
+		moveUp((unsigned int)(m_heap.size()) - 1) ;
+	}
+	else
+	{
+		bool up = m_comp(k, m_keys[e]) ;
+		m_keys[e] = k ;
+		if (up)
+			moveUp(p) ;
+		else
+			moveDown(p) ;
+	}
+}
+
+template <typename KEY, typename COMPARE>
+unsigned int IndexedHeap<KEY, COMPARE>::pop()
+{
+	unsigned int e = m_heap.front() ;
+	remove(e) ;
+	return e ;
+}
+
+template <typename KEY, typename COMPARE>
+void IndexedHeap<KEY, COMPARE>::remove(unsigned int e)
+{
+	unsigned int p = m_position[e] ;
+	if (p == NONE)
+		return ;
+	m_position[e] = NONE ;
+	unsigned int last = m_heap.back() ;
+	m_heap.pop_back() ;
+	if (last != e)
+	{
+		place(p, last) ;
+		if (p > 0 && m_comp(m_keys[last], m_keys[m_heap[(p - 1) / 2]]))
+			moveUp(p) ;
+		else
+			moveDown(p) ;
+	}
+}
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
@@ -0,0 +1,118 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __KDTREE_H__
+#define __KDTREE_H__
+
+#include <vector>
+#include <limits>
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+ * Static kd-tree on a set of points (VEC: Geom::Vector-like type with DIMENSION and DATA_TYPE),
+ * for nearest neighbour queries.
+ * Nodes are split at the median of the coordinate of largest extent, the points are
+ * reordered so that the points of each leaf are contiguous.
+ */
+template <typename VEC>
+class KdTree
+{
+public:
+	typedef typename VEC::DATA_TYPE REAL ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+private:
+	struct Node
+	{
+		unsigned int begin, end ;		// range of the points of the node
+		unsigned int child ;			// first child (the second is child+1), NONE for a leaf
+		unsigned int axis ;
+		REAL split ;
+	} ;
+
+	std::vector<Node> m_nodes ;
+	std::vector<VEC> m_points ;				// reordered points
+	std::vector<unsigned int> m_indices ;	// initial index of reordered points
+	std::vector<unsigned int> m_leaves ;	// leaf nodes, in the order of the points
+
+	unsigned int m_leafSize ;
+
+	void buildNode(const std::vector<VEC>& points, unsigned int n) ;
+
+public:
+	KdTree() : m_leafSize(8) {}
+
+	/**
+	 * build the tree
+	 * @param points the points (copied)
+	 * @param leafSize max number of points in a leaf
+	 */
+	void build(const std::vector<VEC>& points, unsigned int leafSize = 8) ;
+
+	/**
+	 * search the nearest point of x
+	 * @param x query point
+	 * @param index (IN/OUT) index of the nearest point (in the initial order); as input,
+	 * an index whose distance is given in dist2 (e.g. the result of a previous query), or NONE
+	 * @param dist2 (IN/OUT) squared distance to the nearest point; as input, the squared
+	 * distance of x to the given index point or std::numeric_limits<REAL>::max()
+	 * @param exclude index of a point that is not searched (e.g. x itself)
+	 */
+	void nearest(const VEC& x, unsigned int& index, REAL& dist2, unsigned int exclude = NONE) const ;
+
+	unsigned int nearest(const VEC& x) const
+	{
+		unsigned int index = NONE ;
+		REAL dist2 = std::numeric_limits<REAL>::max() ;
+		nearest(x, index, dist2) ;
+		return index ;
+	}
+
+	unsigned int getNbPoints() const { return (unsigned int)(m_points.size()) ; }
+
+	/// i-th point in the tree order
+	const VEC& getPoint(unsigned int i) const { return m_points[i] ; }
+
+	/// initial index of the i-th point in the tree order
+	unsigned int getIndex(unsigned int i) const { return m_indices[i] ; }
+
+	/// leaves : ranges of points in the tree order (spatially coherent blocks of points)
+	unsigned int getNbLeaves() const { return (unsigned int)(m_leaves.size()) ; }
+	unsigned int getLeafBegin(unsigned int l) const { return m_nodes[m_leaves[l]].begin ; }
+	unsigned int getLeafEnd(unsigned int l) const { return m_nodes[m_leaves[l]].end ; }
+} ;
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#include "Utils/kdTree.hpp"
+
+#endif
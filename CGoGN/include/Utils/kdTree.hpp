@@ -0,0 +1,175 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+template <typename VEC>
+void KdTree<VEC>::build(const std::vector<VEC>& points, unsigned int leafSize)
+{
+	m_leafSize = leafSize > 0 ? leafSize : 1 ;
+	m_indices.resize(points.size()) ;
+	for (unsigned int i = 0; i < m_indices.size(); ++i)
+		m_indices[i] = i ;
+
+	m_nodes.clear() ;
+	m_leaves.clear() ;
+	m_points.clear() ;
+	if (points.empty())
+		return ;
+
+	// the tree is built on the indices, points are reordered at the end
+	m_nodes.reserve(2 * (points.size() / m_leafSize + 1)) ;
+	Node root ;
+	root.begin = 0 ;
+	root.end = (unsigned int)(points.size()) ;
+	m_nodes.push_back(root) ;
+	buildNode(points, 0) ;
+
+	m_points.resize(points.size()) ;
+	for (unsigned int i = 0; i < m_indices.size(); ++i)
+		m_points[i] = points[m_indices[i]] ;
+}
+
+template <typename VEC>
+void KdTree<VEC>::buildNode(const std::vector<VEC>& points, unsigned int n)
+{
+	const unsigned int begin = m_nodes[n].begin ;
+	const unsigned int end = m_nodes[n].end ;
+
+	m_nodes[n].child = NONE ;
+	m_nodes[n].axis = 0 ;
+	m_nodes[n].split = REAL(0) ;
+
+	if (end - begin <= m_leafSize)
+	{
+		m_leaves.push_back(n) ;
+		return ;
+	}
+
+	// axis of largest extent
+	VEC bbMin = points[m_indices[begin]] ;
+	VEC bbMax = bbMin ;
+	for (unsigned int i = begin + 1; i < end; ++i)
+	{
+		const VEC& p = points[m_indices[i]] ;
+		for (unsigned int k = 0; k < VEC::DIMENSION; ++k)
+		{
+			bbMin[k] = std::min(bbMin[k], p[k]) ;
+			bbMax[k] = std::max(bbMax[k], p[k]) ;
+		}
+	}
+	unsigned int axis = 0 ;
+	for (unsigned int k = 1; k < VEC::DIMENSION; ++k)
+		if (bbMax[k] - bbMin[k] > bbMax[axis] - bbMin[axis])
+			axis = k ;
+
+	if (bbMax[axis] == bbMin[axis])	// all points are equal
+	{
+		m_leaves.push_back(n) ;
+		return ;
+	}
+
+	// median split
+	const unsigned int mid = begin + (end - begin) / 2 ;
+	std::nth_element(m_indices.begin() + begin, m_indices.begin() + mid, m_indices.begin() + end,
+		[&] (unsigned int a, unsigned int b) { return points[a][axis] < points[b][axis] ; }) ;
+
+	const unsigned int child = (unsigned int)(m_nodes.size()) ;
+	m_nodes[n].child = child ;
+	m_nodes[n].axis = axis ;
+	m_nodes[n].split = points[m_indices[mid]][axis] ;
+
+	Node left ;
+	left.begin = begin ;
+	left.end = mid ;
+	Node right ;
+	right.begin = mid ;
+	right.end = end ;
+	m_nodes.push_back(left) ;
+	m_nodes.push_back(right) ;
+
+	buildNode(points, child) ;
+	buildNode(points, child + 1) ;
+}
+
+template <typename VEC>
+void KdTree<VEC>::nearest(const VEC& x, unsigned int& index, REAL& dist2, unsigned int exclude) const
+{
+	if (m_nodes.empty())
+		return ;
+
+	struct Entry
+	{
+		unsigned int node ;
+		REAL dist2 ;	// lower bound of the squared distance to the points of the node
+	} ;
+
+	Entry stack[64] ;
+	unsigned int top = 0 ;
+	stack[top].node = 0 ;
+	stack[top].dist2 = REAL(0) ;
+	++top ;
+
+	while (top > 0)
+	{
+		const Entry e = stack[--top] ;
+		if (e.dist2 >= dist2)
+			continue ;
+		const Node& node = m_nodes[e.node] ;
+
+		if (node.child == NONE)
+		{
+			for (unsigned int i = node.begin; i < node.end; ++i)
+			{
+				REAL d2 = (m_points[i] - x).norm2() ;
+				if (d2 < dist2 && m_indices[i] != exclude)
+				{
+					dist2 = d2 ;
+					index = m_indices[i] ;
+				}
+			}
+		}
+		else
+		{
+			REAL diff = x[node.axis] - node.split ;
+			// far child first on the stack, so that the near child is processed first
+			stack[top].node = diff < 0 ? node.child + 1 : node.child ;
+			stack[top].dist2 = std::max(e.dist2, diff * diff) ;
+			++top ;
+			stack[top].node = diff < 0 ? node.child : node.child + 1 ;
+			stack[top].dist2 = e.dist2 ;
+			++top ;
+		}
+	}
+}
+
+} // namespace Utils
+
+} // namespace CGoGN
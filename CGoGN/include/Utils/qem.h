@@ -170,7 +170,7 @@ public:
 	 */
 	friend std::ostream& operator<<(std::ostream& out, const Quadric<REAL>& q)
 	{
-		out << q.A ;
+		out << q.matrix() ;
 		return out ;
 	} ;
 
@@ -184,7 +184,9 @@ public:
 	 */
 	friend std::istream& operator>>(std::istream& in, Quadric<REAL>& q)
 	{
-		in >> q.A ;
+		MATRIX44 A ;
+		in >> A ;
+		q.setMatrix(A) ;
 		return in ;
 	} ;
 
@@ -197,8 +199,28 @@ public:
 	 */
 	bool findOptimizedPos(VEC3& v) ;
 
+	/*!
+	 * \brief get the full (symmetric) 4x4 matrix of the Quadric
+	 *
+	 * \return the Quadric matrix
+	 */
+	MATRIX44 matrix() const ;
+
+	/*!
+	 * \brief set the Quadric from a 4x4 matrix (only its upper triangle is read)
+	 *
+	 * \param A the Quadric matrix
+	 */
+	void setMatrix(const MATRIX44& A) ;
+
 private:
-	MATRIX44 A ; /*!< The Quadric matrix */
+	/*!
+	 * The upper triangle of the symmetric Quadric matrix, stored row by row :
+	 * a00 a01 a02 a03 a11 a12 a13 a22 a23 a33.
+	 * Ten contiguous doubles instead of a full 4x4 matrix : accumulation is a
+	 * single vectorizable loop and the attribute takes 80 bytes per vertex.
+	 */
+	double m[10] ;
 
 	/*!
 	 * \brief method to evaluate the error at a given point in space (homogeneous coordinates)
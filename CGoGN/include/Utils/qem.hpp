@@ -31,13 +31,13 @@ namespace Utils {
 template <typename REAL>
 Quadric<REAL>::Quadric()
 {
-	A.zero() ;
+	zero() ;
 }
 
 template <typename REAL>
 Quadric<REAL>::Quadric(int)
 {
-	A.zero() ;
+	zero() ;
 }
 
 template <typename REAL>
@@ -47,29 +47,38 @@ Quadric<REAL>::Quadric(const VEC3& p1, const VEC3& p2, const VEC3& p3)
 	Geom::Plane3D<REAL> plane(p1, p2, p3) ;
 	const VEC3& n = plane.normal() ;
 
-	Geom::Vector<4,double> p = Geom::Vector<4,double>(n[0],n[1],n[2],plane.d()) ;
-	A = Geom::transposed_vectors_mult(p,p) ;
+	const double a = n[0] ;
+	const double b = n[1] ;
+	const double c = n[2] ;
+	const double d = plane.d() ;
+	m[0] = a*a ; m[1] = a*b ; m[2] = a*c ; m[3] = a*d ;
+	m[4] = b*b ; m[5] = b*c ; m[6] = b*d ;
+	m[7] = c*c ; m[8] = c*d ;
+	m[9] = d*d ;
 }
 
 template <typename REAL>
 void
 Quadric<REAL>::zero()
 {
-	A.zero() ;
+	for (unsigned int i = 0; i < 10; ++i)
+		m[i] = 0.0 ;
 }
 
 template <typename REAL>
 void
 Quadric<REAL>::operator= (const Quadric<REAL>& q)
 {
-	A = q.A ;
+	for (unsigned int i = 0; i < 10; ++i)
+		m[i] = q.m[i] ;
 }
 
 template <typename REAL>
 Quadric<REAL>&
 Quadric<REAL>::operator+= (const Quadric<REAL>& q)
 {
-	A += q.A ;
+	for (unsigned int i = 0; i < 10; ++i)
+		m[i] += q.m[i] ;
 	return *this ;
 }
 
@@ -77,7 +86,8 @@ template <typename REAL>
 Quadric<REAL>&
 Quadric<REAL>::operator -= (const Quadric<REAL>& q)
 {
-	A -= q.A ;
+	for (unsigned int i = 0; i < 10; ++i)
+		m[i] -= q.m[i] ;
 	return *this ;
 }
 
@@ -85,7 +95,8 @@ template <typename REAL>
 Quadric<REAL>&
 Quadric<REAL>::operator *= (const REAL& v)
 {
-	A *= v ;
+	for (unsigned int i = 0; i < 10; ++i)
+		m[i] *= v ;
 	return *this ;
 }
 
@@ -93,7 +104,8 @@ template <typename REAL>
 Quadric<REAL>&
 Quadric<REAL>::operator /= (const REAL& v)
 {
-	A /= v ;
+	for (unsigned int i = 0; i < 10; ++i)
+		m[i] /= v ;
 	return *this ;
 }
 
@@ -127,14 +139,43 @@ Quadric<REAL>::findOptimizedPos(VEC3& v)
 	return b ;
 }
 
+template <typename REAL>
+typename Quadric<REAL>::MATRIX44
+Quadric<REAL>::matrix() const
+{
+	MATRIX44 A ;
+	A(0,0) = m[0] ; A(0,1) = m[1] ; A(0,2) = m[2] ; A(0,3) = m[3] ;
+	A(1,0) = m[1] ; A(1,1) = m[4] ; A(1,2) = m[5] ; A(1,3) = m[6] ;
+	A(2,0) = m[2] ; A(2,1) = m[5] ; A(2,2) = m[7] ; A(2,3) = m[8] ;
+	A(3,0) = m[3] ; A(3,1) = m[6] ; A(3,2) = m[8] ; A(3,3) = m[9] ;
+	return A ;
+}
+
+template <typename REAL>
+void
+Quadric<REAL>::setMatrix(const MATRIX44& A)
+{
+	m[0] = A(0,0) ; m[1] = A(0,1) ; m[2] = A(0,2) ; m[3] = A(0,3) ;
+	m[4] = A(1,1) ; m[5] = A(1,2) ; m[6] = A(1,3) ;
+	m[7] = A(2,2) ; m[8] = A(2,3) ;
+	m[9] = A(3,3) ;
+}
+
 template <typename REAL>
 REAL
 Quadric<REAL>::evaluate(const VEC4& v) const
 {
 	// Double computation is crucial for stability
-	Geom::Vector<4, double> vd(v);
-	Geom::Vector<4, double> Av = A * vd ;
-	return REAL(vd * Av) ;
+	const double x = v[0] ;
+	const double y = v[1] ;
+	const double z = v[2] ;
+	const double w = v[3] ;
+	return REAL(
+		x * (m[0]*x + 2.0*(m[1]*y + m[2]*z + m[3]*w)) +
+		y * (m[4]*y + 2.0*(m[5]*z + m[6]*w)) +
+		z * (m[7]*z + 2.0*m[8]*w) +
+		w * m[9]*w
+	) ;
 }
 
 template <typename REAL>
@@ -142,23 +183,30 @@ bool
 Quadric<REAL>::optimize(VEC4& v) const
 {
 #ifdef WIN32
-	if (A(0, 0) != A(0, 0))
+	if (m[0] != m[0])
 #else
-	if (std::isnan(A(0, 0)))
+	if (std::isnan(m[0]))
 #endif
 		return false ;
 
-	MATRIX44 A2(A) ;
-	for(int i = 0; i < 3; ++i)
-		A2(3,i) = 0.0f ;
-	A2(3,3) = 1.0f ;
-	MATRIX44 Ainv ;
-	REAL det = REAL(A2.invert(Ainv));
+	// the last row of the system is (0 0 0 1) : only the upper 3x3 block
+	// has to be inverted (cofactors of a symmetric matrix)
+	const double c00 = m[4]*m[7] - m[5]*m[5] ;
+	const double c01 = m[2]*m[5] - m[1]*m[7] ;
+	const double c02 = m[1]*m[5] - m[2]*m[4] ;
+	const double det = m[0]*c00 + m[1]*c01 + m[2]*c02 ;
 	if(det > -1e-6 && det < 1e-6)
 		return false ;
-//	VEC4 right(0,0,0,1) ;
-	Geom::Vector<4, double> right(0,0,0,1) ;
-	v = VEC4(Ainv * right) ;
+
+	const double c11 = m[0]*m[7] - m[2]*m[2] ;
+	const double c12 = m[1]*m[2] - m[0]*m[5] ;
+	const double c22 = m[0]*m[4] - m[1]*m[1] ;
+
+	const double inv = -1.0 / det ;
+	v[0] = REAL((c00*m[3] + c01*m[6] + c02*m[8]) * inv) ;
+	v[1] = REAL((c01*m[3] + c11*m[6] + c12*m[8]) * inv) ;
+	v[2] = REAL((c02*m[3] + c12*m[6] + c22*m[8]) * inv) ;
+	v[3] = REAL(1) ;
 
 	return true;
 }
@@ -35,6 +35,8 @@
 #include <vector>
 #include <math.h>
 
+#include "Utils/kdTree.h"
+
 namespace CGoGN
 {
 
@@ -48,6 +50,7 @@ struct CodeVector
 	unsigned int regionNbVectors ;
 	VEC regionVectorsSum ;
 	float regionDistortion ;
+	unsigned int index ; // position in the codebook during a Lloyd iteration
 
 	bool operator<(CodeVector<VEC>& c)
 	{
@@ -66,14 +69,31 @@ private:
 	std::list<CodeVector<VEC> > codeVectors ; // codebook
 	unsigned int nbCodeVectors ; // size of codebook
 
+	bool assigned ; // associatedCodeVectors are valid
+
+	// codebook of the current Lloyd iteration, as an array, and its search structure
+	std::vector<CodeVectorID> codebookIDs ;
+	std::vector<VEC> codebookPositions ;
+	std::vector<typename VEC::DATA_TYPE> codebookRadius2 ; // squared half distance of each codeVector to the nearest other one
+	KdTree<VEC> codebookTree ;
+
+	// properties of the regions, accumulated by each thread
+	struct RegionAccumulator
+	{
+		unsigned int nbVectors ;
+		VEC vectorsSum ;
+		double distortion ;
+	} ;
+	std::vector<RegionAccumulator> regionAccumulators ;
+
 	VEC meanSourceVector ;
 	float distortion ;
 	float discreteEntropy, differentialEntropy ;
 	float determinantSigma, traceSigma ;
 
 	void computeMeanSourceVector() ;
-	CodeVectorID nearestNeighbour(int v) ; // for the sourceVector of the given index, search the id of the nearest codeVector
 	void algoLloydMax() ; // Lloyd Iteration
+	void seedCodeVectors(unsigned int nbRegions) ; // k-means++ initial codebook
 
 public:
 	Quantization(const std::vector<VEC>& source) ;
@@ -86,6 +106,10 @@ public:
 
 	unsigned int getNbCodeVectors() { return nbCodeVectors ; }
 
+	// only available after a quantization :
+	// the codebook and, for each source vector, the index of its codeVector
+	void getCodebook(std::vector<VEC>& codebook, std::vector<unsigned int>& indices) ;
+
 	// only available after a quantization
 	float getDiscreteEntropy() { return discreteEntropy ; }
 	// available immediately after object construction
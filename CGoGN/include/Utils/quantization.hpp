@@ -23,9 +23,12 @@
 *******************************************************************************/
 
 #include "Utils/cgognStream.h"
+#include "Topology/generic/parallelLoop.h"
 
 #include <cmath>
 #include <limits>
+#include <map>
+#include <random>
 
 
 namespace CGoGN
@@ -55,6 +58,7 @@ template <typename VEC>
 Quantization<VEC>::Quantization(const std::vector<VEC>& source) : sourceVectors(source)
 {
 	associatedCodeVectors.resize(sourceVectors.size()) ;
+	assigned = false ;
 	nbCodeVectors = 0 ;
 	computeMeanSourceVector() ;
 	computeDifferentialEntropy() ;
@@ -69,77 +73,113 @@ void Quantization<VEC>::computeMeanSourceVector()
 	meanSourceVector /= sourceVectors.size() ;
 }
 
-// Nearest neighbour search : naive algorithm
 template <typename VEC>
-typename Quantization<VEC>::CodeVectorID Quantization<VEC>::nearestNeighbour(int v)
+void Quantization<VEC>::algoLloydMax()
 {
 	typedef typename VEC::DATA_TYPE REAL;
-	VEC x = sourceVectors[v] ;
-	REAL dist_min = std::numeric_limits<REAL>::max();
-	CodeVectorID nearest = codeVectors.begin() ;
-	/* search minimum of squared length between v and each vector of codebook */
-	for(CodeVectorID cv = codeVectors.begin(); cv != codeVectors.end() ; ++cv)
-	{
-		VEC vec = x - cv->v ;
-		REAL l = vec.norm2();
-		if(l < dist_min)
-		{
-			dist_min = l ;
-			nearest = cv ;
-		}
-	}
-	return nearest ;
-}
+	const unsigned int nbSource = uint32(sourceVectors.size()) ;
+	const unsigned int nbThreads = Parallel::NumberOfThreads > 1 ? Parallel::NumberOfThreads : 1 ;
 
-template <typename VEC>
-void Quantization<VEC>::algoLloydMax()
-{
 	unsigned int nbLloydIt = 0 ;
 	bool finished = false ;
 	do
 	{
 		++nbLloydIt ;
 
-		VEC z ;
-		zero<VEC>(z) ;
-
-		// initialize the codeVectors region properties
+		// array copy of the codebook and kd-tree for the nearest codeVector searches
+		codebookIDs.clear() ;
+		codebookPositions.clear() ;
 		for(CodeVectorID cv = codeVectors.begin(); cv != codeVectors.end(); ++cv)
 		{
-			cv->regionNbVectors = 0 ;
-			cv->regionVectorsSum = z ;
-			cv->regionDistortion = 0.0f ;
+			cv->index = uint32(codebookIDs.size()) ;
+			codebookIDs.push_back(cv) ;
+			codebookPositions.push_back(cv->v) ;
 		}
+		codebookTree.build(codebookPositions) ;
+		const unsigned int nbCV = uint32(codebookIDs.size()) ;
+
+		// a sourceVector closer to a codeVector than half the distance of this codeVector
+		// to any other one is in its region : no search is needed
+		codebookRadius2.resize(nbCV) ;
+		Parallel::foreach_index(0, nbCV, [&] (unsigned int c, unsigned int)
+		{
+			unsigned int other = KdTree<VEC>::NONE ;
+			REAL dist2 = std::numeric_limits<REAL>::max() ;
+			codebookTree.nearest(codebookPositions[c], other, dist2, c) ;
+			codebookRadius2[c] = dist2 / REAL(4) ;
+		}, nbThreads) ;
+
+		// initialize the region properties accumulated by each thread
+		RegionAccumulator z ;
+		z.nbVectors = 0 ;
+		zero<VEC>(z.vectorsSum) ;
+		z.distortion = 0.0 ;
+		regionAccumulators.assign(nbThreads * nbCV, z) ;
 
 		// For each sourceVector, find its nearest neighbour among the current codeVectors
-		// and update nbVectors and distortion associated to each codeVector.
-		// In the same time, compute for each codeVector the sum of the sourceVectors of its region
+		// (the search starts from its previous codeVector, that is often still the nearest)
+		// and update nbVectors, distortion and sum of the sourceVectors of its region
 		// (needed if one has to update the positions of the codeVectors)
-		for(unsigned int i = 0; i < sourceVectors.size(); ++i)
+		Parallel::foreach_index(0, nbSource, [&] (unsigned int i, unsigned int threadId)
 		{
-			CodeVectorID cv = nearestNeighbour(i) ;
-			associatedCodeVectors[i] = cv ;
-			cv->regionNbVectors += 1 ;
-			VEC vec = sourceVectors[i] - cv->v ;
-			cv->regionDistortion += vec.norm2() ;
-			cv->regionVectorsSum += sourceVectors[i] ;
+			const VEC& x = sourceVectors[i] ;
+			unsigned int nearest = KdTree<VEC>::NONE ;
+			REAL dist2 = std::numeric_limits<REAL>::max() ;
+			if(assigned)
+			{
+				nearest = associatedCodeVectors[i]->index ;
+				dist2 = (x - codebookPositions[nearest]).norm2() ;
+			}
+			if(!assigned || dist2 > codebookRadius2[nearest])
+				codebookTree.nearest(x, nearest, dist2) ;
+			associatedCodeVectors[i] = codebookIDs[nearest] ;
+
+			RegionAccumulator& acc = regionAccumulators[threadId * nbCV + nearest] ;
+			acc.nbVectors += 1 ;
+			acc.vectorsSum += x ;
+			acc.distortion += dist2 ;
+		}, nbThreads) ;
+		assigned = true ;
+
+		// gather the region properties of all threads
+		for(unsigned int c = 0; c < nbCV; ++c)
+		{
+			RegionAccumulator acc = regionAccumulators[c] ;
+			for(unsigned int t = 1; t < nbThreads; ++t)
+			{
+				const RegionAccumulator& tacc = regionAccumulators[t * nbCV + c] ;
+				acc.nbVectors += tacc.nbVectors ;
+				acc.vectorsSum += tacc.vectorsSum ;
+				acc.distortion += tacc.distortion ;
+			}
+			CodeVectorID cv = codebookIDs[c] ;
+			cv->regionNbVectors = acc.nbVectors ;
+			cv->regionVectorsSum = acc.vectorsSum ;
+			cv->regionDistortion = float(acc.distortion) ;
 		}
 
 		float oldDistortion = distortion ;
-		distortion = 0.0f ;
+		double totalDistortion = 0.0 ;
 
 		// update the distortion associated to each codeVector
-		// and compute the total distortion
-		for(CodeVectorID cv = codeVectors.begin(); cv != codeVectors.end(); ++cv)
+		// and compute the total distortion (codeVectors with empty regions are removed)
+		CodeVectorID cv = codeVectors.begin() ;
+		while(cv != codeVectors.end())
 		{
 			if(cv->regionNbVectors > 0)
-				distortion += cv->regionDistortion ;
+			{
+				totalDistortion += cv->regionDistortion ;
+				++cv ;
+			}
 			else
-				codeVectors.erase(cv) ;
+			{
+				cv = codeVectors.erase(cv) ;
+				--nbCodeVectors ;
+			}
 		}
-		distortion /= sourceVectors.size() ;
+		distortion = float(totalDistortion / nbSource) ;
 
-		if((oldDistortion - distortion) / oldDistortion < epsilonDistortion)
+		if(oldDistortion <= 0.0f || (oldDistortion - distortion) / oldDistortion < epsilonDistortion)
 			finished = true ;
 
 		if(!finished)
@@ -156,6 +196,121 @@ void Quantization<VEC>::algoLloydMax()
 	codeVectors.sort() ;
 }
 
+// k-means++ seeding : each new codeVector is a sourceVector chosen with a probability
+// proportional to its squared distance to the nearest codeVector already chosen.
+// The sourceVectors are handled by spatially coherent blocks (leaves of a kd-tree) :
+// the distances of a block are only updated if the new codeVector is close enough.
+template <typename VEC>
+void Quantization<VEC>::seedCodeVectors(unsigned int nbRegions)
+{
+	typedef typename VEC::DATA_TYPE REAL;
+	const unsigned int nbSource = uint32(sourceVectors.size()) ;
+
+	codeVectors.clear() ;
+	nbCodeVectors = 0 ;
+	assigned = false ;
+
+	KdTree<VEC> tree ;
+	tree.build(sourceVectors, 256) ;
+	const unsigned int nbBlocks = tree.getNbLeaves() ;
+
+	// bounding sphere of the blocks
+	std::vector<VEC> blockCenter(nbBlocks) ;
+	std::vector<REAL> blockRadius(nbBlocks) ;
+	for(unsigned int b = 0; b < nbBlocks; ++b)
+	{
+		VEC bbMin = tree.getPoint(tree.getLeafBegin(b)) ;
+		VEC bbMax = bbMin ;
+		for(unsigned int j = tree.getLeafBegin(b); j < tree.getLeafEnd(b); ++j)
+		{
+			for(unsigned int k = 0; k < VEC::DIMENSION; ++k)
+			{
+				bbMin[k] = std::min(bbMin[k], tree.getPoint(j)[k]) ;
+				bbMax[k] = std::max(bbMax[k], tree.getPoint(j)[k]) ;
+			}
+		}
+		blockCenter[b] = (bbMin + bbMax) / REAL(2) ;
+		REAL r2 = 0 ;
+		for(unsigned int j = tree.getLeafBegin(b); j < tree.getLeafEnd(b); ++j)
+			r2 = std::max(r2, (tree.getPoint(j) - blockCenter[b]).norm2()) ;
+		blockRadius[b] = std::sqrt(r2) ;
+	}
+
+	// squared distance of each sourceVector (in the tree order) to its nearest codeVector,
+	// sum and max distance by block
+	std::vector<REAL> dist2(nbSource, std::numeric_limits<REAL>::max()) ;
+	std::vector<double> blockSum(nbBlocks) ;
+	std::vector<REAL> blockMaxDist(nbBlocks, std::numeric_limits<REAL>::max()) ;
+
+	std::mt19937 rng(0) ; // fixed seed : the quantization is reproducible
+	unsigned int chosen = std::uniform_int_distribution<unsigned int>(0, nbSource - 1)(rng) ;
+
+	while(true)
+	{
+		CodeVector<VEC> cv ;
+		cv.v = tree.getPoint(chosen) ;
+		cv.regionNbVectors = 0 ;
+		zero<VEC>(cv.regionVectorsSum) ;
+		cv.regionDistortion = 0.0f ;
+		codeVectors.push_back(cv) ;
+		++nbCodeVectors ;
+
+		for(unsigned int b = 0; b < nbBlocks; ++b)
+		{
+			if(std::sqrt((cv.v - blockCenter[b]).norm2()) - blockRadius[b] >= blockMaxDist[b])
+				continue ;
+			double sum = 0.0 ;
+			REAL maxDist2 = 0 ;
+			for(unsigned int j = tree.getLeafBegin(b); j < tree.getLeafEnd(b); ++j)
+			{
+				REAL d2 = (tree.getPoint(j) - cv.v).norm2() ;
+				if(d2 < dist2[j])
+					dist2[j] = d2 ;
+				sum += dist2[j] ;
+				maxDist2 = std::max(maxDist2, dist2[j]) ;
+			}
+			blockSum[b] = sum ;
+			blockMaxDist[b] = std::sqrt(maxDist2) ;
+		}
+
+		double total = 0.0 ;
+		for(unsigned int b = 0; b < nbBlocks; ++b)
+			total += blockSum[b] ;
+
+		if(nbCodeVectors >= nbRegions || total <= 0.0) // (all distinct sourceVectors are codeVectors)
+			break ;
+
+		// choose the next codeVector
+		double r = std::uniform_real_distribution<double>(0.0, total)(rng) ;
+		unsigned int b = 0 ;
+		unsigned int lastB = 0 ;
+		for( ; b < nbBlocks; ++b)
+		{
+			if(blockSum[b] <= 0.0)
+				continue ;
+			lastB = b ;
+			if(r < blockSum[b])
+				break ;
+			r -= blockSum[b] ;
+		}
+		if(b == nbBlocks) // rounding errors
+			b = lastB ;
+		chosen = tree.getLeafBegin(b) ;
+		for(unsigned int j = tree.getLeafBegin(b); j < tree.getLeafEnd(b); ++j)
+		{
+			if(dist2[j] <= 0)
+				continue ;
+			chosen = j ;
+			if(r < dist2[j])
+				break ;
+			r -= dist2[j] ;
+		}
+	}
+
+	// the seeds are not the centroids of their regions : the Lloyd iteration must not stop before updating them
+	distortion = std::numeric_limits<float>::max() ;
+}
+
 // Scalar quantization
 //template <typename VEC>
 //void Quantization<VEC>::scalarQuantization(unsigned int nbCodeVectors, std::vector<VEC>& result)
@@ -186,6 +341,7 @@ void Quantization<VEC>::vectorQuantizationInit()
 {
 	codeVectors.clear() ;
 	nbCodeVectors = 0 ;
+	assigned = false ;
 	distortion = 0.0f ;
 	// compute the average distortion
 	for(unsigned int i = 0; i < sourceVectors.size(); ++i)
@@ -212,33 +368,10 @@ void Quantization<VEC>::vectorQuantizationNbRegions(unsigned int nbRegions, std:
 	// do not want to have more codeVectors than sourceVectors
 	nbRegions = nbRegions > uint32(sourceVectors.size()) ? uint32(sourceVectors.size()) : nbRegions;
 
-	VEC eps ;
-	set<VEC>(eps, epsSplitVector) ;
-	while(nbCodeVectors < nbRegions)
-	{
-		unsigned int nbNewCV = nbCodeVectors / 3 + 1 ;
-		if(nbCodeVectors + nbNewCV > nbRegions)
-			nbNewCV = nbRegions - nbCodeVectors ;
-		CodeVectorID lastOldCV = --codeVectors.end() ;
-		CodeVectorID cv = codeVectors.begin() ;
-		unsigned int nbAddedCV = 0 ;
-		do
-		{
-			if(cv->regionNbVectors > 1)
-			{
-				CodeVector<VEC> newCV = (*cv) ;
-				newCV.v -= eps ;
-				cv->v += eps ;
-				codeVectors.push_back(newCV) ;
-				++nbCodeVectors ;
-				++nbAddedCV ;
-			}
-			++cv ;
-		} while(nbAddedCV < nbNewCV && cv != lastOldCV) ;
-
-		// Lloyd Iteration
-		algoLloydMax() ;
-	}
+	// initial codebook with all the codeVectors, refined by a single Lloyd iteration
+	if(nbRegions > 1)
+		seedCodeVectors(nbRegions) ;
+	algoLloydMax() ;
 
 	result.resize(sourceVectors.size()) ;
 	for(unsigned int i = 0; i < sourceVectors.size() ; ++i)
@@ -284,6 +417,23 @@ void Quantization<VEC>::vectorQuantizationDistortion(float distortionGoal, std::
 	computeDiscreteEntropy() ;
 }
 
+template <typename VEC>
+void Quantization<VEC>::getCodebook(std::vector<VEC>& codebook, std::vector<unsigned int>& indices)
+{
+	std::map<const CodeVector<VEC>*, unsigned int> index ;
+	codebook.clear() ;
+	codebook.reserve(nbCodeVectors) ;
+	for(CodeVectorID cv = codeVectors.begin(); cv != codeVectors.end(); ++cv)
+	{
+		index[&(*cv)] = uint32(codebook.size()) ;
+		codebook.push_back(cv->v) ;
+	}
+
+	indices.resize(associatedCodeVectors.size()) ;
+	for(unsigned int i = 0; i < associatedCodeVectors.size(); ++i)
+		indices[i] = index[&(*associatedCodeVectors[i])] ;
+}
+
 inline float log2(float x)
 {
     return log(x) / log(2.0f) ;
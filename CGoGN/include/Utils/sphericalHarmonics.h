@@ -8,9 +8,11 @@
 #ifndef __SPHERICALHARMONICS_H__
 #define __SPHERICALHARMONICS_H__
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 #include <Eigen/Core>
 #include <Eigen/Dense>
@@ -58,6 +60,11 @@ public :
 	Tcoef evaluate_at (Tscalar theta, Tscalar phi, unsigned int threadId = 0) const;               // eval spherical coordinates
 	Tcoef evaluate_at (Tscalar x, Tscalar y, Tscalar z, unsigned int threadId = 0) const;          // eval cartesian coordinates
 
+	// batch evaluation (no static state : can be called concurrently)
+	// the basis values are stored coefficient by coefficient (SoA) : basis[i*n + p] is the value of the i-th function at direction p
+	static void evaluate_basis (unsigned int n, const Tscalar* x, const Tscalar* y, const Tscalar* z, Tscalar* basis) ; // basis values at n directions (unit vectors)
+	void evaluate_batch (unsigned int n, const Tscalar* basis, Tcoef* result) const ;                                   // eval at n directions whose basis values are given
+
 	// I/O
 	const Tcoef& get_coef (int l, int m) const {assert ((l>=0 && l <=resolution) || !" maybe you forgot to call set_level()"); assert (m >= (-l) && m <= l); return get_coef(index(l,m));}
 	Tcoef& get_coef (int l, int m) {assert ((l>=0 && l <=resolution) || !" maybe you forgot to call set_level()"); assert (m >= (-l) && m <= l); return get_coef(index(l,m));}
@@ -79,6 +86,23 @@ public :
 //	static void copy_K_tab (Tscalar tab[]) ; // obsolete, was used for shaders
 
 	// fitting
+	// buffers of the fitting, reused from one call to the other (use one workspace per thread)
+	struct FitWorkspace
+	{
+		std::vector<Tscalar> directions ;
+		std::vector<Tscalar> basis ;
+		Eigen::MatrixXd mM ;
+		Eigen::MatrixXd mRGB ;
+		Eigen::MatrixXd mA ;
+		Eigen::MatrixXd mB ;
+	} ;
+
+	template <typename Tdirection, typename Tchannel>
+	void fit_to_data(int n, Tdirection* t_theta, Tdirection* t_phi, Tchannel* t_R, Tchannel* t_G, Tchannel* t_B, double lambda, FitWorkspace& ws);
+	template <typename Tdirection, typename Tchannel>
+	void fit_to_data(int n, Tdirection* t_x, Tdirection* t_y, Tdirection* t_z, Tchannel* t_R, Tchannel* t_G, Tchannel* t_B, double lambda, FitWorkspace& ws);
+
+	// threadId is not used anymore (kept for compatibility) : these versions allocate their own workspace
 	template <typename Tdirection, typename Tchannel>
 	void fit_to_data(int n, Tdirection* t_theta, Tdirection* t_phi, Tchannel* t_R, Tchannel* t_G, Tchannel* t_B, double lambda, unsigned int threadId = 0);
 	template <typename Tdirection, typename Tchannel>
@@ -95,9 +119,9 @@ private :
 	const Tcoef& get_coef (int i) const {assert ((i>=0 && i<nb_coefs ) || !" maybe you forgot to call set_level()"); return coefs[i];}
 	Tcoef& get_coef (int i) {assert ((i>=0 && i<nb_coefs ) || !" maybe you forgot to call set_level()"); return coefs[i];}
 
-	// fitting
+	// fitting (ws.basis contains the basis functions values, evaluated for all directions)
 	template <typename Tchannel>
-	void fit_to_data(int n, Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic>& mM, Tchannel* t_R, Tchannel* t_G, Tchannel* t_B, double lambda);
+	void fit_to_basis(int n, Tchannel* t_R, Tchannel* t_G, Tchannel* t_B, double lambda, FitWorkspace& ws);
 };
 
 } // namespace Utils
@@ -125,6 +125,110 @@ Tcoef SphericalHarmonics<Tscalar,Tcoef>::evaluate_at (Tscalar x, Tscalar y, Tsca
 	return evaluate(threadId);
 }
 
+template <typename Tscalar,typename Tcoef>
+void SphericalHarmonics<Tscalar,Tcoef>::evaluate_basis (unsigned int n, const Tscalar* x, const Tscalar* y, const Tscalar* z, Tscalar* basis)
+{
+	assert ( (nb_coefs > 0) || !" maybe you forgot to call set_level()");
+
+	// same computation as compute_P_tab and compute_y_tab, done for all directions at each step
+	// (the inner loops run over the directions and can be vectorized)
+
+	std::vector<Tscalar> work(5*n);
+	Tscalar* sin_theta = &work[0];
+	Tscalar* cos_phi = sin_theta + n;
+	Tscalar* sin_phi = cos_phi + n;
+	Tscalar* cos_m_phi = sin_phi + n;
+	Tscalar* sin_m_phi = cos_m_phi + n;
+
+	for (unsigned int p = 0; p < n; ++p)
+	{
+		sin_theta[p] = std::sqrt(std::max(Tscalar(0), 1 - z[p]*z[p]));
+		Tscalar r2 = x[p]*x[p] + y[p]*y[p];
+		Tscalar r = std::sqrt(r2);
+		cos_phi[p] = r2 > 0 ? x[p] / r : Tscalar(1);
+		sin_phi[p] = r2 > 0 ? y[p] / r : Tscalar(0);
+	}
+
+	// Legendre polynomials (m >= 0)
+	Tscalar* b00 = basis + index(0,0)*n;
+	for (unsigned int p = 0; p < n; ++p)
+		b00[p] = 1;
+	for (int l = 1; l <= resolution; l++)
+	{
+		const Tscalar* bpp = basis + index(l-1,l-1)*n;
+		Tscalar* bll = basis + index(l,l)*n;
+		Tscalar* bll1 = basis + index(l,l-1)*n;
+		const Tscalar a = Tscalar(1-2*l);
+		const Tscalar b = Tscalar(2*l-1);
+		for (unsigned int p = 0; p < n; ++p)
+		{
+			bll[p] = a * sin_theta[p] * bpp[p];	// first diago
+			bll1[p] = b * z[p] * bpp[p];		// second diago
+		}
+		for (int m = 0; m <= l-2; m++)
+		{
+			const Tscalar* b1 = basis + index(l-1,m)*n;
+			const Tscalar* b2 = basis + index(l-2,m)*n;
+			Tscalar* blm = basis + index(l,m)*n;
+			const Tscalar c1 = Tscalar(2*l-1) / Tscalar(l-m);
+			const Tscalar c2 = Tscalar(l+m-1) / Tscalar(l-m);
+			for (unsigned int p = 0; p < n; ++p)
+				blm[p] = c1 * z[p] * b1[p] - c2 * b2[p];
+		}
+	}
+
+	// real basis functions
+	for (int l = 0; l <= resolution; l++)
+	{
+		Tscalar* bl0 = basis + index(l,0)*n;
+		const Tscalar k = K_tab[index(l,0)];
+		for (unsigned int p = 0; p < n; ++p)
+			bl0[p] *= k;
+	}
+
+	for (unsigned int p = 0; p < n; ++p)
+	{
+		cos_m_phi[p] = 1;
+		sin_m_phi[p] = 0;
+	}
+	for (int m = 1; m <= resolution; m++)
+	{
+		for (unsigned int p = 0; p < n; ++p)
+		{
+			Tscalar c = cos_m_phi[p] * cos_phi[p] - sin_m_phi[p] * sin_phi[p];
+			Tscalar s = sin_m_phi[p] * cos_phi[p] + cos_m_phi[p] * sin_phi[p];
+			cos_m_phi[p] = c;
+			sin_m_phi[p] = s;
+		}
+		for (int l = m; l <= resolution; l++)
+		{
+			Tscalar* blm = basis + index(l,m)*n;
+			Tscalar* bl_m = basis + index(l,-m)*n;
+			const Tscalar k = Tscalar(M_SQRT2) * K_tab[index(l,m)];
+			for (unsigned int p = 0; p < n; ++p)
+			{
+				Tscalar v = k * blm[p];
+				bl_m[p] = v * sin_m_phi[p];
+				blm[p] = v * cos_m_phi[p];
+			}
+		}
+	}
+}
+
+template <typename Tscalar,typename Tcoef>
+void SphericalHarmonics<Tscalar,Tcoef>::evaluate_batch (unsigned int n, const Tscalar* basis, Tcoef* result) const
+{
+	for (unsigned int p = 0; p < n; ++p)
+		result[p] = Tcoef(0);
+	for (int i = 0; i < nb_coefs; i++)
+	{
+		const Tcoef c = coefs[i];
+		const Tscalar* b = basis + i*n;
+		for (unsigned int p = 0; p < n; ++p)
+			result[p] += c * b[p];
+	}
+}
+
 template <typename Tscalar,typename Tcoef>
 void SphericalHarmonics<Tscalar,Tcoef>::init_K_tab ()
 {
@@ -293,19 +397,23 @@ void SphericalHarmonics<Tscalar,Tcoef>::fit_to_data(
 	Tdirection* t_theta, Tdirection* t_phi,
 	Tchannel* t_R, Tchannel* t_G, Tchannel* t_B,
 	double lambda,
-	unsigned int threadId)
+	FitWorkspace& ws)
 {
-	Eigen::MatrixXd mM (nb_coefs,n); // matrix with basis function values, evaluated for all directions
-	// compute mM
+	// convert to cartesian coordinates
+	ws.directions.resize(3*n);
+	Tscalar* x = &ws.directions[0];
+	Tscalar* y = x + n;
+	Tscalar* z = y + n;
 	for (int p = 0; p < n; ++p)
 	{
-		set_eval_direction(t_theta[p], t_phi[p], threadId);
-		for (int i = 0; i < nb_coefs; ++i)
-		{
-			mM(i,p) = F_tab[threadId][i];
-		}
+		Tscalar st = std::sin(Tscalar(t_theta[p]));
+		x[p] = st * std::cos(Tscalar(t_phi[p]));
+		y[p] = st * std::sin(Tscalar(t_phi[p]));
+		z[p] = std::cos(Tscalar(t_theta[p]));
 	}
-	fit_to_data(n, mM, t_R, t_G, t_B, lambda);
+	ws.basis.resize(nb_coefs*n);
+	evaluate_basis(n, x, y, z, &ws.basis[0]);
+	fit_to_basis(n, t_R, t_G, t_B, lambda, ws);
 }
 
 template <typename Tscalar,typename Tcoef>
@@ -315,88 +423,93 @@ void SphericalHarmonics<Tscalar,Tcoef>::fit_to_data(
 	Tdirection* t_x, Tdirection* t_y, Tdirection* t_z,
 	Tchannel* t_R, Tchannel* t_G, Tchannel* t_B,
 	double lambda,
-	unsigned int threadId)
+	FitWorkspace& ws)
 {
-	Eigen::MatrixXd mM (nb_coefs,n); // matrix with basis function values, evaluated for all directions
-	// compute mM
-	for (int p=0; p<n; ++p)
+	ws.directions.resize(3*n);
+	Tscalar* x = &ws.directions[0];
+	Tscalar* y = x + n;
+	Tscalar* z = y + n;
+	for (int p = 0; p < n; ++p)
 	{
-		set_eval_direction(t_x[p],t_y[p],t_z[p], threadId);
-		for (int i=0; i<nb_coefs; ++i)
-		{
-			mM(i,p) = F_tab[threadId][i];
-		}
+		x[p] = Tscalar(t_x[p]);
+		y[p] = Tscalar(t_y[p]);
+		z[p] = Tscalar(t_z[p]);
 	}
-	fit_to_data(n, mM, t_R, t_G, t_B, lambda);
+	ws.basis.resize(nb_coefs*n);
+	evaluate_basis(n, x, y, z, &ws.basis[0]);
+	fit_to_basis(n, t_R, t_G, t_B, lambda, ws);
 }
 
 template <typename Tscalar,typename Tcoef>
-template <typename Tchannel>
+template <typename Tdirection, typename Tchannel>
 void SphericalHarmonics<Tscalar,Tcoef>::fit_to_data(
 	int n,
-	Eigen::MatrixXd& mM,
+	Tdirection* t_theta, Tdirection* t_phi,
 	Tchannel* t_R, Tchannel* t_G, Tchannel* t_B,
-	double lambda)
+	double lambda,
+	unsigned int /*threadId*/)
+{
+	FitWorkspace ws;
+	fit_to_data(n, t_theta, t_phi, t_R, t_G, t_B, lambda, ws);
+}
+
+template <typename Tscalar,typename Tcoef>
+template <typename Tdirection, typename Tchannel>
+void SphericalHarmonics<Tscalar,Tcoef>::fit_to_data(
+	int n,
+	Tdirection* t_x, Tdirection* t_y, Tdirection* t_z,
+	Tchannel* t_R, Tchannel* t_G, Tchannel* t_B,
+	double lambda,
+	unsigned int /*threadId*/)
+{
+	FitWorkspace ws;
+	fit_to_data(n, t_x, t_y, t_z, t_R, t_G, t_B, lambda, ws);
+}
+
+template <typename Tscalar,typename Tcoef>
+template <typename Tchannel>
+void SphericalHarmonics<Tscalar,Tcoef>::fit_to_basis(
+	int n,
+	Tchannel* t_R, Tchannel* t_G, Tchannel* t_B,
+	double lambda,
+	FitWorkspace& ws)
 {
 	// fits the data t_R, t_G and t_B, according to our 2013 CGF paper
-	// mM contains basis function values, (already) evaluated for all input directions
+	// ws.basis contains basis function values, (already) evaluated for all input directions
 	// works only for 3 channels
 
-	// allocate the memory
-	Eigen::MatrixXd mA (nb_coefs, nb_coefs); // matrix A in linear system AC=B
-	Eigen::MatrixXd mB (nb_coefs, 3); // matrix B in linear system AC=B : contains [t_R, t_G, t_B]
-	Eigen::MatrixXd mC (nb_coefs, 3); // matrix C (solution) in linear system AC=B : contains the RGB coefs of the resulting SH
+	// matrix with basis function values (one line per function)
+	typedef Eigen::Matrix<Tscalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> BasisMatrix;
+	ws.mM = Eigen::Map<const BasisMatrix>(&ws.basis[0], nb_coefs, n).template cast<double>();
 
-	// compute mA
-	for (int i = 0; i < nb_coefs; ++i)
+	// data matrix : contains [t_R, t_G, t_B]
+	ws.mRGB.resize(n, 3);
+	for (int p = 0; p < n; ++p)
 	{
-		for (int j = 0; j < nb_coefs; ++j)
-		{
-			mA(i,j) = 0;
-			for (int p = 0; p < n; ++p)
-			{
-				mA(i,j) += mM(i,p) * mM(j,p);
-			}
-			mA(i,j) *= (1.0-lambda) / n;
-		}
+		ws.mRGB(p,0) = t_R[p];
+		ws.mRGB(p,1) = t_G[p];
+		ws.mRGB(p,2) = t_B[p];
 	}
 
+	// compute matrix A in linear system AC=B
+	ws.mA.noalias() = ws.mM * ws.mM.transpose();
+	ws.mA *= (1.0-lambda) / n;
 	for (int l = 0; l <= resolution; ++l)
 	{
 		for (int m =- l; m <= l; ++m)
 		{
 			int i = index(l,m);
-			mA(i,i) += lambda * l * (l+1) / (4.0*M_PI);
-		}
-	}
-
-	// compute mB
-	for (int i = 0; i < nb_coefs; ++i)
-	{
-		mB(i,0) = 0.0;
-		mB(i,1) = 0.0;
-		mB(i,2) = 0.0;
-		for (int p = 0; p < n; ++p)
-		{
-			mB(i,0) += mM(i,p) * t_R[p];
-			mB(i,1) += mM(i,p) * t_G[p];
-			mB(i,2) += mM(i,p) * t_B[p];
+			ws.mA(i,i) += lambda * l * (l+1) / (4.0*M_PI);
 		}
-		mB(i,0) *= (1.0-lambda) / n;
-		mB(i,1) *= (1.0-lambda) / n;
-		mB(i,2) *= (1.0-lambda) / n;
 	}
 
-	// solve the system with LDLT decomposition
-	Eigen::LDLT<Eigen::MatrixXd> solver (mA);
-	mC = solver.solve(mB);
+	// compute matrix B in linear system AC=B
+	ws.mB.noalias() = ws.mM * ws.mRGB;
+	ws.mB *= (1.0-lambda) / n;
 
-//	std::cout << "phi = " << mM << std::endl;
-//	std::cout << mA << std::endl;
-//	std::cout << "*" << std::endl;
-//	std::cout << mC << std::endl;
-//	std::cout << "=" << std::endl;
-//	std::cout << mB << std::endl;
+	// solve the system with LDLT decomposition : matrix C contains the RGB coefs of the resulting SH
+	Eigen::LDLT<Eigen::MatrixXd> solver (ws.mA);
+	Eigen::MatrixXd mC = solver.solve(ws.mB);
 
 	// store result in the SH
 	// it is assumed that Tcoef is VEC3 actually
@@ -204,16 +204,17 @@ protected:
 		m_data_size = NB_COMPONENTS;
 
 		// alloue la memoire pour le buffer et initialise le conv
-		T_OUT* typedBuffer = new T_OUT[_BLOCKSIZE_];
+		const unsigned int blockSize = attrib->getBlockSize();
+		T_OUT* typedBuffer = new T_OUT[blockSize];
 
 		std::vector<void*> addr;
 		unsigned int byteTableSize;
 		unsigned int nbb = attrib->getBlocksPointers(addr, byteTableSize);
 
-		m_nbElts = nbb * _BLOCKSIZE_/(sizeof(T_OUT));
+		m_nbElts = nbb * blockSize/(sizeof(T_OUT));
 
 		unsigned int offset = 0;
-		unsigned int szb = _BLOCKSIZE_*sizeof(T_OUT);
+		unsigned int szb = blockSize*sizeof(T_OUT);
 
 		// bind buffer to update
 		glBindBuffer(GL_ARRAY_BUFFER, *m_id);
@@ -226,7 +227,7 @@ protected:
 			const T_IN* typedIn = reinterpret_cast<const T_IN*>(addr[i]);
 			T_OUT* typedOut = typedBuffer;
 			// compute conversion
-			for (unsigned int j = 0; j < _BLOCKSIZE_; ++j)
+			for (unsigned int j = 0; j < blockSize; ++j)
 				*typedOut++ = conv(*typedIn++);
 
 			// update sub-vbo
@@ -26,6 +26,8 @@
 
 #include "Algo/Histogram/histogram.h"
 
+#include <algorithm>
+
 
 namespace CGoGN
 {
@@ -44,6 +46,7 @@ void Histogram::initDataConvert(const AttributeConvertGen& conv)
 	m_max = m_min;
 
 	m_dataIdx.reserve(conv.nbElements());
+	m_dataIdx.clear();
 	for (unsigned int i = beg; i!= conv.end(); conv.next(i))
 	{
 		double val = conv[i];
@@ -54,6 +57,9 @@ void Histogram::initDataConvert(const AttributeConvertGen& conv)
 			m_max = val;
 	}
 
+	m_qmin = m_min;
+	m_qmax = m_max;
+
 	m_hcolmap.setMin(m_min);
 	m_hcolmap.setMax(m_max);
 }
@@ -71,18 +77,22 @@ void Histogram::populateHisto(unsigned int nbclasses)
 	//compute width interv
 	m_interWidth = (m_max-m_min)/double(m_nbclasses);
 
-	// init to zero
-	m_populations.resize(m_nbclasses);
-	for (unsigned int i = 0; i<m_nbclasses; ++i)
-		m_populations[i] = 0;
+	// traverse attribute to populate (one vector of population per thread)
+	unsigned int nbth = nbThreads();
+	std::vector< std::vector<unsigned int> > threadPop(nbth, std::vector<unsigned int>(m_nbclasses, 0));
 
-	// traverse attribute to populate
-	for (std::vector<std::pair<double,unsigned int> >::const_iterator it = m_dataIdx.begin(); it != m_dataIdx.end(); ++it)
+	Parallel::foreach_index(0, uint32(m_dataIdx.size()), [&] (unsigned int i, unsigned int th)
 	{
-		unsigned int c = whichClass(it->first);
+		unsigned int c = whichClass(data(i));
 		if (c != 0xffffffff)
-			m_populations[c]++;
-	}
+			threadPop[th][c]++;
+	}, nbth);
+
+	// sum populations of threads
+	m_populations.swap(threadPop[0]);
+	for (unsigned int t = 1; t < nbth; ++t)
+		for (unsigned int i = 0; i<m_nbclasses; ++i)
+			m_populations[i] += threadPop[t][i];
     m_maxBar = 0;
     for (unsigned int i = 0; i<m_nbclasses; ++i)
     {
@@ -98,12 +108,6 @@ void Histogram::populateHisto(unsigned int nbclasses)
 
 void Histogram::populateQuantiles(unsigned int nbquantiles)
 {
-	if (!m_sorted)
-	{
-		std::sort(m_dataIdx.begin(),m_dataIdx.end(),dataComp);
-		m_sorted = true;
-	}
-
 	// compute exact populations
 	size_t nb = m_dataIdx.size();
 	double pop = double(nb)/nbquantiles;
@@ -112,25 +116,159 @@ void Histogram::populateQuantiles(unsigned int nbquantiles)
 	for (unsigned int i = 0; i < nbquantiles; ++i)
 		m_pop_quantiles[i]=pop;
 
+	// ranks needed by quantiles computation
+	std::vector<unsigned int> ranks;
+	ranks.reserve(2*nbquantiles);
+	double cumul = 0.0;
+	for (unsigned int i = 0; i < nbquantiles; ++i)
+	{
+		cumul += m_pop_quantiles[i];
+		uint32 icum = uint32(floor(cumul));
+		if (icum < uint32(nb-1))
+		{
+			ranks.push_back(icum);
+			ranks.push_back(icum+1);
+		}
+	}
+
+	std::vector<double> values;
+	selectRanks(ranks, values);
+
 	m_interv.clear();
 	m_interv.reserve(nbquantiles+1);
 	// quantiles computation
-	m_interv.push_back(m_dataIdx.front().first);
-	double cumul = 0.0;
+	m_interv.push_back(m_qmin);
+	cumul = 0.0;
+	unsigned int r = 0;
 	for (unsigned int i = 0; i < nbquantiles; ++i)
 	{
 		cumul += m_pop_quantiles[i];
 		uint32 icum = uint32(floor(cumul));
 		double val = 0.0;
-		if (icum < uint32(m_dataIdx.size()-1))
-			val = (data(icum)+ data(icum+1)) / 2.0;
+		if (icum < uint32(nb-1))
+		{
+			val = (values[r] + values[r+1]) / 2.0;
+			r += 2;
+		}
 		else
-			val = m_dataIdx.back().first;
+			val = m_qmax;
 		m_interv.push_back(val);
 	}
 	quantilesAreaCorrection();
 }
 
+void Histogram::populateQuantilesApprox(unsigned int nbquantiles, unsigned int sketchSize)
+{
+	size_t nb = m_dataIdx.size();
+	double pop = double(nb)/nbquantiles;
+	m_pop_quantiles.assign(nbquantiles, pop);
+
+	// one sketch per thread, merged at the end
+	unsigned int nbth = nbThreads();
+	std::vector<QuantileSketch> sketches(nbth, QuantileSketch(sketchSize));
+
+	Parallel::foreach_index(0, uint32(nb), [&] (unsigned int i, unsigned int th)
+	{
+		sketches[th].insert(data(i));
+	}, nbth);
+
+	for (unsigned int t = 1; t < nbth; ++t)
+		sketches[0].merge(sketches[t]);
+
+	std::vector<double> q(nbquantiles-1);
+	for (unsigned int i = 1; i < nbquantiles; ++i)
+		q[i-1] = double(i)/double(nbquantiles);
+	std::vector<double> values;
+	sketches[0].quantiles(q, values);
+
+	m_interv.clear();
+	m_interv.reserve(nbquantiles+1);
+	m_interv.push_back(m_qmin);
+	for (unsigned int i = 0; i < values.size(); ++i)
+		m_interv.push_back(values[i]);
+	m_interv.push_back(m_qmax);
+
+	quantilesAreaCorrection();
+}
+
+void Histogram::selectRanks(const std::vector<unsigned int>& ranks, std::vector<double>& values) const
+{
+	values.resize(ranks.size());
+	if (ranks.empty())
+		return;
+
+	unsigned int nb = uint32(m_dataIdx.size());
+	if (m_qmax <= m_qmin)
+	{
+		values.assign(ranks.size(), m_qmin);
+		return;
+	}
+
+	// fine histogram on [qmin,qmax] (class function is monotonous)
+	unsigned int nbc = std::max(1u, std::min(nb / 16, 65536u));
+	double w = (m_qmax - m_qmin) / double(nbc);
+	auto classOf = [&] (double v) -> unsigned int
+	{
+		unsigned int c = uint32((v - m_qmin) / w);
+		return c < nbc ? c : nbc - 1;
+	};
+
+	unsigned int nbth = nbThreads();
+	std::vector< std::vector<unsigned int> > threadPop(nbth, std::vector<unsigned int>(nbc, 0));
+	Parallel::foreach_index(0, nb, [&] (unsigned int i, unsigned int th)
+	{
+		threadPop[th][classOf(data(i))]++;
+	}, nbth);
+
+	// first rank of each class
+	std::vector<unsigned int> first(nbc+1, 0);
+	for (unsigned int c = 0; c < nbc; ++c)
+	{
+		unsigned int p = 0;
+		for (unsigned int t = 0; t < nbth; ++t)
+			p += threadPop[t][c];
+		first[c+1] = first[c] + p;
+	}
+
+	// classes that contain the ranks (slot in gathering, or -1)
+	std::vector<int> slot(nbc, -1);
+	std::vector<unsigned int> rankClass(ranks.size());
+	unsigned int nbSlots = 0;
+	for (unsigned int r = 0; r < ranks.size(); ++r)
+	{
+		unsigned int c = uint32(std::upper_bound(first.begin(), first.end(), ranks[r]) - first.begin()) - 1;
+		rankClass[r] = c;
+		if (slot[c] < 0)
+			slot[c] = int(nbSlots++);
+	}
+
+	// gather values of these classes
+	std::vector< std::vector< std::vector<double> > > threadGather(nbth, std::vector< std::vector<double> >(nbSlots));
+	Parallel::foreach_index(0, nb, [&] (unsigned int i, unsigned int th)
+	{
+		double v = data(i);
+		int s = slot[classOf(v)];
+		if (s >= 0)
+			threadGather[th][s].push_back(v);
+	}, nbth);
+
+	std::vector< std::vector<double> > gathered(nbSlots);
+	gathered.swap(threadGather[0]);
+	for (unsigned int t = 1; t < nbth; ++t)
+		for (unsigned int s = 0; s < nbSlots; ++s)
+			gathered[s].insert(gathered[s].end(), threadGather[t][s].begin(), threadGather[t][s].end());
+
+	// selection inside each gathered class
+	for (unsigned int r = 0; r < ranks.size(); ++r)
+	{
+		unsigned int c = rankClass[r];
+		std::vector<double>& g = gathered[slot[c]];
+		std::vector<double>::iterator nth = g.begin() + (ranks[r] - first[c]);
+		std::nth_element(g.begin(), nth, g.end());
+		values[r] = *nth;
+	}
+}
+
 
  void Histogram::quantilesAreaCorrection()
 {
@@ -162,38 +300,46 @@ void Histogram::histoColorizeVBO(Utils::VBO& vbo)
 	vbo.setDataSize(3);
 	vbo.allocate(nb);
 	Geom::Vec3f* colors = static_cast<Geom::Vec3f*>(vbo.lockPtr());
-	for (unsigned int i = 0; i<nb; ++i)
+	// no GL call in threads, only writing in mapped memory
+	Parallel::foreach_index(0, nb, [&] (unsigned int i, unsigned int)
 	{
-		unsigned int j = idx(i);
 		unsigned int c = whichClass(data(i));
 		if (c != 0xffffffff)
-			colors[j] = m_hcolmap.colorIndex(c);
-	}
+			colors[idx(i)] = m_hcolmap.colorIndex(c);
+	}, nbThreads());
 	vbo.releasePtr();
 }
 
-
-unsigned int Histogram::cellsOfHistogramColumn(unsigned int c, std::vector<unsigned int>& vc) const
+void Histogram::quantilesColorizeVBO(Utils::VBO& vbo, const std::vector<Geom::Vec3f>& tc)
 {
-	if (!m_sorted)
+	assert(tc.size() >= m_interv.size() - 1);
+
+	unsigned int nb = uint32(m_dataIdx.size());
+	vbo.setDataSize(3);
+	vbo.allocate(nb);
+	Geom::Vec3f* colors = static_cast<Geom::Vec3f*>(vbo.lockPtr());
+	Parallel::foreach_index(0, nb, [&] (unsigned int i, unsigned int)
 	{
-		std::sort(m_dataIdx.begin(),m_dataIdx.end(),dataComp);
-		m_sorted = true;
-	}
+		colors[idx(i)] = tc[whichQuantille(data(i))];
+	}, nbThreads());
+	vbo.releasePtr();
+}
 
+
+unsigned int Histogram::cellsOfHistogramColumn(unsigned int c, std::vector<unsigned int>& vc) const
+{
 	vc.clear();
 
 	double bi = (m_max-m_min)/m_nbclasses * c + m_min;
 	double bs = (m_max-m_min)/m_nbclasses * (c+1) + m_min;
 
 	unsigned int nb = uint32(m_dataIdx.size());
-	unsigned int i=0;
-
-	while ((i<nb) && (data(i)< bi))
-		++i;
-
-	while ((i<nb) && (data(i)< bs))
-		vc.push_back(idx(i++));
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		double v = data(i);
+		if ((v >= bi) && (v < bs))
+			vc.push_back(idx(i));
+	}
 
 	return uint32(vc.size());
 }
@@ -206,13 +352,12 @@ unsigned int Histogram::cellsOfQuantilesColumn(unsigned int c, std::vector<unsig
 	double bs = m_interv[c+1];
 
 	unsigned int nb = uint32(m_dataIdx.size());
-	unsigned int i=0;
-
-	while ((i<nb) && (data(i)< bi))
-		++i;
-
-	while ((i<nb) && (data(i)< bs))
-		vc.push_back(idx(i++));
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		double v = data(i);
+		if ((v >= bi) && (v < bs))
+			vc.push_back(idx(i));
+	}
 
 	return uint32(vc.size());
 }
@@ -0,0 +1,168 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#define CGoGN_ALGO_DLL_EXPORT 1
+
+#include "Algo/Histogram/quantileSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Histogram
+{
+
+QuantileSketch::QuantileSketch(unsigned int k):
+	m_k(std::max(k, 8u)),
+	m_levels(1),
+	m_n(0),
+	m_size(0),
+	m_random(0x9e3779b9u)
+{
+}
+
+unsigned int QuantileSketch::capacity(unsigned int level) const
+{
+	// capacities decrease geometrically (by 2/3) from the top level
+	unsigned int depth = (unsigned int)(m_levels.size()) - 1 - level;
+	unsigned int c = (unsigned int)(std::ceil(m_k * std::pow(2.0 / 3.0, double(depth))));
+	return std::max(c, 2u);
+}
+
+unsigned int QuantileSketch::maxSize() const
+{
+	unsigned int s = 0;
+	for (unsigned int h = 0; h < m_levels.size(); ++h)
+		s += capacity(h);
+	return s;
+}
+
+bool QuantileSketch::randomBit()
+{
+	// xorshift32
+	m_random ^= m_random << 13;
+	m_random ^= m_random >> 17;
+	m_random ^= m_random << 5;
+	return (m_random & 1u) != 0;
+}
+
+void QuantileSketch::compress()
+{
+	while (m_size > maxSize())
+	{
+		// compact the lowest full level
+		for (unsigned int h = 0; h < m_levels.size(); ++h)
+		{
+			if (m_levels[h].size() < capacity(h))
+				continue;
+
+			if (h + 1 == m_levels.size())
+				m_levels.push_back(std::vector<double>());
+
+			std::vector<double>& level = m_levels[h];
+			std::sort(level.begin(), level.end());
+
+			// an odd value is kept in the level
+			unsigned int nb = (unsigned int)(level.size()) & ~1u;
+			unsigned int offset = randomBit() ? 1 : 0;
+			std::vector<double>& upper = m_levels[h + 1];
+			for (unsigned int i = offset; i < nb; i += 2)
+				upper.push_back(level[i]);
+
+			level.erase(level.begin(), level.begin() + nb);
+			m_size -= nb / 2;
+			break;
+		}
+	}
+}
+
+void QuantileSketch::insert(double val)
+{
+	m_levels[0].push_back(val);
+	++m_n;
+	++m_size;
+	if (m_size > maxSize())
+		compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch& qs)
+{
+	if (qs.m_levels.size() > m_levels.size())
+		m_levels.resize(qs.m_levels.size());
+	for (unsigned int h = 0; h < qs.m_levels.size(); ++h)
+		m_levels[h].insert(m_levels[h].end(), qs.m_levels[h].begin(), qs.m_levels[h].end());
+	m_n += qs.m_n;
+	m_size += qs.m_size;
+	compress();
+}
+
+double QuantileSketch::quantile(double q) const
+{
+	std::vector<double> qv(1, q);
+	std::vector<double> values;
+	quantiles(qv, values);
+	return values[0];
+}
+
+void QuantileSketch::quantiles(const std::vector<double>& q, std::vector<double>& values) const
+{
+	values.assign(q.size(), 0.0);
+	if (m_size == 0)
+		return;
+
+	// weighted values sorted
+	std::vector< std::pair<double, uint64_t> > weighted;
+	weighted.reserve(m_size);
+	for (unsigned int h = 0; h < m_levels.size(); ++h)
+		for (unsigned int i = 0; i < m_levels[h].size(); ++i)
+			weighted.push_back(std::make_pair(m_levels[h][i], uint64_t(1) << h));
+	std::sort(weighted.begin(), weighted.end());
+
+	uint64_t total = 0;
+	for (unsigned int i = 0; i < weighted.size(); ++i)
+		total += weighted[i].second;
+
+	// first value whose cumulated weight reaches the rank
+	for (unsigned int j = 0; j < q.size(); ++j)
+	{
+		double target = std::min(std::max(q[j], 0.0), 1.0) * double(total);
+		uint64_t cumul = 0;
+		unsigned int i = 0;
+		while (i < weighted.size() - 1 && double(cumul + weighted[i].second) < target)
+			cumul += weighted[i++].second;
+		values[j] = weighted[i].first;
+	}
+}
+
+} // namespace Histogram
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -645,6 +645,11 @@ bool ImplicitHierarchicalMap3::volumeIsSubdivided(Dart d)
 	if(vLevel < m_curLevel)
 		return false;
 
+	// the faces of a subdivided volume are subdivided (edges cut by a
+	// subdivided neighbour would be taken for the inner faces otherwise)
+	if(!faceIsSubdivided(d))
+		return false;
+
 	bool subd = false;
 
 	++m_curLevel;
@@ -0,0 +1,476 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#define CGoGN_ALGO_DLL_EXPORT 1
+
+#include "Algo/Import/importChunked.h"
+
+#include <fstream>
+#include <cstdlib>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define CGOGN_IMPORT_MMAP 1
+#endif
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Volume
+{
+
+namespace Import
+{
+
+/**************************************
+ *            MAPPED FILE             *
+ **************************************/
+
+MappedFile::MappedFile():
+	m_data(NULL),
+	m_size(0),
+	m_mapping(NULL)
+{}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string& filename)
+{
+	close();
+
+#ifdef CGOGN_IMPORT_MMAP
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if ((fstat(fd, &st) == 0) && (st.st_size > 0))
+	{
+		void* ptr = mmap(NULL, std::size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (ptr != MAP_FAILED)
+		{
+			madvise(ptr, std::size_t(st.st_size), MADV_SEQUENTIAL);
+			m_mapping = ptr;
+			m_data = static_cast<const char*>(ptr);
+			m_size = std::size_t(st.st_size);
+		}
+	}
+	::close(fd);
+	if (m_mapping != NULL)
+		return true;
+#endif
+
+	// no mapping available: read the file in one block
+	std::ifstream fp(filename.c_str(), std::ios::in | std::ios::binary);
+	if (!fp.good())
+		return false;
+	fp.seekg(0, std::ios::end);
+	std::streamoff len = fp.tellg();
+	fp.seekg(0, std::ios::beg);
+	if (len < 0)
+		return false;
+	m_buffer.resize(std::size_t(len) + 1);
+	fp.read(&m_buffer[0], len);
+	m_buffer[std::size_t(len)] = '\0';
+	m_data = &m_buffer[0];
+	m_size = std::size_t(len);
+	return true;
+}
+
+void MappedFile::close()
+{
+#ifdef CGOGN_IMPORT_MMAP
+	if (m_mapping != NULL)
+		munmap(m_mapping, m_size);
+#endif
+	m_mapping = NULL;
+	m_data = NULL;
+	m_size = 0;
+	std::vector<char>().swap(m_buffer);
+}
+
+/**************************************
+ *             VTU READER             *
+ **************************************/
+
+namespace
+{
+
+typedef std::vector<std::pair<std::string, std::string> > XMLAttributes;
+
+const std::string& attributeValue(const XMLAttributes& attrs, const char* name)
+{
+	static const std::string none;
+	for (XMLAttributes::const_iterator it = attrs.begin(); it != attrs.end(); ++it)
+		if (it->first == name)
+			return it->second;
+	return none;
+}
+
+inline bool isXMLSpace(char c)
+{
+	return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+}
+
+inline bool isNameChar(char c)
+{
+	return !isXMLSpace(c) && (c != '>') && (c != '/') && (c != '=');
+}
+
+const char* find(const char* p, const char* end, const char* s)
+{
+	const std::size_t n = std::strlen(s);
+	while (p + n <= end)
+	{
+		p = static_cast<const char*>(std::memchr(p, s[0], std::size_t(end - p)));
+		if ((p == NULL) || (p + n > end))
+			return end;
+		if (std::memcmp(p, s, n) == 0)
+			return p;
+		++p;
+	}
+	return end;
+}
+
+/**
+ * read the name and attributes of the tag opened at p ('<' excluded)
+ * @return position after the '>' of the tag (end if the tag is not closed)
+ */
+const char* readTag(const char* p, const char* end, std::string& name, XMLAttributes& attrs, bool& selfClosing)
+{
+	attrs.clear();
+	selfClosing = false;
+
+	const char* q = p;
+	while ((q < end) && isNameChar(*q))
+		++q;
+	name.assign(p, q);
+
+	while (q < end)
+	{
+		while ((q < end) && isXMLSpace(*q))
+			++q;
+		if (q >= end)
+			break;
+		if (*q == '>')
+			return q + 1;
+		if (*q == '/')
+		{
+			selfClosing = true;
+			++q;
+			continue;
+		}
+
+		const char* n = q;
+		while ((q < end) && isNameChar(*q))
+			++q;
+		std::string attName(n, q);
+		while ((q < end) && isXMLSpace(*q))
+			++q;
+		if ((q >= end) || (*q != '='))
+		{
+			if (q == n) // unexpected char
+				++q;
+			continue;
+		}
+		++q;
+		while ((q < end) && isXMLSpace(*q))
+			++q;
+		if ((q >= end) || ((*q != '"') && (*q != '\'')))
+			continue;
+		const char quote = *q++;
+		const char* v = q;
+		while ((q < end) && (*q != quote))
+			++q;
+		attrs.push_back(std::make_pair(attName, std::string(v, q)));
+		if (q < end)
+			++q;
+	}
+	return end;
+}
+
+} // namespace
+
+VTUReader::VTUReader():
+	m_end(NULL),
+	m_nbPoints(0),
+	m_nbCells(0),
+	m_swap(false),
+	m_headerSize(4),
+	m_appendedBase64(false),
+	m_appended(NULL)
+{}
+
+VTUReader::DataType VTUReader::dataType(const std::string& s)
+{
+	if ((s == "Int8") || (s == "Char")) return VTU_INT8;
+	if ((s == "UInt8") || (s == "UChar")) return VTU_UINT8;
+	if ((s == "Int16") || (s == "Short")) return VTU_INT16;
+	if ((s == "UInt16") || (s == "UShort")) return VTU_UINT16;
+	if ((s == "Int32") || (s == "Int")) return VTU_INT32;
+	if ((s == "UInt32") || (s == "UInt")) return VTU_UINT32;
+	if ((s == "Int64") || (s == "Long")) return VTU_INT64;
+	if ((s == "UInt64") || (s == "ULong")) return VTU_UINT64;
+	if ((s == "Float32") || (s == "Float")) return VTU_FLOAT32;
+	if ((s == "Float64") || (s == "Double")) return VTU_FLOAT64;
+	return VTU_UNKNOWN;
+}
+
+unsigned int VTUReader::typeSize(DataType t)
+{
+	switch (t)
+	{
+		case VTU_INT8:
+		case VTU_UINT8:
+			return 1;
+		case VTU_INT16:
+		case VTU_UINT16:
+			return 2;
+		case VTU_INT32:
+		case VTU_UINT32:
+		case VTU_FLOAT32:
+			return 4;
+		case VTU_INT64:
+		case VTU_UINT64:
+		case VTU_FLOAT64:
+			return 8;
+		default:
+			return 0;
+	}
+}
+
+bool VTUReader::parse(const char* begin, const char* end)
+{
+	m_end = end;
+	m_nbPoints = 0;
+	m_nbCells = 0;
+	m_swap = false;
+	m_headerSize = 4;
+	m_appendedBase64 = false;
+	m_appended = NULL;
+	m_points = DataArray();
+	m_connectivity = DataArray();
+	m_offsets = DataArray();
+	m_types = DataArray();
+	m_error.clear();
+
+	const unsigned short one = 1;
+	const bool hostLittleEndian = (*reinterpret_cast<const unsigned char*>(&one) == 1);
+
+	bool gridFound = false;
+	bool pieceFound = false;
+	bool inPiece = false;
+	std::vector<std::string> opened;
+	std::string name;
+	XMLAttributes attrs;
+
+	const char* p = begin;
+	while (p < end)
+	{
+		p = static_cast<const char*>(std::memchr(p, '<', std::size_t(end - p)));
+		if (p == NULL)
+			break;
+
+		if (startsWith(p, end, "<?"))
+		{
+			p = find(p, end, "?>");
+			continue;
+		}
+		if (startsWith(p, end, "<!--"))
+		{
+			p = find(p, end, "-->");
+			continue;
+		}
+		if (startsWith(p, end, "<!"))
+		{
+			p = find(p, end, ">");
+			continue;
+		}
+
+		bool selfClosing;
+		if (startsWith(p, end, "</"))
+		{
+			p = readTag(p + 2, end, name, attrs, selfClosing);
+			if (!opened.empty())
+				opened.pop_back();
+			if (name == "Piece")
+				inPiece = false;
+			continue;
+		}
+
+		p = readTag(p + 1, end, name, attrs, selfClosing);
+		const std::string parent = opened.empty() ? std::string() : opened.back();
+
+		if (name == "VTKFile")
+		{
+			if (attributeValue(attrs, "type") != "UnstructuredGrid")
+			{
+				m_error = "not an UnstructuredGrid";
+				return false;
+			}
+			if (!attributeValue(attrs, "compressor").empty())
+			{
+				m_error = "compressed data not supported";
+				return false;
+			}
+			const std::string& order = attributeValue(attrs, "byte_order");
+			m_swap = (order == "BigEndian") ? hostLittleEndian : ((order == "LittleEndian") && !hostLittleEndian);
+			if (attributeValue(attrs, "header_type") == "UInt64")
+				m_headerSize = 8;
+		}
+		else if (name == "UnstructuredGrid")
+			gridFound = true;
+		else if ((name == "Piece") && !pieceFound)
+		{
+			pieceFound = true;
+			inPiece = !selfClosing;
+			m_nbPoints = unsigned(std::strtoul(attributeValue(attrs, "NumberOfPoints").c_str(), NULL, 10));
+			m_nbCells = unsigned(std::strtoul(attributeValue(attrs, "NumberOfCells").c_str(), NULL, 10));
+		}
+		else if (name == "DataArray")
+		{
+			DataArray a;
+			a.type = dataType(attributeValue(attrs, "type"));
+			const std::string& nbc = attributeValue(attrs, "NumberOfComponents");
+			if (!nbc.empty())
+				a.nbComponents = unsigned(std::strtoul(nbc.c_str(), NULL, 10));
+			const std::string& format = attributeValue(attrs, "format");
+			if (format == "binary")
+				a.format = VTU_BINARY;
+			else if (format == "appended")
+			{
+				a.format = VTU_APPENDED;
+				a.offset = std::size_t(std::strtoull(attributeValue(attrs, "offset").c_str(), NULL, 10));
+			}
+
+			if (!selfClosing)
+			{
+				// content holds no '<' (ascii or base64)
+				a.begin = p;
+				p = static_cast<const char*>(std::memchr(p, '<', std::size_t(end - p)));
+				if (p == NULL)
+					p = end;
+				a.end = p;
+			}
+
+			if (inPiece)
+			{
+				const std::string& arrayName = attributeValue(attrs, "Name");
+				if ((parent == "Points") && !m_points.isValid())
+					m_points = a;
+				else if (parent == "Cells")
+				{
+					if (arrayName == "connectivity")
+						m_connectivity = a;
+					else if (arrayName == "offsets")
+						m_offsets = a;
+					else if (arrayName == "types")
+						m_types = a;
+				}
+			}
+		}
+		else if (name == "AppendedData")
+		{
+			const std::string& encoding = attributeValue(attrs, "encoding");
+			m_appendedBase64 = (encoding != "raw");
+			// raw data may contain any byte: stop scanning here
+			p = static_cast<const char*>(std::memchr(p, '_', std::size_t(end - p)));
+			if (p != NULL)
+				m_appended = p + 1;
+			break;
+		}
+
+		if (!selfClosing)
+			opened.push_back(name);
+	}
+
+	if (!gridFound || !pieceFound)
+		m_error = "no UnstructuredGrid Piece";
+	else if (!m_points.isValid() || (m_points.nbComponents != 3))
+		m_error = "missing or invalid Points";
+	else if (!m_connectivity.isValid() || !m_offsets.isValid() || !m_types.isValid())
+		m_error = "missing or invalid Cells";
+	else if ((m_points.format == VTU_APPENDED || m_connectivity.format == VTU_APPENDED ||
+			  m_offsets.format == VTU_APPENDED || m_types.format == VTU_APPENDED) && (m_appended == NULL))
+		m_error = "missing AppendedData";
+
+	return m_error.empty();
+}
+
+bool VTUReader::dataStream(const DataArray& a, const char*& data, const char*& dataEnd, bool& base64, std::size_t& offset) const
+{
+	if (a.format == VTU_BINARY)
+	{
+		data = a.begin;
+		dataEnd = a.end;
+		while ((data < dataEnd) && isXMLSpace(*data))
+			++data;
+		base64 = true;
+	}
+	else if (a.format == VTU_APPENDED)
+	{
+		if ((m_appended == NULL) || (a.offset >= std::size_t(m_end - m_appended)))
+			return false;
+		data = m_appended + a.offset;
+		dataEnd = m_end;
+		base64 = m_appendedBase64;
+	}
+	else
+		return false;
+
+	if (!base64)
+	{
+		offset = m_headerSize;
+		return true;
+	}
+
+	// the byte count header is either encoded with the data
+	// or in its own base64 block (then ended by padding)
+	const std::size_t headerChars = 4 * ((m_headerSize + 2) / 3);
+	if ((std::size_t(dataEnd - data) > headerChars) && (data[headerChars - 1] == '='))
+	{
+		data += headerChars;
+		offset = 0;
+	}
+	else
+		offset = m_headerSize;
+	return true;
+}
+
+} // namespace Import
+
+} // namespace Volume
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -43,7 +43,11 @@ namespace CGoGN
 	m_size(0),
 	m_maxSize(0),
 	m_lineCost(0),
-	m_attributes_registry_map(NULL)
+	m_attributes_registry_map(NULL),
+	m_allocator(BlockAllocator::defaultAllocator()),
+	m_blockSize(_BLOCKSIZE_),
+	m_blockShift(blockSizeShift(_BLOCKSIZE_)),
+	m_blockMask(_BLOCKSIZE_ - 1)
 {
 	m_holesBlocks.reserve(512);
 }
@@ -154,6 +158,74 @@ namespace CGoGN
 	temp = m_lineCost;
 	m_lineCost = cont.m_lineCost;
 	cont.m_lineCost = temp;
+
+	std::swap(m_allocator, cont.m_allocator);
+	std::swap(m_blockSize, cont.m_blockSize);
+	std::swap(m_blockShift, cont.m_blockShift);
+	std::swap(m_blockMask, cont.m_blockMask);
+}
+
+ bool AttributeContainer::setBlockAllocator(BlockAllocator* alloc)
+{
+	if (!m_holesBlocks.empty())
+	{
+		CGoGNerr << "setBlockAllocator: container has already allocated blocks" << CGoGNendl;
+		return false;
+	}
+
+	m_allocator = alloc;
+
+	for (unsigned int i = 0; i < m_tableAttribs.size(); ++i)
+	{
+		if (m_tableAttribs[i] != NULL)
+			m_tableAttribs[i]->setBlockAllocator(alloc);
+	}
+	// markers keep their blocks after a clear(false): release them with their allocator
+	for (unsigned int i = 0; i < m_tableMarkerAttribs.size(); ++i)
+	{
+		if (m_tableMarkerAttribs[i] != NULL)
+		{
+			m_tableMarkerAttribs[i]->clear();
+			m_tableMarkerAttribs[i]->setBlockAllocator(alloc);
+		}
+	}
+
+	return true;
+}
+
+ bool AttributeContainer::setBlockSize(unsigned int bs)
+{
+	if (!validBlockSize(bs))
+	{
+		CGoGNerr << "setBlockSize: block size must be a power of 2 in [" << _MIN_BLOCKSIZE_ << "," << _MAX_BLOCKSIZE_ << "]" << CGoGNendl;
+		return false;
+	}
+	if (!m_holesBlocks.empty())
+	{
+		CGoGNerr << "setBlockSize: container has already allocated blocks" << CGoGNendl;
+		return false;
+	}
+
+	m_blockSize = bs;
+	m_blockShift = blockSizeShift(bs);
+	m_blockMask = bs - 1;
+
+	for (unsigned int i = 0; i < m_tableAttribs.size(); ++i)
+	{
+		if (m_tableAttribs[i] != NULL)
+			m_tableAttribs[i]->setBlockSize(bs);
+	}
+	// markers keep their blocks after a clear(false)
+	for (unsigned int i = 0; i < m_tableMarkerAttribs.size(); ++i)
+	{
+		if (m_tableMarkerAttribs[i] != NULL)
+		{
+			m_tableMarkerAttribs[i]->clear();
+			m_tableMarkerAttribs[i]->setBlockSize(bs);
+		}
+	}
+
+	return true;
 }
 
  void AttributeContainer::clear(bool removeAttrib)
@@ -269,13 +341,13 @@ namespace CGoGN
 	m_tableBlocksWithFree.clear();
 
 	// compute nb block full
-	unsigned int nbb = m_size / _BLOCKSIZE_;
+	unsigned int nbb = m_size >> m_blockShift;
 	// update holeblock
 	for (unsigned int i=0; i<nbb; ++i)
-		m_holesBlocks[i]->compressFull(_BLOCKSIZE_);
+		m_holesBlocks[i]->compressFull(m_blockSize);
 
 	//update last holeblock
-	unsigned int nbe = m_size % _BLOCKSIZE_;
+	unsigned int nbe = m_size & m_blockMask;
 	if (nbe != 0)
 	{
 		m_holesBlocks[nbb]->compressFull(nbe);
@@ -298,6 +370,86 @@ namespace CGoGN
 }
 
 
+ void AttributeContainer::reserve(unsigned int nb)
+{
+	reserveBlocks(nb, true);
+}
+
+unsigned int AttributeContainer::reserveFirstTouch(unsigned int nb)
+{
+	if (!m_allocator->isFirstTouch())
+	{
+		reserveBlocks(nb, true);
+		return getNbBlocks();
+	}
+	return reserveBlocks(nb, false);
+}
+
+void AttributeContainer::initBlock(unsigned int b)
+{
+	for(unsigned int i = 0; i < m_tableAttribs.size(); ++i)
+	{
+		if (m_tableAttribs[i] != NULL)
+			m_tableAttribs[i]->initBlock(b);
+	}
+	for(unsigned int i = 0; i < m_tableMarkerAttribs.size(); ++i)
+	{
+		if (m_tableMarkerAttribs[i] != NULL)
+			m_tableMarkerAttribs[i]->initBlock(b);
+	}
+}
+
+unsigned int AttributeContainer::getNbBlocks() const
+{
+	return uint32(m_holesBlocks.size());
+}
+
+unsigned int AttributeContainer::reserveBlocks(unsigned int nb, bool init)
+{
+	// lines already available in allocated blocks
+	unsigned int nbFree = uint32(m_holesBlocks.size()) * m_blockSize - m_size;
+	if (nb <= nbFree)
+		return uint32(m_holesBlocks.size());
+
+	unsigned int nbBlocks = uint32(m_holesBlocks.size()) + ((nb - nbFree + m_blockSize - 1) >> m_blockShift);
+	unsigned int firstNew = uint32(m_holesBlocks.size());
+
+	m_holesBlocks.reserve(nbBlocks);
+	for (unsigned int i = firstNew; i < nbBlocks; ++i)
+		m_holesBlocks.push_back(new HoleBlockRef(m_blockSize));
+
+	// new blocks are filled after the blocks that have already free lines (back of table is used first)
+	std::vector<unsigned int> bwf;
+	bwf.reserve(nbBlocks - firstNew + m_tableBlocksWithFree.size());
+	for (unsigned int i = nbBlocks; i > firstNew; --i)
+		bwf.push_back(i - 1);
+	bwf.insert(bwf.end(), m_tableBlocksWithFree.begin(), m_tableBlocksWithFree.end());
+	m_tableBlocksWithFree.swap(bwf);
+
+	for(unsigned int i = 0; i < m_tableAttribs.size(); ++i)
+	{
+		if (m_tableAttribs[i] != NULL)
+		{
+			if (init)
+				m_tableAttribs[i]->setNbBlocks(nbBlocks);
+			else
+				m_tableAttribs[i]->allocBlocks(nbBlocks);
+		}
+	}
+	for(unsigned int i = 0; i < m_tableMarkerAttribs.size(); ++i)
+	{
+		if (m_tableMarkerAttribs[i] != NULL)
+		{
+			if (init)
+				m_tableMarkerAttribs[i]->setNbBlocks(nbBlocks);
+			else
+				m_tableMarkerAttribs[i]->allocBlocks(nbBlocks);
+		}
+	}
+
+	return firstNew;
+}
+
 /**************************************
  *          LINES MANAGEMENT          *
  **************************************/
@@ -307,7 +459,7 @@ namespace CGoGN
 //	// if no more rooms
 //	if (m_tableBlocksWithFree.empty())
 //	{
-//		HoleBlockRef* ptr = new HoleBlockRef();					// new block
+//		HoleBlockRef* ptr = new HoleBlockRef(m_blockSize);					// new block
 //		m_tableBlocksWithFree.push_back(m_holesBlocks.size());	// add its future position to block_free
 //		m_holesBlocks.push_back(ptr);							// and add it to block table
 
@@ -344,7 +496,7 @@ namespace CGoGN
 	// if no more rooms
 	if (m_tableBlocksWithFree.empty())
 	{
-		HoleBlockRef* ptr = new HoleBlockRef();					// new block
+		HoleBlockRef* ptr = new HoleBlockRef(m_blockSize);					// new block
 		unsigned int numBlock = uint32(m_holesBlocks.size());
 		m_tableBlocksWithFree.push_back(numBlock);	// add its future position to block_free
 		m_holesBlocks.push_back(ptr);							// and add it to block table
@@ -368,7 +520,7 @@ namespace CGoGN
 		// add new element in block and compute index
 
 		unsigned int ne = ptr->newRefElt(m_maxSize);
-		return _BLOCKSIZE_ * numBlock + ne;
+		return m_blockSize * numBlock + ne;
 	}
 	// else
 
@@ -379,14 +531,14 @@ namespace CGoGN
 
 	// add new element in block and compute index
 	unsigned int ne = block->newRefElt(m_maxSize);
-	unsigned int index = _BLOCKSIZE_ * bf + ne;
+	unsigned int index = m_blockSize * bf + ne;
 
-	if (ne == _BLOCKSIZE_-1)
+	if (ne == m_blockSize-1)
 	{
 		if (bf == (m_holesBlocks.size()-1))
 		{
 			// we are filling the last line of capacity
-			HoleBlockRef* ptr = new HoleBlockRef();					// new block
+			HoleBlockRef* ptr = new HoleBlockRef(m_blockSize);					// new block
 			unsigned int numBlock = uint32(m_holesBlocks.size());
 			m_tableBlocksWithFree.back() = numBlock;
 			m_tableBlocksWithFree.push_back(bf);
@@ -413,11 +565,67 @@ namespace CGoGN
 	return index;
 }
 
+ bool AttributeContainer::insertLines(unsigned int nb, std::vector<unsigned int>& lines)
+{
+	if (nb == 0)
+		return true;
+
+	// all blocks allocated at once
+	reserve(nb);
+
+	unsigned int first = uint32(lines.size());
+	lines.resize(first + nb);
+
+	bool contiguous = true;
+	unsigned int n = 0;
+	while (n < nb)
+	{
+		// get the first free block index (last in vector)
+		unsigned int bf = m_tableBlocksWithFree.back();
+		HoleBlockRef* block = m_holesBlocks[bf];
+
+		unsigned int* indices = &lines[first + n];
+		unsigned int nbb = block->newRefElts(nb - n, m_maxSize, indices);
+		for (unsigned int i = 0; i < nbb; ++i)
+		{
+			indices[i] += m_blockSize * bf;
+			contiguous = contiguous && (indices[i] == lines[first] + n + i);
+		}
+		n += nbb;
+
+		// if no more room in block remove it from free_blocks
+		if (block->full())
+			m_tableBlocksWithFree.pop_back();
+	}
+	m_size += nb;
+
+	// as in insertLine, keep room after the last line of capacity
+	if (m_holesBlocks.back()->sizeTable() == m_blockSize)
+	{
+		unsigned int numBlock = uint32(m_holesBlocks.size());
+		m_holesBlocks.push_back(new HoleBlockRef(m_blockSize));
+		m_tableBlocksWithFree.push_back(numBlock);
+
+		for(unsigned int i = 0; i < m_tableAttribs.size(); ++i)
+		{
+			if (m_tableAttribs[i] != NULL)
+				m_tableAttribs[i]->addBlock();
+		}
+		for(unsigned int i = 0; i < m_tableMarkerAttribs.size(); ++i)
+		{
+			if (m_tableMarkerAttribs[i] != NULL)
+				m_tableMarkerAttribs[i]->addBlock();
+		}
+	}
+
+	return contiguous;
+}
+
 
  void AttributeContainer::removeLine(unsigned int index)
 {
-	unsigned int bi = index / _BLOCKSIZE_;
-	unsigned int j = index % _BLOCKSIZE_;
+	unsigned int bi = index >> m_blockShift;
+	unsigned int j = index & m_blockMask;
 
 	HoleBlockRef* block = m_holesBlocks[bi];
 
@@ -469,7 +677,7 @@ namespace CGoGN
 	bufferui.reserve(10);
 
 	bufferui.push_back(id);
-	bufferui.push_back(_BLOCKSIZE_);
+	bufferui.push_back(m_blockSize);
 	bufferui.push_back(uint32(m_holesBlocks.size()));
 	bufferui.push_back(uint32(m_tableBlocksWithFree.size()));
 	bufferui.push_back(uint32(bufferamv.size()));
@@ -541,9 +749,10 @@ namespace CGoGN
 	m_nbUnknown = bufferui[7];
 
 
-	if (bs != _BLOCKSIZE_)
+	// the container takes the block size of the file
+	if (bs != m_blockSize && !setBlockSize(bs))
 	{
-		CGoGNerr << "Loading unavailable, different block sizes: "<<_BLOCKSIZE_<<" / " << bs << CGoGNendl;
+		CGoGNerr << "Loading unavailable, different block sizes: "<<m_blockSize<<" / " << bs << CGoGNendl;
 		return false;
 	}
 
@@ -581,7 +790,7 @@ namespace CGoGN
 	// blocks
 	for (unsigned int i = 0; i < szHB; ++i)
 	{
-		m_holesBlocks[i] = new HoleBlockRef;
+		m_holesBlocks[i] = new HoleBlockRef(m_blockSize);
 		m_holesBlocks[i]->loadBin(fs);
 	}
 
@@ -602,6 +811,9 @@ namespace CGoGN
 	m_nbUnknown = cont.m_nbUnknown;
 	m_nbAttributes = cont.m_nbAttributes;
 	m_lineCost = cont.m_lineCost;
+	m_blockSize = cont.m_blockSize;
+	m_blockShift = cont.m_blockShift;
+	m_blockMask = cont.m_blockMask;
 
 	// blocks
 	unsigned int sz = uint32(cont.m_holesBlocks.size());
@@ -638,6 +850,8 @@ namespace CGoGN
 			ptr->setName(cont.m_tableAttribs[i]->getName());
 			ptr->setOrbit(cont.m_tableAttribs[i]->getOrbit());
 			ptr->setIndex(uint32(m_tableAttribs.size()));
+			ptr->setBlockAllocator(m_allocator);
+			ptr->setBlockSize(m_blockSize);
 			ptr->setNbBlocks(cont.m_tableAttribs[i]->getNbBlocks());
 			ptr->copy(cont.m_tableAttribs[i]);
 			m_tableAttribs.push_back(ptr);
@@ -651,6 +865,8 @@ namespace CGoGN
 		ptr->setName(cont.m_tableMarkerAttribs[i]->getName());
 		ptr->setOrbit(cont.m_tableMarkerAttribs[i]->getOrbit());
 		ptr->setIndex(uint32(m_tableMarkerAttribs.size()));
+		ptr->setBlockAllocator(m_allocator);
+		ptr->setBlockSize(m_blockSize);
 		ptr->setNbBlocks(cont.m_tableMarkerAttribs[i]->getNbBlocks());
 		ptr->copy(cont.m_tableMarkerAttribs[i]);
 		m_tableMarkerAttribs.push_back(ptr);
@@ -803,6 +1019,8 @@ namespace CGoGN
 
 	amv->setOrbit(m_orbit) ;
 	amv->setIndex(index) ;
+	amv->setBlockAllocator(m_allocator) ;
+	amv->setBlockSize(m_blockSize) ;
 
 	// resize the new attribute so that it has the same size than others
 	amv->setNbBlocks(uint32(m_holesBlocks.size())) ;
@@ -1151,7 +1369,7 @@ namespace CGoGN
 //	//	// if no more rooms
 //	//	if (m_tableBlocksWithFree.empty())
 //	//	{
-//	//		HoleBlockRef* ptr = new HoleBlockRef();					// new block
+//	//		HoleBlockRef* ptr = new HoleBlockRef(m_blockSize);					// new block
 //	//		m_tableBlocksWithFree.push_back(m_holesBlocks.size());	// add its future position to block_free
 //	//		m_holesBlocks.push_back(ptr);							// and add it to block table
 //
@@ -1188,7 +1406,7 @@ namespace CGoGN
 //		// if no more rooms
 //		if (m_tableBlocksWithFree.empty())
 //		{
-//			HoleBlockRef* ptr = new HoleBlockRef();					// new block
+//			HoleBlockRef* ptr = new HoleBlockRef(m_blockSize);					// new block
 //			unsigned int numBlock = uint32(m_holesBlocks.size());
 //			m_tableBlocksWithFree.push_back(numBlock);	// add its future position to block_free
 //			m_holesBlocks.push_back(ptr);							// and add it to block table
@@ -1230,7 +1448,7 @@ namespace CGoGN
 //			if (bf == (m_holesBlocks.size() - 1))
 //			{
 //				// we are filling the last line of capacity
-//				HoleBlockRef* ptr = new HoleBlockRef();					// new block
+//				HoleBlockRef* ptr = new HoleBlockRef(m_blockSize);					// new block
 //				unsigned int numBlock = uint32(m_holesBlocks.size());
 //				m_tableBlocksWithFree.back() = numBlock;
 //				m_tableBlocksWithFree.push_back(bf);
@@ -0,0 +1,286 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Container/blockAllocator.h"
+
+#include <new>
+#include <string>
+#include <sstream>
+#include <fstream>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace CGoGN
+{
+
+/// alignment of blocks cut in arenas
+static const std::size_t ARENA_ALIGN = 64;
+
+BlockAllocator* BlockAllocator::defaultAllocator()
+{
+	static HeapBlockAllocator heap;
+	return &heap;
+}
+
+/**************************************
+ *                HEAP                *
+ **************************************/
+
+void* HeapBlockAllocator::allocate(std::size_t nbBytes)
+{
+	return ::operator new(nbBytes);
+}
+
+void HeapBlockAllocator::deallocate(void* ptr, std::size_t /*nbBytes*/)
+{
+	::operator delete(ptr);
+}
+
+/**************************************
+ *               ARENAS               *
+ **************************************/
+
+ArenaBlockAllocator::ArenaBlockAllocator(std::size_t arenaSize) :
+	m_arenaSize(arenaSize),
+	m_current(NULL),
+	m_remaining(0)
+{}
+
+ArenaBlockAllocator::~ArenaBlockAllocator()
+{
+	releaseAll();
+}
+
+char* ArenaBlockAllocator::newArena(std::size_t& size)
+{
+#ifdef __linux__
+	void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (ptr == MAP_FAILED)
+		throw std::bad_alloc();
+	return static_cast<char*>(ptr);
+#else
+	return static_cast<char*>(::operator new(size));
+#endif
+}
+
+void ArenaBlockAllocator::releaseArena(char* ptr, std::size_t size)
+{
+#ifdef __linux__
+	munmap(ptr, size);
+#else
+	(void)size;
+	::operator delete(ptr);
+#endif
+}
+
+void* ArenaBlockAllocator::allocate(std::size_t nbBytes)
+{
+	nbBytes = (nbBytes + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// reuse a released block
+	std::map<std::size_t, std::vector<void*> >::iterator it = m_freeBlocks.find(nbBytes);
+	if (it != m_freeBlocks.end() && !it->second.empty())
+	{
+		void* ptr = it->second.back();
+		it->second.pop_back();
+		return ptr;
+	}
+
+	// large block: its own arena
+	if (nbBytes > m_arenaSize)
+	{
+		Arena a;
+		a.size = nbBytes;
+		a.ptr = newArena(a.size);
+		m_arenas.push_back(a);
+		return a.ptr;
+	}
+
+	// cut in current arena (end of previous arena is lost)
+	if (nbBytes > m_remaining)
+	{
+		Arena a;
+		a.size = m_arenaSize;
+		a.ptr = newArena(a.size);
+		m_arenas.push_back(a);
+		m_current = a.ptr;
+		m_remaining = a.size;
+	}
+
+	void* ptr = m_current;
+	m_current += nbBytes;
+	m_remaining -= nbBytes;
+	return ptr;
+}
+
+void ArenaBlockAllocator::deallocate(void* ptr, std::size_t nbBytes)
+{
+	nbBytes = (nbBytes + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_freeBlocks[nbBytes].push_back(ptr);
+}
+
+std::size_t ArenaBlockAllocator::reservedMemory() const
+{
+	std::size_t total = 0;
+	for (std::vector<Arena>::const_iterator it = m_arenas.begin(); it != m_arenas.end(); ++it)
+		total += it->size;
+	return total;
+}
+
+void ArenaBlockAllocator::releaseAll()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (std::vector<Arena>::iterator it = m_arenas.begin(); it != m_arenas.end(); ++it)
+		releaseArena(it->ptr, it->size);
+	m_arenas.clear();
+	m_freeBlocks.clear();
+	m_current = NULL;
+	m_remaining = 0;
+}
+
+/**************************************
+ *             HUGE PAGES             *
+ **************************************/
+
+HugePageBlockAllocator::HugePageBlockAllocator(unsigned int nbHugePages) :
+	ArenaBlockAllocator(nbHugePages * HUGE_PAGE_SIZE)
+{}
+
+char* HugePageBlockAllocator::newArena(std::size_t& size)
+{
+	size = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+#ifdef __linux__
+	// over-allocate to align the arena on a huge page boundary
+	std::size_t mapped = size + HUGE_PAGE_SIZE;
+	void* ptr = mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (ptr == MAP_FAILED)
+		throw std::bad_alloc();
+
+	char* begin = static_cast<char*>(ptr);
+	char* aligned = reinterpret_cast<char*>((reinterpret_cast<std::size_t>(begin) + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE);
+	if (aligned != begin)
+		munmap(begin, aligned - begin);
+	char* end = begin + mapped;
+	if (aligned + size != end)
+		munmap(aligned + size, end - (aligned + size));
+
+#ifdef MADV_HUGEPAGE
+	madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+	return aligned;
+#else
+	return ArenaBlockAllocator::newArena(size);
+#endif
+}
+
+/**************************************
+ *                NUMA                *
+ **************************************/
+
+NumaBlockAllocator::NumaBlockAllocator(Policy policy, std::size_t arenaSize) :
+	ArenaBlockAllocator(arenaSize),
+	m_policy(policy)
+{}
+
+unsigned int NumaBlockAllocator::getNbNodes()
+{
+	unsigned int nb = 0;
+#ifdef __linux__
+	// nodes are numbered contiguously in sysfs
+	for (;;)
+	{
+		std::stringstream ss;
+		ss << "/sys/devices/system/node/node" << nb << "/cpulist";
+		std::ifstream f(ss.str().c_str());
+		if (!f.good())
+			break;
+		++nb;
+	}
+#endif
+	return nb > 0 ? nb : 1;
+}
+
+std::vector<unsigned int> NumaBlockAllocator::getNodeCpus(unsigned int node)
+{
+	std::vector<unsigned int> cpus;
+#ifdef __linux__
+	// cpulist format: comma separated ranges, i.e. 0-7,16-23
+	std::stringstream ss;
+	ss << "/sys/devices/system/node/node" << node << "/cpulist";
+	std::ifstream f(ss.str().c_str());
+	std::string range;
+	while (std::getline(f, range, ','))
+	{
+		unsigned int first = 0, last = 0;
+		char sep = 0;
+		std::stringstream rs(range);
+		if (!(rs >> first))
+			continue;
+		if (rs >> sep >> last && sep == '-')
+		{
+			for (unsigned int c = first; c <= last; ++c)
+				cpus.push_back(c);
+		}
+		else
+			cpus.push_back(first);
+	}
+#else
+	(void)node;
+#endif
+	return cpus;
+}
+
+char* NumaBlockAllocator::newArena(std::size_t& size)
+{
+	// mmap does not touch the pages: with FIRST_TOUCH nothing more to do
+	char* ptr = ArenaBlockAllocator::newArena(size);
+
+#if defined(__linux__) && defined(SYS_mbind)
+	if (m_policy == INTERLEAVE)
+	{
+		unsigned int nbNodes = getNbNodes();
+		if (nbNodes > 1)
+		{
+			const int MPOL_INTERLEAVE_MODE = 3; // MPOL_INTERLEAVE of linux/mempolicy.h
+			unsigned long mask = 0;
+			for (unsigned int i = 0; i < nbNodes && i < 8 * sizeof(unsigned long); ++i)
+				mask |= 1UL << i;
+			syscall(SYS_mbind, ptr, size, MPOL_INTERLEAVE_MODE, &mask, 8 * sizeof(unsigned long) + 1, 0);
+		}
+	}
+#endif
+
+	return ptr;
+}
+
+} // namespace CGoGN
@@ -25,6 +25,7 @@
 #include "Container/holeblockref.h"
 
 #include <map>
+#include <algorithm>
 #include <string>
 #include <cassert>
 #include <stdio.h>
@@ -37,10 +38,10 @@
 namespace CGoGN
 {
 
-HoleBlockRef::HoleBlockRef() : m_nbfree(0), m_nbref(0), m_nb(0)
+HoleBlockRef::HoleBlockRef(unsigned int blockSize) : m_nbfree(0), m_nbref(0), m_nb(0), m_blockSize(blockSize)
 {
-	m_tableFree = new unsigned int[_BLOCKSIZE_ + 10];
-	m_refCount = new unsigned int[_BLOCKSIZE_];
+	m_tableFree = new unsigned int[m_blockSize + 10];
+	m_refCount = new unsigned int[m_blockSize];
 }
 
 HoleBlockRef::HoleBlockRef(const HoleBlockRef& hb)
@@ -48,12 +49,13 @@ HoleBlockRef::HoleBlockRef(const HoleBlockRef& hb)
 	m_nbfree = hb.m_nbfree;
 	m_nbref = hb.m_nbref;
 	m_nb = hb.m_nb;
+	m_blockSize = hb.m_blockSize;
 
-	m_tableFree = new unsigned int[_BLOCKSIZE_ + 10];
-	memcpy(m_tableFree, hb.m_tableFree, (_BLOCKSIZE_ + 10) * sizeof(unsigned int));
+	m_tableFree = new unsigned int[m_blockSize + 10];
+	memcpy(m_tableFree, hb.m_tableFree, (m_blockSize + 10) * sizeof(unsigned int));
 
-	m_refCount = new unsigned int[_BLOCKSIZE_];
-	memcpy(m_refCount, hb.m_refCount, _BLOCKSIZE_ * sizeof(unsigned int));
+	m_refCount = new unsigned int[m_blockSize];
+	memcpy(m_refCount, hb.m_refCount, m_blockSize * sizeof(unsigned int));
 }
 
 HoleBlockRef::~HoleBlockRef()
@@ -76,6 +78,10 @@ void HoleBlockRef::swap(HoleBlockRef& hb)
 	m_nb = hb.m_nb;
 	hb.m_nb = temp;
 
+	temp = m_blockSize;
+	m_blockSize = hb.m_blockSize;
+	hb.m_blockSize = temp;
+
 	unsigned int* ptr = m_tableFree;
 	m_tableFree = hb.m_tableFree;
 	hb.m_tableFree = ptr;
@@ -107,6 +113,29 @@ unsigned int HoleBlockRef::newRefElt(unsigned int& nbEltsMax)
 	return index;
 }
 
+unsigned int HoleBlockRef::newRefElts(unsigned int nb, unsigned int& nbEltsMax, unsigned int* indices)
+{
+	unsigned int n = 0;
+
+	// reuse the holes
+	while (n < nb && m_nbfree > 0)
+	{
+		unsigned int index = m_tableFree[--m_nbfree];
+		m_refCount[index] = 1;
+		indices[n++] = index;
+	}
+
+	// then add lines at the end of block
+	unsigned int nbEnd = std::min(nb - n, m_blockSize - m_nbref);
+	std::fill(m_refCount + m_nbref, m_refCount + m_nbref + nbEnd, 1u);
+	for (unsigned int i = 0; i < nbEnd; ++i)
+		indices[n++] = m_nbref++;
+
+	m_nb += n;
+	nbEltsMax += nbEnd;
+	return n;
+}
+
 bool  HoleBlockRef::compressFree()
 {
 	if (m_nb)
@@ -162,7 +191,7 @@ void HoleBlockRef::saveBin(CGoGNostream& fs)
 	fs.write(reinterpret_cast<const char*>(numbers), 3*sizeof(unsigned int) );
 
 	// sauve les ref count
-	fs.write(reinterpret_cast<const char*>(m_refCount), _BLOCKSIZE_*sizeof(unsigned int));
+	fs.write(reinterpret_cast<const char*>(m_refCount), m_blockSize*sizeof(unsigned int));
 
 	// sauve les free lines
 	fs.write(reinterpret_cast<const char*>(m_tableFree), m_nbfree*sizeof(unsigned int));
@@ -177,7 +206,7 @@ bool HoleBlockRef::loadBin(CGoGNistream& fs)
 	m_nbref = numbers[1];
 	m_nbfree = numbers[2];
 
-	fs.read(reinterpret_cast<char*>(m_refCount), _BLOCKSIZE_*sizeof(unsigned int));
+	fs.read(reinterpret_cast<char*>(m_refCount), m_blockSize*sizeof(unsigned int));
 	fs.read(reinterpret_cast<char*>(m_tableFree), m_nbfree*sizeof(unsigned int));
 
 	return true;
@@ -30,9 +30,15 @@
 #include "Geometry/vector_gen.h"
 #include "Geometry/matrix.h"
 #include "Container/registered.h"
+#include "Container/blockAllocator.h"
 
 #include <algorithm>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace CGoGN
 {
 
@@ -40,6 +46,61 @@ namespace Parallel
 {
 //int NumberOfThreads=1;
 CGoGN_TOPO_API int NumberOfThreads = getSystemNumberOfCores();
+
+CGoGN_TOPO_API bool PinThreads = false;
+
+// NUMA nodes that have cpus, with their cpus
+typedef std::vector<std::pair<unsigned int, std::vector<unsigned int> > > NumaNodesCpus;
+
+static NumaNodesCpus readNumaNodesCpus()
+{
+	NumaNodesCpus nodes;
+	unsigned int nbNodes = NumaBlockAllocator::getNbNodes();
+	for (unsigned int i = 0; i < nbNodes; ++i)
+	{
+		std::vector<unsigned int> cpus = NumaBlockAllocator::getNodeCpus(i);
+		if (!cpus.empty())
+			nodes.push_back(std::make_pair(i, cpus));
+	}
+	return nodes;
+}
+
+static const NumaNodesCpus& numaNodesCpus()
+{
+	static const NumaNodesCpus nodes = readNumaNodesCpus(); // read once
+	return nodes;
+}
+
+CGoGN_TOPO_API unsigned int numaNodeOfThread(unsigned int id)
+{
+	const NumaNodesCpus& nodes = numaNodesCpus();
+	if (nodes.empty())
+		return 0;
+	return nodes[id % nodes.size()].first;
+}
+
+CGoGN_TOPO_API bool pinThisThread(unsigned int id)
+{
+#ifdef __linux__
+	// the thread may run on any cpu of its node: the scheduler balances
+	// the load inside the node and the pages it first touched stay local
+	const NumaNodesCpus& nodes = numaNodesCpus();
+	if (nodes.empty())
+		return false;
+	const std::vector<unsigned int>& cpus = nodes[id % nodes.size()].second;
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+	for (std::vector<unsigned int>::const_iterator it = cpus.begin(); it != cpus.end(); ++it)
+	{
+		if (*it < CPU_SETSIZE)
+			CPU_SET(*it, &cpuset);
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0;
+#else
+	(void)id;
+	return false;
+#endif
+}
 }
 
 std::map<std::string, RegisteredBaseAttribute*>* GenericMap::m_attributes_registry_map = NULL;
@@ -249,6 +310,28 @@ void GenericMap::clear(bool removeAttrib)
 	}
 }
 
+bool GenericMap::setBlockAllocator(BlockAllocator* alloc)
+{
+	bool ok = true;
+	for(unsigned int i = 0; i < NB_ORBITS; ++i)
+		ok = m_attribs[i].setBlockAllocator(alloc) && ok;
+	return ok;
+}
+
+bool GenericMap::setBlockSize(unsigned int bs)
+{
+	if (!validBlockSize(bs))
+	{
+		CGoGNerr << "setBlockSize: block size must be a power of 2 in [" << _MIN_BLOCKSIZE_ << "," << _MAX_BLOCKSIZE_ << "]" << CGoGNendl;
+		return false;
+	}
+
+	bool ok = true;
+	for(unsigned int i = 0; i < NB_ORBITS; ++i)
+		ok = m_attribs[i].setBlockSize(bs) && ok;
+	return ok;
+}
+
 /****************************************
  *        ATTRIBUTES MANAGEMENT         *
  ****************************************/
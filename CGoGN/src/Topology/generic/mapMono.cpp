@@ -198,6 +198,8 @@ void MapMono::compactTopo()
 	if (fragmentation(DART)==1.0)
 		return;
 
+	++m_topoRevision;
+
 	std::vector<unsigned int> oldnew;
 	m_attribs[DART].compact(oldnew);
 
@@ -25,13 +25,15 @@
 #define CGoGN_TOPO_DLL_EXPORT 1
 
 #include "Topology/ihmap/ihm3.h"
+#include "Topology/generic/parallelLoop.h"
 
 #include <cmath>
 
 namespace CGoGN
 {
 
-ImplicitHierarchicalMap3::ImplicitHierarchicalMap3() : m_curLevel(0), m_maxLevel(0), m_edgeIdCount(0), m_faceIdCount(0)
+ImplicitHierarchicalMap3::ImplicitHierarchicalMap3() : m_curLevel(0), m_maxLevel(0), m_edgeIdCount(0), m_faceIdCount(0),
+	m_levelCacheEnabled(false), m_curLevelCache(NULL), m_levelCacheRevision(0)
 {
     m_dartLevel = Map3::addAttribute<unsigned int, DART, ImplicitHierarchicalMap3>("dartLevel") ;
     m_edgeId = Map3::addAttribute<unsigned int, DART, ImplicitHierarchicalMap3>("edgeId") ;
@@ -43,6 +45,7 @@ ImplicitHierarchicalMap3::ImplicitHierarchicalMap3() : m_curLevel(0), m_maxLevel
 
 ImplicitHierarchicalMap3::~ImplicitHierarchicalMap3()
 {
+    clearLevelCache() ;
     removeAttribute(m_edgeId) ;
     removeAttribute(m_faceId) ;
     removeAttribute(m_dartLevel) ;
@@ -50,6 +53,7 @@ ImplicitHierarchicalMap3::~ImplicitHierarchicalMap3()
 
 void ImplicitHierarchicalMap3::clear(bool removeAttrib)
 {
+    clearLevelCache() ;
     Map3::clear(removeAttrib) ;
     if (removeAttrib)
     {
@@ -86,6 +90,7 @@ void ImplicitHierarchicalMap3::initImplicitProperties()
 
 void ImplicitHierarchicalMap3::initEdgeId()
 {
+    invalidateLevelCache() ;
     DartMarkerStore<Map3> edgeMark(*this) ;
     for(Dart d = Map3::begin(); d != Map3::end(); Map3::next(d))
     {
@@ -110,6 +115,7 @@ void ImplicitHierarchicalMap3::initEdgeId()
 
 void ImplicitHierarchicalMap3::initFaceId()
 {
+    invalidateLevelCache() ;
     DartMarkerStore<Map3> faceMark(*this) ;
     for(Dart d = Map3::begin(); d != Map3::end(); Map3::next(d))
     {
@@ -133,4 +139,68 @@ void ImplicitHierarchicalMap3::initFaceId()
     }
 }
 
+void ImplicitHierarchicalMap3::enableLevelCache(bool b)
+{
+    if (!b)
+    {
+        clearLevelCache() ;
+        return ;
+    }
+    m_levelCacheEnabled = true ;
+    updateCurrentLevelCache() ;
+}
+
+void ImplicitHierarchicalMap3::clearLevelCache()
+{
+    for (unsigned int i = 0; i < m_levelCache.size(); ++i)
+        delete m_levelCache[i] ;
+    m_levelCache.clear() ;
+    m_curLevelCache = NULL ;
+    m_levelCacheEnabled = false ;
+}
+
+void ImplicitHierarchicalMap3::updateCurrentLevelCache()
+{
+    m_curLevelCache = NULL ;
+    if (!m_levelCacheEnabled)
+        return ;
+
+    // the map has been modified since the tables were built
+    if (!m_levelCache.empty() && m_levelCacheRevision != getTopoRevision())
+    {
+        clearLevelCache() ;
+        return ;
+    }
+    m_levelCacheRevision = getTopoRevision() ;
+
+    if (m_curLevel >= m_levelCache.size())
+        m_levelCache.resize(m_curLevel + 1, NULL) ;
+
+    if (m_levelCache[m_curLevel] == NULL)
+    {
+        // phi are computed by walking through finer darts (m_curLevelCache is NULL)
+        AttributeContainer& cont = m_attribs[DART] ;
+        unsigned int end = cont.end() ;
+
+        LevelCache* lc = new LevelCache ;
+        lc->phi1.resize(end, NIL) ;
+        lc->phi_1.resize(end, NIL) ;
+        lc->phi2.resize(end, NIL) ;
+
+        Parallel::foreach_index(cont.begin(), end, [&] (unsigned int i, unsigned int)
+        {
+            if (!cont.used(i) || m_dartLevel[i] > m_curLevel)
+                return ;
+            Dart d(i) ;
+            lc->phi1[i] = phi1(d) ;
+            lc->phi_1[i] = phi_1(d) ;
+            lc->phi2[i] = phi2(d) ;
+        });
+
+        m_levelCache[m_curLevel] = lc ;
+    }
+
+    m_curLevelCache = m_levelCache[m_curLevel] ;
+}
+
 } //namespace CGoGN
@@ -129,6 +129,9 @@ void EmbeddedMap2::splitVertex(Dart d, Dart e)
 		initDartEmbedding<FACE>(phi1(dd), getEmbedding<FACE>(dd)) ;
 		initDartEmbedding<FACE>(phi1(ee), getEmbedding<FACE>(ee)) ;
 	}
+
+	notifyVertexStarChanged(d) ;
+	notifyVertexStarChanged(e) ;
 }
 
 Dart EmbeddedMap2::deleteVertex(Dart d)
@@ -140,6 +143,7 @@ Dart EmbeddedMap2::deleteVertex(Dart d)
 		{
 			Algo::Topo::setOrbitEmbedding<FACE>(*this, f, getEmbedding<FACE>(f)) ;
 		}
+		notifyVertexStarChanged(f) ;
 	}
 	return f ;
 }
@@ -161,6 +165,8 @@ void EmbeddedMap2::mergeOppositeVertices(Dart d)
 		copyDartEmbedding<EDGE>(phi2(d2), d2) ;
 		copyDartEmbedding<EDGE>(phi2(d_12), d_12) ;
 	}
+
+	notifyVertexStarChanged(d_12) ;
 }
 
 Dart EmbeddedMap2::cutEdge(Dart d)
@@ -186,6 +192,8 @@ Dart EmbeddedMap2::cutEdge(Dart d)
 		initDartEmbedding<FACE>(phi1(e), getEmbedding<FACE>(e)) ;
 	}
 
+	notifyVertexStarChanged(nd) ;
+
 	return nd;
 }
 
@@ -197,6 +205,7 @@ bool EmbeddedMap2::uncutEdge(Dart d)
 		{
 			copyDartEmbedding<EDGE>(phi2(d), d) ;
 		}
+		notifyVertexStarChanged(d) ;
 		return true ;
 	}
 	return false ;
@@ -266,6 +275,8 @@ Dart EmbeddedMap2::collapseEdge(Dart d, bool delDegenerateFaces)
 		Algo::Topo::setOrbitEmbedding<VERTEX>(*this, dV, vEmb) ;
 	}
 	
+	notifyVertexStarChanged(dV) ;
+
 	return dV ;
 }
 
@@ -287,6 +298,8 @@ bool EmbeddedMap2::flipEdge(Dart d)
 			copyDartEmbedding<FACE>(phi_1(e), e) ;
 		}
 
+		notifyVertexStarChanged(d) ;
+
 		return true ;
 	}
 	return false ;
@@ -310,6 +323,8 @@ bool EmbeddedMap2::flipBackEdge(Dart d)
 			copyDartEmbedding<FACE>(phi1(e), e) ;
 		}
 
+		notifyVertexStarChanged(d) ;
+
 		return true ;
 	}
 	return false ;
@@ -338,6 +353,11 @@ void EmbeddedMap2::swapEdges(Dart d, Dart e)
 	{
 		Algo::Topo::setOrbitEmbeddingOnNewCell<VOLUME>(*this, d);
 	}
+
+	notifyVertexStarChanged(d) ;
+	notifyVertexStarChanged(e) ;
+	notifyVertexStarChanged(d2) ;
+	notifyVertexStarChanged(e2) ;
 }
 
 void EmbeddedMap2::insertEdgeInVertex(Dart d, Dart e)
@@ -361,6 +381,9 @@ void EmbeddedMap2::insertEdgeInVertex(Dart d, Dart e)
 			Algo::Topo::setOrbitEmbedding<FACE>(*this, d, getEmbedding<FACE>(d)) ;
 		}
 	}
+
+	notifyVertexStarChanged(d) ;
+	notifyVertexStarChanged(phi2(e)) ;
 }
 
 bool EmbeddedMap2::removeEdgeFromVertex(Dart d)
@@ -389,6 +412,10 @@ bool EmbeddedMap2::removeEdgeFromVertex(Dart d)
 			setDartEmbedding<FACE>(d, getEmbedding<FACE>(d)) ;
 		}
 	}
+
+	notifyVertexStarChanged(d) ;
+	notifyVertexStarChanged(dPrev) ;
+
 	return b ;
 }
 
@@ -408,6 +435,8 @@ void EmbeddedMap2::sewFaces(Dart d, Dart e, bool withBoundary)
 //			initDartEmbedding<EDGE>(e,emb);
 //		}
 
+		notifyVertexStarChanged(d) ;
+		notifyVertexStarChanged(e) ;
 		return ;
 	}
 
@@ -423,13 +452,19 @@ void EmbeddedMap2::sewFaces(Dart d, Dart e, bool withBoundary)
 	{
 		copyDartEmbedding<EDGE>(e, d) ;
 	}
+
+	notifyVertexStarChanged(d) ;
+	notifyVertexStarChanged(e) ;
 }
 
 void EmbeddedMap2::unsewFaces(Dart d, bool withBoundary)
 {
 	if (!withBoundary)
 	{
+		Dart e = phi2(d) ;
 		Map2::unsewFaces(d, false) ;
+		notifyVertexStarChanged(d) ;
+		notifyVertexStarChanged(e) ;
 		return ;
 	}
 
@@ -461,6 +496,9 @@ void EmbeddedMap2::unsewFaces(Dart d, bool withBoundary)
 		Algo::Topo::setOrbitEmbeddingOnNewCell<EDGE>(*this, e);
 		Algo::Topo::copyCellAttributes<EDGE>(*this, e, d);
 	}
+
+	notifyVertexStarChanged(d) ;
+	notifyVertexStarChanged(e) ;
 }
 
 bool EmbeddedMap2::collapseDegeneratedFace(Dart d)
@@ -476,6 +514,8 @@ bool EmbeddedMap2::collapseDegeneratedFace(Dart d)
 		{
 			copyDartEmbedding<EDGE>(phi2(e), e) ;
 		}
+		notifyVertexStarChanged(e) ;
+		notifyVertexStarChanged(phi2(e)) ;
 		return true ;
 	}
 	return false ;
@@ -502,6 +542,9 @@ void EmbeddedMap2::splitFace(Dart d, Dart e)
 		Algo::Topo::setOrbitEmbeddingOnNewCell<FACE>(*this, e) ;
 		Algo::Topo::copyCellAttributes<FACE>(*this, e, d) ;
 	}
+
+	notifyVertexStarChanged(d) ;
+	notifyVertexStarChanged(e) ;
 }
 
 bool EmbeddedMap2::mergeFaces(Dart d)
@@ -514,6 +557,7 @@ bool EmbeddedMap2::mergeFaces(Dart d)
 		{
 			Algo::Topo::setOrbitEmbedding<FACE>(*this, dNext, getEmbedding<FACE>(dNext)) ;
 		}
+		notifyVertexStarChanged(dNext) ;
 		return true ;
 	}
 	return false ;
@@ -557,6 +601,8 @@ bool EmbeddedMap2::mergeVolumes(Dart d, Dart e, bool deleteFace)
 			{
 				Algo::Topo::setOrbitEmbedding<EDGE>(*this, darts[i], eEmb[i]) ;
 			}
+
+			notifyVertexStarChanged(darts[i]) ;
 		}
 		return true ;
 	}
@@ -605,6 +651,9 @@ void EmbeddedMap2::splitSurface(std::vector<Dart>& vd, bool firstSideClosed, boo
 			initDartEmbedding<VOLUME>(phi2(dit), getEmbedding<VOLUME>(dit));
 			initDartEmbedding<VOLUME>(phi2(dit2), getEmbedding<VOLUME>(dit2));
 		}
+
+		notifyVertexStarChanged(dit) ;
+		notifyVertexStarChanged(dit2) ;
 	}
 }
 
@@ -633,6 +682,8 @@ unsigned int EmbeddedMap2::closeHole(Dart d, bool forboundary)
 				initDartEmbedding<EDGE>(f, emb) ;
 		}
 
+		notifyVertexStarChanged(f) ;
+
 		f = phi1(f) ;
 	} while(dd != f) ;
 
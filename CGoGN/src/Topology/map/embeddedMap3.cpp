@@ -56,6 +56,9 @@ Dart EmbeddedMap3::splitVertex(std::vector<Dart>& vd)
 			Algo::Topo::setOrbitEmbedding<VOLUME>(*this, *it, getEmbedding<VOLUME>(*it)) ;
 	}
 
+	notifyVertexStarChanged(d) ;
+	notifyVertexStarChanged(d2) ;
+
 	return dres;
 }
 
@@ -69,6 +72,7 @@ Dart EmbeddedMap3::deleteVertex(Dart d)
 		{
 			Algo::Topo::setOrbitEmbedding<VOLUME>(*this, v, getEmbedding<VOLUME>(v)) ;
 		}
+		notifyVertexStarChanged(v) ;
 	}
 	return v ;
 }
@@ -132,6 +136,8 @@ Dart EmbeddedMap3::cutEdge(Dart d)
 		} while(f != d);
 	}
 
+	notifyVertexStarChanged(nd) ;
+
 	return nd ;
 }
 
@@ -144,6 +150,7 @@ bool EmbeddedMap3::uncutEdge(Dart d)
 		{
 			Algo::Topo::setOrbitEmbedding<EDGE>(*this, d, getEmbedding<EDGE>(d)) ;
 		}
+		notifyVertexStarChanged(d) ;
 		return true ;
 	}
 	return false ;
@@ -158,6 +165,7 @@ Dart EmbeddedMap3::deleteEdge(Dart d)
 		{
 			Algo::Topo::setOrbitEmbedding<VOLUME>(*this, v, getEmbedding<VOLUME>(v)) ;
 		}
+		notifyVertexStarChanged(v) ;
 	}
 	return v;
 }
@@ -216,6 +224,8 @@ Dart EmbeddedMap3::collapseEdge(Dart d, bool delDegenerateVolumes)
 			Algo::Topo::setOrbitEmbedding<EDGE>(*this, d2, getEmbedding<EDGE>(d2));
 			Algo::Topo::setOrbitEmbedding<EDGE>(*this, dd2, getEmbedding<EDGE>(dd2));
 		}
+
+		notifyVertexStarChanged(resV) ;
 	}
 
 	return resV;
@@ -273,6 +283,9 @@ void EmbeddedMap3::splitFace(Dart d, Dart e)
 		setDartEmbedding<VOLUME>(phi_1(dd),  vEmb2);
 		setDartEmbedding<VOLUME>(phi_1(ee),  vEmb2);
 	}
+
+	notifyVertexStarChanged(d) ;
+	notifyVertexStarChanged(e) ;
 }
 
 bool EmbeddedMap3::mergeFaces(Dart d)
@@ -291,6 +304,8 @@ bool EmbeddedMap3::mergeFaces(Dart d)
 			Algo::Topo::setOrbitEmbedding<FACE>(*this, d1, getEmbedding<FACE>(d1)) ;
 		}
 
+		notifyVertexStarChanged(d1) ;
+
 		return true;
 	}
 
@@ -313,6 +328,8 @@ Dart EmbeddedMap3::collapseFace(Dart d, bool delDegenerateVolumes)
 		{
 			Algo::Topo::setOrbitEmbedding<VERTEX>(*this, resV, vEmb);
 		}
+
+		notifyVertexStarChanged(resV) ;
 	}
 
 	return resV;
@@ -323,6 +340,12 @@ void EmbeddedMap3::sewVolumes(Dart d, Dart e, bool withBoundary)
 	if (!withBoundary)
 	{
 		Map3::sewVolumes(d, e, false) ;
+		Dart it = d ;
+		do
+		{
+			notifyVertexStarChanged(it) ;
+			it = phi1(it) ;
+		} while(it != d) ;
 		return ;
 	}
 
@@ -357,13 +380,29 @@ void EmbeddedMap3::sewVolumes(Dart d, Dart e, bool withBoundary)
 	{
 		Algo::Topo::setOrbitEmbedding<FACE>(*this, e, getEmbedding<FACE>(d)) ;
 	}
+
+	Dart it = d ;
+	do
+	{
+		notifyVertexStarChanged(it) ;
+		it = phi1(it) ;
+	} while(it != d) ;
 }
 
 void EmbeddedMap3::unsewVolumes(Dart d, bool withBoundary)
 {
 	if (!withBoundary)
 	{
+		Dart e = phi3(d) ;
 		Map3::unsewVolumes(d, false) ;
+		Dart it = d ;
+		do
+		{
+			notifyVertexStarChanged(it) ;
+			notifyVertexStarChanged(e) ;
+			it = phi1(it) ;
+			e = phi_1(e) ;
+		} while(it != d) ;
 		return ;
 	}
 
@@ -426,6 +465,14 @@ void EmbeddedMap3::unsewVolumes(Dart d, bool withBoundary)
 		Algo::Topo::setOrbitEmbeddingOnNewCell<FACE>(*this, dd);
 		Algo::Topo::copyCellAttributes<FACE>(*this, dd, d);
 	}
+
+	dit = d;
+	do
+	{
+		notifyVertexStarChanged(dit) ;
+		notifyVertexStarChanged(phi3(dit)) ;
+		dit = phi1(dit);
+	} while(dit != d);
 }
 
 bool EmbeddedMap3::mergeVolumes(Dart d, bool deleteFace)
@@ -438,6 +485,7 @@ bool EmbeddedMap3::mergeVolumes(Dart d, bool deleteFace)
 		{
 			Algo::Topo::setOrbitEmbedding<VOLUME>(*this, d2, getEmbedding<VOLUME>(d2)) ;
 		}
+		notifyVertexStarChanged(d2) ;
 		return true;
 	}
 	return false;
@@ -491,6 +539,9 @@ void EmbeddedMap3::splitVolume(std::vector<Dart>& vd)
 		Algo::Topo::setOrbitEmbeddingOnNewCell<VOLUME>(*this, v23) ;
 		Algo::Topo::copyCellAttributes<VOLUME>(*this, v23, v) ;
 	}
+
+	for(std::vector<Dart>::iterator it = vd.begin() ; it != vd.end() ; ++it)
+		notifyVertexStarChanged(*it) ;
 }
 
 void EmbeddedMap3::cutVolume(std::vector<Dart>& vd)
@@ -549,6 +600,9 @@ void EmbeddedMap3::cutVolume(std::vector<Dart>& vd)
 		Algo::Topo::setOrbitEmbeddingOnNewCell<VOLUME>(*this, v23) ;
 		Algo::Topo::copyCellAttributes<VOLUME>(*this, v23, v) ;
 	}
+
+	for(std::vector<Dart>::iterator it = vd.begin() ; it != vd.end() ; ++it)
+		notifyVertexStarChanged(*it) ;
 }
 
 //! Split a volume into two volumes along a edge path and add the given face between
@@ -600,6 +654,9 @@ void EmbeddedMap3::splitVolumeWithFace(std::vector<Dart>& vd, Dart d)
 		Algo::Topo::setOrbitEmbeddingOnNewCell<VOLUME>(*this, v23) ;
 		Algo::Topo::copyCellAttributes<VOLUME>(*this, v23, v) ;
 	}
+
+	for(std::vector<Dart>::iterator it = vd.begin() ; it != vd.end() ; ++it)
+		notifyVertexStarChanged(*it) ;
 }
 
 Dart EmbeddedMap3::collapseVolume(Dart d, bool delDegenerateVolumes)
@@ -614,6 +671,8 @@ Dart EmbeddedMap3::collapseVolume(Dart d, bool delDegenerateVolumes)
 		{
 			Algo::Topo::setOrbitEmbedding<VERTEX>(*this, resV, vEmb);
 		}
+
+		notifyVertexStarChanged(resV) ;
 	}
 
 	return resV;
@@ -624,6 +683,7 @@ unsigned int EmbeddedMap3::closeHole(Dart d)
 	unsigned int nbF = Map3::closeHole(d) ;
 
 	DartMarkerStore<EmbeddedMap3> mark(*this);	// Lock a marker
+	DartMarkerStore<EmbeddedMap3> markV(*this);	// vertices already notified
 
 	std::vector<Dart> visitedFaces;	// Faces that are traversed
 	visitedFaces.reserve(1024) ;
@@ -649,6 +709,11 @@ unsigned int EmbeddedMap3::closeHole(Dart d)
 			{
 				copyDartEmbedding<FACE>(f, phi3(f)) ;
 			}
+			if (!markV.isMarked(f))
+			{
+				markV.markOrbit<VERTEX>(f) ;
+				notifyVertexStarChanged(f) ;
+			}
 
 			Dart adj = phi2(f);	// Get adjacent face
 			if (!mark.isMarked(adj))
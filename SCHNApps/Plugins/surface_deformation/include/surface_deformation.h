@@ -8,8 +8,7 @@
 
 #include "Container/fakeAttribute.h"
 
-#include "NL/nl.h"
-#include "Algo/LinearSolving/basic.h"
+#include "Algo/LinearSolving/laplacianSolver.h"
 #include "Eigen/Dense"
 
 namespace CGoGN
@@ -43,7 +42,7 @@ struct MapParameters
 	VertexAttribute<unsigned int, PFP2::MAP> vIndex;
 	unsigned int nb_vertices;
 
-	NLContext nlContext;
+	Algo::LinearSolving::LaplacianSolver<PFP2>* solver;
 };
 
 class Surface_Deformation_Plugin : public PluginInteraction
@@ -2,7 +2,7 @@
 
 #include "Algo/Geometry/normal.h"
 #include "Algo/Geometry/laplacian.h"
-#include "Algo/LinearSolving/basic.h"
+#include "Algo/LinearSolving/laplacianSolver.h"
 
 #include "Algo/Topo/basic.h"
 
@@ -21,13 +21,12 @@ MapParameters::MapParameters() :
 	handleSelector(NULL),
 	freeSelector(NULL),
 	initialized(false),
-	nlContext(NULL)
+	solver(NULL)
 {}
 
 MapParameters::~MapParameters()
 {
-	if(nlContext)
-		nlDeleteContext(nlContext);
+	delete solver;
 }
 
 void MapParameters::start(MapHandlerGen* mhg)
@@ -69,12 +68,9 @@ void MapParameters::start(MapHandlerGen* mhg)
 
 			nb_vertices = Algo::Topo::computeIndexCells<VERTEX>(*map, vIndex);
 
-			if(nlContext)
-				nlDeleteContext(nlContext);
-			nlContext = nlNewContext();
-			nlSolverParameteri(NL_NB_VARIABLES, nb_vertices);
-			nlSolverParameteri(NL_LEAST_SQUARES, NL_TRUE);
-			nlSolverParameteri(NL_SOLVER, NL_CHOLMOD_EXT);
+			delete solver;
+			solver = new Algo::LinearSolving::LaplacianSolver<PFP2>(*map, vIndex, nb_vertices);
+			solver->setTopoWeights();
 
 			initialized = true;
 		}
@@ -100,8 +96,8 @@ void MapParameters::stop(MapHandlerGen* mh)
 //		if(vIndex.isValid())
 //			mh->removeAttribute(vIndex);
 
-		if(nlContext)
-			nlDeleteContext(nlContext);
+		delete solver;
+		solver = NULL;
 
 		initialized = false;
 	}
@@ -314,10 +310,7 @@ void Surface_Deformation_Plugin::selectedCellsChanged(CellSelectorGen* cs)
 	MapHandlerGen* map = static_cast<MapHandlerGen*>(QObject::sender());
 	MapParameters& p = h_parameterSet[map];
 	if(p.initialized && (p.handleSelector == cs || p.freeSelector == cs))
-	{
-		nlMakeCurrent(p.nlContext) ;
-		nlReset(NL_FALSE) ;
-	}
+		p.solver->resetConstraints();
 }
 
 
@@ -401,20 +394,9 @@ void Surface_Deformation_Plugin::matchDiffCoord(MapHandlerGen* mh)
 	PFP2::MAP* map = static_cast<MapHandler<PFP2>*>(mh)->getMap();
 	MapParameters& p = h_parameterSet[mh];
 
-	nlMakeCurrent(p.nlContext);
-	if (nlGetCurrentState() == NL_STATE_INITIAL)
-		nlBegin(NL_SYSTEM) ;
-	for (int coord = 0; coord < 3; ++coord)
-	{
-		Algo::LinearSolving::setupVariables<PFP2>(*map, p.vIndex, p.freeSelector->getMarker(), p.positionAttribute, coord);
-		nlBegin(NL_MATRIX);
-		Algo::LinearSolving::addRowsRHS_Laplacian_Topo<PFP2>(*map, p.vIndex, p.diffCoord, coord);
-		nlEnd(NL_MATRIX);
-		nlEnd(NL_SYSTEM);
-		nlSolve();
-		Algo::LinearSolving::getResult<PFP2>(*map, p.vIndex, p.positionAttribute, coord);
-		nlReset(NL_TRUE);
-	}
+	// factorization is kept while the free vertices do not change
+	p.solver->setConstraints(p.freeSelector->getMarker());
+	p.solver->solve(p.diffCoord, p.positionAttribute);
 }
 
 void Surface_Deformation_Plugin::asRigidAsPossible(MapHandlerGen* mh)
@@ -531,21 +513,8 @@ void Surface_Deformation_Plugin::asRigidAsPossible(MapHandlerGen* mh)
 			}
 		}
 
-		nlMakeCurrent(p.nlContext);
-		if (nlGetCurrentState() == NL_STATE_INITIAL)
-			nlBegin(NL_SYSTEM);
-		for (int coord = 0; coord < 3; ++coord)
-		{
-			Algo::LinearSolving::setupVariables<PFP2>(*map, p.vIndex, p.freeSelector->getMarker(), p.positionAttribute, coord);
-			nlBegin(NL_MATRIX);
-	//		LinearSolving::addRowsRHS_Laplacian_Cotan<PFP2>(*map, p.vIndex, p.edgeWeight, p.vertexArea, p.rotatedDiffCoord, coord);
-			Algo::LinearSolving::addRowsRHS_Laplacian_Topo<PFP2>(*map, p.vIndex, p.rotatedDiffCoord, coord);
-			nlEnd(NL_MATRIX);
-			nlEnd(NL_SYSTEM);
-			nlSolve();
-			Algo::LinearSolving::getResult<PFP2>(*map, p.vIndex, p.positionAttribute, coord);
-			nlReset(NL_TRUE);
-		}
+		p.solver->setConstraints(p.freeSelector->getMarker());
+		p.solver->solve(p.rotatedDiffCoord, p.positionAttribute);
 	}
 }
 #if CGOGN_QT_DESIRED_VERSION == 5
@@ -33,6 +33,16 @@ public:
 	 */
 	void Compute(double* outIntegral, double* outArea, CartesianFunction f, void* userDataFunction, CartesianDomain dom, void* userDataDomain) const;
 
+	/*
+	 *	Access to the quadrature samples of the current rule, to integrate functions whose
+	 *	values at the samples are cached
+	 *
+	 *	outX, outY, outZ: sample direction
+	 *	outW: sample weight (the weights sum to 1 : multiply by 4*pi to get areas)
+	 */
+	unsigned int GetNbSamples() const { return rOrder; }
+	void GetSample(unsigned int i, double* outX, double* outY, double* outZ, double* outW) const;
+
 protected:
 	unsigned int rId;
 	unsigned int rOrder;
@@ -6,7 +6,7 @@
 #include "Utils/qem.h"
 #include "Utils/sphericalHarmonics.h"
 
-#include "SphericalFunctionIntegratorCartesian.h"
+#include "radianceErrorIntegrator.h"
 
 namespace CGoGN
 {
@@ -45,7 +45,8 @@ private:
 
 	unsigned int m_nb_coefs;
 
-	SphericalFunctionIntegratorCartesian m_integrator;
+	RadianceErrorIntegrator<REAL, VEC3> m_errorIntegrator;
+	typename RadianceErrorIntegrator<REAL, VEC3>::Workspace m_errorWorkspace;
 
 	std::multimap<float, Dart> edges;
 	typename std::multimap<float, Dart>::iterator cur;
@@ -57,19 +58,6 @@ private:
 
 	typename PFP::REAL computeRadianceError(Dart d, const VEC3& p, const VEC3& n, const SH& r);
 
-	static bool isInHemisphere(double x, double y, double z, void* u)
-	{ // true iff [x,y,z] and u have the same direction
-		REAL* n = (REAL*)(u);
-		return x*n[0] + y*n[1] + z*n[2] >= 0.0;
-	}
-
-	static double SHEvalCartesian_Error(double x, double y, double z, void* u)
-	{
-		SH& e = *(SH*)(u);
-		VEC3 c = e.evaluate_at(x, y, z, 0);
-		return c.norm2();
-	}
-
 public:
 	EdgeSelector_Radiance(
 		MAP& m,
@@ -99,7 +87,6 @@ public:
 		this->m_map.removeAttribute(edgeInfo);
 		this->m_map.removeAttribute(m_quadric);
 //		this->m_map.removeAttribute(m_avgColor);
-		m_integrator.Release();
 	}
 
 	Algo::Surface::Decimation::SelectorType getType() { return Algo::Surface::Decimation::S_OTHER; }
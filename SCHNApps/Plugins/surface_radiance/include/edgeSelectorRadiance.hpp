@@ -24,7 +24,7 @@ bool EdgeSelector_Radiance<PFP>::init()
 
 	m_nb_coefs = SH::get_nb_coefs();
 
-	m_integrator.Init(29) ;
+	m_errorIntegrator.init(29) ;
 
 	// init QEM quadrics
 	for (Vertex v : allVerticesOf(m))
@@ -257,11 +257,7 @@ typename PFP::REAL EdgeSelector_Radiance<PFP>::computeRadianceError(Dart d, cons
 		SH diffRad(r0);
 		diffRad -= (r * alpha1 + r2 * alpha2 + r3 * alpha3);
 
-		double integral;
-		double area;
-		m_integrator.Compute(&integral, &area, EdgeSelector_Radiance<PFP>::SHEvalCartesian_Error, &diffRad, EdgeSelector_Radiance<PFP>::isInHemisphere, n0.data());
-
-		error += tArea * integral / area;
+		error += tArea * m_errorIntegrator.hemisphereMean(diffRad, n0, m_errorWorkspace);
 
 		it1 = it2;
 		it2 = m.phi2(m.phi_1(it1));
@@ -288,11 +284,7 @@ typename PFP::REAL EdgeSelector_Radiance<PFP>::computeRadianceError(Dart d, cons
 		SH diffRad(r1);
 		diffRad -= (r * alpha1 + r2 * alpha2 + r3 * alpha3);
 
-		double integral;
-		double area;
-		m_integrator.Compute(&integral, &area, EdgeSelector_Radiance<PFP>::SHEvalCartesian_Error, &diffRad, EdgeSelector_Radiance<PFP>::isInHemisphere, n1.data());
-
-		error += tArea * integral / area;
+		error += tArea * m_errorIntegrator.hemisphereMean(diffRad, n1, m_errorWorkspace);
 
 		it1 = it2;
 		it2 = m.phi2(m.phi_1(it1));
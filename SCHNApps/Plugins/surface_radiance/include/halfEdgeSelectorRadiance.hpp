@@ -36,7 +36,7 @@ bool HalfEdgeSelector_Radiance<PFP>::init()
 
 	m_nb_coefs = SH::get_nb_coefs();
 
-	m_integrator.Init(29) ;
+	m_errorIntegrator.init(29) ;
 
 	// init QEM quadrics
 	for (Vertex v : allVerticesOf(m))
@@ -317,11 +317,7 @@ typename PFP::REAL HalfEdgeSelector_Radiance<PFP>::computeRadianceError(Dart d)
 		SH diffRad(r0);
 		diffRad -= (r1 * alpha1 + r2 * alpha2 + r3 * alpha3);
 
-		double integral;
-		double area;
-		m_integrator.Compute(&integral, &area, HalfEdgeSelector_Radiance<PFP>::SHEvalCartesian_Error, &diffRad, HalfEdgeSelector_Radiance<PFP>::isInHemisphere, n0.data());
-
-		error += tArea * integral / area;
+		error += tArea * m_errorIntegrator.hemisphereMean(diffRad, n0, m_errorWorkspace);
 
 		it1 = it2;
 		it2 = m.phi2(m.phi_1(it1));
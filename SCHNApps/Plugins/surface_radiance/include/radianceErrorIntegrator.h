@@ -0,0 +1,90 @@
+#ifndef _RADIANCE_ERROR_INTEGRATOR_H_
+#define _RADIANCE_ERROR_INTEGRATOR_H_
+
+#include "Utils/sphericalHarmonics.h"
+
+#include "SphericalFunctionIntegratorCartesian.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace SCHNApps
+{
+
+/**
+ * Mean of the squared norm of a SH (typically a radiance difference) over the hemisphere of a normal,
+ * with the quadrature rule of SphericalFunctionIntegratorCartesian.
+ * The SH basis functions are evaluated once for all the quadrature directions (batch evaluation);
+ * each call then only combines the coefficients with these values.
+ */
+template <typename REAL, typename VEC3>
+class RadianceErrorIntegrator
+{
+public:
+	typedef Utils::SphericalHarmonics<REAL, VEC3> SH;
+
+	// evaluation buffer (use one per thread)
+	typedef std::vector<VEC3> Workspace;
+
+private:
+	unsigned int m_nbSamples;
+	std::vector<REAL> m_directions;	// [x_i] then [y_i] then [z_i]
+	std::vector<REAL> m_weights;
+	std::vector<REAL> m_basis;
+
+public:
+	RadianceErrorIntegrator() : m_nbSamples(0) {}
+
+	// the level of the SH must be set before
+	void init(unsigned int ruleId)
+	{
+		SphericalFunctionIntegratorCartesian integrator;
+		integrator.Init(ruleId);
+
+		m_nbSamples = integrator.GetNbSamples();
+		m_directions.resize(3 * m_nbSamples);
+		m_weights.resize(m_nbSamples);
+		for (unsigned int i = 0; i < m_nbSamples; ++i)
+		{
+			double x, y, z, w;
+			integrator.GetSample(i, &x, &y, &z, &w);
+			m_directions[i] = REAL(x);
+			m_directions[m_nbSamples + i] = REAL(y);
+			m_directions[2 * m_nbSamples + i] = REAL(z);
+			m_weights[i] = REAL(w);
+		}
+		integrator.Release();
+
+		m_basis.resize(SH::get_nb_coefs() * m_nbSamples);
+		SH::evaluate_basis(m_nbSamples, &m_directions[0], &m_directions[m_nbSamples], &m_directions[2 * m_nbSamples], &m_basis[0]);
+	}
+
+	REAL hemisphereMean(const SH& e, const VEC3& n, Workspace& ws) const
+	{
+		ws.resize(m_nbSamples);
+		e.evaluate_batch(m_nbSamples, &m_basis[0], &ws[0]);
+
+		const REAL* x = &m_directions[0];
+		const REAL* y = x + m_nbSamples;
+		const REAL* z = y + m_nbSamples;
+		double integral = 0.0;
+		double area = 0.0;
+		for (unsigned int i = 0; i < m_nbSamples; ++i)
+		{
+			if (x[i]*n[0] + y[i]*n[1] + z[i]*n[2] >= 0.0)
+			{
+				integral += m_weights[i] * ws[i].norm2();
+				area += m_weights[i];
+			}
+		}
+		return area > 0.0 ? REAL(integral / area) : REAL(0);
+	}
+};
+
+} // namespace SCHNApps
+
+} // namespace CGoGN
+
+#endif
@@ -163,19 +163,6 @@ protected:
 
 	QAction* m_importSHAction;
 	QAction* m_importPAction;
-
-	static bool isInHemisphere(double x, double y, double z, void* u)
-	{ // true iff [x,y,z] and u have the same direction
-		PFP2::REAL* n = (PFP2::REAL*)(u);
-		return x*n[0] + y*n[1] + z*n[2] >= 0.0;
-	}
-
-	static double SHEvalCartesian_Error(double x, double y, double z, void* u)
-	{
-		Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3>& e = *(Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3>*)(u);
-		PFP2::VEC3 c = e.evaluate_at(x, y, z, 0);
-		return c.norm2();
-	}
 };
 
 } // namespace SCHNApps
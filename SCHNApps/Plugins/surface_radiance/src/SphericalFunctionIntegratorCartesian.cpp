@@ -66,3 +66,11 @@ void SphericalFunctionIntegratorCartesian::Compute(double* outIntegral, double*
 	*outIntegral = intVal * 4.0 * M_PI;
 	*outArea = areaVal * 4.0 * M_PI;
 }
+
+void SphericalFunctionIntegratorCartesian::GetSample(unsigned int i, double* outX, double* outY, double* outZ, double* outW) const
+{
+	*outX = quadValues[i];
+	*outY = quadValues[rOrder + i];
+	*outZ = quadValues[2 * rOrder + i];
+	*outW = quadValues[3 * rOrder + i];
+}
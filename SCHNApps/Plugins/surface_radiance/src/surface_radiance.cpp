@@ -10,9 +10,12 @@
 #include "camera.h"
 
 #include "Algo/Geometry/distances.h"
+#include "Algo/Geometry/closestFace.h"
 #include "Algo/Geometry/plane.h"
 
-#include "SphericalFunctionIntegratorCartesian.h"
+#include "Utils/chrono.h"
+
+#include "radianceErrorIntegrator.h"
 
 #include <QFileDialog>
 #include <QFileInfo>
@@ -659,9 +662,6 @@ void Surface_Radiance_Plugin::computeRadianceDistance(
 	MapParameters& mapParams1 = h_mapParameterSet[mh1];
 	MapParameters& mapParams2 = h_mapParameterSet[mh2];
 
-	SphericalFunctionIntegratorCartesian integrator;
-	integrator.Init(29);
-
 	PFP2::MAP* map1 = mh1->getMap();
 	PFP2::MAP* map2 = mh2->getMap();
 
@@ -669,72 +669,71 @@ void Surface_Radiance_Plugin::computeRadianceDistance(
 	//   distance from map1 to map2 is stored in map1 vertex attribute distance1
 	//   distance from map2 to map1 is stored in map2 vertex attribute distance2
 
+	Utils::Chrono chrono;
+	chrono.start();
+
+	// the quadrature directions are the same for all vertices :
+	// the values of the SH basis functions at these directions are computed once
+	typedef Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3> SH;
+	RadianceErrorIntegrator<PFP2::REAL, PFP2::VEC3> errorIntegrator;
+	errorIntegrator.init(29);
+
+	// closest face search structure on map2
+	Algo::Geometry::ClosestFaceSearch<PFP2> closestFaceSearch(*map2, position2);
+
 	// for each vertex of map1
 
-	std::vector<PFP2::REAL> errors;
-	errors.reserve(100000);
+	// per thread buffers (the computing threads are numbered from 1)
+	unsigned int nbThreads = std::max(Parallel::NumberOfThreads, 2);
+	std::vector<std::vector<PFP2::REAL> > threadErrors(nbThreads);
+	std::vector<SH> threadRadiance(nbThreads);
+	std::vector<RadianceErrorIntegrator<PFP2::REAL, PFP2::VEC3>::Workspace> threadWorkspaces(nbThreads);
 
 	map2->setExternalThreadsAuthorization(true);
 
 	Parallel::foreach_cell<VERTEX>(*map1, [&] (Vertex v, unsigned int threadIndex)
 	{
 		const PFP2::VEC3& P = position1[v];
-		PFP2::VEC3& N = normal1[v];
+		const PFP2::VEC3& N = normal1[v];
 
 		// find closest point on map2
 
-		PFP2::REAL minDist2 = std::numeric_limits<PFP2::REAL>::max();
-		Face closestFace;
-
-		for (Face f : allFacesOf(*map2))
-		{
-			PFP2::REAL dist = Algo::Geometry::squaredDistancePoint2Face<PFP2>(*map2, f, position2, P);
-			if (dist < minDist2)
-			{
-				minDist2 = dist;
-				closestFace = f;
-			}
-		}
-
-//		PFP2::REAL minDist = sqrt(minDist2);
+		PFP2::REAL minDist2;
+		Face closestFace = closestFaceSearch.closestFace(P, minDist2);
 
 		double l1, l2, l3;
 		Algo::Geometry::closestPointInTriangle<PFP2>(*map2, closestFace, position2, P, l1, l2, l3);
 
 		// compute radiance error
 
-		const PFP2::VEC3& P1 = position2[closestFace.dart];
-		const PFP2::VEC3& P2 = position2[map2->phi1(closestFace.dart)];
-		const PFP2::VEC3& P3 = position2[map2->phi_1(closestFace.dart)];
-		PFP2::VEC3 CP = l1*P1 + l2*P2 + l3*P3;
-
-		const PFP2::VEC3& N1 = normal2[closestFace.dart];
-		const PFP2::VEC3& N2 = normal2[map2->phi1(closestFace.dart)];
-		const PFP2::VEC3& N3 = normal2[map2->phi_1(closestFace.dart)];
-		PFP2::VEC3 CPN = l1*N1 + l2*N2 + l3*N3;
-
-		const Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3>& R1 = mapParams2.radiance[closestFace.dart];
-		const Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3>& R2 = mapParams2.radiance[map2->phi1(closestFace.dart)];
-		const Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3>& R3 = mapParams2.radiance[map2->phi_1(closestFace.dart)];
-		Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3> CPR = R1*l1 + R2*l2 + R3*l3;
-
-		Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3> diffRad(mapParams1.radiance[v]);
-		diffRad -= CPR;
+		const SH& R1 = mapParams2.radiance[closestFace.dart];
+		const SH& R2 = mapParams2.radiance[map2->phi1(closestFace.dart)];
+		const SH& R3 = mapParams2.radiance[map2->phi_1(closestFace.dart)];
+		const SH& R = mapParams1.radiance[v];
 
-		double integral;
-		double area;
-		integrator.Compute(&integral, &area, SHEvalCartesian_Error, &diffRad, isInHemisphere, N.data());
+		SH& diffRad = threadRadiance[threadIndex];
+		for (int l = 0; l <= SH::get_resolution(); ++l)
+			for (int m = -l; m <= l; ++m)
+				diffRad.get_coef(l, m) = R.get_coef(l, m) - (R1.get_coef(l, m)*l1 + R2.get_coef(l, m)*l2 + R3.get_coef(l, m)*l3);
 
-		PFP2::REAL radError = integral / area;
+		// integrate the squared difference over the hemisphere of the normal
+		PFP2::REAL radError = errorIntegrator.hemisphereMean(diffRad, N, threadWorkspaces[threadIndex]);
 
 		distance1[v] = radError;
 
-		errors.push_back(radError);
-	}
-	);
+		threadErrors[threadIndex].push_back(radError);
+	},
+	AUTO, nbThreads);
 
 	map2->setExternalThreadsAuthorization(false);
 
+	std::vector<PFP2::REAL> errors;
+	for (const std::vector<PFP2::REAL>& te : threadErrors)
+		errors.insert(errors.end(), te.begin(), te.end());
+
+	int elapsed = chrono.elapsed();
+	m_schnapps->statusBarMessage(QString("Radiance distance : %1 vertices/s").arg(elapsed > 0 ? 1000.0 * errors.size() / elapsed : 0.0), 5000);
+
 	std::sort(errors.begin(), errors.end());
 	PFP2::REAL Q1 = errors[int(errors.size() / 4)];
 //	PFP2::REAL Q2 = errors[int(errors.size() / 2)];
@@ -748,8 +747,6 @@ void Surface_Radiance_Plugin::computeRadianceDistance(
 		if (dist > upperBound) { dist = upperBound; }
 	}
 
-	integrator.Release();
-
 	this->pythonRecording("computeRadianceDistance", "", mapName1, positionAttributeName1, distanceAttributeName1,
 							mapName2, positionAttributeName2, distanceAttributeName2);
 